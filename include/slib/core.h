@@ -86,11 +86,13 @@
 #include "core/event.h"
 #include "core/thread.h"
 #include "core/thread_pool.h"
+#include "core/parallel.h"
 #include "core/rw_lock.h"
 #include "core/log.h"
 #include "core/asset.h"
 
 #include "core/io.h"
+#include "core/buffered_io.h"
 #include "core/file.h"
 #include "core/pipe.h"
 #include "core/async.h"
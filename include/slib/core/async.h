@@ -73,7 +73,7 @@ namespace slib
 		sl_bool isRunning();
 
 
-		sl_bool addTask(const Function<void()>& task);
+		sl_bool addTask(InlineFunction<void()>&& task);
 	
 		void wake();
 
@@ -86,6 +86,11 @@ namespace slib
 
 		sl_bool dispatch(const Function<void()>& callback, sl_uint64 delay_ms) override;
 
+		// schedules (or reschedules) the entry on this loop's timing wheel
+		sl_bool addTimeout(TimingWheelEntry* entry, sl_uint64 delay_ms);
+
+		void removeTimeout(TimingWheelEntry* entry);
+
 	protected:
 		sl_bool m_flagInit;
 		sl_bool m_flagRunning;
@@ -93,12 +98,14 @@ namespace slib
 
 		Ref<Thread> m_thread;
 
-		LinkedQueue< Function<void()> > m_queueTasks;
+		LinkedQueue< InlineFunction<void()> > m_queueTasks;
 	
 		LinkedQueue< Ref<AsyncIoInstance> > m_queueInstancesOrder;
 		LinkedQueue< Ref<AsyncIoInstance> > m_queueInstancesClosing;
 		LinkedQueue< Ref<AsyncIoInstance> > m_queueInstancesClosed;
 
+		TimingWheel m_timeouts;
+
 	protected:
 		static void* _native_createHandle();
 		static void _native_closeHandle(void* handle);
@@ -108,7 +115,8 @@ namespace slib
 		void _native_wake();
 
 	protected:
-		void _stepBegin();
+		// returns the timeout for waiting events (-1: infinite)
+		sl_int32 _stepBegin();
 		void _stepEnd();
 	
 	};
@@ -232,6 +240,22 @@ namespace slib
 
 	};
 	
+	/*
+		Shared pool of I/O buffers, classed by the power-of-two sizes from 1KB to 64KB.
+		Streams borrow a buffer only while the data is ready to be read (see `AsyncStream::readPooled()`),
+		so idle connections hold no buffer memory.
+	*/
+	class SLIB_EXPORT AsyncBufferPool
+	{
+	public:
+		// returns a buffer having at least `size` bytes
+		static Memory borrow(sl_size size);
+
+		// takes back `mem` if no one else refers to it, and sets `mem` to null
+		static void release(Memory& mem);
+
+	};
+
 	class SLIB_EXPORT AsyncStreamRequest : public Referable
 	{
 		SLIB_DECLARE_OBJECT
@@ -242,6 +266,8 @@ namespace slib
 		Ref<Referable> userObject;
 		Function<void(AsyncStreamResult&)> callback;
 		sl_bool flagRead;
+		// `data` is borrowed from `AsyncBufferPool` only while the stream is ready to be read
+		sl_bool flagBorrowBuffer;
 
 	protected:
 		AsyncStreamRequest(const void* data, sl_uint32 size, Referable* userObject, const Function<void(AsyncStreamResult&)>& callback, sl_bool flagRead);
@@ -253,9 +279,17 @@ namespace slib
 
 		static Ref<AsyncStreamRequest> createWrite(const void* data, sl_uint32 size, Referable* userObject, const Function<void(AsyncStreamResult&)>& callback);
 
+		static Ref<AsyncStreamRequest> createPooledRead(sl_uint32 size, Referable* userObject, const Function<void(AsyncStreamResult&)>& callback);
+
 	public:
 		void runCallback(AsyncStream* stream, sl_uint32 resultSize, sl_bool flagError);
 
+	public:
+		// recycles the storage of the plain requests through a free list (derived requests use the global heap)
+		static void* operator new(sl_size_t size);
+
+		static void operator delete(void* ptr, sl_size_t size);
+
 	};
 	
 	
@@ -334,6 +368,15 @@ namespace slib
 	
 		sl_bool writeFromMemory(const Memory& mem, const Function<void(AsyncStreamResult&)>& callback);
 
+		// reads into a buffer borrowed from `AsyncBufferPool`, which is valid only during the callback
+		virtual sl_bool readPooled(sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject = sl_null);
+
+		// returns true if the stream can write the content of a file without copying it into user space (such as `sendfile`)
+		virtual sl_bool isSendFileSupported();
+
+		// writes `size` bytes of `file` from `offset`, regardless of the current position of `file`
+		virtual sl_bool sendFile(const Ref<File>& file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject = sl_null);
+
 		virtual sl_bool addTask(const Function<void()>& callback) = 0;
 
 	};
@@ -709,6 +752,9 @@ namespace slib
 		sl_bool copyFromFile(const String& path, const Ref<Dispatcher>& dispatcher);
 
 		sl_uint64 getOutputLength() const;
+		
+		// returns false when the output contains the stream bodies
+		sl_bool mergeOutput(Memory& _out) const;
 	
 	protected:
 		sl_uint64 m_lengthOutput;
@@ -761,6 +807,8 @@ namespace slib
 		
 		void onWriteStream(AsyncStreamResult& result);
 
+		void onSendFile(AsyncStreamResult& result);
+
 	protected:
 		void _onError();
 
@@ -768,6 +816,8 @@ namespace slib
 
 		void _write(sl_bool flagCompleted);
 
+		sl_bool _sendFile();
+
 	protected:
 		Ref<AsyncStream> m_streamOutput;
 		sl_uint32 m_bufferSize;
@@ -777,6 +827,9 @@ namespace slib
 
 		Ref<AsyncOutputBufferElement> m_elementWriting;
 		Ref<AsyncCopy> m_copy;
+		Ref<File> m_fileSending;
+		sl_uint64 m_offsetSending;
+		sl_uint64 m_sizeSending;
 		Memory m_bufWrite;
 		sl_bool m_flagWriting;
 		sl_bool m_flagClosed;
@@ -0,0 +1,275 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_CORE_BUFFERED_IO
+#define CHECKHEADER_SLIB_CORE_BUFFERED_IO
+
+#include "definition.h"
+
+#include "io.h"
+#include "ptr.h"
+#include "mio.h"
+
+#define SLIB_BUFFERED_IO_DEFAULT_SIZE 8192
+
+namespace slib
+{
+
+	/*
+		Reads the underlying stream by the blocks of the buffer size.
+		The primitive and CVLI readers below hide the ones of `IReader`, and decode
+		the values directly from the buffer, so they don't call any virtual function
+		until the buffer runs out. The calls through `IReader*` are still served from
+		the buffer by the overridden `read()`.
+		BufferedReader is not thread-safe.
+	*/
+	class SLIB_EXPORT BufferedReader : public Object, public IReader, public IClosable
+	{
+		SLIB_DECLARE_OBJECT
+
+	public:
+		BufferedReader();
+
+		~BufferedReader();
+
+	public:
+		static Ref<BufferedReader> create(const Ptr<IReader>& reader, sl_size bufferSize = SLIB_BUFFERED_IO_DEFAULT_SIZE);
+
+	public:
+		Ptr<IReader> getReader();
+
+		// releases the underlying reader
+		void close() override;
+
+		sl_bool isOpened();
+
+		// returns the bytes in the buffer at first, and reads the underlying reader only when the buffer is empty
+		sl_reg read(void* buf, sl_size size) override;
+
+		// count of the bytes remaining in the buffer
+		sl_size getBufferedSize();
+
+	public:
+		sl_reg readFully(void* buf, sl_size size);
+
+		sl_bool readInt8(sl_int8* output);
+
+		sl_int8 readInt8(sl_int8 def = 0);
+
+		sl_bool readUint8(sl_uint8* output);
+
+		sl_uint8 readUint8(sl_uint8 def = 0);
+
+		sl_bool readInt16(sl_int16* output, sl_bool flagBigEndian = sl_false);
+
+		sl_int16 readInt16(sl_int16 def = 0, sl_bool flagBigEndian = sl_false);
+
+		sl_bool readUint16(sl_uint16* output, sl_bool flagBigEndian = sl_false);
+
+		sl_uint16 readUint16(sl_uint16 def = 0, sl_bool flagBigEndian = sl_false);
+
+		sl_bool readInt32(sl_int32* output, sl_bool flagBigEndian = sl_false);
+
+		sl_int32 readInt32(sl_int32 def = 0, sl_bool flagBigEndian = sl_false);
+
+		sl_bool readUint32(sl_uint32* output, sl_bool flagBigEndian = sl_false);
+
+		sl_uint32 readUint32(sl_uint32 def = 0, sl_bool flagBigEndian = sl_false);
+
+		sl_bool readInt64(sl_int64* output, sl_bool flagBigEndian = sl_false);
+
+		sl_int64 readInt64(sl_int64 def = 0, sl_bool flagBigEndian = sl_false);
+
+		sl_bool readUint64(sl_uint64* output, sl_bool flagBigEndian = sl_false);
+
+		sl_uint64 readUint64(sl_uint64 def = 0, sl_bool flagBigEndian = sl_false);
+
+		sl_bool readFloat(float* output, sl_bool flagBigEndian = sl_false);
+
+		float readFloat(float def = 0, sl_bool flagBigEndian = sl_false);
+
+		sl_bool readDouble(double* output, sl_bool flagBigEndian = sl_false);
+
+		double readDouble(double def = 0, sl_bool flagBigEndian = sl_false);
+
+		sl_bool readUint32CVLI(sl_uint32* output);
+
+		sl_uint32 readUint32CVLI(sl_uint32 def = 0);
+
+		sl_bool readInt32CVLI(sl_int32* output);
+
+		sl_int32 readInt32CVLI(sl_int32 def = 0);
+
+		sl_bool readUint64CVLI(sl_uint64* output);
+
+		sl_uint64 readUint64CVLI(sl_uint64 def = 0);
+
+		sl_bool readInt64CVLI(sl_int64* output);
+
+		sl_int64 readInt64CVLI(sl_int64 def = 0);
+
+		sl_bool readSizeCVLI(sl_size* output);
+
+		sl_size readSizeCVLI(sl_size def = 0);
+
+		sl_bool readIntCVLI(sl_reg* output);
+
+		sl_reg readIntCVLI(sl_reg def = 0);
+
+		sl_bool readSection(Memory* output, sl_size maxSize = SLIB_SIZE_MAX);
+
+		Memory readSection(const Memory& def, sl_size maxSize = SLIB_SIZE_MAX);
+
+		Memory readSection(sl_size maxSize = SLIB_SIZE_MAX);
+
+		// creates the string directly from the buffer
+		sl_bool readStringSection(String* output, sl_size maxLen = SLIB_SIZE_MAX);
+
+		String readStringSection(const String& def, sl_size maxLen = SLIB_SIZE_MAX);
+
+		String readStringSection(sl_size maxLen = SLIB_SIZE_MAX);
+
+		sl_bool readTime(Time* output);
+
+		Time readTime();
+
+		Time readTime(Time def);
+
+	protected:
+		// returns `size` bytes (up to 16) in the buffer, and consumes them
+		const sl_uint8* _prepareRead(sl_size size);
+
+		const sl_uint8* _prepareReadSlow(sl_size size);
+
+		// appends the data of the underlying reader after the buffered bytes
+		sl_bool _fill();
+
+		sl_bool _readUint32CVLISlow(sl_uint32* output);
+
+		sl_bool _readUint64CVLISlow(sl_uint64* output);
+
+	protected:
+		Ptr<IReader> m_reader;
+		sl_uint8* m_buf;
+		sl_size m_sizeBuf;
+		sl_uint8* m_pos;
+		sl_uint8* m_end;
+
+	};
+
+	/*
+		Collects the writes in the buffer, and writes the whole buffer to the
+		underlying stream when it overflows, on `flush()` or `close()`, and on
+		destruction. As `BufferedReader`, the primitive and CVLI writers below encode
+		the values directly into the buffer.
+		BufferedWriter is not thread-safe.
+	*/
+	class SLIB_EXPORT BufferedWriter : public Object, public IWriter, public IClosable
+	{
+		SLIB_DECLARE_OBJECT
+
+	public:
+		BufferedWriter();
+
+		~BufferedWriter();
+
+	public:
+		static Ref<BufferedWriter> create(const Ptr<IWriter>& writer, sl_size bufferSize = SLIB_BUFFERED_IO_DEFAULT_SIZE);
+
+	public:
+		Ptr<IWriter> getWriter();
+
+		// flushes the buffer, and releases the underlying writer
+		void close() override;
+
+		sl_bool isOpened();
+
+		sl_reg write(const void* buf, sl_size size) override;
+
+		sl_bool flush();
+
+		// count of the bytes waiting in the buffer
+		sl_size getBufferedSize();
+
+	public:
+		sl_reg writeFully(const void* buf, sl_size size);
+
+		sl_bool writeInt8(sl_int8 value);
+
+		sl_bool writeUint8(sl_uint8 value);
+
+		sl_bool writeInt16(sl_int16 value, sl_bool flagBigEndian = sl_false);
+
+		sl_bool writeUint16(sl_uint16 value, sl_bool flagBigEndian = sl_false);
+
+		sl_bool writeInt32(sl_int32 value, sl_bool flagBigEndian = sl_false);
+
+		sl_bool writeUint32(sl_uint32 value, sl_bool flagBigEndian = sl_false);
+
+		sl_bool writeInt64(sl_int64 value, sl_bool flagBigEndian = sl_false);
+
+		sl_bool writeUint64(sl_uint64 value, sl_bool flagBigEndian = sl_false);
+
+		sl_bool writeFloat(float value, sl_bool flagBigEndian = sl_false);
+
+		sl_bool writeDouble(double value, sl_bool flagBigEndian = sl_false);
+
+		sl_bool writeUint32CVLI(sl_uint32 value);
+
+		sl_bool writeInt32CVLI(sl_int32 value);
+
+		sl_bool writeUint64CVLI(sl_uint64 value);
+
+		sl_bool writeInt64CVLI(sl_int64 value);
+
+		sl_bool writeSizeCVLI(sl_size value);
+
+		sl_bool writeIntCVLI(sl_reg value);
+
+		sl_bool writeSection(const void* mem, sl_size size);
+
+		sl_bool writeSection(const Memory& mem);
+
+		sl_bool writeStringSection(const String& str, sl_size maxLen = SLIB_SIZE_MAX);
+
+		sl_bool writeTime(const Time& t);
+
+	protected:
+		// reserves `size` bytes (up to 16) in the buffer
+		sl_uint8* _prepareWrite(sl_size size);
+
+		sl_uint8* _prepareWriteSlow(sl_size size);
+
+	protected:
+		Ptr<IWriter> m_writer;
+		sl_uint8* m_buf;
+		sl_size m_sizeBuf;
+		sl_uint8* m_pos;
+		sl_uint8* m_end;
+
+	};
+
+}
+
+#include "detail/buffered_io.inc"
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#ifndef CHECKHEADER_SLIB_CORE_DETAIL_SIMD
+#define CHECKHEADER_SLIB_CORE_DETAIL_SIMD
+
+#include "../definition.h"
+
+/*
+	Internal header, not included by `slib/core.h`.
+	Instruction sets selected at runtime by the vectorized routines (image kernels, strings, charsets, checksums).
+*/
+
+namespace slib
+{
+	
+	class SLIB_EXPORT _priv_Simd
+	{
+	public:
+		// each level includes the lower ones
+		enum Level
+		{
+			None = 0, // scalar code only
+			Base = 1, // SSE2 (x86), NEON (ARM)
+			SSSE3 = 2, // x86 only
+			AVX2 = 3 // x86 only
+		};
+		
+	public:
+		// highest level supported by the processor and the OS, under the limit given by `setLevelLimit()`
+		static Level getLevel() noexcept;
+		
+		// for the tests: forces the vectorized routines down to `level`, to compare each code path with the scalar code
+		static void setLevelLimit(Level level) noexcept;
+		
+	};
+	
+}
+
+#endif
@@ -29,6 +29,7 @@
 #include "thread.h"
 #include "time.h"
 #include "map.h"
+#include "timing_wheel.h"
 
 namespace slib
 {
@@ -58,6 +59,11 @@ namespace slib
 
 		sl_bool dispatch(const Function<void()>& task, sl_uint64 delay_ms = 0) override;
 
+		// schedules (or reschedules) the entry on this loop's timing wheel
+		sl_bool addTimeout(TimingWheelEntry* entry, sl_uint64 delay_ms);
+
+		void removeTimeout(TimingWheelEntry* entry);
+
 		sl_bool addTimer(const Ref<Timer>& timer);
 		
 		void removeTimer(const Ref<Timer>& timer);
@@ -73,13 +79,7 @@ namespace slib
 
 		LinkedQueue< Function<void()> > m_queueTasks;
 
-		struct TimeTask
-		{
-			sl_uint64 time;
-			Function<void()> task;
-		};
-		CMap<sl_uint64, TimeTask> m_timeTasks;
-		Mutex m_lockTimeTasks;
+		TimingWheel m_timeTasks;
 
 		class TimerTask
 		{
@@ -113,8 +113,8 @@ namespace slib
 			sl_uint8* b = (sl_uint8*)(&v);
 			for (int i = 0; i < 4; i++) {
 				sl_uint8 t = b[i];
-				b[i] = b[3 - i];
-				b[3 - i] = t;
+				b[i] = b[7 - i];
+				b[7 - i] = t;
 			}
 			return v;
 		}
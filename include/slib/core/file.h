@@ -27,6 +27,7 @@
 
 #include "list.h"
 #include "io.h"
+#include "buffered_io.h"
 
 typedef sl_reg sl_file;
 #define SLIB_FILE_INVALID_HANDLE (sl_file)(-1)
@@ -137,6 +138,13 @@ namespace slib
 	
 		static Ref<File> openForRandomRead(const String& filePath, sl_bool flagShareRead = sl_true);
 
+		// the buffered streams own the opened file, and close it on release
+		static Ref<BufferedReader> openBufferedForRead(const String& filePath, sl_size bufferSize = SLIB_BUFFERED_IO_DEFAULT_SIZE);
+
+		static Ref<BufferedWriter> openBufferedForWrite(const String& filePath, sl_size bufferSize = SLIB_BUFFERED_IO_DEFAULT_SIZE);
+
+		static Ref<BufferedWriter> openBufferedForAppend(const String& filePath, sl_size bufferSize = SLIB_BUFFERED_IO_DEFAULT_SIZE);
+
 		/*
 			Physical Disks and Volumes
 		 
@@ -321,7 +329,115 @@ namespace slib
 		static sl_bool _deleteDirectory(const String& dirPath);
 
 	};
-	
+
+	class MappedFileMode
+	{
+	public:
+		int value;
+		SLIB_MEMBERS_OF_FLAGS(MappedFileMode, value)
+
+		enum {
+			Read = 1,
+			Write = 2,
+
+			NotCreate = 0x00001000,
+
+			// access pattern hints (madvise, or the flags of CreateFile on Win32)
+			HintSequential = 0x00010000,
+			HintRandom = 0x00020000,
+			HintWillNeed = 0x00040000,
+			// transparent huge pages (Linux)
+			HintHugePages = 0x00080000,
+			// pre-faults the pages on mapping (Linux)
+			Populate = 0x00100000,
+
+			ReadWrite = Read | Write,
+			ReadSequential = Read | HintSequential | HintWillNeed
+		};
+	};
+
+	/*
+		Maps the file into the memory, and hands out the views as `Memory` objects.
+		Every view keeps its own mapping alive, so the views remain valid after the
+		`MappedFile` is closed or released. The views of a writable file share the
+		pages with the file, and `flush()` writes the modified pages back.
+	*/
+	class SLIB_EXPORT MappedFile : public Object
+	{
+		SLIB_DECLARE_OBJECT
+
+	public:
+		MappedFile();
+
+		~MappedFile();
+
+	public:
+		// `size`: resizes the writable file when it is not zero
+		static Ref<MappedFile> open(const String& filePath, const MappedFileMode& mode, sl_uint64 size = 0);
+
+		static Ref<MappedFile> openForRead(const String& filePath);
+
+		static Ref<MappedFile> openForReadWrite(const String& filePath, sl_uint64 size = 0);
+
+		// maps the whole file as a read-only view (null for the empty file)
+		static Memory mapAll(const String& filePath, const MappedFileMode& mode = MappedFileMode::ReadSequential);
+
+	public:
+		void close();
+
+		sl_bool isOpened();
+
+		sl_uint64 getSize();
+
+		MappedFileMode getMode();
+
+		// creates a new view of [offset, offset+size)
+		Memory map(sl_uint64 offset, sl_size size);
+
+		Memory mapAll();
+
+		/*
+			Returns a view of [offset, offset+size) inside the sliding window, which is
+			remapped only when the range is out of it. Use this to scan the files larger
+			than the address space (32-bit) without mapping a region per access.
+		*/
+		Memory mapWindow(sl_uint64 offset, sl_size size);
+
+		sl_size getWindowSize();
+
+		void setWindowSize(sl_size size);
+
+		// writes the modified pages of the view back to the file
+		static sl_bool flush(const void* data, sl_size size, sl_bool flagAsync = sl_false);
+
+		static sl_bool flush(const Memory& view, sl_bool flagAsync = sl_false);
+
+		// alignment of the offsets of the mappings
+		static sl_uint32 getAllocationGranularity();
+
+	public:
+		static void _unmap(void* address, sl_size size);
+
+	private:
+		sl_bool _open(const String& filePath, const MappedFileMode& mode, sl_uint64 size);
+
+		void _close();
+
+		// `offset` is aligned by the allocation granularity
+		void* _map(sl_uint64 offset, sl_size size);
+
+	private:
+		sl_file m_file;
+		void* m_handleMapping;
+		sl_uint64 m_size;
+		MappedFileMode m_mode;
+
+		Memory m_window;
+		sl_uint64 m_offsetWindow;
+		sl_size m_sizeWindow;
+
+	};
+
 	// FilePathSegments is not thread-safe
 	class SLIB_EXPORT FilePathSegments
 	{
@@ -0,0 +1,236 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_CORE_FLAT_HASH_MAP
+#define CHECKHEADER_SLIB_CORE_FLAT_HASH_MAP
+
+#include "definition.h"
+
+#include "base.h"
+#include "macro.h"
+#include "map_common.h"
+#include "hash.h"
+#include "compare.h"
+#include "null_value.h"
+#include "mutex.h"
+
+namespace slib
+{
+
+	template <class KT, class VT>
+	class FlatHashMapNode
+	{
+	public:
+		KT key;
+		VT value;
+
+	public:
+		template <class KEY, class... VALUE_ARGS>
+		FlatHashMapNode(KEY&& _key, VALUE_ARGS&&... value_args) noexcept;
+
+	};
+
+	template <class KT, class VT>
+	class SLIB_EXPORT FlatHashMapPosition
+	{
+	public:
+		typedef FlatHashMapNode<KT, VT> NODE;
+
+	public:
+		FlatHashMapPosition(const sl_int8* ctrl, const sl_int8* ctrl_end, NODE* node) noexcept;
+
+		FlatHashMapPosition(const FlatHashMapPosition& other) noexcept = default;
+
+	public:
+		FlatHashMapPosition& operator=(const FlatHashMapPosition& other) noexcept = default;
+
+		NODE& operator*() const noexcept;
+
+		sl_bool operator==(const FlatHashMapPosition& other) const noexcept;
+
+		sl_bool operator!=(const FlatHashMapPosition& other) const noexcept;
+
+		FlatHashMapPosition& operator++() noexcept;
+
+	public:
+		const sl_int8* ctrl;
+		const sl_int8* ctrl_end;
+		NODE* node;
+
+	};
+
+	/*
+		Open-addressing hash map with unique keys (Swiss table layout).
+		The entries are stored inline in one slot array, and a control byte per slot
+		keeps 7 bits of the hash, so a lookup compares a whole group of control bytes
+		at once (16 with SSE2, 8 otherwise) and touches the slots only on a match.
+		Unlike `HashTable`, the entries move when the table grows or shrinks, so the
+		node pointers and positions are valid only until the next insertion.
+	*/
+	template < class KT, class VT, class HASH = Hash<KT>, class KEY_EQUALS = Equals<KT> >
+	class SLIB_EXPORT FlatHashMap
+	{
+	public:
+		typedef FlatHashMapNode<KT, VT> NODE;
+
+	public:
+		FlatHashMap(sl_size capacity = 0, const HASH& hash = HASH(), const KEY_EQUALS& key_equals = KEY_EQUALS()) noexcept;
+
+		FlatHashMap(const FlatHashMap& other) = delete;
+
+		FlatHashMap(FlatHashMap&& other) noexcept;
+
+		~FlatHashMap() noexcept;
+
+	public:
+		FlatHashMap& operator=(const FlatHashMap& other) = delete;
+
+		FlatHashMap& operator=(FlatHashMap&& other) noexcept;
+
+	public:
+		sl_size getCount() const noexcept;
+
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		// number of the slots
+		sl_size getCapacity() const noexcept;
+
+		NODE* find(const KT& key) const noexcept;
+
+		VT* getItemPointer(const KT& key) const noexcept;
+
+		sl_bool get(const KT& key, VT* outValue = sl_null) const noexcept;
+
+		VT getValue(const KT& key) const noexcept;
+
+		VT getValue(const KT& key, const VT& def) const noexcept;
+
+		template <class KEY, class VALUE>
+		NODE* put(KEY&& key, VALUE&& value, sl_bool* isInsertion = sl_null) noexcept;
+
+		template <class KEY, class VALUE>
+		NODE* replace(const KEY& key, VALUE&& value) noexcept;
+
+		template <class KEY, class... VALUE_ARGS>
+		MapEmplaceReturn<NODE> emplace(KEY&& key, VALUE_ARGS&&... value_args) noexcept;
+
+		sl_bool removeAt(const NODE* node) noexcept;
+
+		sl_bool remove(const KT& key, VT* outValue = sl_null) noexcept;
+
+		sl_size removeAll() noexcept;
+
+		// prepares the slots to hold `count` entries without rehashing
+		sl_bool reserve(sl_size count) noexcept;
+
+		void shrink() noexcept;
+
+		sl_bool copyFrom(const FlatHashMap& other) noexcept;
+
+		// range-based for loop
+		FlatHashMapPosition<KT, VT> begin() const noexcept;
+
+		FlatHashMapPosition<KT, VT> end() const noexcept;
+
+	protected:
+		sl_size _findIndex(const KT& key, sl_size hash) const noexcept;
+
+		sl_size _prepareInsert(sl_size hash) noexcept;
+
+		sl_bool _rehash(sl_size capacity) noexcept;
+
+		void _setCtrl(sl_size index, sl_int8 h) noexcept;
+
+		void _free() noexcept;
+
+	protected:
+		NODE* m_slots;
+		sl_int8* m_ctrl;
+		sl_size m_capacity;
+		sl_size m_count;
+		sl_size m_growthLeft;
+		HASH m_hash;
+		KEY_EQUALS m_equals;
+
+	};
+
+	/*
+		FlatHashMap whose readers never take a lock.
+		The readers look up an immutable table, and every writer (serialized by a mutex)
+		builds a new copy, publishes it, and frees the old one after the readers which
+		may still see it have left. The writes are O(n), so this fits the read-mostly
+		tables (routes, configurations) which are replaced rarely.
+	*/
+	template < class KT, class VT, class HASH = Hash<KT>, class KEY_EQUALS = Equals<KT> >
+	class SLIB_EXPORT ConcurrentFlatHashMap
+	{
+	public:
+		typedef FlatHashMap<KT, VT, HASH, KEY_EQUALS> MAP;
+
+	public:
+		ConcurrentFlatHashMap() noexcept;
+
+		~ConcurrentFlatHashMap() noexcept;
+
+		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(ConcurrentFlatHashMap)
+
+	public:
+		sl_size getCount() const noexcept;
+
+		sl_bool get(const KT& key, VT* outValue = sl_null) const noexcept;
+
+		VT getValue(const KT& key) const noexcept;
+
+		VT getValue(const KT& key, const VT& def) const noexcept;
+
+		template <class KEY, class VALUE>
+		sl_bool put(KEY&& key, VALUE&& value) noexcept;
+
+		sl_bool remove(const KT& key) noexcept;
+
+		void removeAll() noexcept;
+
+		// replaces the whole content at once
+		void setAll(MAP&& map) noexcept;
+
+	protected:
+		MAP* _lockRead(sl_int32& epoch) const noexcept;
+
+		void _unlockRead(sl_int32 epoch) const noexcept;
+
+		void _publish(MAP* map) noexcept;
+
+	protected:
+		MAP* m_map;
+		sl_int32 m_epoch;
+		mutable sl_int32 m_readers[2];
+		Mutex m_lockWrite;
+
+	};
+
+}
+
+#include "detail/flat_hash_map.inc"
+
+#endif
@@ -45,6 +45,12 @@ namespace slib
 	template <class T>
 	class FunctionList;
 
+	template <class T>
+	class InlineFunction;
+
+	template <class RET_TYPE, class... ARGS>
+	class _priv_InlineFunctionOps;
+
 	class CallableBase : public Referable
 	{
 	public:
@@ -196,6 +202,92 @@ namespace slib
 		
 	};
 	
+	/*
+		Move-only variant of `Function` for the callbacks having a single owner (task queues, per-request callbacks).
+		The functors fitting in `InlineSize` bytes are stored inside the object, so that constructing from a lambda
+		or from `fromClass()`, `fromRef()`, `fromWeakRef()` doesn't allocate. Larger functors are allocated as a shared
+		`Callable`, and a `Function` is held by its reference (without allocation).
+	*/
+	template <class RET_TYPE, class... ARGS>
+	class SLIB_EXPORT InlineFunction<RET_TYPE(ARGS...)>
+	{
+	public:
+		static constexpr sl_size InlineSize = sizeof(void*) * 4;
+
+	public:
+		InlineFunction() noexcept;
+
+		InlineFunction(sl_null_t) noexcept;
+
+		InlineFunction(InlineFunction&& other) noexcept;
+
+		InlineFunction(const InlineFunction& other) = delete;
+
+		InlineFunction(const Function<RET_TYPE(ARGS...)>& func) noexcept;
+
+		InlineFunction(Function<RET_TYPE(ARGS...)>&& func) noexcept;
+
+		template <class FUNC>
+		InlineFunction(const FUNC& func) noexcept;
+
+		~InlineFunction() noexcept;
+
+	public:
+		InlineFunction& operator=(InlineFunction&& other) noexcept;
+
+		InlineFunction& operator=(const InlineFunction& other) = delete;
+
+		InlineFunction& operator=(sl_null_t) noexcept;
+
+		InlineFunction& operator=(const Function<RET_TYPE(ARGS...)>& func) noexcept;
+
+		InlineFunction& operator=(Function<RET_TYPE(ARGS...)>&& func) noexcept;
+
+		template <class FUNC>
+		InlineFunction& operator=(const FUNC& func) noexcept;
+
+		RET_TYPE operator()(ARGS... args) const;
+
+	public:
+		sl_bool isNull() const noexcept;
+
+		sl_bool isNotNull() const noexcept;
+
+		void setNull() noexcept;
+
+		// moves the callable into a shared `Function` (allocates only for the inline functors), and this object becomes null
+		Function<RET_TYPE(ARGS...)> moveToFunction() noexcept;
+
+	public:
+		template <class CLASS, class FUNC>
+		static InlineFunction fromClass(CLASS* object, FUNC func) noexcept;
+
+		template <class CLASS, class FUNC>
+		static InlineFunction fromRef(const Ref<CLASS>& object, FUNC func) noexcept;
+
+		template <class CLASS, class FUNC>
+		static InlineFunction fromWeakRef(const WeakRef<CLASS>& object, FUNC func) noexcept;
+
+	private:
+		template <class FUNC>
+		void _init(const FUNC& func) noexcept;
+
+		void _initRef(const Ref< Callable<RET_TYPE(ARGS...)> >& callable) noexcept;
+
+		void _initRef(Ref< Callable<RET_TYPE(ARGS...)> >&& callable) noexcept;
+
+		void _moveFrom(InlineFunction& other) noexcept;
+
+		void _free() noexcept;
+
+	private:
+		const _priv_InlineFunctionOps<RET_TYPE, ARGS...>* m_ops;
+		union {
+			sl_uint8 m_storage[InlineSize];
+			void* m_alignPointer;
+		};
+
+	};
 	
 }
 
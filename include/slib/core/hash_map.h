@@ -185,6 +185,35 @@ namespace slib
 		
 		VT getValue(const KT& key, const VT& def) const noexcept;
 		
+		/*
+			The lookups by `KEY` which is another type of the key (for example, `StringView` for `String` keys).
+			`HASH` and `KEY_COMPARE` should accept `KEY`, and give the same hash code and order as the equal `KT`.
+		*/
+		template <class KEY>
+		NODE* findByKey_NoLock(const KEY& key) const noexcept;
+		
+		/* unsynchronized function */
+		template <class KEY>
+		VT* getItemPointerByKey(const KEY& key) const noexcept;
+		
+		template <class KEY>
+		sl_bool getByKey_NoLock(const KEY& key, VT* _out = sl_null) const noexcept;
+		
+		template <class KEY>
+		sl_bool getByKey(const KEY& key, VT* _out = sl_null) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey_NoLock(const KEY& key) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey(const KEY& key) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey_NoLock(const KEY& key, const VT& def) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey(const KEY& key, const VT& def) const noexcept;
+		
 		List<VT> getValues_NoLock(const KT& key) const noexcept;
 		
 		List<VT> getValues(const KT& key) const noexcept;
@@ -314,6 +343,9 @@ namespace slib
 		
 		NODE* _getEntry(const KT& key) const noexcept;
 		
+		template <class KEY>
+		NODE* _getEntryByKey(const KEY& key) const noexcept;
+		
 		NODE** _getEntryPtr(const KT& key) noexcept;
 		
         void _linkNode(NODE* node, sl_size hash) noexcept;
@@ -445,6 +477,35 @@ namespace slib
 		
 		VT getValue(const KT& key, const VT& def) const noexcept;
 		
+		/*
+			The lookups by `KEY` which is another type of the key (for example, `StringView` for `String` keys).
+			`HASH` and `KEY_COMPARE` should accept `KEY`, and give the same hash code and order as the equal `KT`.
+		*/
+		template <class KEY>
+		NODE* findByKey_NoLock(const KEY& key) const noexcept;
+		
+		/* unsynchronized function */
+		template <class KEY>
+		VT* getItemPointerByKey(const KEY& key) const noexcept;
+		
+		template <class KEY>
+		sl_bool getByKey_NoLock(const KEY& key, VT* _out = sl_null) const noexcept;
+		
+		template <class KEY>
+		sl_bool getByKey(const KEY& key, VT* _out = sl_null) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey_NoLock(const KEY& key) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey(const KEY& key) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey_NoLock(const KEY& key, const VT& def) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey(const KEY& key, const VT& def) const noexcept;
+		
 		List<VT> getValues_NoLock(const KT& key) const noexcept;
 		
 		List<VT> getValues(const KT& key) const noexcept;
@@ -648,6 +709,16 @@ namespace slib
 		
 		VT getValue(const KT& key, const VT& def) const noexcept;
 		
+		// see `HashMap::getValueByKey()`
+		template <class KEY>
+		sl_bool getByKey(const KEY& key, VT* _out = sl_null) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey(const KEY& key) const noexcept;
+		
+		template <class KEY>
+		VT getValueByKey(const KEY& key, const VT& def) const noexcept;
+		
 		List<VT> getValues(const KT& key) const noexcept;
 		
 		template < class VALUE, class VALUE_EQUALS = Equals<VT, VALUE> >
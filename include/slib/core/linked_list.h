@@ -137,7 +137,11 @@ namespace slib
 
 		Link<T>* pushBack_NoLock(const T& value, sl_size countLimit = 0) noexcept;
 
+		Link<T>* pushBack_NoLock(T&& value, sl_size countLimit = 0) noexcept;
+
 		sl_bool pushBack(const T& value, sl_size countLimit = 0) noexcept;
+
+		sl_bool pushBack(T&& value, sl_size countLimit = 0) noexcept;
 		
 		template <class VALUE>
 		sl_bool pushBackAll_NoLock(const CLinkedList<VALUE>* other) noexcept;
@@ -213,6 +217,8 @@ namespace slib
 	protected:
 		static Link<T>* _createItem(const T& value) noexcept;
 
+		static Link<T>* _createItem(T&& value) noexcept;
+
 		static void _freeItem(Link<T>* item) noexcept;
 
 		Link<T>* _pushBackItem(Link<T>* item, sl_size countLimit) noexcept;
@@ -0,0 +1,207 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_CORE_MEMORY_ALLOCATOR
+#define CHECKHEADER_SLIB_CORE_MEMORY_ALLOCATOR
+
+#include "definition.h"
+
+#include "macro.h"
+#include "spin_lock.h"
+
+// size and alignment of the chunks owned by the allocators
+#define SLIB_MEMORY_CHUNK_SIZE_BITS 20
+#define SLIB_MEMORY_CHUNK_SIZE (1 << SLIB_MEMORY_CHUNK_SIZE_BITS)
+
+#define SLIB_MEMORY_TAGS_MAX 64
+
+namespace slib
+{
+
+	/*
+		Allocator behind `Base::createMemory/reallocMemory/freeMemory`.
+		The allocators serve the memory from the chunks reserved by `allocateChunk()`,
+		so `Base::freeMemory` can return any pointer to its owner regardless of the
+		allocator which is current when it is freed. The pointers outside of the
+		chunks belong to the system allocator (malloc).
+	*/
+	class SLIB_EXPORT MemoryAllocator
+	{
+	public:
+		MemoryAllocator() noexcept;
+
+		virtual ~MemoryAllocator() noexcept;
+
+		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(MemoryAllocator)
+
+	public:
+		virtual void* allocate(sl_size size) noexcept = 0;
+
+		// `ptr` is owned by this allocator
+		virtual void* reallocate(void* ptr, sl_size sizeNew) noexcept = 0;
+
+		// `ptr` is owned by this allocator
+		virtual void free(void* ptr) noexcept = 0;
+
+	public:
+		// null: system allocator
+		static MemoryAllocator* getDefault() noexcept;
+
+		// affects the following allocations of the threads without `MemoryAllocatorScope`
+		static void setDefault(MemoryAllocator* allocator) noexcept;
+
+		// allocator used by `Base::createMemory` on the current thread (null: system allocator)
+		static MemoryAllocator* getCurrent() noexcept;
+
+		// built-in thread-caching size-class allocator
+		static MemoryAllocator* getPool() noexcept;
+
+		// returns the allocator owning `ptr` (null: system allocator)
+		static MemoryAllocator* getOwner(const void* ptr, sl_uint32* outChunkParam = sl_null) noexcept;
+
+	protected:
+		// `size` is rounded up to the multiple of `SLIB_MEMORY_CHUNK_SIZE`, `param` is returned by `getOwner()`
+		void* allocateChunk(sl_size size, sl_uint32 param = 0) noexcept;
+
+		void freeChunk(void* chunk, sl_size size) noexcept;
+
+	};
+
+	/*
+		Bump allocator freeing all of its memory at once.
+		`free()` does nothing, and `reset()` or the destructor releases the chunks,
+		so every block allocated while the arena is current must be released (or
+		never touched again) before that. The blocks grow geometrically on
+		reallocation, and the abandoned ones are kept until the reset.
+	*/
+	class SLIB_EXPORT MemoryArena : public MemoryAllocator
+	{
+	public:
+		MemoryArena(sl_size chunkSize = SLIB_MEMORY_CHUNK_SIZE) noexcept;
+
+		~MemoryArena() noexcept;
+
+	public:
+		void* allocate(sl_size size) noexcept override;
+
+		void* reallocate(void* ptr, sl_size sizeNew) noexcept override;
+
+		void free(void* ptr) noexcept override;
+
+	public:
+		void reset() noexcept;
+
+		// allocated bytes since the last reset
+		sl_size getUsedSize() noexcept;
+
+		sl_size getReservedSize() noexcept;
+
+	protected:
+		struct Chunk
+		{
+			Chunk* next;
+			sl_size size;
+		};
+
+		SpinLock m_lock;
+		sl_size m_chunkSize;
+		Chunk* m_chunks;
+		sl_uint8* m_current;
+		sl_uint8* m_end;
+		sl_size m_sizeUsed;
+		sl_size m_sizeReserved;
+
+	};
+
+	/*
+		Accounts the allocations by call site, while a `MemoryTagScope` is active.
+		Declare the tags as static objects:
+			static MemoryTag tag("json");
+	*/
+	class SLIB_EXPORT MemoryTag
+	{
+	public:
+		MemoryTag(const char* name) noexcept;
+
+		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(MemoryTag)
+
+	public:
+		const char* getName() const noexcept;
+
+		sl_uint64 getAllocationsCount() const noexcept;
+
+		// requested bytes by the allocations
+		sl_uint64 getAllocatedSize() const noexcept;
+
+		sl_uint64 getReallocationsCount() const noexcept;
+
+		void resetStatistics() noexcept;
+
+	public:
+		static sl_uint32 getTagsCount() noexcept;
+
+		static MemoryTag* getTag(sl_uint32 index) noexcept;
+
+	public:
+		void _addAllocation(sl_size size) noexcept;
+
+		void _addReallocation() noexcept;
+
+	protected:
+		const char* m_name;
+		sl_int64 m_countAllocations;
+		sl_int64 m_sizeAllocated;
+		sl_int64 m_countReallocations;
+
+	};
+
+	class SLIB_EXPORT MemoryAllocatorScope
+	{
+	public:
+		MemoryAllocatorScope(MemoryAllocator* allocator) noexcept;
+
+		~MemoryAllocatorScope() noexcept;
+
+		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(MemoryAllocatorScope)
+
+	private:
+		MemoryAllocator* m_allocatorPrevious;
+
+	};
+
+	class SLIB_EXPORT MemoryTagScope
+	{
+	public:
+		MemoryTagScope(MemoryTag& tag) noexcept;
+
+		~MemoryTagScope() noexcept;
+
+		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(MemoryTagScope)
+
+	private:
+		MemoryTag* m_tagPrevious;
+
+	};
+
+}
+
+#endif
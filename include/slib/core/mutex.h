@@ -56,6 +56,13 @@ namespace slib
 		Mutex& operator=(Mutex&& other) noexcept;
 		
 	private:
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		// recursive futex lock stored inline: no allocation, same size as before
+		mutable sl_int32 m_state; // 0: unlocked, 1: locked, 2: locked with waiters
+		mutable sl_uint32 m_owner; // thread id of the owner
+		mutable sl_uint32 m_count; // recursion count
+		SpinLock m_lock;
+#else
 		mutable void* m_object;
 		SpinLock m_lock;
 
@@ -63,6 +70,7 @@ namespace slib
 		void* _initObject() const noexcept;
 		
 		void* _getObject() const noexcept;
+#endif
 
 	};
 	
@@ -0,0 +1,161 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_CORE_PARALLEL
+#define CHECKHEADER_SLIB_CORE_PARALLEL
+
+#include "definition.h"
+
+#include "function.h"
+#include "sort.h"
+#include "list.h"
+#include "array.h"
+#include "new_helper.h"
+
+namespace slib
+{
+
+	class ThreadPool;
+
+	/*
+		Data-parallel algorithms running on a shared ThreadPool (one worker per processor).
+		The calling thread always takes part in the work and the calls return after all
+		of the work is done, so they can be nested or called from the pool's tasks.
+		When the concurrency is 1, everything runs on the calling thread.
+	*/
+	class SLIB_EXPORT Parallel
+	{
+	public:
+		static sl_uint32 getConcurrency() noexcept;
+
+		// 0: count of the processors
+		static void setConcurrency(sl_uint32 n) noexcept;
+
+		static Ref<ThreadPool> getThreadPool() noexcept;
+
+		// invokes `task(index)` for every index in [0, nTasks)
+		static void run(sl_size nTasks, const Function<void(sl_size index)>& task) noexcept;
+
+	public:
+		// `func(sl_size from, sl_size to)` is called for the ranges of at least `grainSize` items (0: automatic)
+		template <class FUNC>
+		static void forRange(sl_size begin, sl_size end, const FUNC& func, sl_size grainSize = 0) noexcept;
+
+		// `func(sl_size index)` is called for every index in [begin, end)
+		template <class FUNC>
+		static void forEach(sl_size begin, sl_size end, const FUNC& func, sl_size grainSize = 0) noexcept;
+
+		// `rangeFunc(sl_size from, sl_size to)` returns T, and the results are combined in the order of the ranges by `reduceFunc(const T& a, const T& b)`
+		template <class T, class RANGE_FUNC, class REDUCE_FUNC>
+		static T reduce(sl_size begin, sl_size end, const T& identity, const RANGE_FUNC& rangeFunc, const REDUCE_FUNC& reduceFunc, sl_size grainSize = 0) noexcept;
+
+		template <class T>
+		static T sum(const T* data, sl_size count) noexcept;
+
+		// dst[i] = src[0] op ... op src[i]. `src` and `dst` may be same
+		template <class T, class OP>
+		static void inclusiveScan(const T* src, T* dst, sl_size count, const OP& op) noexcept;
+
+		template <class T>
+		static void inclusiveScan(const T* src, T* dst, sl_size count) noexcept;
+
+		// dst[i] = init op src[0] op ... op src[i-1]. `src` and `dst` may be same
+		template <class T, class OP>
+		static void exclusiveScan(const T* src, T* dst, sl_size count, const T& init, const OP& op) noexcept;
+
+		template <class T>
+		static void exclusiveScan(const T* src, T* dst, sl_size count, const T& init) noexcept;
+
+	public:
+		// sorts the runs on the threads, and merges them in parallel
+		template < class TYPE, class COMPARE = Compare<TYPE> >
+		static void sortAsc(TYPE* data, sl_size count, const COMPARE& compare = COMPARE()) noexcept;
+
+		template < class TYPE, class COMPARE = Compare<TYPE> >
+		static void sortDesc(TYPE* data, sl_size count, const COMPARE& compare = COMPARE()) noexcept;
+
+		template < class T, class COMPARE = Compare<T> >
+		static void sortAsc(const List<T>& list, const COMPARE& compare = COMPARE()) noexcept;
+
+		template < class T, class COMPARE = Compare<T> >
+		static void sortDesc(const List<T>& list, const COMPARE& compare = COMPARE()) noexcept;
+
+		template < class T, class COMPARE = Compare<T> >
+		static void sortAsc(const Array<T>& arr, const COMPARE& compare = COMPARE()) noexcept;
+
+		template < class T, class COMPARE = Compare<T> >
+		static void sortDesc(const Array<T>& arr, const COMPARE& compare = COMPARE()) noexcept;
+
+		// LSD radix sort (stable) of integer or floating-point values
+		template <class TYPE>
+		static void radixSortAsc(TYPE* data, sl_size count) noexcept;
+
+		template <class TYPE>
+		static void radixSortDesc(TYPE* data, sl_size count) noexcept;
+
+		// sorts the items by `getKey(const TYPE&)`, which returns an integer or floating-point key
+		template <class TYPE, class GET_KEY>
+		static void radixSortAsc(TYPE* data, sl_size count, const GET_KEY& getKey) noexcept;
+
+		template <class TYPE, class GET_KEY>
+		static void radixSortDesc(TYPE* data, sl_size count, const GET_KEY& getKey) noexcept;
+
+		template <class T>
+		static void radixSortAsc(const List<T>& list) noexcept;
+
+		template <class T>
+		static void radixSortDesc(const List<T>& list) noexcept;
+
+		template <class T, class GET_KEY>
+		static void radixSortAsc(const List<T>& list, const GET_KEY& getKey) noexcept;
+
+		template <class T, class GET_KEY>
+		static void radixSortDesc(const List<T>& list, const GET_KEY& getKey) noexcept;
+
+		template <class T>
+		static void radixSortAsc(const Array<T>& arr) noexcept;
+
+		template <class T>
+		static void radixSortDesc(const Array<T>& arr) noexcept;
+
+		template <class T, class GET_KEY>
+		static void radixSortAsc(const Array<T>& arr, const GET_KEY& getKey) noexcept;
+
+		template <class T, class GET_KEY>
+		static void radixSortDesc(const Array<T>& arr, const GET_KEY& getKey) noexcept;
+
+	private:
+		static sl_size _getGrainSize(sl_size count, sl_size grainSize) noexcept;
+
+		template <class TYPE, class COMPARE>
+		static void _mergeSort(TYPE* data, sl_size count, const COMPARE& compare) noexcept;
+
+		template <class TYPE, class GET_KEY>
+		static void _radixSort(TYPE* data, sl_size count, const GET_KEY& getKey, sl_bool flagDesc) noexcept;
+
+	};
+
+}
+
+#include "detail/parallel.inc"
+
+#endif
@@ -36,8 +36,12 @@ namespace slib
 	public:
 		sl_bool push_NoLock(const T& value, sl_size countLimit = 0) noexcept;
 
+		sl_bool push_NoLock(T&& value, sl_size countLimit = 0) noexcept;
+
 		sl_bool push(const T& value, sl_size countLimit = 0) noexcept;
 
+		sl_bool push(T&& value, sl_size countLimit = 0) noexcept;
+
 		sl_bool pushAll(const Queue<T, CONTAINER>* other) noexcept;
 
 		sl_bool pop_NoLock(T* _out = sl_null) noexcept;
@@ -97,4 +97,6 @@ namespace slib
 #include "detail/string8.inc"
 #include "detail/string16.inc"
 
+#include "string_view.h"
+
 #endif
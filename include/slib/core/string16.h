@@ -46,6 +46,8 @@ namespace slib
 	typedef Atomic<String> AtomicString;
 	class String16;
 	typedef Atomic<String16> AtomicString16;
+	class StringView;
+	class StringView16;
 	class StringData;
 	class Variant;
 	class Locale;
@@ -136,6 +138,11 @@ namespace slib
 		String16(const std::u16string& str) noexcept;
 		String16(std::u16string&& str) noexcept;
 #endif
+
+		/**
+		 * Copies the characters of the view.
+		 */
+		String16(const StringView16& str) noexcept;
 		
 	public:
 		
@@ -420,6 +427,7 @@ namespace slib
 		sl_bool equals(const sl_char8* other) const noexcept;
 		sl_bool equals(const sl_char16* other) const noexcept;
 		sl_bool equals(const sl_char32* other) const noexcept;
+		sl_bool equals(const StringView16& other) const noexcept;
 #ifdef SLIB_SUPPORT_STD_TYPES
 		sl_bool equals(const std::u16string& other) const noexcept;
 #endif
@@ -439,6 +447,7 @@ namespace slib
 		sl_int32 compare(const sl_char8* other) const noexcept;
 		sl_int32 compare(const sl_char16* other) const noexcept;
 		sl_int32 compare(const sl_char32* other) const noexcept;
+		sl_int32 compare(const StringView16& other) const noexcept;
 #ifdef SLIB_SUPPORT_STD_TYPES
 		sl_int32 compare(const std::u16string& other) const noexcept;
 #endif
@@ -677,6 +686,7 @@ namespace slib
 		 */
 		sl_reg indexOf(const String16& str, sl_reg start = 0) const noexcept;
 		sl_reg indexOf(const sl_char16* str, sl_reg start = 0) const noexcept;
+		sl_reg indexOf(const StringView16& str, sl_reg start = 0) const noexcept;
 		
 		/**
 		 * @return the index within this string of the last occurrence of the specified character, searching backwards from `start` index.
@@ -690,6 +700,7 @@ namespace slib
 		 */
 		sl_reg lastIndexOf(const String16& str, sl_reg start = -1) const noexcept;
 		sl_reg lastIndexOf(const sl_char16* str, sl_reg start = -1) const noexcept;
+		sl_reg lastIndexOf(const StringView16& str, sl_reg start = -1) const noexcept;
 		
 		/**
 		 * @return `true` if this string starts with the specified character.
@@ -701,6 +712,7 @@ namespace slib
 		 */
 		sl_bool startsWith(const String16& str) const noexcept;
 		sl_bool startsWith(const sl_char16* str) const noexcept;
+		sl_bool startsWith(const StringView16& str) const noexcept;
 		
 		/**
 		 * @return `true` if this string ends with the specified character.
@@ -712,6 +724,7 @@ namespace slib
 		 */
 		sl_bool endsWith(const String16& str) const noexcept;
 		sl_bool endsWith(const sl_char16* str) const noexcept;
+		sl_bool endsWith(const StringView16& str) const noexcept;
 		
 		/**
 		 * @return `true` if the specified character occurs within this string.
@@ -723,6 +736,7 @@ namespace slib
 		 */
 		sl_bool contains(const String16& str) const noexcept;
 		sl_bool contains(const sl_char16* str) const noexcept;
+		sl_bool contains(const StringView16& str) const noexcept;
 		
 		/**
 		 * Converts the characters of this string to uppercase.
@@ -782,6 +796,7 @@ namespace slib
 		 */
 		List<String16> split(const String16& pattern) const noexcept;
 		List<String16> split(const sl_char16* pattern) const noexcept;
+		List<String16> split(const StringView16& pattern) const noexcept;
 		
 	public:
 		/**
@@ -2018,6 +2033,8 @@ namespace slib
 	{
 	public:
 		int operator()(const String16& a, const String16& b) const noexcept;
+		int operator()(const String16& a, const StringView16& b) const noexcept;
+		int operator()(const String16& a, const sl_char16* b) const noexcept;
 	};
 	
 	template <>
@@ -2032,6 +2049,8 @@ namespace slib
 	{
 	public:
 		sl_bool operator()(const String16& a, const String16& b) const noexcept;
+		sl_bool operator()(const String16& a, const StringView16& b) const noexcept;
+		sl_bool operator()(const String16& a, const sl_char16* b) const noexcept;
 	};
 	
 	template <>
@@ -2046,6 +2065,8 @@ namespace slib
 	{
 	public:
 		sl_size operator()(const String16& a) const noexcept;
+		sl_size operator()(const StringView16& a) const noexcept;
+		sl_size operator()(const sl_char16* a) const noexcept;
 	};
 	
 	template <>
@@ -2059,18 +2080,24 @@ namespace slib
 	{
 	public:
 		int operator()(const String16& a, const String16& b) const noexcept;
+		int operator()(const String16& a, const StringView16& b) const noexcept;
+		int operator()(const String16& a, const sl_char16* b) const noexcept;
 	};
 	
 	class EqualsIgnoreCaseString16
 	{
 	public:
 		sl_bool operator()(const String16& a, const String16& b) const noexcept;
+		sl_bool operator()(const String16& a, const StringView16& b) const noexcept;
+		sl_bool operator()(const String16& a, const sl_char16* b) const noexcept;
 	};
 	
 	class HashIgnoreCaseString16
 	{
 	public:
 		sl_size operator()(const String16& v) const noexcept;
+		sl_size operator()(const StringView16& v) const noexcept;
+		sl_size operator()(const sl_char16* v) const noexcept;
 		
 	};
 
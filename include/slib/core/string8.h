@@ -46,6 +46,8 @@ namespace slib
 	typedef Atomic<String> AtomicString;
 	class String16;
 	typedef Atomic<String16> AtomicString16;
+	class StringView;
+	class StringView16;
 	class StringData;
 	class Variant;
 	class Locale;
@@ -134,6 +136,11 @@ namespace slib
 		String(const std::string& str) noexcept;
 		String(std::string&& str) noexcept;
 #endif
+
+		/**
+		 * Copies the characters of the view.
+		 */
+		String(const StringView& str) noexcept;
 		
 	public:
 		
@@ -418,6 +425,7 @@ namespace slib
 		sl_bool equals(const sl_char8* other) const noexcept;
 		sl_bool equals(const sl_char16* other) const noexcept;
 		sl_bool equals(const sl_char32* other) const noexcept;
+		sl_bool equals(const StringView& other) const noexcept;
 #ifdef SLIB_SUPPORT_STD_TYPES
 		sl_bool equals(const std::string& other) const noexcept;
 #endif
@@ -437,6 +445,7 @@ namespace slib
 		sl_int32 compare(const sl_char8* other) const noexcept;
 		sl_int32 compare(const sl_char16* other) const noexcept;
 		sl_int32 compare(const sl_char32* other) const noexcept;
+		sl_int32 compare(const StringView& other) const noexcept;
 #ifdef SLIB_SUPPORT_STD_TYPES
 		sl_int32 compare(const std::string& other) const noexcept;
 #endif
@@ -690,6 +699,7 @@ namespace slib
 		 */
 		sl_reg indexOf(const String& str, sl_reg start = 0) const noexcept;
 		sl_reg indexOf(const sl_char8* str, sl_reg start = 0) const noexcept;
+		sl_reg indexOf(const StringView& str, sl_reg start = 0) const noexcept;
 		
 		/**
 		 * @return the index within this string of the last occurrence of the specified character, searching backwards from `start` index.
@@ -703,6 +713,7 @@ namespace slib
 		 */
 		sl_reg lastIndexOf(const String& str, sl_reg start = -1) const noexcept;
 		sl_reg lastIndexOf(const sl_char8* str, sl_reg start = -1) const noexcept;
+		sl_reg lastIndexOf(const StringView& str, sl_reg start = -1) const noexcept;
 		
 		/**
 		 * @return `true` if this string starts with the specified character.
@@ -714,6 +725,7 @@ namespace slib
 		 */
 		sl_bool startsWith(const String& str) const noexcept;
 		sl_bool startsWith(const sl_char8* str) const noexcept;
+		sl_bool startsWith(const StringView& str) const noexcept;
 		
 		/**
 		 * @return `true` if this string ends with the specified character.
@@ -725,6 +737,7 @@ namespace slib
 		 */
 		sl_bool endsWith(const String& str) const noexcept;
 		sl_bool endsWith(const sl_char8* str) const noexcept;
+		sl_bool endsWith(const StringView& str) const noexcept;
 		
 		/**
 		 * @return `true` if the specified character occurs within this string.
@@ -736,6 +749,7 @@ namespace slib
 		 */
 		sl_bool contains(const String& str) const noexcept;
 		sl_bool contains(const sl_char8* str) const noexcept;
+		sl_bool contains(const StringView& str) const noexcept;
 		
 		/**
 		 * Converts the characters of this string to uppercase.
@@ -795,6 +809,7 @@ namespace slib
 		 */
 		List<String> split(const String& pattern) const noexcept;
 		List<String> split(const sl_char8* pattern) const noexcept;
+		List<String> split(const StringView& pattern) const noexcept;
 		
 	public:
 		/**
@@ -2046,6 +2061,8 @@ namespace slib
 	{
 	public:
 		int operator()(const String& a, const String& b) const noexcept;
+		int operator()(const String& a, const StringView& b) const noexcept;
+		int operator()(const String& a, const sl_char8* b) const noexcept;
 	};
 	
 	template <>
@@ -2060,6 +2077,8 @@ namespace slib
 	{
 	public:
 		sl_bool operator()(const String& a, const String& b) const noexcept;
+		sl_bool operator()(const String& a, const StringView& b) const noexcept;
+		sl_bool operator()(const String& a, const sl_char8* b) const noexcept;
 	};
 	
 	template <>
@@ -2074,6 +2093,8 @@ namespace slib
 	{
 	public:
 		sl_size operator()(const String& a) const noexcept;
+		sl_size operator()(const StringView& a) const noexcept;
+		sl_size operator()(const sl_char8* a) const noexcept;
 	};
 	
 	template <>
@@ -2087,18 +2108,24 @@ namespace slib
 	{
 	public:
 		int operator()(const String& a, const String& b) const noexcept;
+		int operator()(const String& a, const StringView& b) const noexcept;
+		int operator()(const String& a, const sl_char8* b) const noexcept;
 	};
 	
 	class EqualsIgnoreCaseString
 	{
 	public:
 		sl_bool operator()(const String& a, const String& b) const noexcept;
+		sl_bool operator()(const String& a, const StringView& b) const noexcept;
+		sl_bool operator()(const String& a, const sl_char8* b) const noexcept;
 	};
 	
 	class HashIgnoreCaseString
 	{
 	public:
 		sl_size operator()(const String& v) const noexcept;
+		sl_size operator()(const StringView& v) const noexcept;
+		sl_size operator()(const sl_char8* v) const noexcept;
 		
 	};
 
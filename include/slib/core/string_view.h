@@ -0,0 +1,326 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_CORE_STRING_VIEW
+#define CHECKHEADER_SLIB_CORE_STRING_VIEW
+
+#include "definition.h"
+
+#include "string.h"
+
+namespace slib
+{
+
+	/*
+		Non-owning view of a sequence of characters (pointer and length).
+		It doesn't hold any reference to the storage, so the viewed string or
+		buffer must outlive the view, and the content is not null-terminated
+		in general. The slicing and searching functions return views and indices,
+		and never allocate. The hash code is same as the one of `String` having
+		the same content, so a view can look up the `String` keys of `HashMap`
+		(see `HashMap::getValueByKey()`).
+	*/
+	class SLIB_EXPORT StringView
+	{
+	public:
+		SLIB_INLINE constexpr StringView() noexcept : m_data(sl_null), m_length(0) {}
+
+		SLIB_INLINE constexpr StringView(sl_null_t) noexcept : m_data(sl_null), m_length(0) {}
+
+		SLIB_INLINE constexpr StringView(const sl_char8* data, sl_size length) noexcept : m_data(data), m_length(length) {}
+
+		StringView(const sl_char8* sz) noexcept;
+
+		StringView(const String& str) noexcept;
+
+	public:
+		const sl_char8* getData() const noexcept;
+
+		sl_size getLength() const noexcept;
+
+		sl_bool isNull() const noexcept;
+
+		sl_bool isNotNull() const noexcept;
+
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		sl_char8 getAt(sl_reg index) const noexcept;
+
+		sl_char8 operator[](sl_size index) const noexcept;
+
+		// copies the characters into a new string
+		String toString() const noexcept;
+
+		sl_size getHashCode() const noexcept;
+
+		sl_size getHashCodeIgnoreCase() const noexcept;
+
+	public:
+		sl_bool equals(const StringView& other) const noexcept;
+
+		sl_bool equalsIgnoreCase(const StringView& other) const noexcept;
+
+		sl_int32 compare(const StringView& other) const noexcept;
+
+		sl_int32 compareIgnoreCase(const StringView& other) const noexcept;
+
+		sl_bool operator==(const StringView& other) const noexcept;
+
+		sl_bool operator!=(const StringView& other) const noexcept;
+
+	public:
+		StringView substring(sl_reg start, sl_reg end = -1) const noexcept;
+
+		sl_reg indexOf(sl_char8 ch, sl_reg start = 0) const noexcept;
+
+		sl_reg indexOf(const StringView& str, sl_reg start = 0) const noexcept;
+
+		sl_reg lastIndexOf(sl_char8 ch, sl_reg start = -1) const noexcept;
+
+		sl_reg lastIndexOf(const StringView& str, sl_reg start = -1) const noexcept;
+
+		sl_bool startsWith(sl_char8 ch) const noexcept;
+
+		sl_bool startsWith(const StringView& str) const noexcept;
+
+		sl_bool endsWith(sl_char8 ch) const noexcept;
+
+		sl_bool endsWith(const StringView& str) const noexcept;
+
+		sl_bool contains(sl_char8 ch) const noexcept;
+
+		sl_bool contains(const StringView& str) const noexcept;
+
+		StringView trim() const noexcept;
+
+		StringView trimLeft() const noexcept;
+
+		StringView trimRight() const noexcept;
+
+		// the items are views into this view
+		List<StringView> split(const StringView& pattern) const noexcept;
+
+	public:
+		sl_bool parseInt32(sl_int32 radix, sl_int32* value) const noexcept;
+
+		sl_int32 parseInt32(sl_int32 radix = 10, sl_int32 def = 0) const noexcept;
+
+		sl_bool parseUint32(sl_int32 radix, sl_uint32* value) const noexcept;
+
+		sl_uint32 parseUint32(sl_int32 radix = 10, sl_uint32 def = 0) const noexcept;
+
+		sl_bool parseInt64(sl_int32 radix, sl_int64* value) const noexcept;
+
+		sl_int64 parseInt64(sl_int32 radix = 10, sl_int64 def = 0) const noexcept;
+
+		sl_bool parseUint64(sl_int32 radix, sl_uint64* value) const noexcept;
+
+		sl_uint64 parseUint64(sl_int32 radix = 10, sl_uint64 def = 0) const noexcept;
+
+		sl_bool parseInt(sl_int32 radix, sl_reg* value) const noexcept;
+
+		sl_reg parseInt(sl_int32 radix = 10, sl_reg def = 0) const noexcept;
+
+		sl_bool parseSize(sl_int32 radix, sl_size* value) const noexcept;
+
+		sl_size parseSize(sl_int32 radix = 10, sl_size def = 0) const noexcept;
+
+	private:
+		const sl_char8* m_data;
+		sl_size m_length;
+
+	};
+
+	/*
+		Non-owning view of a sequence of UTF-16 characters. See `StringView`.
+	*/
+	class SLIB_EXPORT StringView16
+	{
+	public:
+		SLIB_INLINE constexpr StringView16() noexcept : m_data(sl_null), m_length(0) {}
+
+		SLIB_INLINE constexpr StringView16(sl_null_t) noexcept : m_data(sl_null), m_length(0) {}
+
+		SLIB_INLINE constexpr StringView16(const sl_char16* data, sl_size length) noexcept : m_data(data), m_length(length) {}
+
+		StringView16(const sl_char16* sz) noexcept;
+
+		StringView16(const String16& str) noexcept;
+
+	public:
+		const sl_char16* getData() const noexcept;
+
+		sl_size getLength() const noexcept;
+
+		sl_bool isNull() const noexcept;
+
+		sl_bool isNotNull() const noexcept;
+
+		sl_bool isEmpty() const noexcept;
+
+		sl_bool isNotEmpty() const noexcept;
+
+		sl_char16 getAt(sl_reg index) const noexcept;
+
+		sl_char16 operator[](sl_size index) const noexcept;
+
+		// copies the characters into a new string
+		String16 toString() const noexcept;
+
+		sl_size getHashCode() const noexcept;
+
+		sl_size getHashCodeIgnoreCase() const noexcept;
+
+	public:
+		sl_bool equals(const StringView16& other) const noexcept;
+
+		sl_bool equalsIgnoreCase(const StringView16& other) const noexcept;
+
+		sl_int32 compare(const StringView16& other) const noexcept;
+
+		sl_int32 compareIgnoreCase(const StringView16& other) const noexcept;
+
+		sl_bool operator==(const StringView16& other) const noexcept;
+
+		sl_bool operator!=(const StringView16& other) const noexcept;
+
+	public:
+		StringView16 substring(sl_reg start, sl_reg end = -1) const noexcept;
+
+		sl_reg indexOf(sl_char16 ch, sl_reg start = 0) const noexcept;
+
+		sl_reg indexOf(const StringView16& str, sl_reg start = 0) const noexcept;
+
+		sl_reg lastIndexOf(sl_char16 ch, sl_reg start = -1) const noexcept;
+
+		sl_reg lastIndexOf(const StringView16& str, sl_reg start = -1) const noexcept;
+
+		sl_bool startsWith(sl_char16 ch) const noexcept;
+
+		sl_bool startsWith(const StringView16& str) const noexcept;
+
+		sl_bool endsWith(sl_char16 ch) const noexcept;
+
+		sl_bool endsWith(const StringView16& str) const noexcept;
+
+		sl_bool contains(sl_char16 ch) const noexcept;
+
+		sl_bool contains(const StringView16& str) const noexcept;
+
+		StringView16 trim() const noexcept;
+
+		StringView16 trimLeft() const noexcept;
+
+		StringView16 trimRight() const noexcept;
+
+		// the items are views into this view
+		List<StringView16> split(const StringView16& pattern) const noexcept;
+
+	public:
+		sl_bool parseInt32(sl_int32 radix, sl_int32* value) const noexcept;
+
+		sl_int32 parseInt32(sl_int32 radix = 10, sl_int32 def = 0) const noexcept;
+
+		sl_bool parseUint32(sl_int32 radix, sl_uint32* value) const noexcept;
+
+		sl_uint32 parseUint32(sl_int32 radix = 10, sl_uint32 def = 0) const noexcept;
+
+		sl_bool parseInt64(sl_int32 radix, sl_int64* value) const noexcept;
+
+		sl_int64 parseInt64(sl_int32 radix = 10, sl_int64 def = 0) const noexcept;
+
+		sl_bool parseUint64(sl_int32 radix, sl_uint64* value) const noexcept;
+
+		sl_uint64 parseUint64(sl_int32 radix = 10, sl_uint64 def = 0) const noexcept;
+
+		sl_bool parseInt(sl_int32 radix, sl_reg* value) const noexcept;
+
+		sl_reg parseInt(sl_int32 radix = 10, sl_reg def = 0) const noexcept;
+
+		sl_bool parseSize(sl_int32 radix, sl_size* value) const noexcept;
+
+		sl_size parseSize(sl_int32 radix = 10, sl_size def = 0) const noexcept;
+
+	private:
+		const sl_char16* m_data;
+		sl_size m_length;
+
+	};
+
+	sl_bool operator==(const String& first, const StringView& second) noexcept;
+
+	sl_bool operator!=(const String& first, const StringView& second) noexcept;
+
+	sl_bool operator==(const String16& first, const StringView16& second) noexcept;
+
+	sl_bool operator!=(const String16& first, const StringView16& second) noexcept;
+
+
+	template <>
+	class Compare<StringView>
+	{
+	public:
+		int operator()(const StringView& a, const StringView& b) const noexcept;
+	};
+
+	template <>
+	class Compare<StringView16>
+	{
+	public:
+		int operator()(const StringView16& a, const StringView16& b) const noexcept;
+	};
+
+	template <>
+	class Equals<StringView>
+	{
+	public:
+		sl_bool operator()(const StringView& a, const StringView& b) const noexcept;
+	};
+
+	template <>
+	class Equals<StringView16>
+	{
+	public:
+		sl_bool operator()(const StringView16& a, const StringView16& b) const noexcept;
+	};
+
+	template <>
+	class Hash<StringView>
+	{
+	public:
+		sl_size operator()(const StringView& a) const noexcept;
+	};
+
+	template <>
+	class Hash<StringView16>
+	{
+	public:
+		sl_size operator()(const StringView16& a) const noexcept;
+	};
+
+}
+
+#include "detail/string_view.inc"
+
+#endif
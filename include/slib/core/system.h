@@ -60,6 +60,9 @@ namespace slib
 
 		static sl_uint32 getThreadId();
 
+		// number of the logical processors available to the process
+		static sl_uint32 getProcessorsCount();
+
 		static sl_bool createProcess(const String& pathExecutable, const String* command, sl_uint32 nCommands);
 
 		static void exec(const String& pathExecutable, const String* command, sl_uint32 nCommands);
@@ -71,8 +74,7 @@ namespace slib
 		static void yield();
 
 		static void yield(sl_uint32 elapsed);
-	
-		
+			
 		// Error Handling
 		static sl_uint32 getLastError();
 		
@@ -51,7 +51,7 @@ namespace slib
 
 		sl_uint32 getThreadsCount();
 	
-		sl_bool addTask(const Function<void()>& task);
+		sl_bool addTask(InlineFunction<void()>&& task);
 
 		sl_bool dispatch(const Function<void()>& callback, sl_uint64 delay_ms = 0) override;
 	
@@ -66,7 +66,7 @@ namespace slib
 	protected:
 		CList< Ref<Thread> > m_threadWorkers;
 		LinkedQueue< Ref<Thread> > m_threadSleeping;
-		LinkedQueue< Function<void()> > m_tasks;
+		LinkedQueue< InlineFunction<void()> > m_tasks;
 
 		sl_bool m_flagRunning;
 
@@ -0,0 +1,133 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_CORE_TIMING_WHEEL
+#define CHECKHEADER_SLIB_CORE_TIMING_WHEEL
+
+#include "definition.h"
+
+#include "function.h"
+#include "mutex.h"
+#include "time.h"
+
+#define SLIB_TIMING_WHEEL_LEVELS 4
+#define SLIB_TIMING_WHEEL_SLOT_BITS 8
+#define SLIB_TIMING_WHEEL_SLOTS (1 << SLIB_TIMING_WHEEL_SLOT_BITS)
+
+namespace slib
+{
+
+	class TimingWheel;
+
+	/*
+		Intrusive node of TimingWheel.
+		Embed an entry into the owner object to schedule, reschedule and cancel
+		its timeout in O(1) without allocation. `callback` is invoked on the thread
+		calling `TimingWheel::process()`, after the entry is unlinked.
+	*/
+	class SLIB_EXPORT TimingWheelEntry
+	{
+	public:
+		Function<void()> callback;
+
+	public:
+		TimingWheelEntry() noexcept;
+
+		~TimingWheelEntry() noexcept;
+
+		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(TimingWheelEntry)
+
+	public:
+		sl_bool isScheduled() const noexcept;
+
+	private:
+		TimingWheel* m_wheel;
+		TimingWheelEntry* m_prev;
+		TimingWheelEntry* m_next;
+		TimingWheelEntry** m_slot;
+		sl_uint32 m_level;
+		sl_uint64 m_tick;
+		sl_bool m_flagAutoDelete;
+
+		friend class TimingWheel;
+	};
+
+	/*
+		Hierarchical timing wheel (4 levels x 256 slots).
+		Insert, reschedule and cancel are O(1); `process()` only visits the slots
+		holding due entries, and cascades an upper slot to the lower levels once
+		when its time range begins. Expirations are never earlier than requested
+		and are rounded up to the tick resolution.
+	*/
+	class SLIB_EXPORT TimingWheel
+	{
+	public:
+		TimingWheel(sl_uint32 tickMilliseconds = 1) noexcept;
+
+		~TimingWheel() noexcept;
+
+		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(TimingWheel)
+
+	public:
+		// schedules (or reschedules) `entry` to expire after `delay_ms`
+		sl_bool add(TimingWheelEntry* entry, sl_uint64 delay_ms) noexcept;
+
+		// schedules a one-shot task which can not be canceled
+		sl_bool add(const Function<void()>& task, sl_uint64 delay_ms) noexcept;
+
+		void remove(TimingWheelEntry* entry) noexcept;
+
+		void removeAll() noexcept;
+
+		sl_size getCount() noexcept;
+
+		// runs the expired entries, and returns the milliseconds until the next expiration (-1 if there is no entry)
+		sl_int32 process() noexcept;
+
+		sl_int32 getTimeout() noexcept;
+
+		sl_uint64 getElapsedMilliseconds() noexcept;
+
+	protected:
+		void _link(TimingWheelEntry* entry) noexcept;
+
+		void _unlink(TimingWheelEntry* entry) noexcept;
+
+		sl_bool _getNextTick(sl_uint64& tick) noexcept;
+
+		sl_int32 _getTimeout(sl_uint64 now) noexcept;
+
+	protected:
+		sl_uint32 m_tickMilliseconds;
+		TimeCounter m_timeCounter;
+		sl_uint64 m_tickCurrent;
+		TimingWheelEntry* m_slots[SLIB_TIMING_WHEEL_LEVELS][SLIB_TIMING_WHEEL_SLOTS];
+		sl_size m_countLevels[SLIB_TIMING_WHEEL_LEVELS];
+		sl_size m_count;
+		Mutex m_lock;
+
+		friend class TimingWheelEntry;
+	};
+
+}
+
+#endif
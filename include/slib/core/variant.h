@@ -62,6 +62,10 @@ namespace slib
 	class Variant;
 	typedef Atomic<Variant> AtomicVariant;
 	
+	class IReader;
+	class IWriter;
+	class MemoryQueue;
+	
 	class SLIB_EXPORT Variant
 	{
 	public:
@@ -466,6 +470,33 @@ namespace slib
 	
 		String toJsonString() const noexcept;
 		
+	public:
+		/*
+			Compact binary form: a tag byte followed by CVLI integers, UTF-8 strings or
+			raw bytes. Lists and maps are prefixed by the byte size of their contents,
+			so they can be skipped without being decoded. Values that can't be
+			represented in JSON (pointers, other objects) are written as null.
+		*/
+		sl_size getSerializedSize() const noexcept;
+		
+		Memory serialize() const noexcept;
+		
+		sl_bool serialize(IWriter* writer) const noexcept;
+		
+		// memory values are added to `output` without copying
+		sl_bool serialize(MemoryQueue* output) const noexcept;
+		
+		// returns the size of the decoded data (0 on error). Memories of `output` refer to `mem` without copying
+		static sl_size deserialize(const Memory& mem, Variant& output) noexcept;
+		
+		// returns the size of the decoded data (0 on error)
+		static sl_size deserialize(const void* data, sl_size size, Variant& output) noexcept;
+		
+		static sl_bool deserialize(IReader* reader, Variant& output) noexcept;
+		
+		// returns the size of the serialized value at `data` without decoding it (0 on error)
+		static sl_size getSerializedSize(const void* data, sl_size size) noexcept;
+		
 	public:
 		void get(Variant& _out) const noexcept;
 		void set(const Variant& _in) noexcept;
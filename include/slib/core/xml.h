@@ -41,6 +41,8 @@
 #include "variant.h"
 #include "function.h"
 
+#define SLIB_XML_PUSH_PARSER_CHUNK_SIZE 65536
+
 namespace slib
 {
 	
@@ -53,6 +55,8 @@ namespace slib
 	class XmlParseControl;
 	class StringBuffer;
 	class StringBuffer16;
+	class IReader;
+	class AsyncStream;
 
 	enum class XmlNodeType
 	{
@@ -740,6 +744,74 @@ namespace slib
 		static sl_bool checkName(const XmlString& name);
 
 	};
+	
+	/**
+	 * @class XmlPushParser
+	 * @brief parses XML text (UTF-8 encoding) fed by arbitrary chunks.
+	 *
+	 * The parser keeps only the incomplete node at the end of the fed data, and
+	 * the stack of the open elements, so the memory usage does not depend on the
+	 * size of the document. The nodes are reported by the callbacks of
+	 * `XmlParseParam` in the same order as `Xml::parseXml`, but the document tree
+	 * is not created (`flagCreateDocument` is ignored and `XmlElement` objects
+	 * passed to the callbacks are not linked to their parents).
+	 * The positions in the source are counted by bytes from the start of the
+	 * document. `XmlParseControl::parsingPosition` is relative to the buffered
+	 * data, and changing the source in the callbacks is not supported.
+	 */
+	class SLIB_EXPORT XmlPushParser : public Object
+	{
+		SLIB_DECLARE_OBJECT
+		
+	protected:
+		XmlPushParser();
+		
+		~XmlPushParser();
+		
+	public:
+		static Ref<XmlPushParser> create(const XmlParseParam& param);
+		
+	public:
+		/**
+		 * parses the complete nodes in the data, and keeps the rest until the next call
+		 *
+		 * @return `false` on error, or when the parser has already been ended
+		 */
+		virtual sl_bool put(const void* data, sl_size size) = 0;
+		
+		/**
+		 * parses the remaining data, and checks all elements are closed
+		 *
+		 * @return `true` on success
+		 */
+		virtual sl_bool end() = 0;
+		
+		virtual sl_bool isEnded() = 0;
+		
+		virtual sl_bool isError() = 0;
+		
+		// `flagError`, `errorPosition`, `errorLine`, `errorColumn` and `errorMessage` are updated on error
+		virtual const XmlParseParam& getParam() = 0;
+		
+	public:
+		/**
+		 * parses XML text (UTF-8 encoding) read from `reader` by the chunks of `chunkSize` bytes
+		 *
+		 * @return `true` on success
+		 */
+		static sl_bool parse(IReader* reader, XmlParseParam& param, sl_size chunkSize = SLIB_XML_PUSH_PARSER_CHUNK_SIZE);
+		
+		static sl_bool parseFile(const String& filePath, XmlParseParam& param, sl_size chunkSize = SLIB_XML_PUSH_PARSER_CHUNK_SIZE);
+		
+		/**
+		 * reads `stream` until the end of the stream or an error, and feeds the chunks to a new parser.
+		 * `onEnd` is called after the parser is ended.
+		 *
+		 * @return the parser on success to start reading
+		 */
+		static Ref<XmlPushParser> parse(const Ref<AsyncStream>& stream, const XmlParseParam& param, const Function<void(XmlPushParser*)>& onEnd, sl_uint32 chunkSize = SLIB_XML_PUSH_PARSER_CHUNK_SIZE);
+		
+	};
 
 }
 
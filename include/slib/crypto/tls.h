@@ -90,6 +90,9 @@ namespace slib
 		sl_uint32 writingBufferSize;
 		
 		sl_bool flagAutoStartHandshake;
+		
+		// default: false. On Linux, installs the negotiated keys into the kernel (kTLS) after handshake so that the kernel encrypts/decrypts the records. Falls back to user-space when the `tls` module or the cipher is not available.
+		sl_bool flagKernelTls;
 
 		Function<void(TlsStreamResult&)> onHandshake;
 		
@@ -141,6 +144,12 @@ namespace slib
 	public:
 		virtual void handshake() = 0;
 		
+		// returns true if the outgoing records are encrypted by kernel TLS
+		virtual sl_bool isKernelTlsSending();
+		
+		// returns true if the incoming records are decrypted by kernel TLS
+		virtual sl_bool isKernelTlsReceiving();
+		
 	};
 	
 }
@@ -110,6 +110,10 @@ namespace slib
 		Nearest = 0,
 		Linear = 1,
 		Box = 2,
+		// Mitchell-Netravali cubic filter (B = C = 1/3)
+		Mitchell = 3,
+		// windowed sinc filter with 3 lobes, sharpest for downscaling
+		Lanczos3 = 4,
 		
 		Default = Box
 	};
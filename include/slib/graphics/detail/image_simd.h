@@ -0,0 +1,146 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+#ifndef CHECKHEADER_SLIB_GRAPHICS_DETAIL_IMAGE_SIMD
+#define CHECKHEADER_SLIB_GRAPHICS_DETAIL_IMAGE_SIMD
+
+#include "../color.h"
+#include "../yuv.h"
+
+#include "../../core/math.h"
+
+/*
+	Internal header, not included by `slib/graphics.h`.
+	Row kernels used by Image and BitmapData.
+	
+	Every kernel produces exactly the same output as the scalar code (`Color::blend_PA_NPA`, `Color::convertNPAtoPA`, ...), and selects SSE2/SSSE3/AVX2 (x86) or NEON (ARM) implementation by `_priv_Simd::getLevel()`.
+*/
+
+namespace slib
+{
+	
+	// fixed-point coefficients of `YUVMatrix`
+	class _priv_YUVMatrix
+	{
+	public:
+		// YUV -> RGB, 6 bit fraction
+		sl_uint16 yg; // round(Y gain * 64 * 65536 / 257)
+		sl_int16 yb; // Y bias, including the rounding of the final shift
+		sl_int16 ub;
+		sl_int16 ug;
+		sl_int16 vg;
+		sl_int16 vr;
+		
+		// RGB -> YUV, 8 bit fraction
+		sl_int16 ry;
+		sl_int16 gy;
+		sl_int16 by;
+		sl_int16 ru;
+		sl_int16 gu;
+		sl_int16 bu;
+		sl_int16 rv;
+		sl_int16 gv;
+		sl_int16 bv;
+		sl_uint16 offsetY;
+		sl_uint16 offsetUV;
+		
+	public:
+		static const _priv_YUVMatrix& get(YUVMatrix matrix);
+		
+		/*
+			The SIMD kernels compute the same expressions with 16 bit lanes.
+			The RGB -> YUV results never leave 0 ~ 65535 before the shift, and only the last addition of YUV -> RGB can saturate, which is clamped anyway.
+		*/
+		SLIB_INLINE void toRGB(sl_uint8 Y, sl_uint8 U, sl_uint8 V, sl_uint8& R, sl_uint8& G, sl_uint8& B) const
+		{
+			sl_int32 y = (sl_int32)(((sl_uint32)Y * 0x0101 * yg) >> 16) + yb;
+			sl_int32 u = (sl_int32)U - 128;
+			sl_int32 v = (sl_int32)V - 128;
+			B = (sl_uint8)(Math::clamp0_255((y + u * ub) >> 6));
+			G = (sl_uint8)(Math::clamp0_255((y - u * ug - v * vg) >> 6));
+			R = (sl_uint8)(Math::clamp0_255((y + v * vr) >> 6));
+		}
+		
+		SLIB_INLINE sl_uint8 getY(sl_uint32 R, sl_uint32 G, sl_uint32 B) const
+		{
+			return (sl_uint8)((ry * R + gy * G + by * B + offsetY) >> 8);
+		}
+		
+		SLIB_INLINE sl_uint8 getU(sl_uint32 R, sl_uint32 G, sl_uint32 B) const
+		{
+			return (sl_uint8)((sl_int32)(ru * (sl_int32)R + gu * (sl_int32)G + bu * (sl_int32)B + offsetUV) >> 8);
+		}
+		
+		SLIB_INLINE sl_uint8 getV(sl_uint32 R, sl_uint32 G, sl_uint32 B) const
+		{
+			return (sl_uint8)((sl_int32)(rv * (sl_int32)R + gv * (sl_int32)G + bv * (sl_int32)B + offsetUV) >> 8);
+		}
+		
+	};
+	
+	class _priv_ImageSimd
+	{
+	public:
+		static void fillRow(Color* dst, const Color& color, sl_size count);
+		
+		// dst: premultiplied alpha, src: non-premultiplied alpha
+		static void blendRow_PA_NPA(Color* dst, const Color* src, sl_size count);
+		
+		// dst: premultiplied alpha, color: non-premultiplied alpha
+		static void blendColorRow_PA_NPA(Color* dst, const Color& color, sl_size count);
+		
+		// sums the channels of a `width` x `height` block into `sum` (r, g, b, a)
+		static void sumBlock(sl_uint32* sum, const Color* src, sl_uint32 width, sl_uint32 height, sl_int32 stride);
+		
+		// dst[i * 4 + k] = src[i * 4 + order[k]]
+		static void shuffleRow_4to4(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[4]);
+		
+		// dst[i * 3 + k] = src[i * 4 + order[k]]
+		static void shuffleRow_4to3(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[3]);
+		
+		// dst[i * 4 + k] = src[i * 3 + order[k]], or 255 if order[k] is 255
+		static void shuffleRow_3to4(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[4]);
+		
+		// `indexAlpha` is the position of the alpha in 4-byte samples (0 or 3)
+		static void premultiplyRow(sl_uint8* data, sl_size count, sl_uint32 indexAlpha);
+		
+		// `indexAlpha` is the position of the alpha in 4-byte samples (0 or 3)
+		static void unpremultiplyRow(sl_uint8* data, sl_size count, sl_uint32 indexAlpha);
+		
+		/*
+			YUV <-> RGBA (BGRA when `flagBGRA` is set)
+			Chroma of the pixel `i` is `u[i / 2 * strideUV]` and `v[i / 2 * strideUV]`, and it is the rounded average of the 2x2 (4:2:0) or 2x1 (4:2:2) block on writing
+		*/
+		static void convertYUV420ToRGBARow(sl_uint8* dst, const sl_uint8* y, const sl_uint8* u, const sl_uint8* v, sl_uint32 strideUV, sl_size count, const _priv_YUVMatrix& matrix, sl_bool flagBGRA);
+		
+		// `src1` and `y1` may be same as `src0` and `y0` for the last row of the odd height
+		static void convertRGBAToYUV420Rows(sl_uint8* y0, sl_uint8* y1, sl_uint8* u, sl_uint8* v, sl_uint32 strideUV, const sl_uint8* src0, const sl_uint8* src1, sl_size count, const _priv_YUVMatrix& matrix, sl_bool flagBGRA);
+		
+		static void convertYUYVToRGBARow(sl_uint8* dst, const sl_uint8* src, sl_size count, const _priv_YUVMatrix& matrix, sl_bool flagBGRA);
+		
+		static void convertRGBAToYUYVRow(sl_uint8* dst, const sl_uint8* src, sl_size count, const _priv_YUVMatrix& matrix, sl_bool flagBGRA);
+		
+	};
+	
+}
+
+#endif
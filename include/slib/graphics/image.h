@@ -32,6 +32,7 @@
 #include "../core/object.h"
 #include "../core/memory.h"
 #include "../core/string.h"
+#include "../core/function.h"
 
 namespace slib
 {
@@ -199,6 +200,18 @@ namespace slib
 
 		static Ref<Image> loadJPEG(const void* content, sl_size size);
 
+		// Uses IDCT scaling (1/2, 1/4, 1/8) to decode the smallest image which is not smaller than `minWidth` x `minHeight`
+		static Ref<Image> loadJPEG(const void* content, sl_size size, sl_uint32 minWidth, sl_uint32 minHeight);
+
+		// Decodes and box-filters the rows as they are read, so that the full frame is never held in memory
+		static Ref<Image> loadJPEGToSmall(const void* content, sl_size size, sl_uint32 requiredWidth, sl_uint32 requiredHeight, sl_bool flagKeepAspectRatio = sl_true);
+
+		/*
+			Streaming decoder: `onStart` receives the output size (returning `sl_false` cancels decoding), then `onRow` receives every scanline in order.
+			`minWidth` and `minHeight` select the IDCT scale as in `loadJPEG()` (0 means full size).
+		*/
+		static sl_bool decodeJPEG(const void* content, sl_size size, sl_uint32 minWidth, sl_uint32 minHeight, const Function<sl_bool(sl_uint32 width, sl_uint32 height)>& onStart, const Function<void(sl_uint32 y, const Color* colors)>& onRow);
+
 		static Memory saveJPEG(const Ref<Image>& image, float quality = 0.5f);
 
 		Memory saveJPEG(float quality = 0.5f);
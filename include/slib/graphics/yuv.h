@@ -28,12 +28,53 @@
 namespace slib
 {
 	
+	enum class YUVMatrix
+	{
+		BT601 = 0, // ITU-R BT.601, limited range (Y: 16~235, UV: 16~240)
+		BT601_Full = 1, // ITU-R BT.601, full range (JPEG)
+		BT709 = 2, // ITU-R BT.709, limited range
+		BT709_Full = 3, // ITU-R BT.709, full range
+		Default = BT601
+	};
+	
 	class SLIB_EXPORT YUV
 	{
 	public:
 		static void convertRGBToYUV(sl_uint8 R, sl_uint8 G, sl_uint8 B, sl_uint8& Y, sl_uint8& U, sl_uint8& V);
 
 		static void convertYUVToRGB(sl_uint8 Y, sl_uint8 U, sl_uint8 V, sl_uint8& R, sl_uint8& G, sl_uint8& B);
+		
+		static void convertRGBToYUV(YUVMatrix matrix, sl_uint8 R, sl_uint8 G, sl_uint8 B, sl_uint8& Y, sl_uint8& U, sl_uint8& V);
+		
+		static void convertYUVToRGB(YUVMatrix matrix, sl_uint8 Y, sl_uint8 U, sl_uint8 V, sl_uint8& R, sl_uint8& G, sl_uint8& B);
+		
+		/*
+			Frame converters
+		 
+			`rgba` has 4 bytes per pixel in R, G, B, A order (B, G, R, A when `flagBGRA` is set). Alpha is written as 255, and ignored on reading.
+			4:2:0 chroma planes have (width + 1) / 2 x (height + 1) / 2 samples, and `strideUV` is the distance of the adjacent chroma samples (1: I420/YV12, 2: NV12/NV21).
+			Large frames are converted by row bands on multiple threads.
+		*/
+		static void convertYUV420ToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* y, sl_int32 pitchY, const sl_uint8* u, sl_int32 pitchU, const sl_uint8* v, sl_int32 pitchV, sl_uint32 strideUV, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
+		
+		static void convertRGBAToYUV420(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* y, sl_int32 pitchY, sl_uint8* u, sl_int32 pitchU, sl_uint8* v, sl_int32 pitchV, sl_uint32 strideUV, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
+		
+		static void convertI420ToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* y, sl_int32 pitchY, const sl_uint8* u, sl_int32 pitchU, const sl_uint8* v, sl_int32 pitchV, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
+		
+		static void convertRGBAToI420(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* y, sl_int32 pitchY, sl_uint8* u, sl_int32 pitchU, sl_uint8* v, sl_int32 pitchV, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
+		
+		static void convertNV12ToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* y, sl_int32 pitchY, const sl_uint8* uv, sl_int32 pitchUV, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
+		
+		static void convertRGBAToNV12(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* y, sl_int32 pitchY, sl_uint8* uv, sl_int32 pitchUV, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
+		
+		static void convertNV21ToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* y, sl_int32 pitchY, const sl_uint8* vu, sl_int32 pitchVU, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
+		
+		static void convertRGBAToNV21(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* y, sl_int32 pitchY, sl_uint8* vu, sl_int32 pitchVU, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
+		
+		// packed 4:2:2 (Y0, U, Y1, V)
+		static void convertYUYVToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* yuyv, sl_int32 pitchYUYV, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
+		
+		static void convertRGBAToYUYV(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* yuyv, sl_int32 pitchYUYV, sl_bool flagBGRA = sl_false, YUVMatrix matrix = YUVMatrix::Default);
 
 	};
 
@@ -81,6 +81,12 @@ namespace slib
 		
 		sl_bool send(const Memory& mem, const Function<void(AsyncStreamResult&)>& callback);
 		
+		sl_bool isSendFileSupported() override;
+		
+		sl_bool sendFile(const Ref<File>& file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject = sl_null) override;
+		
+		sl_bool readPooled(sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject = sl_null) override;
+		
 	protected:
 		Ref<AsyncTcpSocketInstance> _getIoInstance();
 		
@@ -185,10 +191,14 @@ namespace slib
 		sl_bool flagAutoStart; // default: true
 		sl_bool flagLogError; // default: true
 		sl_uint32 packetSize; // default: 65536
+		sl_uint32 receiveBatchCount; // default: 1, maximum number of datagrams received by one system call (recvmmsg on linux)
 		Ref<AsyncIoLoop> ioLoop;
 		
 		Function<void(AsyncUdpSocket*, const SocketAddress&, void* data, sl_uint32 sizeReceived)> onReceiveFrom;
 		
+		// called instead of `onReceiveFrom` if set. The buffers of the datagrams are reused after the callback returns
+		Function<void(AsyncUdpSocket*, SocketDatagram* datagrams, sl_uint32 count)> onReceiveBatch;
+		
 	public:
 		AsyncUdpSocketParam();
 		
@@ -230,16 +240,22 @@ namespace slib
 		
 		sl_bool sendTo(const SocketAddress& addressTo, const Memory& mem);
 		
+		// the queued datagrams are sent together (sendmmsg and UDP GSO on linux)
+		sl_bool sendTo(const SocketAddress& addressTo, const Memory* packets, sl_uint32 count);
+		
 	protected:
 		Ref<AsyncUdpSocketInstance> _getIoInstance();
 		
 		void _onReceive(const SocketAddress& address, void* data, sl_uint32 sizeReceived);
 		
+		void _onReceive(SocketDatagram* datagrams, sl_uint32 count);
+		
 	protected:
-		static Ref<AsyncUdpSocketInstance> _createInstance(const Ref<Socket>& socket, sl_uint32 packetSize);
+		static Ref<AsyncUdpSocketInstance> _createInstance(const Ref<Socket>& socket, sl_uint32 packetSize, sl_uint32 receiveBatchCount);
 		
 	protected:
 		Function<void(AsyncUdpSocket*, const SocketAddress&, void* data, sl_uint32 sizeReceived)> m_onReceiveFrom;
+		Function<void(AsyncUdpSocket*, SocketDatagram* datagrams, sl_uint32 count)> m_onReceiveBatch;
 		
 		friend class AsyncUdpSocketInstance;
 		
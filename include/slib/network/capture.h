@@ -29,6 +29,7 @@
 	
 		libpcap (unix) and winpcap (win32)
 		, raw sockets, packet sockets (linux)
+		, memory-mapped packet rings (linux, TPACKET_V3)
 		
 *****************************************************************/
 
@@ -41,6 +42,7 @@
 #include "../core/time.h"
 #include "../core/string.h"
 #include "../core/function.h"
+#include "../core/list.h"
 
 namespace slib
 {
@@ -48,6 +50,7 @@ namespace slib
 	class SLIB_EXPORT NetCapturePacket
 	{
 	public:
+		// in Packet Ring mode, points into the ring and is valid only in the callback
 		sl_uint8* data;
 		sl_uint32 length;
 		Time time;
@@ -76,6 +79,31 @@ namespace slib
 		
 	};
 	
+	class SLIB_EXPORT NetCaptureStatistics
+	{
+	public:
+		sl_uint64 countPackets; // packets received by the socket, including the dropped ones
+		sl_uint64 countDrops; // packets dropped because the ring was full
+		sl_uint64 countFreezes; // times the ring was frozen (TPACKET_V3)
+		
+	public:
+		NetCaptureStatistics();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(NetCaptureStatistics)
+		
+	};
+	
+	// values of PACKET_FANOUT_* (linux)
+	enum class NetCaptureFanoutMode
+	{
+		Hash = 0, // packets of a flow are delivered to the same thread
+		LoadBalance = 1,
+		CPU = 2, // by the CPU the packet arrived on
+		Rollover = 3,
+		Random = 4,
+		QueueMapping = 5 // by the recorded RX queue
+	};
+	
 	class NetCapture;
 	
 	class SLIB_EXPORT NetCaptureParam
@@ -90,8 +118,18 @@ namespace slib
 		
 		NetworkLinkDeviceType preferedLinkDeviceType; // NetworkLinkDeviceType, used in Packet Socket mode. now supported Ethernet and Raw
 		
+		// used in Packet Ring mode
+		sl_uint32 threadsCount; // number of capturing threads (one ring per thread, joined to a fanout group when greater than 1)
+		NetCaptureFanoutMode fanoutMode;
+		sl_uint16 fanoutGroupId; // 0: generated from the process id
+		sl_uint32 ringBlockSize; // power of 2, multiple of the page size
+		sl_uint32 ringBlocksCount;
+		sl_uint32 ringBlockTimeout; // in milliseconds, retires a partially filled block
+		sl_uint32 ringTxFramesCount; // 0: sends without TX ring, used in Ethernet link type
+		
 		sl_bool flagAutoStart; // default: true
 		
+		// called concurrently from the capturing threads in Packet Ring mode
 		Function<void(NetCapture*, NetCapturePacket&)> onCapturePacket;
 		
 	public:
@@ -120,6 +158,9 @@ namespace slib
 		// raw socket
 		static Ref<NetCapture> createRawIPv4(const NetCaptureParam& param);
 		
+		// linux packet socket with memory-mapped TPACKET_V3 rings
+		static Ref<NetCapture> createPacketRing(const NetCaptureParam& param);
+		
 	public:
 		virtual void release() = 0;
 		
@@ -136,6 +177,11 @@ namespace slib
 		
 		virtual String getLastErrorMessage();
 		
+		// accumulated over all the rings
+		virtual sl_bool getStatistics(NetCaptureStatistics& _out);
+		
+		virtual List<NetCaptureStatistics> getRingStatistics();
+		
 		// Pcap Utiltities
 		static List<NetCaptureDeviceInfo> getAllPcapDevices();
 		
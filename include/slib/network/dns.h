@@ -31,6 +31,7 @@
 #include "../core/string.h"
 #include "../core/hash_map.h"
 #include "../core/json.h"
+#include "../core/time.h"
 #include "../crypto/aes.h"
 
 /********************************************************************
@@ -445,7 +446,162 @@ namespace slib
 		
 		static Memory buildQuestionPacket(sl_uint16 id, const String& host);
 		
-		static Memory buildHostAddressAnswerPacket(sl_uint16 id, const String& hostName, const IPv4Address& hostAddress);
+		static Memory buildHostAddressAnswerPacket(sl_uint16 id, const String& hostName, const IPv4Address& hostAddress, sl_uint32 TTL = 0);
+		
+	};
+	
+	
+	class SLIB_EXPORT DnsCacheParam
+	{
+	public:
+		sl_uint32 shardsCount; // default: 0 (number of processors)
+		
+		sl_uint32 maximumEntriesCount; // default: 65536
+		
+		sl_uint32 minimumTTL; // in seconds, default: 0
+		sl_uint32 maximumTTL; // in seconds, default: 86400
+		
+		sl_uint32 negativeTTL; // in seconds, used for the negative answers without SOA record, default: 60
+		
+		// A popular entry (hit `prefetchHitsCount` times) is prefetched once, when its remaining TTL falls below `prefetchPercent` of the original TTL (0: disabled)
+		sl_uint32 prefetchPercent; // default: 10
+		sl_uint32 prefetchHitsCount; // default: 2
+		
+	public:
+		DnsCacheParam();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(DnsCacheParam)
+		
+	};
+	
+	class SLIB_EXPORT DnsCacheStatistics
+	{
+	public:
+		sl_uint64 countHits;
+		sl_uint64 countNegativeHits; // included in `countHits`
+		sl_uint64 countMisses;
+		sl_uint64 countPrefetches;
+		sl_uint64 countEvictions; // entries removed before expiring
+		sl_size countEntries;
+		
+	public:
+		DnsCacheStatistics();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(DnsCacheStatistics)
+		
+	};
+	
+	class SLIB_EXPORT DnsCacheAnswer
+	{
+	public:
+		Memory message; // answer message as received from the upstream server
+		
+		DnsPacket packet;
+		
+		DnsResponseCode responseCode;
+		
+		sl_uint32 TTL; // remaining seconds
+		
+		sl_uint32 elapsedSeconds; // since the answer is stored
+		
+		sl_bool flagNegative; // NXDOMAIN or NODATA
+		
+		// set on the one lookup which should refresh the entry from the upstream server
+		sl_bool flagPrefetch;
+		
+	public:
+		DnsCacheAnswer();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(DnsCacheAnswer)
+		
+	public:
+		// copy of `message` for the request `id`, whose record TTLs are decreased by the elapsed time
+		Memory buildMessage(sl_uint16 id) const;
+		
+	};
+	
+	class DnsCacheEntry
+	{
+	public:
+		Memory message;
+		DnsPacket packet;
+		DnsResponseCode responseCode;
+		sl_uint64 timeStored;
+		sl_uint64 timeExpire;
+		sl_uint32 TTL;
+		sl_uint32 countHits;
+		sl_bool flagNegative;
+		sl_bool flagPrefetched;
+		
+	public:
+		DnsCacheEntry();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(DnsCacheEntry)
+		
+	};
+	
+	class DnsCacheShard
+	{
+	public:
+		Mutex lock;
+		CHashMap<String, DnsCacheEntry> entries;
+		DnsCacheStatistics statistics;
+		
+	public:
+		DnsCacheShard();
+		
+		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(DnsCacheShard)
+		
+	};
+	
+	/*
+		In-memory cache of the answers keyed by (name, type).
+		Positive answers live for the smallest TTL of their answer records,
+		and negative answers (NXDOMAIN, NODATA) for the TTL of the SOA record
+		in their authority section (RFC 2308). Entries are sharded by key,
+		so lookups from different threads rarely contend on the same lock.
+	*/
+	class SLIB_EXPORT DnsCache : public Object
+	{
+		SLIB_DECLARE_OBJECT
+		
+	protected:
+		DnsCache();
+		
+		~DnsCache();
+		
+	public:
+		static Ref<DnsCache> create(const DnsCacheParam& param);
+		
+		static Ref<DnsCache> create();
+		
+	public:
+		sl_bool get(const String& name, DnsRecordType type, DnsCacheAnswer& _out);
+		
+		// returns sl_false when the answer is not cacheable (truncated, server failure, zero TTL)
+		sl_bool put(const String& name, DnsRecordType type, const void* message, sl_uint32 size, sl_uint32* outTTL = sl_null);
+		
+		void remove(const String& name, DnsRecordType type);
+		
+		void removeAll();
+		
+		void getStatistics(DnsCacheStatistics& _out);
+		
+		static String getKey(const String& name, DnsRecordType type);
+		
+	protected:
+		DnsCacheShard* _getShard(const String& key);
+		
+		void _evict(DnsCacheShard* shard, sl_uint64 now);
+		
+	protected:
+		DnsCacheParam m_param;
+		
+		DnsCacheShard* m_shards;
+		sl_uint32 m_nShards;
+		sl_uint32 m_nMaxEntriesPerShard;
+		
+		TimeCounter m_timeCounter;
 		
 	};
 	
@@ -459,6 +615,12 @@ namespace slib
 
 		Ref<AsyncIoLoop> ioLoop;
 		
+		// answers are looked up in and stored into the cache when it is not null
+		Ref<DnsCache> cache;
+		
+		// in milliseconds, a question in flight is sent again after this time, default: 5000
+		sl_uint32 questionTimeout;
+		
 	public:
 		DnsClientParam();
 		
@@ -483,15 +645,32 @@ namespace slib
 		
 		void sendQuestion(const IPv4Address& serverIp, const String& hostName);
 		
+		Ref<DnsCache> getCache();
+		
 	protected:
+		void _sendQuestion(const SocketAddress& serverAddress, const String& hostName, sl_bool flagPrefetch);
+		
 		void _onReceiveFrom(AsyncUdpSocket* socket, const SocketAddress& address, void* data, sl_uint32 sizeReceive);
 
 		void _onAnswer(const SocketAddress& serverAddress, const DnsPacket& packet);
 		
 	protected:
 		Ref<AsyncUdpSocket> m_udp;
+		Mutex m_lockQuestions;
 		sl_uint16 m_idLast;
 		
+		Ref<DnsCache> m_cache;
+		sl_uint32 m_questionTimeout;
+		
+		struct PendingQuestion
+		{
+			sl_uint16 id;
+			sl_uint32 timeStart;
+			sl_bool flagPrefetch;
+		};
+		// in-flight questions by server and question, identical questions are not sent again while waiting for the answer
+		CHashMap<String, PendingQuestion> m_mapQuestions;
+		
 		Function<void(DnsClient*, const SocketAddress&, const DnsPacket&)> m_onAnswer;
 
 	};
@@ -541,6 +720,15 @@ namespace slib
 		
 		sl_bool flagAutoStart;
 		
+		// answers of the forwarded questions are cached, default: true
+		sl_bool flagCache;
+		// shared cache, created from `cacheParam` when it is null
+		Ref<DnsCache> cache;
+		DnsCacheParam cacheParam;
+		
+		// in milliseconds, identical questions are coalesced into the forward in flight until this time, default: 5000
+		sl_uint32 forwardTimeout;
+		
 		Ref<AsyncIoLoop> ioLoop;
 		
 		Function<void(DnsServer*, DnsResolveHostParam&)> onResolve;
@@ -575,10 +763,29 @@ namespace slib
 		
 		sl_bool isRunning();
 		
+		Ref<DnsCache> getCache();
+		
+	protected:
+		struct ForwardClient
+		{
+			SocketAddress clientAddress;
+			sl_uint16 requestedId;
+			sl_bool flagEncrypted;
+		};
+		
+		struct ForwardElement
+		{
+			String requestedHostName;
+			DnsRecordType requestedType;
+			String key;
+			List<ForwardClient> clients;
+			sl_uint32 timeStart;
+		};
+		
 	protected:
 		void _processReceivedDnsQuestion(const SocketAddress& clientAddress, sl_uint16 id, const String& hostName, sl_bool flagEncryptedRequest);
 		
-		void _processReceivedDnsAnswer(const DnsPacket& packet);
+		void _processReceivedDnsAnswer(const DnsPacket& packet, const void* data, sl_uint32 size);
 		
 		void _processReceivedProxyQuestion(const SocketAddress& clientAddress, void* data, sl_uint32 size, sl_bool flagEncryptedRequest);
 		
@@ -588,11 +795,20 @@ namespace slib
 		
 		Memory _buildQuestionPacket(sl_uint16 id, const String& host, sl_bool flagEncrypt);
 		
-		Memory _buildHostAddressAnswerPacket(sl_uint16 id, const String& hostName, const IPv4Address& hostAddress, sl_bool flagEncrypt);
+		Memory _buildHostAddressAnswerPacket(sl_uint16 id, const String& hostName, const IPv4Address& hostAddress, sl_bool flagEncrypt, sl_uint32 TTL = 0);
+		
+		IPv4Address _resolveAnswer(const DnsPacket& packet, const String& hostName, sl_bool flagNotifyCache);
+		
+		// `client` joins the forward in flight of the same question if exists, otherwise a new forward is sent (`message`: original question, or null to build one)
+		void _forwardQuestion(const String& hostName, DnsRecordType type, const ForwardClient* client, const SocketAddress& forwardAddress, sl_bool flagEncryptForward, const void* message, sl_uint32 size);
+		
+		sl_bool _takeForward(sl_uint16 idForward, ForwardElement& _out);
 		
 	protected:
 		void _onReceiveFrom(AsyncUdpSocket* socket, const SocketAddress& address, void* data, sl_uint32 sizeReceive);
 		
+		void _onReceiveBatch(AsyncUdpSocket* socket, SocketDatagram* datagrams, sl_uint32 count);
+		
 		void _onResolve(DnsResolveHostParam& param);
 		
 		void _onCache(const String& hostName, const IPAddress& hostAddress);
@@ -611,16 +827,13 @@ namespace slib
 		SocketAddress m_defaultForwardAddress;
 		sl_bool m_flagEncryptDefaultForward;
 		
-		sl_uint16 m_lastForwardId;
+		Ref<DnsCache> m_cache;
+		sl_uint32 m_forwardTimeout;
 		
-		struct ForwardElement
-		{
-			SocketAddress clientAddress;
-			sl_uint16 requestedId;
-			String requestedHostName;
-			sl_bool flagEncrypted;
-		};
+		Mutex m_lockForward;
+		sl_uint16 m_lastForwardId;
 		CHashMap<sl_uint16, ForwardElement> m_mapForward;
+		CHashMap<String, sl_uint16> m_mapForwardQuestions; // forwards in flight by question
 		
 		Function<void(DnsServer*, DnsResolveHostParam&)> m_onResolve;
 		Function<void(DnsServer*, const String& hostName, const IPAddress& hostAddress)> m_onCache;
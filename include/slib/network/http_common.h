@@ -182,6 +182,8 @@ namespace slib
 		static const String& AcceptRanges;
 		static const String& ContentRange;
 		static const String& LastModified;
+		static const String& Vary;
+		static const String& Age;
 		
 	public:
 		
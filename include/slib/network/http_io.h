@@ -59,6 +59,9 @@ namespace slib
 		
 		sl_uint64 getOutputLength() const;
 		
+		// returns false when the output contains the stream bodies (files)
+		sl_bool mergeOutput(Memory& _out) const;
+		
 	protected:
 		AsyncOutputBuffer m_bufferOutput;
 		
@@ -31,6 +31,8 @@
 
 #include "../core/thread_pool.h"
 #include "../core/ptr.h"
+#include "../core/event.h"
+#include "../core/time.h"
 #include "../crypto/tls.h"
 
 namespace slib
@@ -160,9 +162,12 @@ namespace slib
 		AtomicRef<HttpServerContext> m_contextCurrent;
 		
 		sl_bool m_flagClosed;
-		Memory m_bufRead;
+		Function<void(AsyncStreamResult&)> m_callbackRead;
 		sl_bool m_flagReading;
 		sl_bool m_flagKeepAlive;
+		sl_bool m_flagWritingResponse;
+		
+		TimingWheelEntry m_entryTimeout;
 		
 	protected:
 		void _read();
@@ -173,6 +178,10 @@ namespace slib
 		
 		void _completeResponse(HttpServerContext* context);
 		
+		void _setTimeout(sl_uint32 timeout);
+		
+		void _onTimeout();
+		
 	protected:
 		void onReadStream(AsyncStreamResult& result);
 
@@ -222,7 +231,7 @@ namespace slib
 	public:
 		HttpServerRoute* createRoute(const String& path);
 		
-		HttpServerRoute* getRoute(const String& path, HashMap<String, String>& parameters);
+		HttpServerRoute* getRoute(const StringView& path, HashMap<String, String>& parameters);
 		
 		void add(const String& path, const HttpServerRoute& route);
 		
@@ -287,6 +296,149 @@ namespace slib
 		
 	};
 	
+	class SLIB_EXPORT HttpResponseCacheRule
+	{
+	public:
+		sl_uint32 TTL; // in seconds, default: 60
+		
+		// in seconds, an expired response is served to the other requests while one request is updating it (0: disabled), default: 0
+		sl_uint32 staleWhileRevalidate;
+		
+		// query parameters composing the key (empty: whole query string)
+		List<String> queryParameters;
+		sl_bool flagIgnoreQuery; // default: false
+		
+		// request headers composing the key, also listed in `Vary` header of the response
+		List<String> varyHeaders;
+		
+		sl_bool flagGzip; // stores pre-compressed content for the clients accepting gzip, default: true
+		
+		// in milliseconds, identical misses wait for the request updating the entry instead of calling the handler (0: disabled), default: 5000
+		sl_uint32 lockTimeout;
+		
+	public:
+		HttpResponseCacheRule();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(HttpResponseCacheRule)
+		
+	};
+	
+	class SLIB_EXPORT HttpResponseCacheParam
+	{
+	public:
+		sl_uint32 maximumEntriesCount; // default: 4096
+		sl_size maximumContentSize; // larger responses are not stored, default: 1MB
+		
+		sl_uint32 minimumGzipSize; // default: 256
+		sl_int32 gzipLevel; // default: 6
+		
+	public:
+		HttpResponseCacheParam();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(HttpResponseCacheParam)
+		
+	};
+	
+	class SLIB_EXPORT HttpResponseCacheStatistics
+	{
+	public:
+		sl_uint64 countHits;
+		sl_uint64 countStaleHits; // included in `countHits`
+		sl_uint64 countMisses;
+		sl_uint64 countCollapsed; // misses served by the response of the concurrent identical request, included in `countHits`
+		sl_uint64 countEvictions; // entries removed before going stale
+		sl_size countEntries;
+		
+	public:
+		HttpResponseCacheStatistics();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(HttpResponseCacheStatistics)
+		
+	};
+	
+	class SLIB_EXPORT HttpResponseCacheEntry : public Referable
+	{
+	public:
+		HttpStatus code;
+		List< Pair<String, String> > headers;
+		Memory content;
+		Memory contentGzip;
+		sl_uint64 timeStored;
+		sl_uint64 timeExpire;
+		sl_uint64 timeStale; // `timeExpire` + stale-while-revalidate
+		sl_bool flagValid; // false while the first response is pending
+		sl_bool flagUpdating;
+		Ref<Event> eventUpdated;
+		
+	public:
+		HttpResponseCacheEntry();
+		
+		~HttpResponseCacheEntry();
+		
+	};
+	
+	/*
+		Caches the fully serialized responses of the routes, keyed by method, path,
+		selected query parameters and `Vary` headers. Hits are written in the
+		pre-process phase, so neither the handler nor the serialization is invoked.
+		The responses are captured in the post-process phase; only `200 OK`
+		responses held in memory, without `Set-Cookie` and `no-store`/`private`
+		Cache-Control, are stored.
+	*/
+	class SLIB_EXPORT HttpResponseCache : public Object
+	{
+		SLIB_DECLARE_OBJECT
+		
+	protected:
+		HttpResponseCache();
+		
+		~HttpResponseCache();
+		
+	public:
+		static Ref<HttpResponseCache> create(const HttpResponseCacheParam& param);
+		
+		static Ref<HttpResponseCache> create();
+		
+	public:
+		/*
+			Wraps the pre/post routes of `path` in `router`: the handlers registered there before run first,
+			and the cache is consulted only when the pre-route handler did not respond (for example, authentication passed).
+			Handlers registered by `before`/`after` on the same path afterwards replace the cache, so call this last.
+		*/
+		void add(HttpServerRouter& router, HttpMethod method, const String& path, const HttpResponseCacheRule& rule);
+		
+		void GET(HttpServerRouter& router, const String& path, const HttpResponseCacheRule& rule);
+		
+		// removes the entries of `path` for every query and variant
+		void remove(HttpMethod method, const String& path);
+		
+		void removeAll();
+		
+		HttpResponseCacheStatistics getStatistics();
+		
+		// returns true if the response is written from the cache
+		sl_bool processRequest(HttpServerContext* context, const HttpResponseCacheRule& rule);
+		
+		void processResponse(HttpServerContext* context, const HttpResponseCacheRule& rule);
+		
+	protected:
+		String _getKey(HttpServerContext* context, const HttpResponseCacheRule& rule);
+		
+		void _writeResponse(HttpServerContext* context, const HttpResponseCacheRule& rule, HttpResponseCacheEntry* entry, sl_uint64 now);
+		
+		void _evict(sl_uint64 now);
+		
+	protected:
+		HttpResponseCacheParam m_param;
+		
+		Mutex m_lock;
+		CHashMap< String, Ref<HttpResponseCacheEntry> > m_entries;
+		CHashMap< HttpServerContext*, Pair< String, Ref<HttpResponseCacheEntry> > > m_mapUpdating; // requests updating the entries
+		HttpResponseCacheStatistics m_statistics;
+		TimeCounter m_timeCounter;
+		
+	};
+	
 	class SLIB_EXPORT HttpServerParam
 	{
 	public:
@@ -304,6 +456,19 @@ namespace slib
 		
 		sl_uint64 maxRequestHeadersSize;
 		sl_uint64 maxRequestBodySize;
+
+		/*
+			The files (and the ranges) up to this size are sent from the memory-mapped views
+			without copying, when the connection doesn't support sendfile (default: 0, disabled).
+			Don't enable this if the served files can be truncated while they are sent:
+			touching the pages beyond the new end of the file raises SIGBUS.
+		*/
+		sl_uint64 maxMappedFileSize;
+		
+		// Timeouts in milliseconds (0: disabled)
+		sl_uint32 idleTimeout; // waiting for a new request on an opened connection
+		sl_uint32 requestHeaderTimeout; // receiving the whole request header
+		sl_uint32 requestBodyTimeout; // between the reads of the request body
 		
 		sl_bool flagAllowCrossOrigin;
 		
@@ -32,6 +32,7 @@
 
 #include "../core/object.h"
 #include "../core/hash_map.h"
+#include "../core/timing_wheel.h"
 
 /*
 	If you are usiing kernel-mode NAT on linux (for example on port range 40000~60000), following configuration will avoid to conflict with kernel-networking.
@@ -48,7 +49,10 @@ namespace slib
 	public:
 		sl_bool flagActive;
 		SocketAddress addressSource;
-		Time timeLastAccess;
+		sl_uint64 timeLastAccess; // milliseconds on the clock of the shard's timing wheel
+		
+		// fires at least `timeout` after the last access (not copied: the entry of a copy is not scheduled)
+		TimingWheelEntry entryTimeout;
 		
 	public:
 		NatTablePort();
@@ -57,6 +61,26 @@ namespace slib
 		
 	};
 	
+	/*
+		Ports are interleaved over the shards (port index `k` belongs to shard `k % countShards`),
+		so that the shard of an incoming packet is known from its port, and the shard
+		of an outgoing packet is chosen by hashing its source address.
+	*/
+	class NatTableMappingShard
+	{
+	public:
+		Mutex lock;
+		CHashMap< SocketAddress, sl_uint16 > mapPorts;
+		TimingWheel timeouts;
+		sl_uint32 pos; // next port index in the shard
+		
+	public:
+		NatTableMappingShard();
+		
+		SLIB_DELETE_CLASS_DEFAULT_MEMBERS(NatTableMappingShard)
+		
+	};
+	
 	class NatTableMapping : public Object
 	{
 	public:
@@ -65,21 +89,29 @@ namespace slib
 		~NatTableMapping();
 		
 	public:
-		void setup(sl_uint16 portBegin, sl_uint16 portEnd);
+		// timeout: idle time in milliseconds before a port is released (0: kept until the ports are exhausted)
+		// not synchronized with the mapping functions: call before the mapping is used
+		void setup(sl_uint16 portBegin, sl_uint16 portEnd, sl_uint32 timeout = 0, sl_uint32 countShards = 1);
 		
 		sl_bool mapToExternalPort(const SocketAddress& address, sl_uint16& port);
 		
 		sl_bool mapToInternalAddress(sl_uint16 port, SocketAddress& address);
 		
 	protected:
-		CHashMap< SocketAddress, sl_uint16 > m_mapPorts;
+		void _free();
 		
+		void _onExpirePort(sl_uint32 index);
+		
+	protected:
 		NatTablePort* m_ports;
-		sl_uint16 m_nPorts;
-		sl_uint16 m_pos;
+		sl_uint32 m_nPorts;
+		
+		NatTableMappingShard* m_shards;
+		sl_uint32 m_nShards;
 		
 		sl_uint16 m_portBegin;
 		sl_uint16 m_portEnd;
+		sl_uint32 m_timeout;
 		
 	};
 	
@@ -96,6 +128,11 @@ namespace slib
 		
 		sl_uint16 icmpEchoIdentifier;
 		
+		sl_uint32 tcpPortTimeout; // in milliseconds, default: 7440000 (RFC 5382)
+		sl_uint32 udpPortTimeout; // in milliseconds, default: 300000 (RFC 4787)
+		
+		sl_uint32 shardsCount; // number of mapping shards, default: 0 (number of processors)
+		
 	public:
 		NatTableParam();
 		
@@ -115,9 +152,11 @@ namespace slib
 	public:
 		const NatTableParam& getParam() const;
 		
+		// reallocates the port mappings: call before any packet is translated, not concurrently with the translation
 		void setup(const NatTableParam& param);
 		
 	public:
+		// thread-safe: can be called concurrently from the capturing threads
 		sl_bool translateOutgoingPacket(IPv4Packet* ipHeader, void* ipContent, sl_uint32 sizeContent);
 		
 		sl_bool translateIncomingPacket(IPv4Packet* ipHeader, void* ipContent, sl_uint32 sizeContent);
@@ -131,6 +170,7 @@ namespace slib
 		
 		NatTableMapping m_mappingUdp;
 		
+		Mutex m_lockIcmpEcho;
 		sl_uint16 m_icmpEchoSequenceCurrent;
 		
 		struct IcmpEchoElement
@@ -65,6 +65,21 @@ namespace slib
 		
 	};
 	
+	// an element of the batched `sendTo`/`receiveFrom`
+	class SLIB_EXPORT SocketDatagram
+	{
+	public:
+		SocketAddress address;
+		void* data;
+		sl_uint32 size; // receiving: size of the buffer on input, size of the datagram on output
+		
+	public:
+		SocketDatagram();
+		
+		SLIB_DECLARE_CLASS_DEFAULT_MEMBERS(SocketDatagram)
+		
+	};
+	
 	enum class SocketType
 	{
 		None = 0,
@@ -222,6 +237,17 @@ namespace slib
 		
 		sl_int32 receiveFrom(SocketAddress& address, void* buf, sl_uint32 size);
 		
+		/*
+			Sends the datagrams with as few system calls as possible (sendmmsg on linux).
+			Consecutive datagrams of the same size to the same address are coalesced by UDP GSO when the kernel supports it.
+			Empty datagrams are not sent (as by `sendTo(address, buf, 0)`) on every platform, but are counted as sent.
+			Returns the number of the datagrams sent, 0 if the socket would block, or -1 on error.
+		*/
+		sl_int32 sendTo(const SocketDatagram* datagrams, sl_uint32 count);
+		
+		// Receives up to `count` datagrams (recvmmsg on linux). Returns the number of the datagrams received, 0 if there is no datagram, or -1 on error.
+		sl_int32 receiveFrom(SocketDatagram* datagrams, sl_uint32 count);
+		
 		sl_int32 sendPacket(const void* buf, sl_uint32 size, const L2PacketInfo& info);
 		
 		sl_int32 receivePacket(const void* buf, sl_uint32 size, L2PacketInfo& info);
@@ -133,8 +133,16 @@ namespace slib
 	public:
 		static sl_uint16 calculateOneComplementSum(const void* data, sl_size size, sl_uint32 add = 0);
 
+		// copies `size` bytes, and returns the same sum as `calculateOneComplementSum` over the copied bytes
+		static sl_uint16 copyAndCalculateOneComplementSum(void* dst, const void* src, sl_size size, sl_uint32 add = 0);
+
 		static sl_uint16 calculateChecksum(const void* data, sl_size size);
 
+		// incremental update of a checksum when a 16-bit field changes (RFC 1624)
+		static sl_uint16 adjustChecksum(sl_uint16 checksum, sl_uint16 valueOld, sl_uint16 valueNew);
+
+		static sl_uint16 adjustChecksum(sl_uint16 checksum, const IPv4Address& addressOld, const IPv4Address& addressNew);
+
 	};
 
 	class SLIB_EXPORT IPv4Packet
@@ -263,6 +271,11 @@ public:
 		static sl_bool checkHeader(const void* packet, sl_size sizePacket);
 		
 		static sl_bool checkHeaderSize(const void* packet, sl_size sizePacket);
+		
+		// validates the headers of `count` packets (`checkHeader`), and returns the number of valid ones. `outResults` is optional
+		static sl_size checkHeaders(const void* const* packets, const sl_size* sizes, sl_size count, sl_bool* outResults = sl_null);
+		
+		static void updateChecksums(IPv4Packet* const* packets, sl_size count);
 
 		sl_bool getPortsForTcpUdp(sl_uint16& src, sl_uint16& dst) const;
 
@@ -52,10 +52,11 @@ namespace slib
 		sl_bool processHttpRequest(HttpServerContext* context);
 		
 	protected:
-		static String _getHandlerSignature(HttpMethod method, const String& path);
+		CHashMap<String, WebHandler>* _getHandlers(HttpMethod method);
 		
 	protected:
-		CMap<String, WebHandler> m_handlers;
+		// handlers by path, indexed by method
+		CHashMap<String, WebHandler> m_handlers[(sl_uint32)(HttpMethod::PATCH) + 1];
 		
 		friend class WebModule;
 		
@@ -26,16 +26,57 @@
 #include "definition.h"
 
 #include "../core/json.h"
+#include "../core/memory.h"
 
 namespace slib
 {
 	
+	class HttpOutputBuffer;
+	
+	/*
+		Template parsed once into a flat instruction list.
+		The top-level variables are bound to slots at compile time, so each
+		of them is looked up once per rendering, and the text between the
+		tags is emitted by reference to the compiled source.
+	*/
+	class SLIB_EXPORT GingerTemplate : public Object
+	{
+		SLIB_DECLARE_OBJECT
+		
+	protected:
+		GingerTemplate();
+		
+		~GingerTemplate();
+		
+	public:
+		// returns null on syntax error
+		static Ref<GingerTemplate> compile(const String& source);
+		
+	public:
+		virtual void render(MemoryQueue& output, const Json& data) = 0;
+		
+		String render(const Json& data);
+		
+		void render(HttpOutputBuffer* output, const Json& data);
+		
+	};
+	
 	class SLIB_EXPORT Ginger
 	{
 	public:
+		// returns null (and logs the error) on syntax error
 		static String render(const String& _template, const Json& data);
 		
+		// returns null (and logs the error) when the file can not be read or compiled
 		static String renderFile(const String& filePath, const Json& data);
+		
+		// writes nothing (and logs the error) when the file can not be read or compiled
+		static void renderFile(HttpOutputBuffer* output, const String& filePath, const Json& data);
+		
+		// compiled templates are cached by path, and compiled again when the file is modified
+		static Ref<GingerTemplate> getCompiledFile(const String& filePath);
+		
+		static void clearCache();
 
 	};
 	
@@ -105,6 +105,8 @@ namespace slib
 		m_queueInstancesClosing.removeAll();
 		m_queueInstancesClosed.removeAll();
 		
+		m_timeouts.removeAll();
+		
 	}
 
 	void AsyncIoLoop::start()
@@ -127,12 +129,12 @@ namespace slib
 		return m_flagRunning;
 	}
 
-	sl_bool AsyncIoLoop::addTask(const Function<void()>& task)
+	sl_bool AsyncIoLoop::addTask(InlineFunction<void()>&& task)
 	{
 		if (task.isNull()) {
 			return sl_false;
 		}
-		if (m_queueTasks.push(task)) {
+		if (m_queueTasks.push(Move(task))) {
 			wake();
 			return sl_true;
 		}
@@ -141,7 +143,31 @@ namespace slib
 
 	sl_bool AsyncIoLoop::dispatch(const Function<void()>& callback, sl_uint64 delay_ms)
 	{
-		return addTask(callback);
+		if (delay_ms == 0) {
+			return addTask(callback);
+		}
+		if (m_timeouts.add(callback, delay_ms)) {
+			wake();
+			return sl_true;
+		}
+		return sl_false;
+	}
+
+	sl_bool AsyncIoLoop::addTimeout(TimingWheelEntry* entry, sl_uint64 delay_ms)
+	{
+		if (m_timeouts.add(entry, delay_ms)) {
+			// the loop thread recalculates its timeout before waiting
+			if (!(m_thread->isCurrentThread())) {
+				wake();
+			}
+			return sl_true;
+		}
+		return sl_false;
+	}
+
+	void AsyncIoLoop::removeTimeout(TimingWheelEntry* entry)
+	{
+		m_timeouts.remove(entry);
 	}
 
 	void AsyncIoLoop::wake()
@@ -182,18 +208,21 @@ namespace slib
 		if (m_handle) {
 			if (instance && instance->isOpened()) {
 				instance->addToQueue(m_queueInstancesOrder);
-				wake();
+				// the loop thread processes the orders before waiting
+				if (!(m_thread->isCurrentThread())) {
+					wake();
+				}
 			}
 		}
 	}
 
-	void AsyncIoLoop::_stepBegin()
+	sl_int32 AsyncIoLoop::_stepBegin()
 	{
 		// Async Tasks
 		{
-			LinkedQueue< Function<void()> > tasks;
+			LinkedQueue< InlineFunction<void()> > tasks;
 			tasks.merge(&m_queueTasks);
-			Function<void()> task;
+			InlineFunction<void()> task;
 			while (tasks.pop(&task)) {
 				task();
 			}
@@ -210,6 +239,15 @@ namespace slib
 				}
 			}
 		}
+		
+		// Timeouts
+		sl_int32 timeout = m_timeouts.process();
+		
+		// the orders requested by the loop thread during this step did not wake the loop
+		if (m_queueInstancesOrder.isNotEmpty()) {
+			return 0;
+		}
+		return timeout;
 	}
 
 	void AsyncIoLoop::_stepEnd()
@@ -384,10 +422,91 @@ namespace slib
 		m_ioInstance = instance;
 	}
 
+/*************************************
+		AsyncBufferPool
+**************************************/
+
+#define PRIV_BUFFER_POOL_MIN_SHIFT 10
+#define PRIV_BUFFER_POOL_CLASS_COUNT 7
+#define PRIV_BUFFER_POOL_MAX_BYTES_PER_CLASS 0x400000
+#define PRIV_BUFFER_POOL_MAX_COUNT_PER_CLASS 256
+
+	// free buffers are chained through their first bytes
+	static CMemory* _priv_AsyncBufferPool_first[PRIV_BUFFER_POOL_CLASS_COUNT] = { 0 };
+	static sl_uint32 _priv_AsyncBufferPool_count[PRIV_BUFFER_POOL_CLASS_COUNT] = { 0 };
+	static SpinLock _priv_AsyncBufferPool_lock[PRIV_BUFFER_POOL_CLASS_COUNT];
+
+	static sl_bool _priv_AsyncBufferPool_getClass(sl_size size, sl_uint32& index)
+	{
+		for (sl_uint32 i = 0; i < PRIV_BUFFER_POOL_CLASS_COUNT; i++) {
+			if (size <= ((sl_size)1 << (i + PRIV_BUFFER_POOL_MIN_SHIFT))) {
+				index = i;
+				return sl_true;
+			}
+		}
+		return sl_false;
+	}
+
+	Memory AsyncBufferPool::borrow(sl_size size)
+	{
+		sl_uint32 index;
+		if (!(_priv_AsyncBufferPool_getClass(size, index))) {
+			return Memory::create(size);
+		}
+		CMemory* mem;
+		{
+			SpinLocker lock(_priv_AsyncBufferPool_lock + index);
+			mem = _priv_AsyncBufferPool_first[index];
+			if (mem) {
+				_priv_AsyncBufferPool_first[index] = *((CMemory**)(mem->getData()));
+				_priv_AsyncBufferPool_count[index]--;
+			}
+		}
+		if (mem) {
+			Memory ret;
+			ret.ref = mem;
+			mem->decreaseReferenceNoFree();
+			return ret;
+		}
+		return Memory::create((sl_size)1 << (index + PRIV_BUFFER_POOL_MIN_SHIFT));
+	}
+
+	void AsyncBufferPool::release(Memory& _mem)
+	{
+		CMemory* mem = _mem.ref.get();
+		if (!mem) {
+			return;
+		}
+		sl_size size = mem->getCount();
+		sl_uint32 index;
+		if (mem->isStatic() || mem->getReferenceCount() != 1 || !(_priv_AsyncBufferPool_getClass(size, index)) || size != ((sl_size)1 << (index + PRIV_BUFFER_POOL_MIN_SHIFT))) {
+			_mem.setNull();
+			return;
+		}
+		{
+			SpinLocker lock(_priv_AsyncBufferPool_lock + index);
+			sl_uint32 n = _priv_AsyncBufferPool_count[index];
+			if (n < PRIV_BUFFER_POOL_MAX_COUNT_PER_CLASS && (n + 1) * size <= PRIV_BUFFER_POOL_MAX_BYTES_PER_CLASS) {
+				mem->increaseReference();
+				*((CMemory**)(mem->getData())) = _priv_AsyncBufferPool_first[index];
+				_priv_AsyncBufferPool_first[index] = mem;
+				_priv_AsyncBufferPool_count[index] = n + 1;
+			}
+		}
+		_mem.setNull();
+	}
+
 /*************************************
 		AsyncStreamInstance
 **************************************/
 
+#define PRIV_STREAM_REQUEST_FREE_LIST_MAX 1024
+
+	// free storages of the requests are chained through their first bytes
+	static void* _priv_AsyncStreamRequest_freeList = sl_null;
+	static sl_uint32 _priv_AsyncStreamRequest_countFree = 0;
+	static SpinLock _priv_AsyncStreamRequest_lockFree;
+
 	SLIB_DEFINE_ROOT_OBJECT(AsyncStreamRequest)
 
 	AsyncStreamRequest::AsyncStreamRequest(
@@ -396,7 +515,7 @@ namespace slib
 		Referable* _userObject,
 		const Function<void(AsyncStreamResult&)>& _callback,
 		sl_bool _flagRead)
-	 : data((void*)_data), size(_size), userObject(_userObject), callback(_callback), flagRead(_flagRead)
+	 : data((void*)_data), size(_size), userObject(_userObject), callback(_callback), flagRead(_flagRead), flagBorrowBuffer(sl_false)
 	{
 	}
 	
@@ -422,6 +541,18 @@ namespace slib
 		return new AsyncStreamRequest(data, size, userObject, callback, sl_false);
 	}
 
+	Ref<AsyncStreamRequest> AsyncStreamRequest::createPooledRead(
+		sl_uint32 size,
+		Referable* userObject,
+		const Function<void(AsyncStreamResult&)>& callback)
+	{
+		Ref<AsyncStreamRequest> ret = new AsyncStreamRequest(sl_null, size, userObject, callback, sl_true);
+		if (ret.isNotNull()) {
+			ret->flagBorrowBuffer = sl_true;
+		}
+		return ret;
+	}
+
 	void AsyncStreamRequest::runCallback(AsyncStream* stream, sl_uint32 resultSize, sl_bool flagError)
 	{
 		if (callback.isNotNull()) {
@@ -436,6 +567,34 @@ namespace slib
 		}
 	}
 
+	void* AsyncStreamRequest::operator new(sl_size_t size)
+	{
+		if (size == sizeof(AsyncStreamRequest)) {
+			SpinLocker lock(&_priv_AsyncStreamRequest_lockFree);
+			void* ptr = _priv_AsyncStreamRequest_freeList;
+			if (ptr) {
+				_priv_AsyncStreamRequest_freeList = *((void**)ptr);
+				_priv_AsyncStreamRequest_countFree--;
+				return ptr;
+			}
+		}
+		return ::operator new(size);
+	}
+
+	void AsyncStreamRequest::operator delete(void* ptr, sl_size_t size)
+	{
+		if (size == sizeof(AsyncStreamRequest)) {
+			SpinLocker lock(&_priv_AsyncStreamRequest_lockFree);
+			if (_priv_AsyncStreamRequest_countFree < PRIV_STREAM_REQUEST_FREE_LIST_MAX) {
+				*((void**)ptr) = _priv_AsyncStreamRequest_freeList;
+				_priv_AsyncStreamRequest_freeList = ptr;
+				_priv_AsyncStreamRequest_countFree++;
+				return;
+			}
+		}
+		::operator delete(ptr);
+	}
+
 	SLIB_DEFINE_OBJECT(AsyncStreamInstance, AsyncIoInstance)
 
 	AsyncStreamInstance::AsyncStreamInstance()
@@ -594,6 +753,47 @@ namespace slib
 		return write(mem.getData(), (sl_uint32)(size), callback, mem.ref.get());
 	}
 
+	class _priv_AsyncStream_PooledRead : public Referable
+	{
+	public:
+		Memory mem;
+		Function<void(AsyncStreamResult&)> callback;
+
+	public:
+		void onRead(AsyncStreamResult& result)
+		{
+			callback(result);
+			AsyncBufferPool::release(mem);
+		}
+
+	};
+
+	sl_bool AsyncStream::readPooled(sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject)
+	{
+		// streams which can't wait for the readiness hold the buffer until the read is completed
+		Ref<_priv_AsyncStream_PooledRead> pooled = new _priv_AsyncStream_PooledRead;
+		if (pooled.isNull()) {
+			return sl_false;
+		}
+		pooled->mem = AsyncBufferPool::borrow(size);
+		void* data = pooled->mem.getData();
+		if (!data) {
+			return sl_false;
+		}
+		pooled->callback = callback;
+		return read(data, size, SLIB_FUNCTION_REF(_priv_AsyncStream_PooledRead, onRead, pooled), userObject);
+	}
+
+	sl_bool AsyncStream::isSendFileSupported()
+	{
+		return sl_false;
+	}
+
+	sl_bool AsyncStream::sendFile(const Ref<File>& file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject)
+	{
+		return sl_false;
+	}
+
 /*************************************
 		AsyncStreamBase
 **************************************/
@@ -1634,6 +1834,21 @@ namespace slib
 		return m_lengthOutput;
 	}
 
+	sl_bool AsyncOutputBuffer::mergeOutput(Memory& _out) const
+	{
+		ObjectLocker lock(this);
+		Link< Ref<AsyncOutputBufferElement> >* link = m_queueOutput.getFront();
+		if (!link) {
+			_out.setNull();
+			return sl_true;
+		}
+		if (link->next || !(link->value->isEmptyBody())) {
+			return sl_false;
+		}
+		_out = link->value->getHeader().merge();
+		return sl_true;
+	}
+
 /**********************************************
 				AsyncOutput
 **********************************************/
@@ -1655,6 +1870,9 @@ namespace slib
 
 		m_bufferCount = 1;
 		m_bufferSize = 0x10000;
+
+		m_offsetSending = 0;
+		m_sizeSending = 0;
 	}
 
 	AsyncOutput::~AsyncOutput()
@@ -1674,6 +1892,7 @@ namespace slib
 			copy->close();
 		}
 		m_copy.setNull();
+		m_fileSending.setNull();
 		m_streamOutput.setNull();
 	}
 
@@ -1750,6 +1969,20 @@ namespace slib
 			if (sizeBody != 0 && body.isNotNull()) {
 				m_flagWriting = sl_true;
 				m_elementWriting.setNull();
+				if (IsInstanceOf<AsyncFile>(body) && m_streamOutput->isSendFileSupported()) {
+					Ref<File> file = ((AsyncFile*)(body.get()))->getFile();
+					if (file.isNotNull()) {
+						m_fileSending = file;
+						m_offsetSending = file->getPosition();
+						m_sizeSending = sizeBody;
+						if (!(_sendFile())) {
+							m_fileSending.setNull();
+							m_flagWriting = sl_false;
+							_onError();
+						}
+						return;
+					}
+				}
 				AsyncCopyParam param;
 				param.source = body;
 				param.target = m_streamOutput;
@@ -1778,6 +2011,42 @@ namespace slib
 		}
 	}
 
+	sl_bool AsyncOutput::_sendFile()
+	{
+		sl_uint64 size = m_sizeSending;
+		if (size > 0x1000000) {
+			size = 0x1000000;
+		}
+		return m_streamOutput->sendFile(m_fileSending, m_offsetSending, (sl_uint32)size, SLIB_FUNCTION_WEAKREF(AsyncOutput, onSendFile, this));
+	}
+
+	void AsyncOutput::onSendFile(AsyncStreamResult& result)
+	{
+		ObjectLocker lock(this);
+		if (m_flagClosed) {
+			return;
+		}
+		if (result.flagError || result.size != result.requestSize) {
+			m_fileSending.setNull();
+			m_flagWriting = sl_false;
+			_onError();
+			return;
+		}
+		m_offsetSending += result.size;
+		m_sizeSending -= result.size;
+		if (m_sizeSending > 0) {
+			if (!(_sendFile())) {
+				m_fileSending.setNull();
+				m_flagWriting = sl_false;
+				_onError();
+			}
+			return;
+		}
+		m_fileSending.setNull();
+		m_flagWriting = sl_false;
+		_write(sl_true);
+	}
+
 	void AsyncOutput::onWriteStream(AsyncStreamResult& result)
 	{
 		m_flagWriting = sl_false;
@@ -90,9 +90,9 @@ namespace slib
 
 		while (m_flagRunning) {
 
-			_stepBegin();
+			sl_int32 timeout = _stepBegin();
 
-			int nEvents = ::epoll_wait(handle->fdEpoll, waitEvents, ASYNC_MAX_WAIT_EVENT, -1);
+			int nEvents = ::epoll_wait(handle->fdEpoll, waitEvents, ASYNC_MAX_WAIT_EVENT, timeout);
 			if (nEvents == 0) {
 				m_queueInstancesClosed.removeAll();
 			}
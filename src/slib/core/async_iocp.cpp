@@ -67,6 +67,9 @@ namespace slib
 		BOOL fAlertable
 	)
 	{
+		// nothing is dequeued when the wait times out
+		lpCompletionPortEntries[0].lpCompletionKey = 0;
+		lpCompletionPortEntries[0].lpOverlapped = NULL;
 		::GetQueuedCompletionStatus(CompletionPort
 			, &(lpCompletionPortEntries[0].dwNumberOfBytesTransferred)
 			, &(lpCompletionPortEntries[0].lpCompletionKey)
@@ -93,11 +96,11 @@ namespace slib
 
 		while (m_flagRunning) {
 
-			_stepBegin();
+			sl_int32 timeout = _stepBegin();
 
 			DWORD nCount = 0;
 			
-			if (!fGetQueuedCompletionStatusEx(handle->hCompletionPort, entries, ASYNC_MAX_WAIT_EVENT, &nCount, INFINITE, FALSE)) {
+			if (!fGetQueuedCompletionStatusEx(handle->hCompletionPort, entries, ASYNC_MAX_WAIT_EVENT, &nCount, timeout < 0 ? INFINITE : (DWORD)timeout, FALSE)) {
 				nCount = 0;
 			}
 			if (nCount == 0) {
@@ -21,9 +21,11 @@
  */
 
 #include "slib/core/base.h"
+#include "slib/core/memory_allocator.h"
 
 #include "slib/core/system.h"
 #include "slib/core/math.h"
+#include "slib/core/spin_lock.h"
 
 #if !defined(SLIB_PLATFORM_IS_APPLE)
 #include <malloc.h>
@@ -39,6 +41,7 @@
 
 #ifdef SLIB_PLATFORM_IS_WINDOWS
 #	include "slib/core/platform_windows.h"
+#	include <atomic>
 #endif
 
 #if defined(SLIB_ARCH_IS_32BIT)
@@ -59,21 +62,154 @@ namespace slib
 	typedef char32_t _base_char32;
 #endif
 
+/***********************************************************************
+						Memory Allocation
+***********************************************************************/
+
+#if defined(SLIB_ARCH_IS_64BIT)
+#	define CHUNK_MAP_ADDRESS_BITS 48
+#else
+#	define CHUNK_MAP_ADDRESS_BITS 32
+#endif
+#define CHUNK_MAP_INDEX_BITS (CHUNK_MAP_ADDRESS_BITS - SLIB_MEMORY_CHUNK_SIZE_BITS)
+#define CHUNK_MAP_LEAF_BITS (CHUNK_MAP_INDEX_BITS / 2)
+#define CHUNK_MAP_ROOT_BITS (CHUNK_MAP_INDEX_BITS - CHUNK_MAP_LEAF_BITS)
+#define CHUNK_MAP_LEAF_SIZE ((sl_size)1 << CHUNK_MAP_LEAF_BITS)
+
+	struct _priv_MemoryChunkEntry
+	{
+		MemoryAllocator* allocator;
+		sl_uint32 param;
+	};
+
+	// two-level map of the chunks owned by the allocators, indexed by address
+	static _priv_MemoryChunkEntry* _g_priv_memory_chunkMap[(sl_size)1 << CHUNK_MAP_ROOT_BITS] = { 0 };
+
+	struct _priv_MemoryThreadContext
+	{
+		MemoryAllocator* allocator;
+		MemoryTag* tag;
+	};
+
+	static SLIB_THREAD _priv_MemoryThreadContext _gt_priv_memory_context = { sl_null, sl_null };
+
+	static MemoryAllocator* _g_priv_memory_allocatorDefault = sl_null;
+
+	// plain acquire load, the leaves are published by compare-exchange
+	SLIB_INLINE static _priv_MemoryChunkEntry* _priv_MemoryChunkMap_loadLeaf(void** pLeaf) noexcept
+	{
+#if defined(SLIB_PLATFORM_IS_WINDOWS)
+		return (_priv_MemoryChunkEntry*)(((std::atomic<void*>*)pLeaf)->load(std::memory_order_acquire));
+#else
+		return (_priv_MemoryChunkEntry*)(__atomic_load_n(pLeaf, __ATOMIC_ACQUIRE));
+#endif
+	}
+
+	SLIB_INLINE static _priv_MemoryChunkEntry* _priv_MemoryChunkMap_find(const void* ptr) noexcept
+	{
+		sl_size index = ((sl_size)ptr) >> SLIB_MEMORY_CHUNK_SIZE_BITS;
+#if defined(SLIB_ARCH_IS_64BIT)
+		if (index >> CHUNK_MAP_INDEX_BITS) {
+			return sl_null;
+		}
+#endif
+		_priv_MemoryChunkEntry* leaf = _priv_MemoryChunkMap_loadLeaf((void**)(_g_priv_memory_chunkMap + (index >> CHUNK_MAP_LEAF_BITS)));
+		if (leaf) {
+			_priv_MemoryChunkEntry* entry = leaf + (index & (CHUNK_MAP_LEAF_SIZE - 1));
+			if (entry->allocator) {
+				return entry;
+			}
+		}
+		return sl_null;
+	}
+
+	static sl_bool _priv_MemoryChunkMap_register(void* chunk, sl_size size, MemoryAllocator* allocator, sl_uint32 param) noexcept
+	{
+		sl_size indexStart = ((sl_size)chunk) >> SLIB_MEMORY_CHUNK_SIZE_BITS;
+		sl_size indexEnd = indexStart + (size >> SLIB_MEMORY_CHUNK_SIZE_BITS);
+#if defined(SLIB_ARCH_IS_64BIT)
+		if (indexEnd > ((sl_size)1 << CHUNK_MAP_INDEX_BITS)) {
+			return sl_false;
+		}
+#endif
+		for (sl_size index = indexStart; index < indexEnd; index++) {
+			void** pLeaf = (void**)(_g_priv_memory_chunkMap + (index >> CHUNK_MAP_LEAF_BITS));
+			_priv_MemoryChunkEntry* leaf = _priv_MemoryChunkMap_loadLeaf(pLeaf);
+			if (!leaf) {
+				leaf = (_priv_MemoryChunkEntry*)(::calloc(CHUNK_MAP_LEAF_SIZE, sizeof(_priv_MemoryChunkEntry)));
+				if (!leaf) {
+					return sl_false;
+				}
+				if (!(Base::interlockedCompareExchangePtr(pLeaf, leaf, sl_null))) {
+					::free(leaf);
+					leaf = _priv_MemoryChunkMap_loadLeaf(pLeaf);
+				}
+			}
+			_priv_MemoryChunkEntry* entry = leaf + (index & (CHUNK_MAP_LEAF_SIZE - 1));
+			entry->param = param;
+			Base::interlockedCompareExchangePtr((void**)&(entry->allocator), allocator, sl_null);
+		}
+		return sl_true;
+	}
+
+	static void _priv_MemoryChunkMap_unregister(void* chunk, sl_size size) noexcept
+	{
+		sl_size indexStart = ((sl_size)chunk) >> SLIB_MEMORY_CHUNK_SIZE_BITS;
+		sl_size indexEnd = indexStart + (size >> SLIB_MEMORY_CHUNK_SIZE_BITS);
+		for (sl_size index = indexStart; index < indexEnd; index++) {
+			_priv_MemoryChunkEntry* leaf = _g_priv_memory_chunkMap[index >> CHUNK_MAP_LEAF_BITS];
+			if (leaf) {
+				_priv_MemoryChunkEntry* entry = leaf + (index & (CHUNK_MAP_LEAF_SIZE - 1));
+				Base::interlockedCompareExchangePtr((void**)&(entry->allocator), sl_null, entry->allocator);
+			}
+		}
+	}
+
 	void* Base::createMemory(sl_size size) noexcept
 	{
-		return ::malloc(size);
+		_priv_MemoryThreadContext& context = _gt_priv_memory_context;
+		if (context.tag) {
+			context.tag->_addAllocation(size);
+		}
+		MemoryAllocator* allocator = context.allocator;
+		if (!allocator) {
+			allocator = _g_priv_memory_allocatorDefault;
+			if (!allocator) {
+				return ::malloc(size);
+			}
+		}
+		return allocator->allocate(size);
 	}
 
 	void Base::freeMemory(void* ptr) noexcept
 	{
-		::free(ptr);
+		if (!ptr) {
+			return;
+		}
+		_priv_MemoryChunkEntry* entry = _priv_MemoryChunkMap_find(ptr);
+		if (entry) {
+			entry->allocator->free(ptr);
+		} else {
+			::free(ptr);
+		}
 	}
 
 	void* Base::reallocMemory(void* ptr, sl_size sizeNew) noexcept
 	{
+		if (!ptr) {
+			return createMemory(sizeNew);
+		}
 		if (sizeNew == 0) {
-			::free(ptr);
-			return ::malloc(1);
+			freeMemory(ptr);
+			return createMemory(1);
+		}
+		MemoryTag* tag = _gt_priv_memory_context.tag;
+		if (tag) {
+			tag->_addReallocation();
+		}
+		_priv_MemoryChunkEntry* entry = _priv_MemoryChunkMap_find(ptr);
+		if (entry) {
+			return entry->allocator->reallocate(ptr, sizeNew);
 		} else {
 			return ::realloc(ptr, sizeNew);
 		}
@@ -81,13 +217,522 @@ namespace slib
 
 	void* Base::createZeroMemory(sl_size size) noexcept
 	{
-		void* ptr = ::malloc(size);
+		void* ptr = createMemory(size);
 		if (ptr) {
 			::memset(ptr, 0, size);
 		}
 		return ptr;
 	}
 
+
+	MemoryAllocator::MemoryAllocator() noexcept
+	{
+	}
+
+	MemoryAllocator::~MemoryAllocator() noexcept
+	{
+	}
+
+	MemoryAllocator* MemoryAllocator::getDefault() noexcept
+	{
+		return _g_priv_memory_allocatorDefault;
+	}
+
+	void MemoryAllocator::setDefault(MemoryAllocator* allocator) noexcept
+	{
+		_g_priv_memory_allocatorDefault = allocator;
+	}
+
+	MemoryAllocator* MemoryAllocator::getCurrent() noexcept
+	{
+		MemoryAllocator* allocator = _gt_priv_memory_context.allocator;
+		if (allocator) {
+			return allocator;
+		}
+		return _g_priv_memory_allocatorDefault;
+	}
+
+	MemoryAllocator* MemoryAllocator::getOwner(const void* ptr, sl_uint32* outChunkParam) noexcept
+	{
+		_priv_MemoryChunkEntry* entry = _priv_MemoryChunkMap_find(ptr);
+		if (entry) {
+			if (outChunkParam) {
+				*outChunkParam = entry->param;
+			}
+			return entry->allocator;
+		}
+		return sl_null;
+	}
+
+	void* MemoryAllocator::allocateChunk(sl_size size, sl_uint32 param) noexcept
+	{
+		size = (size + SLIB_MEMORY_CHUNK_SIZE - 1) & ~((sl_size)(SLIB_MEMORY_CHUNK_SIZE - 1));
+		if (!size) {
+			return sl_null;
+		}
+		void* chunk;
+#if defined(SLIB_PLATFORM_IS_WINDOWS)
+		chunk = ::_aligned_malloc(size, SLIB_MEMORY_CHUNK_SIZE);
+#else
+		if (::posix_memalign(&chunk, SLIB_MEMORY_CHUNK_SIZE, size)) {
+			chunk = sl_null;
+		}
+#endif
+		if (!chunk) {
+			return sl_null;
+		}
+		if (_priv_MemoryChunkMap_register(chunk, size, this, param)) {
+			return chunk;
+		}
+		_priv_MemoryChunkMap_unregister(chunk, size);
+#if defined(SLIB_PLATFORM_IS_WINDOWS)
+		::_aligned_free(chunk);
+#else
+		::free(chunk);
+#endif
+		return sl_null;
+	}
+
+	void MemoryAllocator::freeChunk(void* chunk, sl_size size) noexcept
+	{
+		if (!chunk) {
+			return;
+		}
+		size = (size + SLIB_MEMORY_CHUNK_SIZE - 1) & ~((sl_size)(SLIB_MEMORY_CHUNK_SIZE - 1));
+		_priv_MemoryChunkMap_unregister(chunk, size);
+#if defined(SLIB_PLATFORM_IS_WINDOWS)
+		::_aligned_free(chunk);
+#else
+		::free(chunk);
+#endif
+	}
+
+
+#define MEMORY_POOL_CLASSES_COUNT 28
+#define MEMORY_POOL_MAX_SIZE 4096
+
+	static const sl_uint32 _g_priv_memory_pool_sizes[MEMORY_POOL_CLASSES_COUNT] = {
+		16, 32, 48, 64, 80, 96, 112, 128,
+		160, 192, 224, 256,
+		320, 384, 448, 512,
+		640, 768, 896, 1024,
+		1280, 1536, 1792, 2048,
+		2560, 3072, 3584, 4096
+	};
+
+	SLIB_INLINE static sl_uint32 _priv_MemoryPool_getClass(sl_size size) noexcept
+	{
+		if (size <= 128) {
+			return size ? (sl_uint32)((size - 1) >> 4) : 0;
+		}
+		sl_uint32 index = 8;
+		while (_g_priv_memory_pool_sizes[index] < size) {
+			index++;
+		}
+		return index;
+	}
+
+	SLIB_INLINE static sl_uint32 _priv_MemoryPool_getBatchCount(sl_uint32 index) noexcept
+	{
+		sl_uint32 n = 16384 / _g_priv_memory_pool_sizes[index];
+		if (n < 4) {
+			return 4;
+		}
+		if (n > 64) {
+			return 64;
+		}
+		return n;
+	}
+
+	struct _priv_MemoryPoolClass
+	{
+		SpinLock lock;
+		void* listFree;
+		sl_uint8* current;
+		sl_uint8* end;
+	};
+
+	static _priv_MemoryPoolClass _g_priv_memory_pool_classes[MEMORY_POOL_CLASSES_COUNT];
+
+	// moves `count` blocks of the list to the central list
+	static void _priv_MemoryPool_release(sl_uint32 index, void* list, sl_uint32 count) noexcept
+	{
+		if (!list) {
+			return;
+		}
+		void* last = list;
+		for (sl_uint32 i = 1; i < count && *((void**)last); i++) {
+			last = *((void**)last);
+		}
+		_priv_MemoryPoolClass& c = _g_priv_memory_pool_classes[index];
+		SpinLocker lock(&(c.lock));
+		*((void**)last) = c.listFree;
+		c.listFree = list;
+	}
+
+	// zero-initialized per thread
+	class _priv_MemoryPoolCache
+	{
+	public:
+		void* lists[MEMORY_POOL_CLASSES_COUNT];
+		sl_uint32 counts[MEMORY_POOL_CLASSES_COUNT];
+		sl_bool flagDestroyed;
+
+	public:
+		~_priv_MemoryPoolCache() noexcept
+		{
+			flagDestroyed = sl_true;
+			for (sl_uint32 i = 0; i < MEMORY_POOL_CLASSES_COUNT; i++) {
+				_priv_MemoryPool_release(i, lists[i], counts[i]);
+				lists[i] = sl_null;
+				counts[i] = 0;
+			}
+		}
+
+	};
+
+	static SLIB_THREAD _priv_MemoryPoolCache _gt_priv_memory_poolCache;
+
+	class _priv_MemoryPool : public MemoryAllocator
+	{
+	public:
+		void* allocate(sl_size size) noexcept override
+		{
+			if (size > MEMORY_POOL_MAX_SIZE) {
+				return ::malloc(size);
+			}
+			sl_uint32 index = _priv_MemoryPool_getClass(size);
+			_priv_MemoryPoolCache& cache = _gt_priv_memory_poolCache;
+			void* ret = cache.lists[index];
+			if (ret) {
+				cache.lists[index] = *((void**)ret);
+				cache.counts[index]--;
+				return ret;
+			}
+			ret = _fetch(index, cache);
+			if (ret) {
+				return ret;
+			}
+			return ::malloc(size);
+		}
+
+		void* reallocate(void* ptr, sl_size sizeNew) noexcept override
+		{
+			sl_uint32 index = 0;
+			getOwner(ptr, &index);
+			sl_size sizeOld = _g_priv_memory_pool_sizes[index];
+			if (sizeNew <= sizeOld) {
+				return ptr;
+			}
+			void* ret = allocate(sizeNew);
+			if (ret) {
+				Base::copyMemory(ret, ptr, sizeOld);
+				free(ptr);
+			}
+			return ret;
+		}
+
+		void free(void* ptr) noexcept override
+		{
+			sl_uint32 index = 0;
+			getOwner(ptr, &index);
+			_priv_MemoryPoolCache& cache = _gt_priv_memory_poolCache;
+			if (cache.flagDestroyed) {
+				*((void**)ptr) = sl_null;
+				_priv_MemoryPool_release(index, ptr, 1);
+				return;
+			}
+			*((void**)ptr) = cache.lists[index];
+			cache.lists[index] = ptr;
+			cache.counts[index]++;
+			sl_uint32 nBatch = _priv_MemoryPool_getBatchCount(index);
+			if (cache.counts[index] > nBatch * 2) {
+				// returns the blocks following the first `nBatch` blocks
+				void* last = ptr;
+				for (sl_uint32 i = 1; i < nBatch; i++) {
+					last = *((void**)last);
+				}
+				void* list = *((void**)last);
+				*((void**)last) = sl_null;
+				_priv_MemoryPool_release(index, list, cache.counts[index] - nBatch);
+				cache.counts[index] = nBatch;
+			}
+		}
+
+	protected:
+		// moves a batch of blocks from the central list (or a new chunk) to the thread cache, and returns one of them
+		void* _fetch(sl_uint32 index, _priv_MemoryPoolCache& cache) noexcept
+		{
+			sl_uint32 nBatch = _priv_MemoryPool_getBatchCount(index);
+			sl_size sizeBlock = _g_priv_memory_pool_sizes[index];
+			_priv_MemoryPoolClass& c = _g_priv_memory_pool_classes[index];
+			void* list = sl_null;
+			sl_uint32 n = 0;
+			SpinLocker lock(&(c.lock));
+			while (n < nBatch && c.listFree) {
+				void* block = c.listFree;
+				c.listFree = *((void**)block);
+				*((void**)block) = list;
+				list = block;
+				n++;
+			}
+			while (n < nBatch) {
+				if (c.current + sizeBlock > c.end) {
+					sl_uint8* chunk = (sl_uint8*)(allocateChunk(SLIB_MEMORY_CHUNK_SIZE, index));
+					if (!chunk) {
+						break;
+					}
+					c.current = chunk;
+					c.end = chunk + SLIB_MEMORY_CHUNK_SIZE;
+				}
+				void* block = c.current;
+				c.current += sizeBlock;
+				*((void**)block) = list;
+				list = block;
+				n++;
+			}
+			lock.unlock();
+			if (!list) {
+				return sl_null;
+			}
+			if (cache.flagDestroyed) {
+				_priv_MemoryPool_release(index, *((void**)list), n - 1);
+				return list;
+			}
+			cache.lists[index] = *((void**)list);
+			cache.counts[index] = n - 1;
+			return list;
+		}
+
+	};
+
+	MemoryAllocator* MemoryAllocator::getPool() noexcept
+	{
+		// never destroyed: the blocks may be freed while the static objects are destructing
+		static _priv_MemoryPool* pool = new _priv_MemoryPool;
+		return pool;
+	}
+
+
+	MemoryArena::MemoryArena(sl_size chunkSize) noexcept
+	{
+		m_chunkSize = (chunkSize + SLIB_MEMORY_CHUNK_SIZE - 1) & ~((sl_size)(SLIB_MEMORY_CHUNK_SIZE - 1));
+		if (!m_chunkSize) {
+			m_chunkSize = SLIB_MEMORY_CHUNK_SIZE;
+		}
+		m_chunks = sl_null;
+		m_current = sl_null;
+		m_end = sl_null;
+		m_sizeUsed = 0;
+		m_sizeReserved = 0;
+	}
+
+	MemoryArena::~MemoryArena() noexcept
+	{
+		reset();
+	}
+
+	void* MemoryArena::allocate(sl_size size) noexcept
+	{
+		// every block is preceded by its capacity, padded to keep 16-byte alignment
+		size = (size + 15) & ~((sl_size)15);
+		if (!size) {
+			size = 16;
+		}
+		sl_size sizeBlock = size + 16;
+		SpinLocker lock(&m_lock);
+		if (m_current + sizeBlock > m_end) {
+			sl_size sizeChunk = sizeBlock + 16;
+			sl_bool flagDedicated = sizeChunk > (m_chunkSize >> 2);
+			if (!flagDedicated) {
+				sizeChunk = m_chunkSize;
+			}
+			Chunk* chunk = (Chunk*)(allocateChunk(sizeChunk));
+			if (!chunk) {
+				return sl_null;
+			}
+			sizeChunk = (sizeChunk + SLIB_MEMORY_CHUNK_SIZE - 1) & ~((sl_size)(SLIB_MEMORY_CHUNK_SIZE - 1));
+			chunk->next = m_chunks;
+			chunk->size = sizeChunk;
+			m_chunks = chunk;
+			m_sizeReserved += sizeChunk;
+			sl_uint8* start = (sl_uint8*)chunk + 16;
+			if (flagDedicated) {
+				// keeps the current chunk for the following small blocks, and gives the rest of the chunk to this block
+				*((sl_size*)start) = sizeChunk - 32;
+				m_sizeUsed += sizeBlock;
+				return start + 16;
+			}
+			m_current = start;
+			m_end = (sl_uint8*)chunk + sizeChunk;
+		}
+		sl_uint8* block = m_current;
+		*((sl_size*)block) = size;
+		m_current += sizeBlock;
+		m_sizeUsed += sizeBlock;
+		return block + 16;
+	}
+
+	void* MemoryArena::reallocate(void* ptr, sl_size sizeNew) noexcept
+	{
+		sl_uint8* p = (sl_uint8*)ptr;
+		sl_size* pCapacity = (sl_size*)(p - 16);
+		sl_size capacity = *pCapacity;
+		if (sizeNew <= capacity) {
+			return ptr;
+		}
+		{
+			SpinLocker lock(&m_lock);
+			if (p + capacity == m_current) {
+				// grows the last block in place
+				sl_size size = (sizeNew + 15) & ~((sl_size)15);
+				if (p + size <= m_end) {
+					m_sizeUsed += size - capacity;
+					m_current = p + size;
+					*pCapacity = size;
+					return ptr;
+				}
+			}
+		}
+		// grows geometrically, the abandoned blocks are released at once by `reset()`
+		sl_size sizeAlloc = capacity << 1;
+		if (sizeAlloc < sizeNew) {
+			sizeAlloc = sizeNew;
+		}
+		void* ret = allocate(sizeAlloc);
+		if (ret) {
+			Base::copyMemory(ret, ptr, capacity);
+		}
+		return ret;
+	}
+
+	void MemoryArena::free(void* ptr) noexcept
+	{
+	}
+
+	void MemoryArena::reset() noexcept
+	{
+		SpinLocker lock(&m_lock);
+		Chunk* chunk = m_chunks;
+		while (chunk) {
+			Chunk* next = chunk->next;
+			freeChunk(chunk, chunk->size);
+			chunk = next;
+		}
+		m_chunks = sl_null;
+		m_current = sl_null;
+		m_end = sl_null;
+		m_sizeUsed = 0;
+		m_sizeReserved = 0;
+	}
+
+	sl_size MemoryArena::getUsedSize() noexcept
+	{
+		return m_sizeUsed;
+	}
+
+	sl_size MemoryArena::getReservedSize() noexcept
+	{
+		return m_sizeReserved;
+	}
+
+
+	static MemoryTag* _g_priv_memory_tags[SLIB_MEMORY_TAGS_MAX] = { 0 };
+	static sl_int32 _g_priv_memory_tagsCount = 0;
+
+	MemoryTag::MemoryTag(const char* name) noexcept
+	{
+		m_name = name;
+		m_countAllocations = 0;
+		m_sizeAllocated = 0;
+		m_countReallocations = 0;
+		sl_int32 index = Base::interlockedIncrement32(&_g_priv_memory_tagsCount) - 1;
+		if (index < SLIB_MEMORY_TAGS_MAX) {
+			_g_priv_memory_tags[index] = this;
+		}
+	}
+
+	const char* MemoryTag::getName() const noexcept
+	{
+		return m_name;
+	}
+
+	sl_uint64 MemoryTag::getAllocationsCount() const noexcept
+	{
+		return m_countAllocations;
+	}
+
+	sl_uint64 MemoryTag::getAllocatedSize() const noexcept
+	{
+		return m_sizeAllocated;
+	}
+
+	sl_uint64 MemoryTag::getReallocationsCount() const noexcept
+	{
+		return m_countReallocations;
+	}
+
+	void MemoryTag::resetStatistics() noexcept
+	{
+		m_countAllocations = 0;
+		m_sizeAllocated = 0;
+		m_countReallocations = 0;
+	}
+
+	sl_uint32 MemoryTag::getTagsCount() noexcept
+	{
+		sl_int32 n = _g_priv_memory_tagsCount;
+		if (n > SLIB_MEMORY_TAGS_MAX) {
+			return SLIB_MEMORY_TAGS_MAX;
+		}
+		return n;
+	}
+
+	MemoryTag* MemoryTag::getTag(sl_uint32 index) noexcept
+	{
+		if (index < getTagsCount()) {
+			return _g_priv_memory_tags[index];
+		}
+		return sl_null;
+	}
+
+	void MemoryTag::_addAllocation(sl_size size) noexcept
+	{
+		Base::interlockedIncrement64(&m_countAllocations);
+		Base::interlockedAdd64(&m_sizeAllocated, size);
+	}
+
+	void MemoryTag::_addReallocation() noexcept
+	{
+		Base::interlockedIncrement64(&m_countReallocations);
+	}
+
+
+	MemoryAllocatorScope::MemoryAllocatorScope(MemoryAllocator* allocator) noexcept
+	{
+		_priv_MemoryThreadContext& context = _gt_priv_memory_context;
+		m_allocatorPrevious = context.allocator;
+		context.allocator = allocator;
+	}
+
+	MemoryAllocatorScope::~MemoryAllocatorScope() noexcept
+	{
+		_gt_priv_memory_context.allocator = m_allocatorPrevious;
+	}
+
+
+	MemoryTagScope::MemoryTagScope(MemoryTag& tag) noexcept
+	{
+		_priv_MemoryThreadContext& context = _gt_priv_memory_context;
+		m_tagPrevious = context.tag;
+		context.tag = &tag;
+	}
+
+	MemoryTagScope::~MemoryTagScope() noexcept
+	{
+		_gt_priv_memory_context.tag = m_tagPrevious;
+	}
+
 	void Base::copyMemory(void* dst, const void* src, sl_size count) noexcept
 	{
 		::memcpy(dst, src, count);
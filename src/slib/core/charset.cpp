@@ -22,10 +22,268 @@
 
 #include "slib/core/charset.h"
 #include "slib/core/base.h"
+#include "slib/core/detail/simd.h"
+
+#include <string.h>
+
+#if defined(SLIB_ARCH_IS_X64) || (defined(SLIB_ARCH_IS_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#	define PRIV_CHARSET_SIMD_X86
+#	include <emmintrin.h>
+#elif defined(SLIB_ARCH_IS_ARM64)
+#	define PRIV_CHARSET_SIMD_NEON
+#	include <arm_neon.h>
+#endif
 
 namespace slib
 {
 	
+	/*
+		ASCII runs are converted in blocks before falling back to the per-character decoders.
+		Each function returns the length of the leading ASCII run of `src` (at most `count`),
+		and stores the converted run into `dst` when `dst` is not null.
+	*/
+	
+	static sl_size _priv_Charsets_widenAsciiTo16(sl_char16* dst, const sl_char8* src, sl_size count)
+	{
+		sl_size i = 0;
+#if defined(PRIV_CHARSET_SIMD_X86)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			__m128i zero = _mm_setzero_si128();
+			for (; i + 16 <= count; i += 16) {
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+				if (_mm_movemask_epi8(v)) {
+					break;
+				}
+				if (dst) {
+					_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(v, zero));
+					_mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(v, zero));
+				}
+			}
+		}
+#elif defined(PRIV_CHARSET_SIMD_NEON)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			for (; i + 16 <= count; i += 16) {
+				uint8x16_t v = vld1q_u8((const uint8_t*)(src + i));
+				if (vmaxvq_u8(v) & 0x80) {
+					break;
+				}
+				if (dst) {
+					vst1q_u16((uint16_t*)(dst + i), vmovl_u8(vget_low_u8(v)));
+					vst1q_u16((uint16_t*)(dst + i + 8), vmovl_u8(vget_high_u8(v)));
+				}
+			}
+		}
+#else
+		for (; i + 8 <= count; i += 8) {
+			sl_uint64 v;
+			memcpy(&v, src + i, 8);
+			if (v & SLIB_UINT64(0x8080808080808080)) {
+				break;
+			}
+			if (dst) {
+				for (sl_size k = 0; k < 8; k++) {
+					dst[i + k] = (sl_char16)(src[i + k]);
+				}
+			}
+		}
+#endif
+		for (; i < count; i++) {
+			sl_uint8 ch = (sl_uint8)(src[i]);
+			if (ch >= 0x80) {
+				break;
+			}
+			if (dst) {
+				dst[i] = (sl_char16)ch;
+			}
+		}
+		return i;
+	}
+	
+	static sl_size _priv_Charsets_widenAsciiTo32(sl_char32* dst, const sl_char8* src, sl_size count)
+	{
+		sl_size i = 0;
+#if defined(PRIV_CHARSET_SIMD_X86)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			__m128i zero = _mm_setzero_si128();
+			for (; i + 16 <= count; i += 16) {
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+				if (_mm_movemask_epi8(v)) {
+					break;
+				}
+				if (dst) {
+					__m128i lo = _mm_unpacklo_epi8(v, zero);
+					__m128i hi = _mm_unpackhi_epi8(v, zero);
+					_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi16(lo, zero));
+					_mm_storeu_si128((__m128i*)(dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+					_mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+					_mm_storeu_si128((__m128i*)(dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+				}
+			}
+		}
+#elif defined(PRIV_CHARSET_SIMD_NEON)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			for (; i + 16 <= count; i += 16) {
+				uint8x16_t v = vld1q_u8((const uint8_t*)(src + i));
+				if (vmaxvq_u8(v) & 0x80) {
+					break;
+				}
+				if (dst) {
+					uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+					uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+					vst1q_u32((uint32_t*)(dst + i), vmovl_u16(vget_low_u16(lo)));
+					vst1q_u32((uint32_t*)(dst + i + 4), vmovl_u16(vget_high_u16(lo)));
+					vst1q_u32((uint32_t*)(dst + i + 8), vmovl_u16(vget_low_u16(hi)));
+					vst1q_u32((uint32_t*)(dst + i + 12), vmovl_u16(vget_high_u16(hi)));
+				}
+			}
+		}
+#else
+		for (; i + 8 <= count; i += 8) {
+			sl_uint64 v;
+			memcpy(&v, src + i, 8);
+			if (v & SLIB_UINT64(0x8080808080808080)) {
+				break;
+			}
+			if (dst) {
+				for (sl_size k = 0; k < 8; k++) {
+					dst[i + k] = (sl_char32)(src[i + k]);
+				}
+			}
+		}
+#endif
+		for (; i < count; i++) {
+			sl_uint8 ch = (sl_uint8)(src[i]);
+			if (ch >= 0x80) {
+				break;
+			}
+			if (dst) {
+				dst[i] = (sl_char32)ch;
+			}
+		}
+		return i;
+	}
+	
+	static sl_size _priv_Charsets_narrowAsciiFrom16(sl_char8* dst, const sl_char16* src, sl_size count)
+	{
+		sl_size i = 0;
+#if defined(PRIV_CHARSET_SIMD_X86)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			__m128i zero = _mm_setzero_si128();
+			__m128i maskHigh = _mm_set1_epi16((short)0xFF80);
+			for (; i + 16 <= count; i += 16) {
+				__m128i v0 = _mm_loadu_si128((const __m128i*)(src + i));
+				__m128i v1 = _mm_loadu_si128((const __m128i*)(src + i + 8));
+				__m128i t = _mm_and_si128(_mm_or_si128(v0, v1), maskHigh);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi16(t, zero)) != 0xFFFF) {
+					break;
+				}
+				if (dst) {
+					_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(v0, v1));
+				}
+			}
+		}
+#elif defined(PRIV_CHARSET_SIMD_NEON)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			for (; i + 16 <= count; i += 16) {
+				uint16x8_t v0 = vld1q_u16((const uint16_t*)(src + i));
+				uint16x8_t v1 = vld1q_u16((const uint16_t*)(src + i + 8));
+				if (vmaxvq_u16(vorrq_u16(v0, v1)) >= 0x80) {
+					break;
+				}
+				if (dst) {
+					vst1q_u8((uint8_t*)(dst + i), vcombine_u8(vmovn_u16(v0), vmovn_u16(v1)));
+				}
+			}
+		}
+#else
+		for (; i + 4 <= count; i += 4) {
+			sl_uint64 v;
+			memcpy(&v, src + i, 8);
+			if (v & SLIB_UINT64(0xFF80FF80FF80FF80)) {
+				break;
+			}
+			if (dst) {
+				for (sl_size k = 0; k < 4; k++) {
+					dst[i + k] = (sl_char8)(src[i + k]);
+				}
+			}
+		}
+#endif
+		for (; i < count; i++) {
+			sl_uint32 ch = (sl_uint32)(src[i]);
+			if (ch >= 0x80) {
+				break;
+			}
+			if (dst) {
+				dst[i] = (sl_char8)ch;
+			}
+		}
+		return i;
+	}
+	
+	static sl_size _priv_Charsets_narrowAsciiFrom32(sl_char8* dst, const sl_char32* src, sl_size count)
+	{
+		sl_size i = 0;
+#if defined(PRIV_CHARSET_SIMD_X86)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			__m128i zero = _mm_setzero_si128();
+			__m128i maskHigh = _mm_set1_epi32((int)0xFFFFFF80);
+			for (; i + 16 <= count; i += 16) {
+				__m128i v0 = _mm_loadu_si128((const __m128i*)(src + i));
+				__m128i v1 = _mm_loadu_si128((const __m128i*)(src + i + 4));
+				__m128i v2 = _mm_loadu_si128((const __m128i*)(src + i + 8));
+				__m128i v3 = _mm_loadu_si128((const __m128i*)(src + i + 12));
+				__m128i t = _mm_and_si128(_mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3)), maskHigh);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(t, zero)) != 0xFFFF) {
+					break;
+				}
+				if (dst) {
+					_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3)));
+				}
+			}
+		}
+#elif defined(PRIV_CHARSET_SIMD_NEON)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			for (; i + 16 <= count; i += 16) {
+				uint32x4_t v0 = vld1q_u32((const uint32_t*)(src + i));
+				uint32x4_t v1 = vld1q_u32((const uint32_t*)(src + i + 4));
+				uint32x4_t v2 = vld1q_u32((const uint32_t*)(src + i + 8));
+				uint32x4_t v3 = vld1q_u32((const uint32_t*)(src + i + 12));
+				if (vmaxvq_u32(vorrq_u32(vorrq_u32(v0, v1), vorrq_u32(v2, v3))) >= 0x80) {
+					break;
+				}
+				if (dst) {
+					uint16x8_t lo = vcombine_u16(vmovn_u32(v0), vmovn_u32(v1));
+					uint16x8_t hi = vcombine_u16(vmovn_u32(v2), vmovn_u32(v3));
+					vst1q_u8((uint8_t*)(dst + i), vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+				}
+			}
+		}
+#else
+		for (; i + 2 <= count; i += 2) {
+			sl_uint64 v;
+			memcpy(&v, src + i, 8);
+			if (v & SLIB_UINT64(0xFFFFFF80FFFFFF80)) {
+				break;
+			}
+			if (dst) {
+				dst[i] = (sl_char8)(src[i]);
+				dst[i + 1] = (sl_char8)(src[i + 1]);
+			}
+		}
+#endif
+		for (; i < count; i++) {
+			sl_uint32 ch = (sl_uint32)(src[i]);
+			if (ch >= 0x80) {
+				break;
+			}
+			if (dst) {
+				dst[i] = (sl_char8)ch;
+			}
+		}
+		return i;
+	}
+	
 	sl_size Charsets::utf8ToUtf16(const sl_char8* utf8, sl_reg lenUtf8, sl_char16* utf16, sl_reg lenUtf16Buffer)
 	{
 		if (lenUtf8 < 0) {
@@ -35,11 +293,13 @@ namespace slib
 		for (sl_reg i = 0; i < lenUtf8 && (lenUtf16Buffer < 0 || n < lenUtf16Buffer); i++) {
 			sl_uint32 ch = (sl_uint32)((sl_uint8)utf8[i]);
 			if (ch < 0x80) {
-				if (utf16) {
-					utf16[n++] = (sl_char16)ch;
-				} else {
-					n++;
+				sl_size m = (sl_size)(lenUtf8 - i);
+				if (lenUtf16Buffer >= 0 && (sl_size)(lenUtf16Buffer - n) < m) {
+					m = (sl_size)(lenUtf16Buffer - n);
 				}
+				sl_size k = _priv_Charsets_widenAsciiTo16(utf16 ? utf16 + n : sl_null, utf8 + i, m);
+				n += k;
+				i += k - 1;
 			} else if (ch < 0xC0) {
 				// Corrupted data element
 			} else if (ch < 0xE0) {
@@ -79,11 +339,13 @@ namespace slib
 		for (sl_reg i = 0; i < lenUtf8 && (lenUtf32Buffer < 0 || n < lenUtf32Buffer); i++) {
 			sl_uint32 ch = (sl_uint32)((sl_uint8)utf8[i]);
 			if (ch < 0x80) {
-				if (utf32) {
-					utf32[n++] = (sl_char32)ch;
-				} else {
-					n++;
+				sl_size m = (sl_size)(lenUtf8 - i);
+				if (lenUtf32Buffer >= 0 && (sl_size)(lenUtf32Buffer - n) < m) {
+					m = (sl_size)(lenUtf32Buffer - n);
 				}
+				sl_size k = _priv_Charsets_widenAsciiTo32(utf32 ? utf32 + n : sl_null, utf8 + i, m);
+				n += k;
+				i += k - 1;
 			} else if (ch < 0xC0) {
 				// Corrupted data element
 			} else if (ch < 0xE0) {
@@ -165,11 +427,13 @@ namespace slib
 		for (sl_reg i = 0; i < lenUtf16 && (lenUtf8Buffer < 0 || n < lenUtf8Buffer); i++) {
 			sl_uint32 ch = (sl_uint32)(utf16[i]);
 			if (ch < 0x80) {
-				if (utf8) {
-					utf8[n++] = (sl_char8)(ch);
-				} else {
-					n++;
+				sl_size m = (sl_size)(lenUtf16 - i);
+				if (lenUtf8Buffer >= 0 && (sl_size)(lenUtf8Buffer - n) < m) {
+					m = (sl_size)(lenUtf8Buffer - n);
 				}
+				sl_size k = _priv_Charsets_narrowAsciiFrom16(utf8 ? utf8 + n : sl_null, utf16 + i, m);
+				n += k;
+				i += k - 1;
 			} else if (ch < 0x800) {
 				if (lenUtf8Buffer < 0 || n + 1 < lenUtf8Buffer) {
 					if (utf8) {
@@ -203,11 +467,13 @@ namespace slib
 		for (sl_reg i = 0; i < lenUtf32 && (lenUtf8Buffer < 0 || n < lenUtf8Buffer); i++) {
 			sl_uint32 ch = (sl_uint32)(utf32[i]);
 			if (ch < 0x80) {
-				if (utf8) {
-					utf8[n++] = (sl_char8)(ch);
-				} else {
-					n++;
+				sl_size m = (sl_size)(lenUtf32 - i);
+				if (lenUtf8Buffer >= 0 && (sl_size)(lenUtf8Buffer - n) < m) {
+					m = (sl_size)(lenUtf8Buffer - n);
 				}
+				sl_size k = _priv_Charsets_narrowAsciiFrom32(utf8 ? utf8 + n : sl_null, utf32 + i, m);
+				n += k;
+				i += k - 1;
 			} else if (ch < 0x800) {
 				if (lenUtf8Buffer < 0 || n + 1 < lenUtf8Buffer) {
 					if (utf8) {
@@ -86,6 +86,333 @@ namespace slib
 	}
 
 
+/*************************************
+			TimingWheel
+*************************************/
+
+#define PRIV_TIMING_WHEEL_SLOT_MASK (SLIB_TIMING_WHEEL_SLOTS - 1)
+#define PRIV_TIMING_WHEEL_MAX_DELTA ((((sl_uint64)1) << (SLIB_TIMING_WHEEL_SLOT_BITS * SLIB_TIMING_WHEEL_LEVELS)) - 1)
+#define PRIV_TIMING_WHEEL_MAX_DELAY ((((sl_uint64)1) << 62) - 1)
+
+	TimingWheelEntry::TimingWheelEntry() noexcept
+	{
+		m_wheel = sl_null;
+		m_prev = sl_null;
+		m_next = sl_null;
+		m_slot = sl_null;
+		m_level = 0;
+		m_tick = 0;
+		m_flagAutoDelete = sl_false;
+	}
+
+	TimingWheelEntry::~TimingWheelEntry() noexcept
+	{
+		TimingWheel* wheel = m_wheel;
+		if (wheel) {
+			wheel->remove(this);
+		}
+	}
+
+	sl_bool TimingWheelEntry::isScheduled() const noexcept
+	{
+		return m_wheel != sl_null;
+	}
+
+	TimingWheel::TimingWheel(sl_uint32 tickMilliseconds) noexcept
+	{
+		if (!tickMilliseconds) {
+			tickMilliseconds = 1;
+		}
+		m_tickMilliseconds = tickMilliseconds;
+		m_tickCurrent = 0;
+		Base::zeroMemory(m_slots, sizeof(m_slots));
+		Base::zeroMemory(m_countLevels, sizeof(m_countLevels));
+		m_count = 0;
+	}
+
+	TimingWheel::~TimingWheel() noexcept
+	{
+		removeAll();
+	}
+
+	sl_bool TimingWheel::add(TimingWheelEntry* entry, sl_uint64 delay_ms) noexcept
+	{
+		if (!entry) {
+			return sl_false;
+		}
+		if (delay_ms > PRIV_TIMING_WHEEL_MAX_DELAY) {
+			delay_ms = PRIV_TIMING_WHEEL_MAX_DELAY;
+		}
+		MutexLocker lock(&m_lock);
+		TimingWheel* wheel = entry->m_wheel;
+		if (wheel) {
+			if (wheel != this) {
+				return sl_false;
+			}
+			_unlink(entry);
+		}
+		m_timeCounter.update();
+		sl_uint64 now = m_timeCounter.getElapsedMilliseconds();
+		entry->m_tick = (now + delay_ms + m_tickMilliseconds - 1) / m_tickMilliseconds;
+		entry->m_wheel = this;
+		_link(entry);
+		return sl_true;
+	}
+
+	sl_bool TimingWheel::add(const Function<void()>& task, sl_uint64 delay_ms) noexcept
+	{
+		if (task.isNull()) {
+			return sl_false;
+		}
+		TimingWheelEntry* entry = new TimingWheelEntry;
+		if (!entry) {
+			return sl_false;
+		}
+		entry->callback = task;
+		entry->m_flagAutoDelete = sl_true;
+		if (add(entry, delay_ms)) {
+			return sl_true;
+		}
+		delete entry;
+		return sl_false;
+	}
+
+	void TimingWheel::remove(TimingWheelEntry* entry) noexcept
+	{
+		if (!entry) {
+			return;
+		}
+		MutexLocker lock(&m_lock);
+		if (entry->m_wheel == this) {
+			_unlink(entry);
+			entry->m_wheel = sl_null;
+		}
+	}
+
+	void TimingWheel::removeAll() noexcept
+	{
+		LinkedQueue< Function<void()> > tasks;
+		MutexLocker lock(&m_lock);
+		for (sl_uint32 level = 0; level < SLIB_TIMING_WHEEL_LEVELS; level++) {
+			for (sl_uint32 index = 0; index < SLIB_TIMING_WHEEL_SLOTS; index++) {
+				TimingWheelEntry* entry = m_slots[level][index];
+				m_slots[level][index] = sl_null;
+				while (entry) {
+					TimingWheelEntry* next = entry->m_next;
+					entry->m_wheel = sl_null;
+					entry->m_prev = sl_null;
+					entry->m_next = sl_null;
+					entry->m_slot = sl_null;
+					if (entry->m_flagAutoDelete) {
+						// the task is released after unlocking, because its destructor may access this wheel
+						tasks.push_NoLock(Move(entry->callback));
+						delete entry;
+					}
+					entry = next;
+				}
+			}
+			m_countLevels[level] = 0;
+		}
+		m_count = 0;
+	}
+
+	sl_size TimingWheel::getCount() noexcept
+	{
+		return m_count;
+	}
+
+	sl_int32 TimingWheel::process() noexcept
+	{
+		LinkedQueue< Function<void()> > tasks;
+		{
+			MutexLocker lock(&m_lock);
+			m_timeCounter.update();
+			sl_uint64 tickNow = m_timeCounter.getElapsedMilliseconds() / m_tickMilliseconds;
+			while (m_tickCurrent <= tickNow) {
+				sl_uint64 tick;
+				if (!(_getNextTick(tick)) || tick > tickNow) {
+					m_tickCurrent = tickNow + 1;
+					break;
+				}
+				m_tickCurrent = tick;
+				if (!(tick & PRIV_TIMING_WHEEL_SLOT_MASK)) {
+					// cascade the upper slots beginning at this tick
+					for (sl_uint32 level = 1; level < SLIB_TIMING_WHEEL_LEVELS; level++) {
+						sl_uint32 index = (sl_uint32)(tick >> (level * SLIB_TIMING_WHEEL_SLOT_BITS)) & PRIV_TIMING_WHEEL_SLOT_MASK;
+						TimingWheelEntry* entry = m_slots[level][index];
+						m_slots[level][index] = sl_null;
+						while (entry) {
+							TimingWheelEntry* next = entry->m_next;
+							m_countLevels[level]--;
+							m_count--;
+							_link(entry);
+							entry = next;
+						}
+						if (index) {
+							break;
+						}
+					}
+				}
+				sl_uint32 index = (sl_uint32)tick & PRIV_TIMING_WHEEL_SLOT_MASK;
+				TimingWheelEntry* entry = m_slots[0][index];
+				m_slots[0][index] = sl_null;
+				while (entry) {
+					TimingWheelEntry* next = entry->m_next;
+					m_countLevels[0]--;
+					m_count--;
+					if (entry->m_tick <= tick) {
+						entry->m_wheel = sl_null;
+						entry->m_prev = sl_null;
+						entry->m_next = sl_null;
+						entry->m_slot = sl_null;
+						if (entry->m_flagAutoDelete) {
+							tasks.push_NoLock(Move(entry->callback));
+							delete entry;
+						} else {
+							tasks.push_NoLock(entry->callback);
+						}
+					} else {
+						_link(entry);
+					}
+					entry = next;
+				}
+				m_tickCurrent = tick + 1;
+			}
+		}
+		Function<void()> task;
+		while (tasks.pop_NoLock(&task)) {
+			task();
+		}
+		return getTimeout();
+	}
+
+	sl_int32 TimingWheel::getTimeout() noexcept
+	{
+		MutexLocker lock(&m_lock);
+		return _getTimeout(m_timeCounter.getElapsedMilliseconds());
+	}
+
+	sl_uint64 TimingWheel::getElapsedMilliseconds() noexcept
+	{
+		return m_timeCounter.getElapsedMilliseconds();
+	}
+
+	void TimingWheel::_link(TimingWheelEntry* entry) noexcept
+	{
+		sl_uint64 tick = entry->m_tick;
+		sl_uint64 current = m_tickCurrent;
+		sl_uint64 delta;
+		if (tick > current) {
+			delta = tick - current;
+			if (delta > PRIV_TIMING_WHEEL_MAX_DELTA) {
+				// stays in the top level until it is cascaded into range
+				delta = PRIV_TIMING_WHEEL_MAX_DELTA;
+				tick = current + delta;
+			}
+		} else {
+			delta = 0;
+			tick = current;
+		}
+		sl_uint32 level = 0;
+		while (level + 1 < SLIB_TIMING_WHEEL_LEVELS && (delta >> ((level + 1) * SLIB_TIMING_WHEEL_SLOT_BITS))) {
+			level++;
+		}
+		sl_uint32 index = (sl_uint32)(tick >> (level * SLIB_TIMING_WHEEL_SLOT_BITS)) & PRIV_TIMING_WHEEL_SLOT_MASK;
+		TimingWheelEntry** slot = &(m_slots[level][index]);
+		TimingWheelEntry* head = *slot;
+		entry->m_prev = sl_null;
+		entry->m_next = head;
+		if (head) {
+			head->m_prev = entry;
+		}
+		*slot = entry;
+		entry->m_slot = slot;
+		entry->m_level = level;
+		m_countLevels[level]++;
+		m_count++;
+	}
+
+	void TimingWheel::_unlink(TimingWheelEntry* entry) noexcept
+	{
+		TimingWheelEntry* prev = entry->m_prev;
+		TimingWheelEntry* next = entry->m_next;
+		if (prev) {
+			prev->m_next = next;
+		} else {
+			*(entry->m_slot) = next;
+		}
+		if (next) {
+			next->m_prev = prev;
+		}
+		entry->m_prev = sl_null;
+		entry->m_next = sl_null;
+		entry->m_slot = sl_null;
+		m_countLevels[entry->m_level]--;
+		m_count--;
+	}
+
+	sl_bool TimingWheel::_getNextTick(sl_uint64& _tick) noexcept
+	{
+		if (!m_count) {
+			return sl_false;
+		}
+		sl_uint64 current = m_tickCurrent;
+		sl_bool flagFound = sl_false;
+		sl_uint64 tick = 0;
+		if (m_countLevels[0]) {
+			for (sl_uint32 i = 0; i < SLIB_TIMING_WHEEL_SLOTS; i++) {
+				if (m_slots[0][(current + i) & PRIV_TIMING_WHEEL_SLOT_MASK]) {
+					tick = current + i;
+					flagFound = sl_true;
+					break;
+				}
+			}
+			if (flagFound && (current & PRIV_TIMING_WHEEL_SLOT_MASK) && (tick >> SLIB_TIMING_WHEEL_SLOT_BITS) == (current >> SLIB_TIMING_WHEEL_SLOT_BITS)) {
+				// upper levels are cascaded not earlier than the next block
+				_tick = tick;
+				return sl_true;
+			}
+		}
+		for (sl_uint32 level = 1; level < SLIB_TIMING_WHEEL_LEVELS; level++) {
+			if (m_countLevels[level]) {
+				sl_uint32 shift = level * SLIB_TIMING_WHEEL_SLOT_BITS;
+				sl_uint64 base = current >> shift;
+				// the block beginning at the current tick is not cascaded yet
+				sl_uint32 start = (current & ((((sl_uint64)1) << shift) - 1)) ? 1 : 0;
+				for (sl_uint32 i = start; i < start + SLIB_TIMING_WHEEL_SLOTS; i++) {
+					if (m_slots[level][(base + i) & PRIV_TIMING_WHEEL_SLOT_MASK]) {
+						sl_uint64 t = (base + i) << shift;
+						if (!flagFound || t < tick) {
+							tick = t;
+							flagFound = sl_true;
+						}
+						break;
+					}
+				}
+			}
+		}
+		_tick = tick;
+		return flagFound;
+	}
+
+	sl_int32 TimingWheel::_getTimeout(sl_uint64 now) noexcept
+	{
+		sl_uint64 tick;
+		if (!(_getNextTick(tick))) {
+			return -1;
+		}
+		sl_uint64 t = tick * m_tickMilliseconds;
+		if (t <= now) {
+			return 0;
+		}
+		t -= now;
+		if (t > 0x7fffffff) {
+			return 0x7fffffff;
+		}
+		return (sl_int32)t;
+	}
+
+
 /*************************************
 			DispatchLoop
 *************************************/
@@ -152,7 +479,6 @@ namespace slib
 
 		m_queueTasks.removeAll();
 		
-		MutexLocker lockTime(&m_lockTimeTasks);
 		m_timeTasks.removeAll();
 	}
 
@@ -215,11 +541,7 @@ namespace slib
 				return sl_true;
 			}
 		} else {
-			MutexLocker lock(&m_lockTimeTasks);
-			TimeTask tt;
-			tt.time = getElapsedMilliseconds() + delay_ms;
-			tt.task = task;
-			if (m_timeTasks.add(tt.time, tt)) {
+			if (m_timeTasks.add(task, delay_ms)) {
 				_wake();
 				return sl_true;
 			}
@@ -227,31 +549,26 @@ namespace slib
 		return sl_false;
 	}
 
-	sl_int32 DispatchLoop::_getTimeout_TimeTasks()
+	sl_bool DispatchLoop::addTimeout(TimingWheelEntry* entry, sl_uint64 delay_ms)
 	{
-		MutexLocker lock(&m_lockTimeTasks);
-		sl_uint64 rel = getElapsedMilliseconds();
-		if (m_timeTasks.getCount() == 0) {
-			return -1;
-		}
-		sl_int32 timeout = -1;
-		LinkedQueue< Function<void()> > tasks;
-		while (MapNode<sl_uint64, TimeTask>* node = m_timeTasks.getFirstNode()) {
-			if (rel >= node->key) {
-				tasks.push(node->value.task);
-				m_timeTasks.removeAt(node);
-			} else {
-				timeout = (sl_int32)(node->key - rel);
-				break;
+		if (m_timeTasks.add(entry, delay_ms)) {
+			// the loop thread recalculates its timeout before sleeping
+			if (!(m_thread->isCurrentThread())) {
+				_wake();
 			}
+			return sl_true;
 		}
-		lock.unlock();
+		return sl_false;
+	}
 
-		Function<void()> task;
-		while (tasks.pop(&task)) {
-			task();
-		}
-		return timeout;
+	void DispatchLoop::removeTimeout(TimingWheelEntry* entry)
+	{
+		m_timeTasks.remove(entry);
+	}
+
+	sl_int32 DispatchLoop::_getTimeout_TimeTasks()
+	{
+		return m_timeTasks.process();
 	}
 
 	sl_int32 DispatchLoop::_getTimeout_Timer()
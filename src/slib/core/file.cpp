@@ -87,6 +87,33 @@ namespace slib
 		return open(filePath, FileMode::RandomRead, flagShareRead ? (FilePermissions::All | FilePermissions::ShareRead) : FilePermissions::All);
 	}
 
+	Ref<BufferedReader> File::openBufferedForRead(const String& filePath, sl_size bufferSize)
+	{
+		Ref<File> file = openForRead(filePath);
+		if (file.isNotNull()) {
+			return BufferedReader::create(file, bufferSize);
+		}
+		return sl_null;
+	}
+
+	Ref<BufferedWriter> File::openBufferedForWrite(const String& filePath, sl_size bufferSize)
+	{
+		Ref<File> file = openForWrite(filePath);
+		if (file.isNotNull()) {
+			return BufferedWriter::create(file, bufferSize);
+		}
+		return sl_null;
+	}
+
+	Ref<BufferedWriter> File::openBufferedForAppend(const String& filePath, sl_size bufferSize)
+	{
+		Ref<File> file = openForAppend(filePath);
+		if (file.isNotNull()) {
+			return BufferedWriter::create(file, bufferSize);
+		}
+		return sl_null;
+	}
+
 	Ref<File> File::openDevice(const String16& path, sl_bool flagRead, sl_bool flagWrite)
 	{
 		FileMode mode = FileMode::NotCreate | FileMode::NotTruncate | FileMode::HintRandomAccess;
@@ -610,6 +637,204 @@ namespace slib
 	}
 
 
+	class _priv_MappedFileView : public Referable
+	{
+	public:
+		void* address;
+		sl_size size;
+
+	public:
+		_priv_MappedFileView(void* _address, sl_size _size): address(_address), size(_size)
+		{
+		}
+
+		~_priv_MappedFileView()
+		{
+			MappedFile::_unmap(address, size);
+		}
+
+	};
+
+#if defined(SLIB_ARCH_IS_64BIT)
+#	define PRIV_SLIB_MAPPED_FILE_DEFAULT_WINDOW_SIZE 0x40000000 // 1GB
+#else
+#	define PRIV_SLIB_MAPPED_FILE_DEFAULT_WINDOW_SIZE 0x1000000 // 16MB
+#endif
+
+	SLIB_DEFINE_OBJECT(MappedFile, Object)
+
+	MappedFile::MappedFile()
+	{
+		m_file = SLIB_FILE_INVALID_HANDLE;
+		m_handleMapping = sl_null;
+		m_size = 0;
+		m_mode = 0;
+		m_offsetWindow = 0;
+		m_sizeWindow = PRIV_SLIB_MAPPED_FILE_DEFAULT_WINDOW_SIZE;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		_close();
+	}
+
+	Ref<MappedFile> MappedFile::open(const String& filePath, const MappedFileMode& mode, sl_uint64 size)
+	{
+		if (filePath.isEmpty()) {
+			return sl_null;
+		}
+		Ref<MappedFile> ret = new MappedFile;
+		if (ret.isNotNull()) {
+			if (ret->_open(filePath, mode, size)) {
+				ret->m_mode = mode;
+				return ret;
+			}
+		}
+		return sl_null;
+	}
+
+	Ref<MappedFile> MappedFile::openForRead(const String& filePath)
+	{
+		return open(filePath, MappedFileMode::Read);
+	}
+
+	Ref<MappedFile> MappedFile::openForReadWrite(const String& filePath, sl_uint64 size)
+	{
+		return open(filePath, MappedFileMode::ReadWrite, size);
+	}
+
+	Memory MappedFile::mapAll(const String& filePath, const MappedFileMode& mode)
+	{
+		Ref<MappedFile> file = open(filePath, mode & (~((int)(MappedFileMode::Write))));
+		if (file.isNotNull()) {
+			return file->mapAll();
+		}
+		return sl_null;
+	}
+
+	void MappedFile::close()
+	{
+		ObjectLocker lock(this);
+		m_window.setNull();
+		_close();
+	}
+
+	sl_bool MappedFile::isOpened()
+	{
+		return m_file != SLIB_FILE_INVALID_HANDLE;
+	}
+
+	sl_uint64 MappedFile::getSize()
+	{
+		return m_size;
+	}
+
+	MappedFileMode MappedFile::getMode()
+	{
+		return m_mode;
+	}
+
+	Memory MappedFile::map(sl_uint64 offset, sl_size size)
+	{
+		ObjectLocker lock(this);
+		if (m_file == SLIB_FILE_INVALID_HANDLE) {
+			return sl_null;
+		}
+		if (offset >= m_size) {
+			return sl_null;
+		}
+		if (size > m_size - offset) {
+			size = (sl_size)(m_size - offset);
+		}
+		if (!size) {
+			return sl_null;
+		}
+		sl_uint32 granularity = getAllocationGranularity();
+		sl_uint64 offsetMapping = offset - offset % granularity;
+		sl_size delta = (sl_size)(offset - offsetMapping);
+		sl_size sizeMapping = size + delta;
+		if (sizeMapping < size) {
+			return sl_null;
+		}
+		void* address = _map(offsetMapping, sizeMapping);
+		if (!address) {
+			return sl_null;
+		}
+		Ref<_priv_MappedFileView> view = new _priv_MappedFileView(address, sizeMapping);
+		if (view.isNull()) {
+			_unmap(address, sizeMapping);
+			return sl_null;
+		}
+		return Memory::createStatic((sl_uint8*)address + delta, size, view.get());
+	}
+
+	Memory MappedFile::mapAll()
+	{
+		if (m_size > SLIB_SIZE_MAX) {
+			return sl_null;
+		}
+		return map(0, (sl_size)m_size);
+	}
+
+	Memory MappedFile::mapWindow(sl_uint64 offset, sl_size size)
+	{
+		ObjectLocker lock(this);
+		if (offset >= m_size) {
+			return sl_null;
+		}
+		if (size > m_size - offset) {
+			size = (sl_size)(m_size - offset);
+		}
+		if (!size) {
+			return sl_null;
+		}
+		if (m_window.isNotNull()) {
+			if (offset >= m_offsetWindow && offset - m_offsetWindow + size <= m_window.getSize()) {
+				return m_window.sub((sl_size)(offset - m_offsetWindow), size);
+			}
+			// releases the address space before mapping the next window
+			m_window.setNull();
+		}
+		sl_uint32 granularity = getAllocationGranularity();
+		sl_uint64 offsetWindow = offset - offset % granularity;
+		sl_size delta = (sl_size)(offset - offsetWindow);
+		sl_size sizeWindow = m_sizeWindow;
+		if (sizeWindow < delta || size > sizeWindow - delta) {
+			sizeWindow = size + delta;
+			if (sizeWindow < size) {
+				return sl_null;
+			}
+		}
+		Memory window = map(offsetWindow, sizeWindow);
+		if (window.isNull()) {
+			return sl_null;
+		}
+		m_window = window;
+		m_offsetWindow = offsetWindow;
+		return window.sub(delta, size);
+	}
+
+	sl_size MappedFile::getWindowSize()
+	{
+		return m_sizeWindow;
+	}
+
+	void MappedFile::setWindowSize(sl_size size)
+	{
+		ObjectLocker lock(this);
+		sl_uint32 granularity = getAllocationGranularity();
+		if (size < granularity) {
+			size = granularity;
+		}
+		m_sizeWindow = size;
+	}
+
+	sl_bool MappedFile::flush(const Memory& view, sl_bool flagAsync)
+	{
+		return flush(view.getData(), view.getSize(), flagAsync);
+	}
+
+
 	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(FilePathSegments)
 	
 	FilePathSegments::FilePathSegments()
@@ -31,6 +31,7 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <sys/mman.h>
 #if defined(SLIB_PLATFORM_IS_DESKTOP)
 #	include <sys/ioctl.h>
 #	if defined(SLIB_PLATFORM_IS_MACOS)
@@ -566,6 +567,111 @@ namespace slib
 		return realpath(filePath.getData(), path);
 	}
 
+
+	sl_bool MappedFile::_open(const String& filePath, const MappedFileMode& mode, sl_uint64 size)
+	{
+		int flags = O_RDONLY;
+		if (mode & MappedFileMode::Write) {
+			flags = O_RDWR;
+			if (!(mode & MappedFileMode::NotCreate)) {
+				flags |= O_CREAT;
+			}
+		}
+		int fd = ::open(filePath.getData(), flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+		if (fd == -1) {
+			return sl_false;
+		}
+		if ((mode & MappedFileMode::Write) && size) {
+			if (0 != ::ftruncate(fd, size)) {
+				::close(fd);
+				return sl_false;
+			}
+		} else {
+			struct stat st;
+			if (0 != ::fstat(fd, &st)) {
+				::close(fd);
+				return sl_false;
+			}
+			size = st.st_size;
+		}
+		m_file = (sl_file)fd;
+		m_size = size;
+		return sl_true;
+	}
+
+	void MappedFile::_close()
+	{
+		int fd = (int)m_file;
+		if (fd != -1) {
+			::close(fd);
+			m_file = SLIB_FILE_INVALID_HANDLE;
+		}
+		m_size = 0;
+	}
+
+	void* MappedFile::_map(sl_uint64 offset, sl_size size)
+	{
+		int prot = PROT_READ;
+		if (m_mode & MappedFileMode::Write) {
+			prot |= PROT_WRITE;
+		}
+		int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+		if (m_mode & MappedFileMode::Populate) {
+			flags |= MAP_POPULATE;
+		}
+#endif
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		void* address = ::mmap64(sl_null, size, prot, flags, (int)m_file, (off64_t)offset);
+#else
+		void* address = ::mmap(sl_null, size, prot, flags, (int)m_file, (off_t)offset);
+#endif
+		if (address == MAP_FAILED) {
+			return sl_null;
+		}
+		if (m_mode & MappedFileMode::HintSequential) {
+			::madvise(address, size, MADV_SEQUENTIAL);
+		} else if (m_mode & MappedFileMode::HintRandom) {
+			::madvise(address, size, MADV_RANDOM);
+		}
+		if (m_mode & MappedFileMode::HintWillNeed) {
+			::madvise(address, size, MADV_WILLNEED);
+		}
+#if defined(MADV_HUGEPAGE)
+		if (m_mode & MappedFileMode::HintHugePages) {
+			::madvise(address, size, MADV_HUGEPAGE);
+		}
+#endif
+		return address;
+	}
+
+	void MappedFile::_unmap(void* address, sl_size size)
+	{
+		::munmap(address, size);
+	}
+
+	sl_bool MappedFile::flush(const void* data, sl_size size, sl_bool flagAsync)
+	{
+		if (!data || !size) {
+			return sl_false;
+		}
+		// msync requires the address aligned by the page size
+		sl_size pageSize = getAllocationGranularity();
+		sl_size start = ((sl_size)data) & ~(pageSize - 1);
+		size += (sl_size)data - start;
+		return 0 == ::msync((void*)start, size, flagAsync ? MS_ASYNC : MS_SYNC);
+	}
+
+	sl_uint32 MappedFile::getAllocationGranularity()
+	{
+		static sl_uint32 granularity = 0;
+		if (!granularity) {
+			long n = ::sysconf(_SC_PAGESIZE);
+			granularity = n > 0 ? (sl_uint32)n : 4096;
+		}
+		return granularity;
+	}
+
 }
 
 #endif
@@ -568,6 +568,106 @@ namespace slib
 		return sl_null;
 	}
 
+
+	sl_bool MappedFile::_open(const String& _filePath, const MappedFileMode& mode, sl_uint64 size)
+	{
+		String16 filePath = _filePath;
+		DWORD dwDesiredAccess = GENERIC_READ;
+		DWORD dwCreationDisposition = OPEN_EXISTING;
+		if (mode & MappedFileMode::Write) {
+			dwDesiredAccess |= GENERIC_WRITE;
+			if (!(mode & MappedFileMode::NotCreate)) {
+				dwCreationDisposition = OPEN_ALWAYS;
+			}
+		}
+		DWORD dwFlags = FILE_ATTRIBUTE_NORMAL;
+		if (mode & MappedFileMode::HintSequential) {
+			dwFlags |= FILE_FLAG_SEQUENTIAL_SCAN;
+		} else if (mode & MappedFileMode::HintRandom) {
+			dwFlags |= FILE_FLAG_RANDOM_ACCESS;
+		}
+		HANDLE hFile = ::CreateFileW((LPCWSTR)(filePath.getData()), dwDesiredAccess, FILE_SHARE_READ, NULL, dwCreationDisposition, dwFlags, NULL);
+		if (hFile == INVALID_HANDLE_VALUE) {
+			return sl_false;
+		}
+		if ((mode & MappedFileMode::Write) && size) {
+			LARGE_INTEGER li;
+			li.QuadPart = size;
+			if (!(::SetFilePointerEx(hFile, li, NULL, FILE_BEGIN) && ::SetEndOfFile(hFile))) {
+				::CloseHandle(hFile);
+				return sl_false;
+			}
+		} else {
+			LARGE_INTEGER li;
+			if (!(::GetFileSizeEx(hFile, &li))) {
+				::CloseHandle(hFile);
+				return sl_false;
+			}
+			size = li.QuadPart;
+		}
+		// the empty file can't be mapped
+		HANDLE hMapping = NULL;
+		if (size) {
+			hMapping = ::CreateFileMappingW(hFile, NULL, (mode & MappedFileMode::Write) ? PAGE_READWRITE : PAGE_READONLY, 0, 0, NULL);
+			if (!hMapping) {
+				::CloseHandle(hFile);
+				return sl_false;
+			}
+		}
+		m_file = (sl_file)hFile;
+		m_handleMapping = (void*)hMapping;
+		m_size = size;
+		return sl_true;
+	}
+
+	void MappedFile::_close()
+	{
+		// the views keep their mappings alive after closing the handles
+		if (m_handleMapping) {
+			::CloseHandle((HANDLE)m_handleMapping);
+			m_handleMapping = sl_null;
+		}
+		if (m_file != SLIB_FILE_INVALID_HANDLE) {
+			::CloseHandle((HANDLE)m_file);
+			m_file = SLIB_FILE_INVALID_HANDLE;
+		}
+		m_size = 0;
+	}
+
+	void* MappedFile::_map(sl_uint64 offset, sl_size size)
+	{
+		if (!m_handleMapping) {
+			return sl_null;
+		}
+		DWORD dwAccess = (m_mode & MappedFileMode::Write) ? FILE_MAP_WRITE : FILE_MAP_READ;
+		return ::MapViewOfFile((HANDLE)m_handleMapping, dwAccess, (DWORD)(offset >> 32), (DWORD)offset, size);
+	}
+
+	void MappedFile::_unmap(void* address, sl_size size)
+	{
+		::UnmapViewOfFile(address);
+	}
+
+	sl_bool MappedFile::flush(const void* data, sl_size size, sl_bool flagAsync)
+	{
+		if (!data || !size) {
+			return sl_false;
+		}
+		// FlushViewOfFile only starts writing the pages, which is same as MS_ASYNC
+		return ::FlushViewOfFile(data, size) != 0;
+	}
+
+	sl_uint32 MappedFile::getAllocationGranularity()
+	{
+		static sl_uint32 granularity = 0;
+		if (!granularity) {
+			SYSTEM_INFO si;
+			::GetSystemInfo(&si);
+			granularity = (sl_uint32)(si.dwAllocationGranularity);
+		}
+		return granularity;
+	}
+
 }
 
 #endif
@@ -21,6 +21,7 @@
  */
 
 #include "slib/core/io.h"
+#include "slib/core/buffered_io.h"
 
 #include "slib/core/mio.h"
 #include "slib/core/string_buffer.h"
@@ -1968,4 +1969,407 @@ namespace slib
 		return getOffset();
 	}
 
+
+#define PRIV_SLIB_BUFFERED_IO_MINIMUM_SIZE 16
+
+	SLIB_DEFINE_OBJECT(BufferedReader, Object)
+
+	BufferedReader::BufferedReader()
+	{
+		m_buf = sl_null;
+		m_sizeBuf = 0;
+		m_pos = sl_null;
+		m_end = sl_null;
+	}
+
+	BufferedReader::~BufferedReader()
+	{
+		if (m_buf) {
+			Base::freeMemory(m_buf);
+		}
+	}
+
+	Ref<BufferedReader> BufferedReader::create(const Ptr<IReader>& reader, sl_size bufferSize)
+	{
+		if (reader.isNull()) {
+			return sl_null;
+		}
+		if (bufferSize < PRIV_SLIB_BUFFERED_IO_MINIMUM_SIZE) {
+			bufferSize = PRIV_SLIB_BUFFERED_IO_MINIMUM_SIZE;
+		}
+		sl_uint8* buf = (sl_uint8*)(Base::createMemory(bufferSize));
+		if (buf) {
+			Ref<BufferedReader> ret = new BufferedReader;
+			if (ret.isNotNull()) {
+				ret->m_reader = reader;
+				ret->m_buf = buf;
+				ret->m_sizeBuf = bufferSize;
+				ret->m_pos = buf;
+				ret->m_end = buf;
+				return ret;
+			}
+			Base::freeMemory(buf);
+		}
+		return sl_null;
+	}
+
+	Ptr<IReader> BufferedReader::getReader()
+	{
+		return m_reader;
+	}
+
+	void BufferedReader::close()
+	{
+		m_reader.setNull();
+		m_pos = m_buf;
+		m_end = m_buf;
+	}
+
+	sl_bool BufferedReader::isOpened()
+	{
+		return m_reader.isNotNull();
+	}
+
+	sl_reg BufferedReader::read(void* buf, sl_size size)
+	{
+		if (!size) {
+			return 0;
+		}
+		sl_size n = m_end - m_pos;
+		if (!n) {
+			IReader* reader = m_reader._ptr;
+			if (!reader) {
+				return -1;
+			}
+			// the large reads go directly to the underlying reader
+			if (size >= m_sizeBuf) {
+				return reader->read(buf, size);
+			}
+			m_pos = m_buf;
+			m_end = m_buf;
+			sl_reg m = reader->read(m_buf, m_sizeBuf);
+			if (m <= 0) {
+				return m;
+			}
+			m_end = m_buf + m;
+			n = m;
+		}
+		if (n > size) {
+			n = size;
+		}
+		Base::copyMemory(buf, m_pos, n);
+		m_pos += n;
+		return n;
+	}
+
+	sl_size BufferedReader::getBufferedSize()
+	{
+		return m_end - m_pos;
+	}
+
+	sl_bool BufferedReader::readSection(Memory* output, sl_size maxSize)
+	{
+		sl_size size;
+		if (readSizeCVLI(&size)) {
+			if (size > maxSize) {
+				return sl_false;
+			}
+			if (size == 0) {
+				output->setNull();
+				return sl_true;
+			}
+			Memory ret = Memory::create(size);
+			if (ret.isNotNull()) {
+				if (readFully(ret.getData(), size) == (sl_reg)size) {
+					*output = ret;
+					return sl_true;
+				}
+			}
+		}
+		return sl_false;
+	}
+
+	Memory BufferedReader::readSection(const Memory& def, sl_size maxSize)
+	{
+		Memory ret;
+		if (readSection(&ret, maxSize)) {
+			return ret;
+		}
+		return def;
+	}
+
+	Memory BufferedReader::readSection(sl_size maxSize)
+	{
+		Memory ret;
+		if (readSection(&ret, maxSize)) {
+			return ret;
+		}
+		return sl_null;
+	}
+
+	sl_bool BufferedReader::readStringSection(String* output, sl_size maxLen)
+	{
+		sl_size len;
+		if (readSizeCVLI(&len)) {
+			if (len > maxLen) {
+				return sl_false;
+			}
+			if (len == 0) {
+				output->setNull();
+				return sl_true;
+			}
+			if ((sl_size)(m_end - m_pos) >= len) {
+				String ret((char*)m_pos, len);
+				if (ret.isNotNull()) {
+					m_pos += len;
+					*output = ret;
+					return sl_true;
+				}
+				return sl_false;
+			}
+			String ret = String::allocate(len);
+			if (ret.isNotNull()) {
+				if (readFully(ret.getData(), len) == (sl_reg)len) {
+					*output = ret;
+					return sl_true;
+				}
+			}
+		}
+		return sl_false;
+	}
+
+	String BufferedReader::readStringSection(const String& def, sl_size maxLen)
+	{
+		String ret;
+		if (readStringSection(&ret, maxLen)) {
+			return ret;
+		} else {
+			return def;
+		}
+	}
+
+	String BufferedReader::readStringSection(sl_size maxLen)
+	{
+		String ret;
+		if (readStringSection(&ret, maxLen)) {
+			return ret;
+		} else {
+			return sl_null;
+		}
+	}
+
+	const sl_uint8* BufferedReader::_prepareReadSlow(sl_size size)
+	{
+		if (size > m_sizeBuf) {
+			return sl_null;
+		}
+		sl_size n = m_end - m_pos;
+		if (n && m_pos != m_buf) {
+			Base::moveMemory(m_buf, m_pos, n);
+		}
+		m_pos = m_buf;
+		m_end = m_buf + n;
+		while (n < size) {
+			if (!(_fill())) {
+				return sl_null;
+			}
+			n = m_end - m_pos;
+		}
+		sl_uint8* p = m_pos;
+		m_pos = p + size;
+		return p;
+	}
+
+	sl_bool BufferedReader::_fill()
+	{
+		IReader* reader = m_reader._ptr;
+		if (!reader) {
+			return sl_false;
+		}
+		sl_size nSpace = m_buf + m_sizeBuf - m_end;
+		if (!nSpace) {
+			return sl_false;
+		}
+		for (;;) {
+			sl_reg m = reader->read(m_end, nSpace);
+			if (m > 0) {
+				m_end += m;
+				return sl_true;
+			}
+			if (m < 0) {
+				return sl_false;
+			}
+			if (Thread::isStoppingCurrent()) {
+				return sl_false;
+			}
+			Thread::sleep(1);
+			if (Thread::isStoppingCurrent()) {
+				return sl_false;
+			}
+		}
+	}
+
+	sl_bool BufferedReader::_readUint32CVLISlow(sl_uint32* output)
+	{
+		sl_uint32 v = 0;
+		int m = 0;
+		while (1) {
+			sl_uint8 n;
+			if (readUint8(&n)) {
+				v += (((sl_uint32)(n & 127)) << m);
+				m += 7;
+				if ((n & 128) == 0) {
+					break;
+				}
+			} else {
+				return sl_false;
+			}
+		}
+		*output = v;
+		return sl_true;
+	}
+
+	sl_bool BufferedReader::_readUint64CVLISlow(sl_uint64* output)
+	{
+		sl_uint64 v = 0;
+		int m = 0;
+		while (1) {
+			sl_uint8 n;
+			if (readUint8(&n)) {
+				v += (((sl_uint64)(n & 127)) << m);
+				m += 7;
+				if ((n & 128) == 0) {
+					break;
+				}
+			} else {
+				return sl_false;
+			}
+		}
+		*output = v;
+		return sl_true;
+	}
+
+
+	SLIB_DEFINE_OBJECT(BufferedWriter, Object)
+
+	BufferedWriter::BufferedWriter()
+	{
+		m_buf = sl_null;
+		m_sizeBuf = 0;
+		m_pos = sl_null;
+		m_end = sl_null;
+	}
+
+	BufferedWriter::~BufferedWriter()
+	{
+		flush();
+		if (m_buf) {
+			Base::freeMemory(m_buf);
+		}
+	}
+
+	Ref<BufferedWriter> BufferedWriter::create(const Ptr<IWriter>& writer, sl_size bufferSize)
+	{
+		if (writer.isNull()) {
+			return sl_null;
+		}
+		if (bufferSize < PRIV_SLIB_BUFFERED_IO_MINIMUM_SIZE) {
+			bufferSize = PRIV_SLIB_BUFFERED_IO_MINIMUM_SIZE;
+		}
+		sl_uint8* buf = (sl_uint8*)(Base::createMemory(bufferSize));
+		if (buf) {
+			Ref<BufferedWriter> ret = new BufferedWriter;
+			if (ret.isNotNull()) {
+				ret->m_writer = writer;
+				ret->m_buf = buf;
+				ret->m_sizeBuf = bufferSize;
+				ret->m_pos = buf;
+				ret->m_end = buf + bufferSize;
+				return ret;
+			}
+			Base::freeMemory(buf);
+		}
+		return sl_null;
+	}
+
+	Ptr<IWriter> BufferedWriter::getWriter()
+	{
+		return m_writer;
+	}
+
+	void BufferedWriter::close()
+	{
+		flush();
+		m_writer.setNull();
+		// no more room for the writes
+		m_pos = m_buf;
+		m_end = m_buf;
+	}
+
+	sl_bool BufferedWriter::isOpened()
+	{
+		return m_writer.isNotNull();
+	}
+
+	sl_reg BufferedWriter::write(const void* buf, sl_size size)
+	{
+		if (!size) {
+			return 0;
+		}
+		// the large writes go directly to the underlying writer
+		if (size >= m_sizeBuf) {
+			if (!(flush())) {
+				return -1;
+			}
+			IWriter* writer = m_writer._ptr;
+			if (!writer) {
+				return -1;
+			}
+			return writer->write(buf, size);
+		}
+		if ((sl_size)(m_end - m_pos) < size) {
+			if (!(flush())) {
+				return -1;
+			}
+			if (!(m_writer._ptr)) {
+				return -1;
+			}
+		}
+		Base::copyMemory(m_pos, buf, size);
+		m_pos += size;
+		return size;
+	}
+
+	sl_bool BufferedWriter::flush()
+	{
+		sl_size n = m_pos - m_buf;
+		if (!n) {
+			return sl_true;
+		}
+		m_pos = m_buf;
+		IWriter* writer = m_writer._ptr;
+		if (!writer) {
+			return sl_false;
+		}
+		return writer->writeFully(m_buf, n) == (sl_reg)n;
+	}
+
+	sl_size BufferedWriter::getBufferedSize()
+	{
+		return m_pos - m_buf;
+	}
+
+	sl_uint8* BufferedWriter::_prepareWriteSlow(sl_size size)
+	{
+		if (!(flush())) {
+			return sl_null;
+		}
+		sl_uint8* p = m_pos;
+		if ((sl_size)(m_end - p) < size) {
+			return sl_null;
+		}
+		m_pos = p + size;
+		return p;
+	}
+
 }
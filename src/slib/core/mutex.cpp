@@ -26,6 +26,11 @@
 
 #if defined(SLIB_PLATFORM_IS_WINDOWS)
 #include <windows.h>
+#elif defined(SLIB_PLATFORM_IS_LINUX)
+#include "slib/core/system.h"
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #elif defined(SLIB_PLATFORM_IS_UNIX)
 #include <pthread.h>
 #endif
@@ -33,6 +38,110 @@
 namespace slib
 {
 
+#if defined(SLIB_PLATFORM_IS_LINUX)
+	
+	SLIB_THREAD sl_uint32 _gt_priv_Mutex_threadId = 0;
+	
+	SLIB_INLINE static sl_uint32 _priv_Mutex_getThreadId() noexcept
+	{
+		sl_uint32 tid = _gt_priv_Mutex_threadId;
+		if (tid) {
+			return tid;
+		}
+		tid = (sl_uint32)(::syscall(SYS_gettid));
+		_gt_priv_Mutex_threadId = tid;
+		return tid;
+	}
+	
+	SLIB_INLINE static sl_int32 _priv_Mutex_compareExchange(sl_int32* state, sl_int32 comparand, sl_int32 value) noexcept
+	{
+		__atomic_compare_exchange_n(state, &comparand, value, sl_false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+		return comparand;
+	}
+	
+	Mutex::Mutex() noexcept
+	 : m_state(0), m_owner(0), m_count(0)
+	{
+	}
+
+	Mutex::Mutex(const Mutex& other) noexcept
+	 : m_state(0), m_owner(0), m_count(0)
+	{
+	}
+	
+	Mutex::Mutex(Mutex&& other) noexcept
+	 : m_state(0), m_owner(0), m_count(0)
+	{
+	}
+
+	Mutex::~Mutex() noexcept
+	{
+	}
+	
+	void Mutex::lock() const noexcept
+	{
+		sl_uint32 tid = _priv_Mutex_getThreadId();
+		if (__atomic_load_n(&m_owner, __ATOMIC_RELAXED) == tid) {
+			m_count++;
+			return;
+		}
+		sl_int32 c = _priv_Mutex_compareExchange(&m_state, 0, 1);
+		if (c) {
+			// spins shortly before sleeping, most of the critical sections are short
+			sl_bool flagLocked = sl_false;
+			for (sl_uint32 i = 0; i < 100; i++) {
+				if (c != 2) {
+					if (!(_priv_Mutex_compareExchange(&m_state, 0, 1))) {
+						flagLocked = sl_true;
+						break;
+					}
+				}
+				System::yield(i);
+				c = __atomic_load_n(&m_state, __ATOMIC_RELAXED);
+			}
+			if (!flagLocked) {
+				c = __atomic_exchange_n(&m_state, 2, __ATOMIC_ACQUIRE);
+				while (c) {
+					::syscall(SYS_futex, &m_state, FUTEX_WAIT_PRIVATE, 2, sl_null, sl_null, 0);
+					c = __atomic_exchange_n(&m_state, 2, __ATOMIC_ACQUIRE);
+				}
+			}
+		}
+		__atomic_store_n(&m_owner, tid, __ATOMIC_RELAXED);
+		m_count = 1;
+	}
+
+	sl_bool Mutex::tryLock() const noexcept
+	{
+		sl_uint32 tid = _priv_Mutex_getThreadId();
+		if (__atomic_load_n(&m_owner, __ATOMIC_RELAXED) == tid) {
+			m_count++;
+			return sl_true;
+		}
+		if (_priv_Mutex_compareExchange(&m_state, 0, 1)) {
+			return sl_false;
+		}
+		__atomic_store_n(&m_owner, tid, __ATOMIC_RELAXED);
+		m_count = 1;
+		return sl_true;
+	}
+
+	void Mutex::unlock() const noexcept
+	{
+		if (__atomic_load_n(&m_owner, __ATOMIC_RELAXED) != _priv_Mutex_getThreadId()) {
+			return;
+		}
+		if (--m_count) {
+			return;
+		}
+		__atomic_store_n(&m_owner, 0, __ATOMIC_RELAXED);
+		if (__atomic_exchange_n(&m_state, 0, __ATOMIC_RELEASE) == 2) {
+			::syscall(SYS_futex, &m_state, FUTEX_WAKE_PRIVATE, 1, sl_null, sl_null, 0);
+		}
+	}
+	
+#else
+	
 	Mutex::Mutex() noexcept
 	 : m_object(sl_null)
 	{
@@ -141,6 +250,8 @@ namespace slib
 #endif
 	}
 	
+#endif
+	
 	SpinLock* Mutex::getSpinLock() const noexcept
 	{
 		return const_cast<SpinLock*>(&m_lock);
@@ -203,7 +203,18 @@ namespace slib
 		} else {
 			return sl_null;
 		}
-		SLIB_SCOPED_BUFFER(CT, 2048, buf, n);
+		// the unescaped string is not longer than the quoted part, so the buffer is not sized by the rest of the input
+		sl_size nQuoted = 1;
+		while (nQuoted < n && sz[nQuoted] != chEnd) {
+			if (sz[nQuoted] == '\\') {
+				nQuoted++;
+			}
+			nQuoted++;
+		}
+		if (nQuoted > n) {
+			nQuoted = n;
+		}
+		SLIB_SCOPED_BUFFER(CT, 2048, buf, nQuoted);
 		if (buf == sl_null) {
 			return sl_null;
 		}
@@ -34,6 +34,26 @@
 #include "slib/core/cast.h"
 #include "slib/core/math.h"
 #include "slib/core/locale.h"
+#include "slib/core/detail/simd.h"
+
+#include <string.h>
+
+#if defined(SLIB_ARCH_IS_X64) || (defined(SLIB_ARCH_IS_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#	define PRIV_STRING_SIMD_X86
+#	include <emmintrin.h>
+#	include <immintrin.h>
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#	endif
+#	if defined(__GNUC__) || defined(__clang__)
+#		define PRIV_TARGET_AVX2 __attribute__((target("avx2")))
+#	else
+#		define PRIV_TARGET_AVX2
+#	endif
+#elif defined(SLIB_ARCH_IS_ARM64)
+#	define PRIV_STRING_SIMD_NEON
+#	include <arm_neon.h>
+#endif
 
 namespace slib
 {
@@ -44,6 +64,285 @@ namespace slib
 	{
 	}
 
+	/*
+		Vectorized kernels for the 8-bit strings.
+		Substring search filters the candidate positions by the first and the last characters of the pattern
+		(16 positions per SSE2 block, 32 per AVX2 block which is selected at runtime), and case folding works on
+		16 bytes per block (8 bytes per word on the platforms without SIMD). All of them return exactly the same
+		results as the per-character loops, which are taken when `_priv_Simd::getLevel()` is `_priv_Simd::None`.
+	*/
+
+#if defined(PRIV_STRING_SIMD_X86)
+	SLIB_INLINE static sl_uint32 _priv_String_getLowestBitIndex(sl_uint32 mask)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return (sl_uint32)index;
+#else
+		return (sl_uint32)(__builtin_ctz(mask));
+#endif
+	}
+
+	// checks the candidates of `mask` (bit per position from `mem`)
+	SLIB_INLINE static const sl_char8* _priv_String_checkPatternCandidates(const sl_char8* mem, sl_uint32 mask, const sl_char8* pattern, sl_size countPattern)
+	{
+		while (mask) {
+			const sl_char8* pt = mem + _priv_String_getLowestBitIndex(mask);
+			if (countPattern <= 2 || Base::equalsMemory(pt + 1, pattern + 1, countPattern - 2)) {
+				return pt;
+			}
+			mask &= mask - 1;
+		}
+		return sl_null;
+	}
+
+	// searches the first `nBlocks` * 16 positions
+	static const sl_char8* _priv_String_findPattern_SSE2(const sl_char8* mem, sl_size nBlocks, const sl_char8* pattern, sl_size countPattern)
+	{
+		__m128i first = _mm_set1_epi8(pattern[0]);
+		__m128i last = _mm_set1_epi8(pattern[countPattern - 1]);
+		for (sl_size i = 0; i < nBlocks; i++) {
+			__m128i v0 = _mm_loadu_si128((const __m128i*)mem);
+			__m128i v1 = _mm_loadu_si128((const __m128i*)(mem + countPattern - 1));
+			sl_uint32 mask = (sl_uint32)(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(v0, first), _mm_cmpeq_epi8(v1, last))));
+			if (mask) {
+				const sl_char8* pt = _priv_String_checkPatternCandidates(mem, mask, pattern, countPattern);
+				if (pt) {
+					return pt;
+				}
+			}
+			mem += 16;
+		}
+		return sl_null;
+	}
+
+	// searches the first `nBlocks` * 32 positions
+	PRIV_TARGET_AVX2 static const sl_char8* _priv_String_findPattern_AVX2(const sl_char8* mem, sl_size nBlocks, const sl_char8* pattern, sl_size countPattern)
+	{
+		__m256i first = _mm256_set1_epi8(pattern[0]);
+		__m256i last = _mm256_set1_epi8(pattern[countPattern - 1]);
+		for (sl_size i = 0; i < nBlocks; i++) {
+			__m256i v0 = _mm256_loadu_si256((const __m256i*)mem);
+			__m256i v1 = _mm256_loadu_si256((const __m256i*)(mem + countPattern - 1));
+			sl_uint32 mask = (sl_uint32)(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(v0, first), _mm256_cmpeq_epi8(v1, last))));
+			if (mask) {
+				const sl_char8* pt = _priv_String_checkPatternCandidates(mem, mask, pattern, countPattern);
+				if (pt) {
+					return pt;
+				}
+			}
+			mem += 32;
+		}
+		return sl_null;
+	}
+
+	// flips the case of the characters in [from, from + 25]
+	SLIB_INLINE static __m128i _priv_String_changeCase_SSE2(__m128i v, __m128i offset, __m128i limit, __m128i bit)
+	{
+		__m128i mask = _mm_cmplt_epi8(_mm_add_epi8(v, offset), limit);
+		return _mm_xor_si128(v, _mm_and_si128(mask, bit));
+	}
+#elif defined(PRIV_STRING_SIMD_NEON)
+	// searches the first `nBlocks` * 16 positions
+	static const sl_char8* _priv_String_findPattern_NEON(const sl_char8* mem, sl_size nBlocks, const sl_char8* pattern, sl_size countPattern)
+	{
+		uint8x16_t first = vdupq_n_u8((sl_uint8)(pattern[0]));
+		uint8x16_t last = vdupq_n_u8((sl_uint8)(pattern[countPattern - 1]));
+		for (sl_size i = 0; i < nBlocks; i++) {
+			uint8x16_t v0 = vld1q_u8((const sl_uint8*)mem);
+			uint8x16_t v1 = vld1q_u8((const sl_uint8*)(mem + countPattern - 1));
+			uint8x16_t eq = vandq_u8(vceqq_u8(v0, first), vceqq_u8(v1, last));
+			// 4 bits per position
+			sl_uint64 mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+			while (mask) {
+				const sl_char8* pt = mem + (__builtin_ctzll(mask) >> 2);
+				if (countPattern <= 2 || Base::equalsMemory(pt + 1, pattern + 1, countPattern - 2)) {
+					return pt;
+				}
+				mask &= ~((sl_uint64)0xF << (__builtin_ctzll(mask) & ~3));
+			}
+			mem += 16;
+		}
+		return sl_null;
+	}
+#endif
+
+	// `count` >= `countPattern` >= 2
+	static const sl_char8* _priv_String_findPattern8(const sl_char8* mem, sl_size count, const sl_char8* pattern, sl_size countPattern) noexcept
+	{
+		sl_size nPositions = count - countPattern + 1;
+#if defined(PRIV_STRING_SIMD_X86)
+		_priv_Simd::Level level = _priv_Simd::getLevel();
+		if (nPositions >= 64 && level >= _priv_Simd::AVX2) {
+			sl_size nBlocks = nPositions >> 5;
+			const sl_char8* pt = _priv_String_findPattern_AVX2(mem, nBlocks, pattern, countPattern);
+			if (pt) {
+				return pt;
+			}
+			nBlocks <<= 5;
+			mem += nBlocks;
+			nPositions -= nBlocks;
+		}
+		if (nPositions >= 16 && level != _priv_Simd::None) {
+			sl_size nBlocks = nPositions >> 4;
+			const sl_char8* pt = _priv_String_findPattern_SSE2(mem, nBlocks, pattern, countPattern);
+			if (pt) {
+				return pt;
+			}
+			nBlocks <<= 4;
+			mem += nBlocks;
+			nPositions -= nBlocks;
+		}
+#elif defined(PRIV_STRING_SIMD_NEON)
+		if (nPositions >= 16 && _priv_Simd::getLevel() != _priv_Simd::None) {
+			sl_size nBlocks = nPositions >> 4;
+			const sl_char8* pt = _priv_String_findPattern_NEON(mem, nBlocks, pattern, countPattern);
+			if (pt) {
+				return pt;
+			}
+			nBlocks <<= 4;
+			mem += nBlocks;
+			nPositions -= nBlocks;
+		}
+#endif
+		while (nPositions) {
+			const sl_char8* pt = (const sl_char8*)(Base::findMemory(mem, pattern[0], nPositions));
+			if (pt == sl_null) {
+				return sl_null;
+			}
+			if (Base::equalsMemory(pt + 1, pattern + 1, countPattern - 1)) {
+				return pt;
+			}
+			nPositions -= pt - mem + 1;
+			mem = pt + 1;
+		}
+		return sl_null;
+	}
+
+	// flips the case of the ASCII characters in [from, from + 25]
+	static void _priv_String_copyChangingCase8(sl_char8* dst, const sl_char8* src, sl_size len, sl_uint8 from) noexcept
+	{
+		sl_size i = 0;
+#if defined(PRIV_STRING_SIMD_X86)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			__m128i offset = _mm_set1_epi8((char)(0x80 - from));
+			__m128i limit = _mm_set1_epi8((char)(-128 + 26));
+			__m128i bit = _mm_set1_epi8(0x20);
+			for (; i + 16 <= len; i += 16) {
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+				_mm_storeu_si128((__m128i*)(dst + i), _priv_String_changeCase_SSE2(v, offset, limit, bit));
+			}
+		}
+#elif defined(PRIV_STRING_SIMD_NEON)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			uint8x16_t vFrom = vdupq_n_u8(from);
+			uint8x16_t limit = vdupq_n_u8(26);
+			uint8x16_t bit = vdupq_n_u8(0x20);
+			for (; i + 16 <= len; i += 16) {
+				uint8x16_t v = vld1q_u8((const sl_uint8*)(src + i));
+				uint8x16_t mask = vcltq_u8(vsubq_u8(v, vFrom), limit);
+				vst1q_u8((sl_uint8*)(dst + i), veorq_u8(v, vandq_u8(mask, bit)));
+			}
+		}
+#else
+		sl_uint64 addFrom = SLIB_UINT64(0x0101010101010101) * (sl_uint8)(0x80 - from);
+		sl_uint64 addTo = SLIB_UINT64(0x0101010101010101) * (sl_uint8)(0x7F - (from + 25));
+		for (; i + 8 <= len; i += 8) {
+			sl_uint64 v;
+			memcpy(&v, src + i, 8);
+			sl_uint64 heptets = v & SLIB_UINT64(0x7F7F7F7F7F7F7F7F);
+			sl_uint64 mask = ((heptets + addFrom) ^ (heptets + addTo)) & ~v & SLIB_UINT64(0x8080808080808080);
+			v ^= mask >> 2;
+			memcpy(dst + i, &v, 8);
+		}
+#endif
+		for (; i < len; i++) {
+			sl_uint8 ch = (sl_uint8)(src[i]);
+			if ((sl_uint8)(ch - from) < 26) {
+				ch ^= 0x20;
+			}
+			dst[i] = (sl_char8)ch;
+		}
+	}
+
+	// returns the length of the leading part (multiple of the block size) which is equal ignoring the case,
+	// and doesn't contain null characters in `s1` when `flagStopAtNull` is set
+	static sl_size _priv_String_getEqualPrefixIgnoreCase8(const sl_char8* s1, const sl_char8* s2, sl_size len, sl_bool flagStopAtNull) noexcept
+	{
+		sl_size i = 0;
+#if defined(PRIV_STRING_SIMD_X86)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			__m128i offset = _mm_set1_epi8((char)(0x80 - 'a'));
+			__m128i limit = _mm_set1_epi8((char)(-128 + 26));
+			__m128i bit = _mm_set1_epi8(0x20);
+			__m128i zero = _mm_setzero_si128();
+			for (; i + 16 <= len; i += 16) {
+				__m128i v1 = _mm_loadu_si128((const __m128i*)(s1 + i));
+				__m128i v2 = _mm_loadu_si128((const __m128i*)(s2 + i));
+				__m128i eq = _mm_cmpeq_epi8(_priv_String_changeCase_SSE2(v1, offset, limit, bit), _priv_String_changeCase_SSE2(v2, offset, limit, bit));
+				if (flagStopAtNull) {
+					eq = _mm_andnot_si128(_mm_cmpeq_epi8(v1, zero), eq);
+				}
+				if (_mm_movemask_epi8(eq) != 0xFFFF) {
+					break;
+				}
+			}
+		}
+#elif defined(PRIV_STRING_SIMD_NEON)
+		if (_priv_Simd::getLevel() != _priv_Simd::None) {
+			uint8x16_t vFrom = vdupq_n_u8('a');
+			uint8x16_t limit = vdupq_n_u8(26);
+			uint8x16_t bit = vdupq_n_u8(0x20);
+			for (; i + 16 <= len; i += 16) {
+				uint8x16_t v1 = vld1q_u8((const sl_uint8*)(s1 + i));
+				uint8x16_t v2 = vld1q_u8((const sl_uint8*)(s2 + i));
+				v1 = veorq_u8(v1, vandq_u8(vcltq_u8(vsubq_u8(v1, vFrom), limit), bit));
+				v2 = veorq_u8(v2, vandq_u8(vcltq_u8(vsubq_u8(v2, vFrom), limit), bit));
+				uint8x16_t eq = vceqq_u8(v1, v2);
+				if (flagStopAtNull) {
+					eq = vandq_u8(eq, vtstq_u8(v1, v1));
+				}
+				if (vminvq_u8(eq) != 0xFF) {
+					break;
+				}
+			}
+		}
+#else
+		sl_uint64 addFrom = SLIB_UINT64(0x0101010101010101) * (sl_uint8)(0x80 - 'a');
+		sl_uint64 addTo = SLIB_UINT64(0x0101010101010101) * (sl_uint8)(0x7F - 'z');
+		for (; i + 8 <= len; i += 8) {
+			sl_uint64 v1, v2;
+			memcpy(&v1, s1 + i, 8);
+			memcpy(&v2, s2 + i, 8);
+			if (flagStopAtNull) {
+				if ((v1 - SLIB_UINT64(0x0101010101010101)) & ~v1 & SLIB_UINT64(0x8080808080808080)) {
+					break;
+				}
+			}
+			sl_uint64 h1 = v1 & SLIB_UINT64(0x7F7F7F7F7F7F7F7F);
+			sl_uint64 h2 = v2 & SLIB_UINT64(0x7F7F7F7F7F7F7F7F);
+			v1 ^= (((h1 + addFrom) ^ (h1 + addTo)) & ~v1 & SLIB_UINT64(0x8080808080808080)) >> 2;
+			v2 ^= (((h2 + addFrom) ^ (h2 + addTo)) & ~v2 & SLIB_UINT64(0x8080808080808080)) >> 2;
+			if (v1 != v2) {
+				break;
+			}
+		}
+#endif
+		return i;
+	}
+
+	template <class CT>
+	SLIB_INLINE static sl_size _priv_String_getEqualPrefixIgnoreCase(const CT*, const CT*, sl_size, sl_bool) noexcept
+	{
+		return 0;
+	}
+
+	SLIB_INLINE static sl_size _priv_String_getEqualPrefixIgnoreCase(const sl_char8* s1, const sl_char8* s2, sl_size len, sl_bool flagStopAtNull) noexcept
+	{
+		return _priv_String_getEqualPrefixIgnoreCase8(s1, s2, len, flagStopAtNull);
+	}
+
 	class _priv_TemplateFunc8
 	{
 	public:
@@ -66,6 +365,12 @@ namespace slib
 		{
 			return Base::resetMemory(dst, value, count);
 		}
+		
+		// `count` >= `countPattern` >= 2
+		SLIB_INLINE static const sl_char8* findPattern(const sl_char8* mem, sl_size count, const sl_char8* pattern, sl_size countPattern) noexcept
+		{
+			return _priv_String_findPattern8(mem, count, pattern, countPattern);
+		}
 	};
 
 	class _priv_TemplateFunc16
@@ -90,6 +395,24 @@ namespace slib
 		{
 			return Base::resetMemory2((sl_uint16*)dst, value, count);
 		}
+		
+		// `count` >= `countPattern` >= 2
+		static const sl_char16* findPattern(const sl_char16* mem, sl_size count, const sl_char16* pattern, sl_size countPattern) noexcept
+		{
+			sl_size nPositions = count - countPattern + 1;
+			while (nPositions) {
+				const sl_char16* pt = (const sl_char16*)(Base::findMemory2((sl_uint16*)mem, pattern[0], nPositions));
+				if (pt == sl_null) {
+					return sl_null;
+				}
+				if (Base::equalsMemory2((sl_uint16*)(pt + 1), (sl_uint16*)(pattern + 1), countPattern - 1)) {
+					return pt;
+				}
+				nPositions -= pt - mem + 1;
+				mem = pt + 1;
+			}
+			return sl_null;
+		}
 	};
 	
 	enum STRING_CONTAINER_TYPES {
@@ -1979,11 +2302,20 @@ namespace slib
 	}
 	
 	
+	// 4 characters per step: hash * 31^4 + c0 * 31^3 + c1 * 31^2 + c2 * 31 + c3 (same result as the per-character steps)
 	template <class CT>
 	SLIB_INLINE static sl_size _priv_String_calcHash(const CT* buf, sl_size len) noexcept
 	{
 		sl_size hash = 0;
-		for (sl_size i = 0; i < len; i++) {
+		sl_size i = 0;
+		for (; i + 4 <= len; i += 4) {
+			sl_size c0 = (sl_uint32)(buf[i]);
+			sl_size c1 = (sl_uint32)(buf[i + 1]);
+			sl_size c2 = (sl_uint32)(buf[i + 2]);
+			sl_size c3 = (sl_uint32)(buf[i + 3]);
+			hash = hash * 923521 + (c0 * 29791 + c1 * 961 + c2 * 31 + c3);
+		}
+		for (; i < len; i++) {
 			sl_uint32 ch = buf[i];
 			hash = hash * 31 + ch;
 		}
@@ -2055,7 +2387,19 @@ namespace slib
 	SLIB_INLINE static sl_size _priv_String_calcHashIgnoreCase(const CT* buf, sl_size len) noexcept
 	{
 		sl_size hash = 0;
-		for (sl_size i = 0; i < len; i++) {
+		sl_size i = 0;
+		for (; i + 4 <= len; i += 4) {
+			sl_uint32 c0 = buf[i];
+			sl_uint32 c1 = buf[i + 1];
+			sl_uint32 c2 = buf[i + 2];
+			sl_uint32 c3 = buf[i + 3];
+			c0 = SLIB_CHAR_LOWER_TO_UPPER(c0);
+			c1 = SLIB_CHAR_LOWER_TO_UPPER(c1);
+			c2 = SLIB_CHAR_LOWER_TO_UPPER(c2);
+			c3 = SLIB_CHAR_LOWER_TO_UPPER(c3);
+			hash = hash * 923521 + ((sl_size)c0 * 29791 + (sl_size)c1 * 961 + (sl_size)c2 * 31 + (sl_size)c3);
+		}
+		for (; i < len; i++) {
 			sl_uint32 ch = buf[i];
 			ch = SLIB_CHAR_LOWER_TO_UPPER(ch);
 			hash = hash * 31 + ch;
@@ -4444,7 +4788,7 @@ namespace slib
 		if (len != other.getLength()) {
 			return sl_false;
 		}
-		for (sl_size i = 0; i < len; i++) {
+		for (sl_size i = _priv_String_getEqualPrefixIgnoreCase8(s1, s2, len, sl_false); i < len; i++) {
 			sl_uint8 c1 = s1[i];
 			sl_uint8 c2 = s2[i];
 			c1 = SLIB_CHAR_LOWER_TO_UPPER(c1);
@@ -4502,7 +4846,7 @@ namespace slib
 		sl_size len1 = getLength();
 		sl_size len2 = other.getLength();
 		sl_size len = SLIB_MIN(len1, len2);
-		for (sl_size i = 0; i < len; i++) {
+		for (sl_size i = _priv_String_getEqualPrefixIgnoreCase8(s1, s2, len, sl_true); i < len; i++) {
 			sl_uint8 c1 = s1[i];
 			sl_uint8 c2 = s2[i];
 			c1 = SLIB_CHAR_LOWER_TO_UPPER(c1);
@@ -5097,18 +5441,11 @@ namespace slib
 				return -1;
 			}
 		}
-		while (start <= count - countPat) {
-			const CT* pt = (const CT*)(TT::findMemory(buf + start, bufPat[0], count - start - countPat + 1));
-			if (pt == sl_null) {
-				return -1;
-			}
-			if (TT::compareMemory(pt + 1, bufPat + 1, countPat - 1) == 0) {
-				return (sl_reg)(pt - buf);
-			} else {
-				start = (sl_size)(pt - buf + 1);
-			}
+		const CT* pt = TT::findPattern(buf + start, count - start, bufPat, countPat);
+		if (pt == sl_null) {
+			return -1;
 		}
-		return -1;
+		return (sl_reg)(pt - buf);
 	}
 
 	sl_reg String::indexOf(const String& pattern, sl_reg start) const noexcept
@@ -5612,6 +5949,16 @@ namespace slib
 		}
 	}
 
+	SLIB_INLINE static void _priv_String_copyMakingUpper(sl_char8* dst, const sl_char8* src, sl_size len) noexcept
+	{
+		_priv_String_copyChangingCase8(dst, src, len, 'a');
+	}
+
+	SLIB_INLINE static void _priv_String_copyMakingLower(sl_char8* dst, const sl_char8* src, sl_size len) noexcept
+	{
+		_priv_String_copyChangingCase8(dst, src, len, 'A');
+	}
+
 	void String::makeUpper() noexcept
 	{
 		_priv_String_copyMakingUpper(getData(), getData(), getLength());
@@ -8634,6 +8981,816 @@ https://docs.oracle.com/javase/7/docs/api/java/util/Formatter.html
 	}
 
 	
+/**********************************************************
+					String View
+**********************************************************/
+
+	SLIB_INLINE static sl_bool _priv_StringView_equalsMemory(const sl_char8* s1, const sl_char8* s2, sl_size count) noexcept
+	{
+		return Base::equalsMemory(s1, s2, count);
+	}
+
+	SLIB_INLINE static sl_bool _priv_StringView_equalsMemory(const sl_char16* s1, const sl_char16* s2, sl_size count) noexcept
+	{
+		return Base::equalsMemory2((sl_uint16*)s1, (sl_uint16*)s2, count);
+	}
+
+	SLIB_INLINE static sl_int32 _priv_StringView_compareObjects(const sl_char8* s1, sl_size len1, const sl_char8* s2, sl_size len2) noexcept
+	{
+		return _priv_String_compare_objects(s1, len1, s2, len2);
+	}
+
+	SLIB_INLINE static sl_int32 _priv_StringView_compareObjects(const sl_char16* s1, sl_size len1, const sl_char16* s2, sl_size len2) noexcept
+	{
+		return _priv_String16_compare_objects(s1, len1, s2, len2);
+	}
+
+	template <class CT>
+	SLIB_INLINE static sl_bool _priv_StringView_equals(const CT* s1, sl_size len1, const CT* s2, sl_size len2) noexcept
+	{
+		if (len1 != len2) {
+			return sl_false;
+		}
+		if (s1 == s2 || len1 == 0) {
+			return sl_true;
+		}
+		return _priv_StringView_equalsMemory(s1, s2, len1);
+	}
+
+	template <class CT>
+	SLIB_INLINE static sl_bool _priv_StringView_equalsIgnoreCase(const CT* s1, sl_size len1, const CT* s2, sl_size len2) noexcept
+	{
+		if (len1 != len2) {
+			return sl_false;
+		}
+		if (s1 == s2) {
+			return sl_true;
+		}
+		for (sl_size i = _priv_String_getEqualPrefixIgnoreCase(s1, s2, len1, sl_false); i < len1; i++) {
+			sl_uint32 c1 = s1[i];
+			sl_uint32 c2 = s2[i];
+			c1 = SLIB_CHAR_LOWER_TO_UPPER(c1);
+			c2 = SLIB_CHAR_LOWER_TO_UPPER(c2);
+			if (c1 != c2) {
+				return sl_false;
+			}
+		}
+		return sl_true;
+	}
+
+	template <class CT>
+	SLIB_INLINE static sl_int32 _priv_StringView_compare(const CT* s1, sl_size len1, const CT* s2, sl_size len2) noexcept
+	{
+		if (s1 == s2 && len1 == len2) {
+			return 0;
+		}
+		return _priv_StringView_compareObjects(s1, len1, s2, len2);
+	}
+
+	// same order as `String::compareIgnoreCase()` for the strings without null characters
+	template <class CT>
+	SLIB_INLINE static sl_int32 _priv_StringView_compareIgnoreCase(const CT* s1, sl_size len1, const CT* s2, sl_size len2) noexcept
+	{
+		sl_size len = SLIB_MIN(len1, len2);
+		for (sl_size i = _priv_String_getEqualPrefixIgnoreCase(s1, s2, len, sl_true); i < len; i++) {
+			sl_uint32 c1 = s1[i];
+			sl_uint32 c2 = s2[i];
+			c1 = SLIB_CHAR_LOWER_TO_UPPER(c1);
+			c2 = SLIB_CHAR_LOWER_TO_UPPER(c2);
+			if (c1 < c2) {
+				return -1;
+			}
+			if (c1 > c2) {
+				return 1;
+			}
+			if (c1 == 0) {
+				return 0;
+			}
+		}
+		if (len1 < len2) {
+			return -1;
+		}
+		if (len1 > len2) {
+			return 1;
+		}
+		return 0;
+	}
+
+	template <class VIEW, class CT>
+	SLIB_INLINE static VIEW _priv_StringView_substring(const CT* data, sl_reg count, sl_reg start, sl_reg end) noexcept
+	{
+		if (start < 0) {
+			start = 0;
+		}
+		if (end < 0 || end > count) {
+			end = count;
+		}
+		if (start >= end) {
+			return sl_null;
+		}
+		return VIEW(data + start, end - start);
+	}
+
+	template <class CT, class TT>
+	SLIB_INLINE static sl_reg _priv_StringView_indexOf(const CT* data, sl_size count, CT ch, sl_reg _start) noexcept
+	{
+		if (count == 0) {
+			return -1;
+		}
+		sl_size start;
+		if (_start < 0) {
+			start = 0;
+		} else {
+			start = _start;
+			if (start >= count) {
+				return -1;
+			}
+		}
+		const CT* pt = (const CT*)(TT::findMemory(data + start, ch, count - start));
+		if (pt == sl_null) {
+			return -1;
+		} else {
+			return (sl_reg)(pt - data);
+		}
+	}
+
+	template <class CT, class TT>
+	SLIB_INLINE static sl_reg _priv_StringView_lastIndexOf(const CT* data, sl_size count, CT ch, sl_reg _start) noexcept
+	{
+		if (count == 0) {
+			return -1;
+		}
+		sl_size start;
+		if (_start < 0) {
+			start = count - 1;
+		} else {
+			start = _start;
+			if (start >= count) {
+				start = count - 1;
+			}
+		}
+		const CT* pt = (const CT*)(TT::findMemoryReverse(data, ch, start + 1));
+		if (pt == sl_null) {
+			return -1;
+		} else {
+			return (sl_reg)(pt - data);
+		}
+	}
+
+	template <class CT>
+	SLIB_INLINE static sl_bool _priv_StringView_startsWith(const CT* s1, sl_size len1, const CT* s2, sl_size len2) noexcept
+	{
+		if (len2 == 0) {
+			return sl_true;
+		}
+		if (len1 < len2) {
+			return sl_false;
+		}
+		return _priv_StringView_equalsMemory(s1, s2, len2);
+	}
+
+	template <class CT>
+	SLIB_INLINE static sl_bool _priv_StringView_endsWith(const CT* s1, sl_size len1, const CT* s2, sl_size len2) noexcept
+	{
+		if (len2 == 0) {
+			return sl_true;
+		}
+		if (len1 < len2) {
+			return sl_false;
+		}
+		return _priv_StringView_equalsMemory(s1 + (len1 - len2), s2, len2);
+	}
+
+	String StringView::toString() const noexcept
+	{
+		if (m_data) {
+			return String(m_data, m_length);
+		}
+		return sl_null;
+	}
+
+	sl_size StringView::getHashCode() const noexcept
+	{
+		if (m_length) {
+			return _priv_String_calcHash(m_data, m_length);
+		}
+		return 0;
+	}
+
+	sl_size StringView::getHashCodeIgnoreCase() const noexcept
+	{
+		if (m_length) {
+			return _priv_String_calcHashIgnoreCase(m_data, m_length);
+		}
+		return 0;
+	}
+
+	sl_bool StringView::equals(const StringView& other) const noexcept
+	{
+		return _priv_StringView_equals(m_data, m_length, other.m_data, other.m_length);
+	}
+
+	sl_bool StringView::equalsIgnoreCase(const StringView& other) const noexcept
+	{
+		return _priv_StringView_equalsIgnoreCase(m_data, m_length, other.m_data, other.m_length);
+	}
+
+	sl_int32 StringView::compare(const StringView& other) const noexcept
+	{
+		return _priv_StringView_compare(m_data, m_length, other.m_data, other.m_length);
+	}
+
+	sl_int32 StringView::compareIgnoreCase(const StringView& other) const noexcept
+	{
+		return _priv_StringView_compareIgnoreCase(m_data, m_length, other.m_data, other.m_length);
+	}
+
+	StringView StringView::substring(sl_reg start, sl_reg end) const noexcept
+	{
+		return _priv_StringView_substring<StringView, sl_char8>(m_data, (sl_reg)m_length, start, end);
+	}
+
+	sl_reg StringView::indexOf(sl_char8 ch, sl_reg start) const noexcept
+	{
+		return _priv_StringView_indexOf<sl_char8, _priv_TemplateFunc8>(m_data, m_length, ch, start);
+	}
+
+	sl_reg StringView::indexOf(const StringView& str, sl_reg start) const noexcept
+	{
+		return _priv_String_indexOf<StringView, sl_char8, _priv_TemplateFunc8>(*this, str.m_data, str.m_length, start);
+	}
+
+	sl_reg StringView::lastIndexOf(sl_char8 ch, sl_reg start) const noexcept
+	{
+		return _priv_StringView_lastIndexOf<sl_char8, _priv_TemplateFunc8>(m_data, m_length, ch, start);
+	}
+
+	sl_reg StringView::lastIndexOf(const StringView& str, sl_reg start) const noexcept
+	{
+		return _priv_String_lastIndexOf<StringView, sl_char8, _priv_TemplateFunc8>(*this, str.m_data, str.m_length, start);
+	}
+
+	sl_bool StringView::startsWith(sl_char8 ch) const noexcept
+	{
+		return m_length && m_data[0] == ch;
+	}
+
+	sl_bool StringView::startsWith(const StringView& str) const noexcept
+	{
+		return _priv_StringView_startsWith(m_data, m_length, str.m_data, str.m_length);
+	}
+
+	sl_bool StringView::endsWith(sl_char8 ch) const noexcept
+	{
+		return m_length && m_data[m_length - 1] == ch;
+	}
+
+	sl_bool StringView::endsWith(const StringView& str) const noexcept
+	{
+		return _priv_StringView_endsWith(m_data, m_length, str.m_data, str.m_length);
+	}
+
+	sl_bool StringView::contains(sl_char8 ch) const noexcept
+	{
+		return indexOf(ch) >= 0;
+	}
+
+	sl_bool StringView::contains(const StringView& str) const noexcept
+	{
+		return indexOf(str) >= 0;
+	}
+
+	StringView StringView::trim() const noexcept
+	{
+		return _priv_String_trim<StringView, sl_char8>(*this);
+	}
+
+	StringView StringView::trimLeft() const noexcept
+	{
+		return _priv_String_trimLeft<StringView, sl_char8>(*this);
+	}
+
+	StringView StringView::trimRight() const noexcept
+	{
+		return _priv_String_trimRight<StringView, sl_char8>(*this);
+	}
+
+	List<StringView> StringView::split(const StringView& pattern) const noexcept
+	{
+		return _priv_String_split<StringView, sl_char8, _priv_TemplateFunc8>(*this, pattern.m_data, pattern.m_length);
+	}
+
+	sl_bool StringView::parseInt32(sl_int32 radix, sl_int32* _out) const noexcept
+	{
+		return m_length && _priv_String_parseInt(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_int32 StringView::parseInt32(sl_int32 radix, sl_int32 def) const noexcept
+	{
+		sl_int32 _out = def;
+		parseInt32(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView::parseUint32(sl_int32 radix, sl_uint32* _out) const noexcept
+	{
+		return m_length && _priv_String_parseUint(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_uint32 StringView::parseUint32(sl_int32 radix, sl_uint32 def) const noexcept
+	{
+		sl_uint32 _out = def;
+		parseUint32(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView::parseInt64(sl_int32 radix, sl_int64* _out) const noexcept
+	{
+		return m_length && _priv_String_parseInt(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_int64 StringView::parseInt64(sl_int32 radix, sl_int64 def) const noexcept
+	{
+		sl_int64 _out = def;
+		parseInt64(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView::parseUint64(sl_int32 radix, sl_uint64* _out) const noexcept
+	{
+		return m_length && _priv_String_parseUint(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_uint64 StringView::parseUint64(sl_int32 radix, sl_uint64 def) const noexcept
+	{
+		sl_uint64 _out = def;
+		parseUint64(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView::parseInt(sl_int32 radix, sl_reg* _out) const noexcept
+	{
+		return m_length && _priv_String_parseInt(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_reg StringView::parseInt(sl_int32 radix, sl_reg def) const noexcept
+	{
+		sl_reg _out = def;
+		parseInt(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView::parseSize(sl_int32 radix, sl_size* _out) const noexcept
+	{
+		return m_length && _priv_String_parseUint(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_size StringView::parseSize(sl_int32 radix, sl_size def) const noexcept
+	{
+		sl_size _out = def;
+		parseSize(radix, &_out);
+		return _out;
+	}
+
+	String::String(const StringView& str) noexcept
+	{
+		if (str.isNotNull()) {
+			m_container = _priv_String_create(str.getData(), str.getLength());
+		} else {
+			m_container = sl_null;
+		}
+	}
+
+	sl_bool String::equals(const StringView& other) const noexcept
+	{
+		return _priv_StringView_equals((const sl_char8*)(getData()), getLength(), other.getData(), other.getLength());
+	}
+
+	sl_int32 String::compare(const StringView& other) const noexcept
+	{
+		return _priv_StringView_compare((const sl_char8*)(getData()), getLength(), other.getData(), other.getLength());
+	}
+
+	sl_reg String::indexOf(const StringView& str, sl_reg start) const noexcept
+	{
+		return _priv_String_indexOf<String, sl_char8, _priv_TemplateFunc8>(*this, str.getData(), str.getLength(), start);
+	}
+
+	sl_reg String::lastIndexOf(const StringView& str, sl_reg start) const noexcept
+	{
+		return _priv_String_lastIndexOf<String, sl_char8, _priv_TemplateFunc8>(*this, str.getData(), str.getLength(), start);
+	}
+
+	sl_bool String::startsWith(const StringView& str) const noexcept
+	{
+		return _priv_StringView_startsWith((const sl_char8*)(getData()), getLength(), str.getData(), str.getLength());
+	}
+
+	sl_bool String::endsWith(const StringView& str) const noexcept
+	{
+		return _priv_StringView_endsWith((const sl_char8*)(getData()), getLength(), str.getData(), str.getLength());
+	}
+
+	sl_bool String::contains(const StringView& str) const noexcept
+	{
+		return indexOf(str) >= 0;
+	}
+
+	List<String> String::split(const StringView& pattern) const noexcept
+	{
+		return _priv_String_split<String, sl_char8, _priv_TemplateFunc8>(*this, pattern.getData(), pattern.getLength());
+	}
+
+	int Compare<StringView>::operator()(const StringView& a, const StringView& b) const noexcept
+	{
+		return a.compare(b);
+	}
+
+	sl_bool Equals<StringView>::operator()(const StringView& a, const StringView& b) const noexcept
+	{
+		return a.equals(b);
+	}
+
+	sl_size Hash<StringView>::operator()(const StringView& a) const noexcept
+	{
+		return a.getHashCode();
+	}
+
+	int Compare<String>::operator()(const String& a, const StringView& b) const noexcept
+	{
+		return a.compare(b);
+	}
+
+	int Compare<String>::operator()(const String& a, const sl_char8* b) const noexcept
+	{
+		return operator()(a, StringView(b));
+	}
+
+	sl_bool Equals<String>::operator()(const String& a, const StringView& b) const noexcept
+	{
+		return a.equals(b);
+	}
+
+	sl_bool Equals<String>::operator()(const String& a, const sl_char8* b) const noexcept
+	{
+		return operator()(a, StringView(b));
+	}
+
+	sl_size Hash<String>::operator()(const StringView& a) const noexcept
+	{
+		return a.getHashCode();
+	}
+
+	sl_size Hash<String>::operator()(const sl_char8* a) const noexcept
+	{
+		return StringView(a).getHashCode();
+	}
+
+	int CompareIgnoreCaseString::operator()(const String& a, const StringView& b) const noexcept
+	{
+		return _priv_StringView_compareIgnoreCase((const sl_char8*)(a.getData()), a.getLength(), b.getData(), b.getLength());
+	}
+
+	int CompareIgnoreCaseString::operator()(const String& a, const sl_char8* b) const noexcept
+	{
+		return operator()(a, StringView(b));
+	}
+
+	sl_bool EqualsIgnoreCaseString::operator()(const String& a, const StringView& b) const noexcept
+	{
+		return _priv_StringView_equalsIgnoreCase((const sl_char8*)(a.getData()), a.getLength(), b.getData(), b.getLength());
+	}
+
+	sl_bool EqualsIgnoreCaseString::operator()(const String& a, const sl_char8* b) const noexcept
+	{
+		return operator()(a, StringView(b));
+	}
+
+	sl_size HashIgnoreCaseString::operator()(const StringView& a) const noexcept
+	{
+		return a.getHashCodeIgnoreCase();
+	}
+
+	sl_size HashIgnoreCaseString::operator()(const sl_char8* a) const noexcept
+	{
+		return StringView(a).getHashCodeIgnoreCase();
+	}
+
+	String16 StringView16::toString() const noexcept
+	{
+		if (m_data) {
+			return String16(m_data, m_length);
+		}
+		return sl_null;
+	}
+
+	sl_size StringView16::getHashCode() const noexcept
+	{
+		if (m_length) {
+			return _priv_String_calcHash(m_data, m_length);
+		}
+		return 0;
+	}
+
+	sl_size StringView16::getHashCodeIgnoreCase() const noexcept
+	{
+		if (m_length) {
+			return _priv_String_calcHashIgnoreCase(m_data, m_length);
+		}
+		return 0;
+	}
+
+	sl_bool StringView16::equals(const StringView16& other) const noexcept
+	{
+		return _priv_StringView_equals(m_data, m_length, other.m_data, other.m_length);
+	}
+
+	sl_bool StringView16::equalsIgnoreCase(const StringView16& other) const noexcept
+	{
+		return _priv_StringView_equalsIgnoreCase(m_data, m_length, other.m_data, other.m_length);
+	}
+
+	sl_int32 StringView16::compare(const StringView16& other) const noexcept
+	{
+		return _priv_StringView_compare(m_data, m_length, other.m_data, other.m_length);
+	}
+
+	sl_int32 StringView16::compareIgnoreCase(const StringView16& other) const noexcept
+	{
+		return _priv_StringView_compareIgnoreCase(m_data, m_length, other.m_data, other.m_length);
+	}
+
+	StringView16 StringView16::substring(sl_reg start, sl_reg end) const noexcept
+	{
+		return _priv_StringView_substring<StringView16, sl_char16>(m_data, (sl_reg)m_length, start, end);
+	}
+
+	sl_reg StringView16::indexOf(sl_char16 ch, sl_reg start) const noexcept
+	{
+		return _priv_StringView_indexOf<sl_char16, _priv_TemplateFunc16>(m_data, m_length, ch, start);
+	}
+
+	sl_reg StringView16::indexOf(const StringView16& str, sl_reg start) const noexcept
+	{
+		return _priv_String_indexOf<StringView16, sl_char16, _priv_TemplateFunc16>(*this, str.m_data, str.m_length, start);
+	}
+
+	sl_reg StringView16::lastIndexOf(sl_char16 ch, sl_reg start) const noexcept
+	{
+		return _priv_StringView_lastIndexOf<sl_char16, _priv_TemplateFunc16>(m_data, m_length, ch, start);
+	}
+
+	sl_reg StringView16::lastIndexOf(const StringView16& str, sl_reg start) const noexcept
+	{
+		return _priv_String_lastIndexOf<StringView16, sl_char16, _priv_TemplateFunc16>(*this, str.m_data, str.m_length, start);
+	}
+
+	sl_bool StringView16::startsWith(sl_char16 ch) const noexcept
+	{
+		return m_length && m_data[0] == ch;
+	}
+
+	sl_bool StringView16::startsWith(const StringView16& str) const noexcept
+	{
+		return _priv_StringView_startsWith(m_data, m_length, str.m_data, str.m_length);
+	}
+
+	sl_bool StringView16::endsWith(sl_char16 ch) const noexcept
+	{
+		return m_length && m_data[m_length - 1] == ch;
+	}
+
+	sl_bool StringView16::endsWith(const StringView16& str) const noexcept
+	{
+		return _priv_StringView_endsWith(m_data, m_length, str.m_data, str.m_length);
+	}
+
+	sl_bool StringView16::contains(sl_char16 ch) const noexcept
+	{
+		return indexOf(ch) >= 0;
+	}
+
+	sl_bool StringView16::contains(const StringView16& str) const noexcept
+	{
+		return indexOf(str) >= 0;
+	}
+
+	StringView16 StringView16::trim() const noexcept
+	{
+		return _priv_String_trim<StringView16, sl_char16>(*this);
+	}
+
+	StringView16 StringView16::trimLeft() const noexcept
+	{
+		return _priv_String_trimLeft<StringView16, sl_char16>(*this);
+	}
+
+	StringView16 StringView16::trimRight() const noexcept
+	{
+		return _priv_String_trimRight<StringView16, sl_char16>(*this);
+	}
+
+	List<StringView16> StringView16::split(const StringView16& pattern) const noexcept
+	{
+		return _priv_String_split<StringView16, sl_char16, _priv_TemplateFunc16>(*this, pattern.m_data, pattern.m_length);
+	}
+
+	sl_bool StringView16::parseInt32(sl_int32 radix, sl_int32* _out) const noexcept
+	{
+		return m_length && _priv_String_parseInt(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_int32 StringView16::parseInt32(sl_int32 radix, sl_int32 def) const noexcept
+	{
+		sl_int32 _out = def;
+		parseInt32(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView16::parseUint32(sl_int32 radix, sl_uint32* _out) const noexcept
+	{
+		return m_length && _priv_String_parseUint(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_uint32 StringView16::parseUint32(sl_int32 radix, sl_uint32 def) const noexcept
+	{
+		sl_uint32 _out = def;
+		parseUint32(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView16::parseInt64(sl_int32 radix, sl_int64* _out) const noexcept
+	{
+		return m_length && _priv_String_parseInt(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_int64 StringView16::parseInt64(sl_int32 radix, sl_int64 def) const noexcept
+	{
+		sl_int64 _out = def;
+		parseInt64(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView16::parseUint64(sl_int32 radix, sl_uint64* _out) const noexcept
+	{
+		return m_length && _priv_String_parseUint(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_uint64 StringView16::parseUint64(sl_int32 radix, sl_uint64 def) const noexcept
+	{
+		sl_uint64 _out = def;
+		parseUint64(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView16::parseInt(sl_int32 radix, sl_reg* _out) const noexcept
+	{
+		return m_length && _priv_String_parseInt(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_reg StringView16::parseInt(sl_int32 radix, sl_reg def) const noexcept
+	{
+		sl_reg _out = def;
+		parseInt(radix, &_out);
+		return _out;
+	}
+
+	sl_bool StringView16::parseSize(sl_int32 radix, sl_size* _out) const noexcept
+	{
+		return m_length && _priv_String_parseUint(radix, m_data, 0, m_length, _out) == (sl_reg)m_length;
+	}
+
+	sl_size StringView16::parseSize(sl_int32 radix, sl_size def) const noexcept
+	{
+		sl_size _out = def;
+		parseSize(radix, &_out);
+		return _out;
+	}
+
+	String16::String16(const StringView16& str) noexcept
+	{
+		if (str.isNotNull()) {
+			m_container = _priv_String16_create(str.getData(), str.getLength());
+		} else {
+			m_container = sl_null;
+		}
+	}
+
+	sl_bool String16::equals(const StringView16& other) const noexcept
+	{
+		return _priv_StringView_equals((const sl_char16*)(getData()), getLength(), other.getData(), other.getLength());
+	}
+
+	sl_int32 String16::compare(const StringView16& other) const noexcept
+	{
+		return _priv_StringView_compare((const sl_char16*)(getData()), getLength(), other.getData(), other.getLength());
+	}
+
+	sl_reg String16::indexOf(const StringView16& str, sl_reg start) const noexcept
+	{
+		return _priv_String_indexOf<String16, sl_char16, _priv_TemplateFunc16>(*this, str.getData(), str.getLength(), start);
+	}
+
+	sl_reg String16::lastIndexOf(const StringView16& str, sl_reg start) const noexcept
+	{
+		return _priv_String_lastIndexOf<String16, sl_char16, _priv_TemplateFunc16>(*this, str.getData(), str.getLength(), start);
+	}
+
+	sl_bool String16::startsWith(const StringView16& str) const noexcept
+	{
+		return _priv_StringView_startsWith((const sl_char16*)(getData()), getLength(), str.getData(), str.getLength());
+	}
+
+	sl_bool String16::endsWith(const StringView16& str) const noexcept
+	{
+		return _priv_StringView_endsWith((const sl_char16*)(getData()), getLength(), str.getData(), str.getLength());
+	}
+
+	sl_bool String16::contains(const StringView16& str) const noexcept
+	{
+		return indexOf(str) >= 0;
+	}
+
+	List<String16> String16::split(const StringView16& pattern) const noexcept
+	{
+		return _priv_String_split<String16, sl_char16, _priv_TemplateFunc16>(*this, pattern.getData(), pattern.getLength());
+	}
+
+	int Compare<StringView16>::operator()(const StringView16& a, const StringView16& b) const noexcept
+	{
+		return a.compare(b);
+	}
+
+	sl_bool Equals<StringView16>::operator()(const StringView16& a, const StringView16& b) const noexcept
+	{
+		return a.equals(b);
+	}
+
+	sl_size Hash<StringView16>::operator()(const StringView16& a) const noexcept
+	{
+		return a.getHashCode();
+	}
+
+	int Compare<String16>::operator()(const String16& a, const StringView16& b) const noexcept
+	{
+		return a.compare(b);
+	}
+
+	int Compare<String16>::operator()(const String16& a, const sl_char16* b) const noexcept
+	{
+		return operator()(a, StringView16(b));
+	}
+
+	sl_bool Equals<String16>::operator()(const String16& a, const StringView16& b) const noexcept
+	{
+		return a.equals(b);
+	}
+
+	sl_bool Equals<String16>::operator()(const String16& a, const sl_char16* b) const noexcept
+	{
+		return operator()(a, StringView16(b));
+	}
+
+	sl_size Hash<String16>::operator()(const StringView16& a) const noexcept
+	{
+		return a.getHashCode();
+	}
+
+	sl_size Hash<String16>::operator()(const sl_char16* a) const noexcept
+	{
+		return StringView16(a).getHashCode();
+	}
+
+	int CompareIgnoreCaseString16::operator()(const String16& a, const StringView16& b) const noexcept
+	{
+		return _priv_StringView_compareIgnoreCase((const sl_char16*)(a.getData()), a.getLength(), b.getData(), b.getLength());
+	}
+
+	int CompareIgnoreCaseString16::operator()(const String16& a, const sl_char16* b) const noexcept
+	{
+		return operator()(a, StringView16(b));
+	}
+
+	sl_bool EqualsIgnoreCaseString16::operator()(const String16& a, const StringView16& b) const noexcept
+	{
+		return _priv_StringView_equalsIgnoreCase((const sl_char16*)(a.getData()), a.getLength(), b.getData(), b.getLength());
+	}
+
+	sl_bool EqualsIgnoreCaseString16::operator()(const String16& a, const sl_char16* b) const noexcept
+	{
+		return operator()(a, StringView16(b));
+	}
+
+	sl_size HashIgnoreCaseString16::operator()(const StringView16& a) const noexcept
+	{
+		return a.getHashCodeIgnoreCase();
+	}
+
+	sl_size HashIgnoreCaseString16::operator()(const sl_char16* a) const noexcept
+	{
+		return StringView16(a).getHashCodeIgnoreCase();
+	}
+
 /**********************************************************
 				String Buffer
 **********************************************************/
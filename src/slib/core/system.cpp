@@ -27,6 +27,17 @@
 #include "slib/core/log.h"
 #include "slib/core/list.h"
 #include "slib/core/safe_static.h"
+#include "slib/core/detail/simd.h"
+
+#if defined(SLIB_ARCH_IS_X64) || (defined(SLIB_ARCH_IS_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#	define PRIV_SIMD_X86
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#		include <immintrin.h>
+#	endif
+#elif defined(SLIB_ARCH_IS_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define PRIV_SIMD_NEON
+#endif
 
 namespace slib
 {
@@ -96,6 +107,71 @@ namespace slib
 	}
 
 
+	static sl_int32 _priv_Simd_detectLevel()
+	{
+#if defined(PRIV_SIMD_X86)
+		sl_bool flagSSSE3 = sl_false;
+		sl_bool flagAVX2 = sl_false;
+#	if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+		int nIds = info[0];
+		__cpuid(info, 1);
+		flagSSSE3 = (info[2] & (1 << 9)) != 0;
+		sl_bool flagOSXSave = (info[2] & (1 << 27)) != 0;
+		sl_bool flagAVX = (info[2] & (1 << 28)) != 0;
+		if (nIds >= 7 && flagOSXSave && flagAVX) {
+			if ((_xgetbv(0) & 6) == 6) {
+				__cpuidex(info, 7, 0);
+				flagAVX2 = (info[1] & (1 << 5)) != 0;
+			}
+		}
+#	else
+		__builtin_cpu_init();
+		flagSSSE3 = __builtin_cpu_supports("ssse3") != 0;
+		flagAVX2 = __builtin_cpu_supports("avx2") != 0;
+#	endif
+		if (!flagSSSE3) {
+			return _priv_Simd::Base;
+		}
+		return flagAVX2 ? _priv_Simd::AVX2 : _priv_Simd::SSSE3;
+#elif defined(PRIV_SIMD_NEON)
+		return _priv_Simd::Base;
+#else
+		return _priv_Simd::None;
+#endif
+	}
+
+	// detection is idempotent, so concurrent first calls are harmless
+	static volatile sl_int32 _g_priv_simd_detected = -1;
+	static volatile sl_int32 _g_priv_simd_limit = _priv_Simd::AVX2;
+	static volatile sl_int32 _g_priv_simd_level = -1;
+
+	_priv_Simd::Level _priv_Simd::getLevel() noexcept
+	{
+		sl_int32 level = _g_priv_simd_level;
+		if (level < 0) {
+			level = _g_priv_simd_detected;
+			if (level < 0) {
+				level = _priv_Simd_detectLevel();
+				_g_priv_simd_detected = level;
+			}
+			sl_int32 limit = _g_priv_simd_limit;
+			if (level > limit) {
+				level = limit;
+			}
+			_g_priv_simd_level = level;
+		}
+		return (Level)level;
+	}
+
+	void _priv_Simd::setLevelLimit(Level level) noexcept
+	{
+		_g_priv_simd_limit = level;
+		_g_priv_simd_level = -1;
+	}
+
+
 	SLIB_DEFINE_OBJECT(GlobalUniqueInstance, Object)
 	
 	GlobalUniqueInstance::GlobalUniqueInstance()
@@ -109,6 +109,16 @@ namespace slib
 		return ::GetCurrentProcessId();
 	}
 
+	sl_uint32 System::getProcessorsCount()
+	{
+		SYSTEM_INFO si;
+		::GetSystemInfo(&si);
+		if (si.dwNumberOfProcessors > 0) {
+			return (sl_uint32)(si.dwNumberOfProcessors);
+		}
+		return 1;
+	}
+
 	sl_uint32 System::getThreadId()
 	{
 		return ::GetCurrentThreadId();
@@ -22,6 +22,11 @@
 
 #include "slib/core/thread_pool.h"
 
+#include "slib/core/parallel.h"
+#include "slib/core/event.h"
+#include "slib/core/system.h"
+#include "slib/core/safe_static.h"
+
 namespace slib
 {
 
@@ -76,7 +81,7 @@ namespace slib
 		return (sl_uint32)(m_threadWorkers.getCount());
 	}
 
-	sl_bool ThreadPool::addTask(const Function<void()>& task)
+	sl_bool ThreadPool::addTask(InlineFunction<void()>&& task)
 	{
 		if (task.isNull()) {
 			return sl_false;
@@ -86,7 +91,7 @@ namespace slib
 			return sl_false;
 		}
 		// add task
-		if (!(m_tasks.push(task))) {
+		if (!(m_tasks.push(Move(task)))) {
 			return sl_false;
 		}
 
@@ -124,11 +129,15 @@ namespace slib
 			return;
 		}
 		while (m_flagRunning && Thread::isNotStoppingCurrent()) {
-			Function<void()> task;
+			InlineFunction<void()> task;
 			if (m_tasks.pop(&task)) {
 				task();
 			} else {
 				ObjectLocker lock(this);
+				if (!(m_tasks.isEmpty())) {
+					// a task was added after the queue had been checked
+					continue;
+				}
 				sl_size nThreads = m_threadWorkers.getCount();
 				if (nThreads > getMinimumThreadsCount()) {
 					m_threadWorkers.remove_NoLock(thread);
@@ -142,4 +151,134 @@ namespace slib
 		}
 	}
 
+
+	class _priv_ParallelTasks : public Referable
+	{
+	public:
+		Function<void(sl_size)> task;
+		sl_size count;
+		sl_reg indexNext;
+		sl_reg countDone;
+		Ref<Event> eventDone;
+
+	public:
+		_priv_ParallelTasks(const Function<void(sl_size)>& _task, sl_size _count): task(_task), count(_count), indexNext(0), countDone(0)
+		{
+			eventDone = Event::create(sl_false);
+		}
+
+	public:
+		void process()
+		{
+			for (;;) {
+				sl_size index = (sl_size)(Base::interlockedIncrement(&indexNext) - 1);
+				if (index >= count) {
+					return;
+				}
+				task(index);
+				if ((sl_size)(Base::interlockedIncrement(&countDone)) == count) {
+					eventDone->set();
+				}
+			}
+		}
+
+		void wait()
+		{
+			while ((sl_size)(Base::interlockedAdd(&countDone, 0)) != count) {
+				eventDone->wait();
+			}
+		}
+
+	};
+
+	static sl_uint32 _g_priv_parallel_concurrency = 0;
+
+	SLIB_SAFE_STATIC_GETTER(Ref<ThreadPool>, _priv_Parallel_getThreadPool, ThreadPool::create())
+
+	sl_uint32 Parallel::getConcurrency() noexcept
+	{
+		sl_uint32 n = _g_priv_parallel_concurrency;
+		if (n) {
+			return n;
+		}
+		static sl_uint32 nProcessors = 0;
+		if (!nProcessors) {
+			nProcessors = System::getProcessorsCount();
+		}
+		return nProcessors;
+	}
+
+	void Parallel::setConcurrency(sl_uint32 n) noexcept
+	{
+		_g_priv_parallel_concurrency = n;
+	}
+
+	Ref<ThreadPool> Parallel::getThreadPool() noexcept
+	{
+		Ref<ThreadPool>* pool = _priv_Parallel_getThreadPool();
+		if (pool) {
+			return *pool;
+		}
+		return sl_null;
+	}
+
+	void Parallel::run(sl_size nTasks, const Function<void(sl_size index)>& task) noexcept
+	{
+		if (!nTasks) {
+			return;
+		}
+		sl_uint32 nThreads = getConcurrency();
+		Ref<ThreadPool> pool;
+		if (nTasks > 1 && nThreads > 1) {
+			pool = getThreadPool();
+		}
+		if (pool.isNull()) {
+			for (sl_size i = 0; i < nTasks; i++) {
+				task(i);
+			}
+			return;
+		}
+		Ref<_priv_ParallelTasks> tasks = new _priv_ParallelTasks(task, nTasks);
+		if (tasks.isNull() || tasks->eventDone.isNull()) {
+			for (sl_size i = 0; i < nTasks; i++) {
+				task(i);
+			}
+			return;
+		}
+		sl_uint32 nWorkers = nThreads - 1;
+		if (nTasks <= nWorkers) {
+			nWorkers = (sl_uint32)(nTasks - 1);
+		}
+		// keeps the workers sleeping between the calls
+		if (pool->getMinimumThreadsCount() < nWorkers) {
+			pool->setMinimumThreadsCount(nWorkers);
+		}
+		if (pool->getMaximumThreadsCount() < nWorkers) {
+			pool->setMaximumThreadsCount(nWorkers);
+		}
+		for (sl_uint32 i = 0; i < nWorkers; i++) {
+			pool->addTask([tasks]() {
+				tasks->process();
+			});
+		}
+		tasks->process();
+		tasks->wait();
+	}
+
+	sl_size Parallel::_getGrainSize(sl_size count, sl_size grainSize) noexcept
+	{
+		if (grainSize) {
+			return grainSize;
+		}
+		sl_uint32 nThreads = getConcurrency();
+		if (nThreads < 2) {
+			return count;
+		}
+		sl_size grain = count / (nThreads << 2);
+		if (!grain) {
+			grain = 1;
+		}
+		return grain;
+	}
+
 }
@@ -26,6 +26,8 @@
 
 #include "slib/core/string_buffer.h"
 #include "slib/core/math.h"
+#include "slib/core/io.h"
+#include "slib/core/mio.h"
 
 #define PTR_VAR(TYPE, x) (reinterpret_cast<TYPE*>(&(x)))
 #define REF_VAR(TYPE, x) (*PTR_VAR(TYPE, x))
@@ -4774,4 +4776,944 @@ namespace slib
 		return !(v1 == v2);
 	}
 
+#define PRIV_SLIB_VARIANT_BINARY_NULL 0
+#define PRIV_SLIB_VARIANT_BINARY_FALSE 1
+#define PRIV_SLIB_VARIANT_BINARY_TRUE 2
+#define PRIV_SLIB_VARIANT_BINARY_INT32 3
+#define PRIV_SLIB_VARIANT_BINARY_UINT32 4
+#define PRIV_SLIB_VARIANT_BINARY_INT64 5
+#define PRIV_SLIB_VARIANT_BINARY_UINT64 6
+#define PRIV_SLIB_VARIANT_BINARY_FLOAT 7
+#define PRIV_SLIB_VARIANT_BINARY_DOUBLE 8
+#define PRIV_SLIB_VARIANT_BINARY_STRING 9
+#define PRIV_SLIB_VARIANT_BINARY_TIME 10
+#define PRIV_SLIB_VARIANT_BINARY_MEMORY 11
+#define PRIV_SLIB_VARIANT_BINARY_LIST 12
+#define PRIV_SLIB_VARIANT_BINARY_MAP 13
+#define PRIV_SLIB_VARIANT_BINARY_HASH_MAP 14
+
+#define PRIV_SLIB_VARIANT_BINARY_MAX_DEPTH 256
+#define PRIV_SLIB_VARIANT_BINARY_WRITE_BUFFER_SIZE 512
+
+	SLIB_INLINE static sl_uint64 _priv_VariantBinary_encodeSigned(sl_int64 v) noexcept
+	{
+		// zigzag: small negative numbers are encoded by small CVLI
+		return (((sl_uint64)v) << 1) ^ ((sl_uint64)(v >> 63));
+	}
+	
+	SLIB_INLINE static sl_int64 _priv_VariantBinary_decodeSigned(sl_uint64 v) noexcept
+	{
+		return (sl_int64)(v >> 1) ^ -((sl_int64)(v & 1));
+	}
+	
+	class _priv_VariantBinary_SizeOutput
+	{
+	public:
+		sl_size size;
+		// body sizes of the containers in the order of writing, used by the second pass
+		List<sl_size> containerSizes;
+		
+	public:
+		_priv_VariantBinary_SizeOutput() noexcept: size(0) {}
+		
+	public:
+		sl_bool write(const void* data, sl_size n) noexcept
+		{
+			size += n;
+			return sl_true;
+		}
+		
+		sl_bool writeByte(sl_uint8 n) noexcept
+		{
+			size++;
+			return sl_true;
+		}
+		
+		sl_bool writeMemory(const Memory& mem) noexcept
+		{
+			size += mem.getSize();
+			return sl_true;
+		}
+		
+	};
+	
+	// consumes the container sizes counted by `_priv_VariantBinary_SizeOutput`
+	class _priv_VariantBinary_CountedOutput
+	{
+	public:
+		const sl_size* containerSizes;
+		sl_size countContainerSizes;
+		sl_size indexContainerSize;
+		
+	public:
+		_priv_VariantBinary_CountedOutput() noexcept: containerSizes(sl_null), countContainerSizes(0), indexContainerSize(0) {}
+		
+	public:
+		void setContainerSizes(const List<sl_size>& list) noexcept
+		{
+			containerSizes = list.getData();
+			countContainerSizes = list.getCount();
+			indexContainerSize = 0;
+		}
+		
+		sl_bool getNextContainerSize(sl_size& size) noexcept
+		{
+			if (indexContainerSize < countContainerSizes) {
+				size = containerSizes[indexContainerSize++];
+				return sl_true;
+			}
+			return sl_false;
+		}
+		
+	};
+	
+	class _priv_VariantBinary_MemoryOutput : public _priv_VariantBinary_CountedOutput
+	{
+	public:
+		sl_uint8* begin;
+		sl_uint8* pos;
+		sl_uint8* end;
+		
+	public:
+		_priv_VariantBinary_MemoryOutput(void* data, sl_size size) noexcept: begin((sl_uint8*)data), pos((sl_uint8*)data), end((sl_uint8*)data + size) {}
+		
+	public:
+		sl_size getOffset() noexcept
+		{
+			return pos - begin;
+		}
+		
+
+		sl_bool write(const void* data, sl_size n) noexcept
+		{
+			if (n > (sl_size)(end - pos)) {
+				return sl_false;
+			}
+			Base::copyMemory(pos, data, n);
+			pos += n;
+			return sl_true;
+		}
+		
+		sl_bool writeByte(sl_uint8 n) noexcept
+		{
+			if (pos < end) {
+				*(pos++) = n;
+				return sl_true;
+			}
+			return sl_false;
+		}
+		
+		sl_bool writeMemory(const Memory& mem) noexcept
+		{
+			return write(mem.getData(), mem.getSize());
+		}
+		
+	};
+	
+	// collects the small writes, and passes them to `SINK::writeOut()`
+	template <class SINK>
+	class _priv_VariantBinary_BufferedOutput : public _priv_VariantBinary_CountedOutput
+	{
+	public:
+		sl_uint8 buf[PRIV_SLIB_VARIANT_BINARY_WRITE_BUFFER_SIZE];
+		sl_size sizeBuf;
+		sl_size offset;
+		
+	public:
+		_priv_VariantBinary_BufferedOutput() noexcept: sizeBuf(0), offset(0) {}
+		
+	public:
+		sl_size getOffset() noexcept
+		{
+			return offset;
+		}
+		
+		sl_bool write(const void* data, sl_size n) noexcept
+		{
+			offset += n;
+			if (sizeBuf + n <= sizeof(buf)) {
+				Base::copyMemory(buf + sizeBuf, data, n);
+				sizeBuf += n;
+				return sl_true;
+			}
+			if (!(flush())) {
+				return sl_false;
+			}
+			if (n < sizeof(buf)) {
+				Base::copyMemory(buf, data, n);
+				sizeBuf = n;
+				return sl_true;
+			}
+			return ((SINK*)this)->writeOut(data, n);
+		}
+		
+		sl_bool writeByte(sl_uint8 n) noexcept
+		{
+			if (sizeBuf < sizeof(buf)) {
+				buf[sizeBuf++] = n;
+				offset++;
+				return sl_true;
+			}
+			return write(&n, 1);
+		}
+		
+		sl_bool writeMemory(const Memory& mem) noexcept
+		{
+			return write(mem.getData(), mem.getSize());
+		}
+		
+		sl_bool flush() noexcept
+		{
+			if (sizeBuf) {
+				sl_size n = sizeBuf;
+				sizeBuf = 0;
+				return ((SINK*)this)->writeOut(buf, n);
+			}
+			return sl_true;
+		}
+		
+	};
+	
+	class _priv_VariantBinary_WriterOutput : public _priv_VariantBinary_BufferedOutput<_priv_VariantBinary_WriterOutput>
+	{
+	public:
+		IWriter* writer;
+		
+	public:
+		_priv_VariantBinary_WriterOutput(IWriter* _writer) noexcept: writer(_writer) {}
+		
+	public:
+		sl_bool writeOut(const void* data, sl_size n) noexcept
+		{
+			return writer->writeFully(data, n) == (sl_reg)n;
+		}
+		
+	};
+	
+	class _priv_VariantBinary_QueueOutput : public _priv_VariantBinary_BufferedOutput<_priv_VariantBinary_QueueOutput>
+	{
+	public:
+		MemoryQueue* queue;
+		
+	public:
+		_priv_VariantBinary_QueueOutput(MemoryQueue* _queue) noexcept: queue(_queue) {}
+		
+	public:
+		sl_bool writeOut(const void* data, sl_size n) noexcept
+		{
+			Memory mem = Memory::create(data, n);
+			if (mem.isNull()) {
+				return sl_false;
+			}
+			return queue->add(mem);
+		}
+		
+		sl_bool writeMemory(const Memory& mem) noexcept
+		{
+			if (mem.getSize() < PRIV_SLIB_VARIANT_BINARY_WRITE_BUFFER_SIZE) {
+				return write(mem.getData(), mem.getSize());
+			}
+			if (!(flush())) {
+				return sl_false;
+			}
+			offset += mem.getSize();
+			return queue->add(mem);
+		}
+		
+	};
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_writeCVLI(OUTPUT& output, sl_uint64 value) noexcept
+	{
+		sl_uint8 buf[10];
+		sl_uint32 n = 0;
+		while (value >= 128) {
+			buf[n++] = (sl_uint8)(value | 128);
+			value >>= 7;
+		}
+		buf[n++] = (sl_uint8)value;
+		return output.write(buf, n);
+	}
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_writeTagAndCVLI(OUTPUT& output, sl_uint8 tag, sl_uint64 value) noexcept
+	{
+		if (!(output.writeByte(tag))) {
+			return sl_false;
+		}
+		return _priv_VariantBinary_writeCVLI(output, value);
+	}
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_writeString(OUTPUT& output, const sl_char8* sz, sl_size len) noexcept
+	{
+		if (!(_priv_VariantBinary_writeCVLI(output, len))) {
+			return sl_false;
+		}
+		return output.write(sz, len);
+	}
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_write(OUTPUT& output, const Variant& v, sl_uint32 depth) noexcept;
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_writeListBody(OUTPUT& output, CList<Variant>* list, sl_uint32 depth) noexcept
+	{
+		sl_size n = list->getCount();
+		if (!(_priv_VariantBinary_writeCVLI(output, n))) {
+			return sl_false;
+		}
+		Variant* data = list->getData();
+		for (sl_size i = 0; i < n; i++) {
+			if (!(_priv_VariantBinary_write(output, data[i], depth))) {
+				return sl_false;
+			}
+		}
+		return sl_true;
+	}
+	
+	template <class OUTPUT, class MAP>
+	static sl_bool _priv_VariantBinary_writeMapBody(OUTPUT& output, MAP* map, sl_uint32 depth) noexcept
+	{
+		if (!(_priv_VariantBinary_writeCVLI(output, map->getCount()))) {
+			return sl_false;
+		}
+		for (auto& item : *map) {
+			if (!(_priv_VariantBinary_writeString(output, item.key.getData(), item.key.getLength()))) {
+				return sl_false;
+			}
+			if (!(_priv_VariantBinary_write(output, item.value, depth))) {
+				return sl_false;
+			}
+		}
+		return sl_true;
+	}
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_writeContainerBody(OUTPUT& output, CList<Variant>* list, sl_uint32 depth) noexcept
+	{
+		return _priv_VariantBinary_writeListBody(output, list, depth);
+	}
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_writeContainerBody(OUTPUT& output, CMap<String, Variant>* map, sl_uint32 depth) noexcept
+	{
+		return _priv_VariantBinary_writeMapBody(output, map, depth);
+	}
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_writeContainerBody(OUTPUT& output, CHashMap<String, Variant>* map, sl_uint32 depth) noexcept
+	{
+		return _priv_VariantBinary_writeMapBody(output, map, depth);
+	}
+	
+	// first pass: counts the body of every container once, and records the sizes in the order of writing
+	template <class CONTAINER>
+	static sl_bool _priv_VariantBinary_writeContainer(_priv_VariantBinary_SizeOutput& output, sl_uint8 tag, CONTAINER* container, sl_uint32 depth) noexcept
+	{
+		ObjectLocker lock(container);
+		sl_size index = output.containerSizes.getCount();
+		if (!(output.containerSizes.add_NoLock(0))) {
+			return sl_false;
+		}
+		sl_size start = output.size;
+		if (!(_priv_VariantBinary_writeContainerBody(output, container, depth + 1))) {
+			return sl_false;
+		}
+		sl_size size = output.size - start;
+		*(output.containerSizes.getPointerAt(index)) = size;
+		return _priv_VariantBinary_writeTagAndCVLI(output, tag, size);
+	}
+	
+	// second pass: writes the size prefix recorded by the first pass
+	template <class OUTPUT, class CONTAINER>
+	static sl_bool _priv_VariantBinary_writeContainer(OUTPUT& output, sl_uint8 tag, CONTAINER* container, sl_uint32 depth) noexcept
+	{
+		ObjectLocker lock(container);
+		sl_size size;
+		if (!(output.getNextContainerSize(size))) {
+			return sl_false;
+		}
+		if (!(_priv_VariantBinary_writeTagAndCVLI(output, tag, size))) {
+			return sl_false;
+		}
+		sl_size start = output.getOffset();
+		if (!(_priv_VariantBinary_writeContainerBody(output, container, depth + 1))) {
+			return sl_false;
+		}
+		// the containers can be changed by other threads between the passes
+		return output.getOffset() - start == size;
+	}
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_writeCounted(OUTPUT& output, const Variant& v) noexcept
+	{
+		_priv_VariantBinary_SizeOutput counter;
+		if (!(_priv_VariantBinary_write(counter, v, 0))) {
+			return sl_false;
+		}
+		output.setContainerSizes(counter.containerSizes);
+		return _priv_VariantBinary_write(output, v, 0);
+	}
+	
+	template <class OUTPUT>
+	static sl_bool _priv_VariantBinary_write(OUTPUT& output, const Variant& v, sl_uint32 depth) noexcept
+	{
+		switch (v.getType()) {
+			case VariantType::Int32:
+				return _priv_VariantBinary_writeTagAndCVLI(output, PRIV_SLIB_VARIANT_BINARY_INT32, _priv_VariantBinary_encodeSigned(v.getInt32()));
+			case VariantType::Uint32:
+				return _priv_VariantBinary_writeTagAndCVLI(output, PRIV_SLIB_VARIANT_BINARY_UINT32, v.getUint32());
+			case VariantType::Int64:
+				return _priv_VariantBinary_writeTagAndCVLI(output, PRIV_SLIB_VARIANT_BINARY_INT64, _priv_VariantBinary_encodeSigned(v.getInt64()));
+			case VariantType::Uint64:
+				return _priv_VariantBinary_writeTagAndCVLI(output, PRIV_SLIB_VARIANT_BINARY_UINT64, v.getUint64());
+			case VariantType::Float:
+				{
+					sl_uint8 buf[5];
+					buf[0] = PRIV_SLIB_VARIANT_BINARY_FLOAT;
+					MIO::writeFloatLE(buf + 1, v.getFloat());
+					return output.write(buf, 5);
+				}
+			case VariantType::Double:
+				{
+					sl_uint8 buf[9];
+					buf[0] = PRIV_SLIB_VARIANT_BINARY_DOUBLE;
+					MIO::writeDoubleLE(buf + 1, v.getDouble());
+					return output.write(buf, 9);
+				}
+			case VariantType::Boolean:
+				return output.writeByte(v.getBoolean() ? PRIV_SLIB_VARIANT_BINARY_TRUE : PRIV_SLIB_VARIANT_BINARY_FALSE);
+			case VariantType::String8:
+				{
+					const String& str = *(PTR_VAR(String const, v._value));
+					if (!(output.writeByte(PRIV_SLIB_VARIANT_BINARY_STRING))) {
+						return sl_false;
+					}
+					return _priv_VariantBinary_writeString(output, str.getData(), str.getLength());
+				}
+			case VariantType::Sz8:
+				{
+					const sl_char8* sz = REF_VAR(sl_char8 const* const, v._value);
+					if (!(output.writeByte(PRIV_SLIB_VARIANT_BINARY_STRING))) {
+						return sl_false;
+					}
+					return _priv_VariantBinary_writeString(output, sz, Base::getStringLength(sz));
+				}
+			case VariantType::String16:
+			case VariantType::Sz16:
+				{
+					String str = v.getString();
+					if (!(output.writeByte(PRIV_SLIB_VARIANT_BINARY_STRING))) {
+						return sl_false;
+					}
+					return _priv_VariantBinary_writeString(output, str.getData(), str.getLength());
+				}
+			case VariantType::Time:
+				return _priv_VariantBinary_writeTagAndCVLI(output, PRIV_SLIB_VARIANT_BINARY_TIME, _priv_VariantBinary_encodeSigned(v.getTime().toInt()));
+			case VariantType::Object:
+			case VariantType::Weak:
+				if (depth < PRIV_SLIB_VARIANT_BINARY_MAX_DEPTH) {
+					Ref<Referable> obj(v.getObject());
+					if (obj.isNotNull()) {
+						if (CMemory* p0 = CastInstance<CMemory>(obj._ptr)) {
+							Memory mem(p0);
+							if (!(_priv_VariantBinary_writeTagAndCVLI(output, PRIV_SLIB_VARIANT_BINARY_MEMORY, mem.getSize()))) {
+								return sl_false;
+							}
+							return output.writeMemory(mem);
+						} else if (CList<Variant>* p1 = CastInstance< CList<Variant> >(obj._ptr)) {
+							return _priv_VariantBinary_writeContainer(output, PRIV_SLIB_VARIANT_BINARY_LIST, p1, depth);
+						} else if (CMap<String, Variant>* p2 = CastInstance< CMap<String, Variant> >(obj._ptr)) {
+							return _priv_VariantBinary_writeContainer(output, PRIV_SLIB_VARIANT_BINARY_MAP, p2, depth);
+						} else if (CHashMap<String, Variant>* p3 = CastInstance< CHashMap<String, Variant> >(obj._ptr)) {
+							return _priv_VariantBinary_writeContainer(output, PRIV_SLIB_VARIANT_BINARY_HASH_MAP, p3, depth);
+						}
+					}
+				}
+				break;
+			default:
+				break;
+		}
+		return output.writeByte(PRIV_SLIB_VARIANT_BINARY_NULL);
+	}
+	
+	sl_size Variant::getSerializedSize() const noexcept
+	{
+		_priv_VariantBinary_SizeOutput output;
+		_priv_VariantBinary_write(output, *this, 0);
+		return output.size;
+	}
+	
+	Memory Variant::serialize() const noexcept
+	{
+		_priv_VariantBinary_SizeOutput counter;
+		if (!(_priv_VariantBinary_write(counter, *this, 0))) {
+			return sl_null;
+		}
+		sl_size size = counter.size;
+		Memory mem = Memory::create(size);
+		if (mem.isNotNull()) {
+			_priv_VariantBinary_MemoryOutput output(mem.getData(), size);
+			output.setContainerSizes(counter.containerSizes);
+			if (_priv_VariantBinary_write(output, *this, 0)) {
+				// the containers can be changed by other threads
+				if (output.pos == output.end) {
+					return mem;
+				}
+			}
+		}
+		return sl_null;
+	}
+	
+	sl_bool Variant::serialize(IWriter* writer) const noexcept
+	{
+		_priv_VariantBinary_WriterOutput output(writer);
+		if (_priv_VariantBinary_writeCounted(output, *this)) {
+			return output.flush();
+		}
+		return sl_false;
+	}
+	
+	sl_bool Variant::serialize(MemoryQueue* queue) const noexcept
+	{
+		_priv_VariantBinary_QueueOutput output(queue);
+		if (_priv_VariantBinary_writeCounted(output, *this)) {
+			return output.flush();
+		}
+		return sl_false;
+	}
+	
+	class _priv_VariantBinary_MemoryInput
+	{
+	public:
+		const sl_uint8* begin;
+		const sl_uint8* pos;
+		const sl_uint8* end;
+		// memories refer to this instead of copying
+		CMemory* mem;
+		
+	public:
+		_priv_VariantBinary_MemoryInput(const void* data, sl_size size, CMemory* _mem) noexcept: begin((sl_uint8*)data), pos((sl_uint8*)data), end((sl_uint8*)data + size), mem(_mem) {}
+		
+	public:
+		sl_size getOffset() noexcept
+		{
+			return pos - begin;
+		}
+		
+		sl_bool checkAvailable(sl_uint64 size) noexcept
+		{
+			return size <= (sl_uint64)(end - pos);
+		}
+		
+		sl_bool readByte(sl_uint8& n) noexcept
+		{
+			if (pos < end) {
+				n = *(pos++);
+				return sl_true;
+			}
+			return sl_false;
+		}
+		
+		sl_bool read(void* data, sl_size size) noexcept
+		{
+			if (size <= (sl_size)(end - pos)) {
+				Base::copyMemory(data, pos, size);
+				pos += size;
+				return sl_true;
+			}
+			return sl_false;
+		}
+		
+		sl_bool readCVLI(sl_uint64& value) noexcept
+		{
+			sl_uint64 v = 0;
+			sl_uint32 m = 0;
+			while (pos < end && m < 64) {
+				sl_uint8 n = *(pos++);
+				v |= ((sl_uint64)(n & 127)) << m;
+				if (!(n & 128)) {
+					value = v;
+					return sl_true;
+				}
+				m += 7;
+			}
+			return sl_false;
+		}
+		
+		sl_bool readString(sl_size len, String& str) noexcept
+		{
+			if (len > (sl_size)(end - pos)) {
+				return sl_false;
+			}
+			if (!len) {
+				str = String::getEmpty();
+				return sl_true;
+			}
+			// copied to be null-terminated
+			str = String::fromUtf8(pos, len);
+			pos += len;
+			return str.isNotNull();
+		}
+		
+		sl_bool readMemory(sl_size size, Memory& output) noexcept
+		{
+			if (size > (sl_size)(end - pos)) {
+				return sl_false;
+			}
+			if (mem) {
+				output = Memory::createStatic(pos, size, mem);
+			} else {
+				output = Memory::create(pos, size);
+			}
+			pos += size;
+			return output.isNotNull();
+		}
+		
+		sl_bool skip(sl_size size) noexcept
+		{
+			if (size <= (sl_size)(end - pos)) {
+				pos += size;
+				return sl_true;
+			}
+			return sl_false;
+		}
+		
+	};
+	
+	class _priv_VariantBinary_ReaderInput
+	{
+	public:
+		IReader* reader;
+		sl_size offset;
+		
+	public:
+		_priv_VariantBinary_ReaderInput(IReader* _reader) noexcept: reader(_reader), offset(0) {}
+		
+	public:
+		sl_size getOffset() noexcept
+		{
+			return offset;
+		}
+		
+		sl_bool checkAvailable(sl_uint64 size) noexcept
+		{
+			return size <= SLIB_SIZE_MAX - offset;
+		}
+		
+		sl_bool readByte(sl_uint8& n) noexcept
+		{
+			return read(&n, 1);
+		}
+		
+		sl_bool read(void* data, sl_size size) noexcept
+		{
+			if (reader->readFully(data, size) == (sl_reg)size) {
+				offset += size;
+				return sl_true;
+			}
+			return sl_false;
+		}
+		
+		sl_bool readCVLI(sl_uint64& value) noexcept
+		{
+			sl_uint64 v = 0;
+			sl_uint32 m = 0;
+			sl_uint8 n;
+			while (m < 64 && readByte(n)) {
+				v |= ((sl_uint64)(n & 127)) << m;
+				if (!(n & 128)) {
+					value = v;
+					return sl_true;
+				}
+				m += 7;
+			}
+			return sl_false;
+		}
+		
+		sl_bool readString(sl_size len, String& str) noexcept
+		{
+			if (!len) {
+				str = String::getEmpty();
+				return sl_true;
+			}
+			str = String::allocate(len);
+			if (str.isNull()) {
+				return sl_false;
+			}
+			return read(str.getData(), len);
+		}
+		
+		sl_bool readMemory(sl_size size, Memory& output) noexcept
+		{
+			output = Memory::create(size);
+			if (output.isNull()) {
+				return sl_false;
+			}
+			return read(output.getData(), size);
+		}
+		
+	};
+	
+	template <class INPUT>
+	static sl_bool _priv_VariantBinary_readSize(INPUT& input, sl_size& size) noexcept
+	{
+		sl_uint64 n;
+		if (input.readCVLI(n)) {
+			if (input.checkAvailable(n)) {
+				size = (sl_size)n;
+				return sl_true;
+			}
+		}
+		return sl_false;
+	}
+	
+	template <class INPUT>
+	static sl_bool _priv_VariantBinary_read(INPUT& input, Variant& output, sl_uint32 depth) noexcept;
+	
+	template <class INPUT, class MAP>
+	static sl_bool _priv_VariantBinary_readMap(INPUT& input, MAP& map, sl_size count, sl_uint32 depth) noexcept
+	{
+		for (sl_size i = 0; i < count; i++) {
+			sl_size len;
+			if (!(_priv_VariantBinary_readSize(input, len))) {
+				return sl_false;
+			}
+			String key;
+			if (!(input.readString(len, key))) {
+				return sl_false;
+			}
+			Variant value;
+			if (!(_priv_VariantBinary_read(input, value, depth))) {
+				return sl_false;
+			}
+			if (!(map.put_NoLock(Move(key), Move(value)))) {
+				return sl_false;
+			}
+		}
+		return sl_true;
+	}
+	
+	template <class INPUT>
+	static sl_bool _priv_VariantBinary_read(INPUT& input, Variant& output, sl_uint32 depth) noexcept
+	{
+		sl_uint8 tag;
+		if (!(input.readByte(tag))) {
+			return sl_false;
+		}
+		sl_uint64 n;
+		switch (tag) {
+			case PRIV_SLIB_VARIANT_BINARY_NULL:
+				output.setNull();
+				return sl_true;
+			case PRIV_SLIB_VARIANT_BINARY_FALSE:
+				output = sl_false;
+				return sl_true;
+			case PRIV_SLIB_VARIANT_BINARY_TRUE:
+				output = sl_true;
+				return sl_true;
+			case PRIV_SLIB_VARIANT_BINARY_INT32:
+				if (input.readCVLI(n)) {
+					output = (sl_int32)(_priv_VariantBinary_decodeSigned(n));
+					return sl_true;
+				}
+				return sl_false;
+			case PRIV_SLIB_VARIANT_BINARY_UINT32:
+				if (input.readCVLI(n)) {
+					output = (sl_uint32)n;
+					return sl_true;
+				}
+				return sl_false;
+			case PRIV_SLIB_VARIANT_BINARY_INT64:
+				if (input.readCVLI(n)) {
+					output = _priv_VariantBinary_decodeSigned(n);
+					return sl_true;
+				}
+				return sl_false;
+			case PRIV_SLIB_VARIANT_BINARY_UINT64:
+				if (input.readCVLI(n)) {
+					output = n;
+					return sl_true;
+				}
+				return sl_false;
+			case PRIV_SLIB_VARIANT_BINARY_FLOAT:
+				{
+					sl_uint8 buf[4];
+					if (input.read(buf, 4)) {
+						output = MIO::readFloatLE(buf);
+						return sl_true;
+					}
+					return sl_false;
+				}
+			case PRIV_SLIB_VARIANT_BINARY_DOUBLE:
+				{
+					sl_uint8 buf[8];
+					if (input.read(buf, 8)) {
+						output = MIO::readDoubleLE(buf);
+						return sl_true;
+					}
+					return sl_false;
+				}
+			case PRIV_SLIB_VARIANT_BINARY_STRING:
+				{
+					sl_size len;
+					if (_priv_VariantBinary_readSize(input, len)) {
+						String str;
+						if (input.readString(len, str)) {
+							output = str;
+							return sl_true;
+						}
+					}
+					return sl_false;
+				}
+			case PRIV_SLIB_VARIANT_BINARY_TIME:
+				if (input.readCVLI(n)) {
+					output = Time(_priv_VariantBinary_decodeSigned(n));
+					return sl_true;
+				}
+				return sl_false;
+			case PRIV_SLIB_VARIANT_BINARY_MEMORY:
+				{
+					sl_size size;
+					if (_priv_VariantBinary_readSize(input, size)) {
+						Memory mem;
+						if (input.readMemory(size, mem)) {
+							output = mem;
+							return sl_true;
+						}
+					}
+					return sl_false;
+				}
+			case PRIV_SLIB_VARIANT_BINARY_LIST:
+			case PRIV_SLIB_VARIANT_BINARY_MAP:
+			case PRIV_SLIB_VARIANT_BINARY_HASH_MAP:
+				{
+					if (depth >= PRIV_SLIB_VARIANT_BINARY_MAX_DEPTH) {
+						return sl_false;
+					}
+					sl_size sizeBody;
+					if (!(_priv_VariantBinary_readSize(input, sizeBody))) {
+						return sl_false;
+					}
+					sl_size offsetEnd = input.getOffset() + sizeBody;
+					sl_uint64 count;
+					if (!(input.readCVLI(count))) {
+						return sl_false;
+					}
+					// every item takes one byte at least
+					if (count > sizeBody) {
+						return sl_false;
+					}
+					if (tag == PRIV_SLIB_VARIANT_BINARY_LIST) {
+						List<Variant> list = List<Variant>::create(0, (sl_size)count);
+						if (list.isNull()) {
+							return sl_false;
+						}
+						for (sl_size i = 0; i < (sl_size)count; i++) {
+							Variant item;
+							if (!(_priv_VariantBinary_read(input, item, depth + 1))) {
+								return sl_false;
+							}
+							if (!(list.add_NoLock(Move(item)))) {
+								return sl_false;
+							}
+						}
+						output = list;
+					} else if (tag == PRIV_SLIB_VARIANT_BINARY_MAP) {
+						VariantMap map = VariantMap::create();
+						if (map.isNull()) {
+							return sl_false;
+						}
+						if (!(_priv_VariantBinary_readMap(input, map, (sl_size)count, depth + 1))) {
+							return sl_false;
+						}
+						output = map;
+					} else {
+						VariantHashMap map = VariantHashMap::create();
+						if (map.isNull()) {
+							return sl_false;
+						}
+						if (!(_priv_VariantBinary_readMap(input, map, (sl_size)count, depth + 1))) {
+							return sl_false;
+						}
+						output = map;
+					}
+					return input.getOffset() == offsetEnd;
+				}
+			default:
+				break;
+		}
+		return sl_false;
+	}
+	
+	sl_size Variant::deserialize(const Memory& mem, Variant& output) noexcept
+	{
+		_priv_VariantBinary_MemoryInput input(mem.getData(), mem.getSize(), mem.ref.get());
+		if (_priv_VariantBinary_read(input, output, 0)) {
+			return input.getOffset();
+		}
+		return 0;
+	}
+	
+	sl_size Variant::deserialize(const void* data, sl_size size, Variant& output) noexcept
+	{
+		_priv_VariantBinary_MemoryInput input(data, size, sl_null);
+		if (_priv_VariantBinary_read(input, output, 0)) {
+			return input.getOffset();
+		}
+		return 0;
+	}
+	
+	sl_bool Variant::deserialize(IReader* reader, Variant& output) noexcept
+	{
+		_priv_VariantBinary_ReaderInput input(reader);
+		return _priv_VariantBinary_read(input, output, 0);
+	}
+	
+	sl_size Variant::getSerializedSize(const void* data, sl_size size) noexcept
+	{
+		_priv_VariantBinary_MemoryInput input(data, size, sl_null);
+		sl_uint8 tag;
+		if (!(input.readByte(tag))) {
+			return 0;
+		}
+		sl_uint64 n;
+		switch (tag) {
+			case PRIV_SLIB_VARIANT_BINARY_NULL:
+			case PRIV_SLIB_VARIANT_BINARY_FALSE:
+			case PRIV_SLIB_VARIANT_BINARY_TRUE:
+				return 1;
+			case PRIV_SLIB_VARIANT_BINARY_INT32:
+			case PRIV_SLIB_VARIANT_BINARY_UINT32:
+			case PRIV_SLIB_VARIANT_BINARY_INT64:
+			case PRIV_SLIB_VARIANT_BINARY_UINT64:
+			case PRIV_SLIB_VARIANT_BINARY_TIME:
+				if (input.readCVLI(n)) {
+					return input.getOffset();
+				}
+				return 0;
+			case PRIV_SLIB_VARIANT_BINARY_FLOAT:
+				return input.skip(4) ? 5 : 0;
+			case PRIV_SLIB_VARIANT_BINARY_DOUBLE:
+				return input.skip(8) ? 9 : 0;
+			case PRIV_SLIB_VARIANT_BINARY_STRING:
+			case PRIV_SLIB_VARIANT_BINARY_MEMORY:
+			case PRIV_SLIB_VARIANT_BINARY_LIST:
+			case PRIV_SLIB_VARIANT_BINARY_MAP:
+			case PRIV_SLIB_VARIANT_BINARY_HASH_MAP:
+				{
+					// the containers are skipped by the size of the body
+					sl_size sizeBody;
+					if (_priv_VariantBinary_readSize(input, sizeBody)) {
+						return input.getOffset() + sizeBody;
+					}
+					return 0;
+				}
+			default:
+				break;
+		}
+		return 0;
+	}
+
 }
@@ -25,6 +25,7 @@
 #include "slib/core/file.h"
 #include "slib/core/log.h"
 #include "slib/core/string_buffer.h"
+#include "slib/core/async.h"
 
 namespace slib
 {
@@ -1428,6 +1429,8 @@ namespace slib
 		sl_size lineNumber;
 		sl_size columnNumber;
 		sl_size posForLineColumn;
+		// position of `buf` in the whole source
+		sl_size offsetSource;
 		
 		Ref<XmlDocument> document;
 		XmlParseControl control;
@@ -1460,6 +1463,12 @@ namespace slib
 		
 		void parseAttribute(XmlString& name, XmlString& value);
 		
+		void parseStartTag(XmlNodeGroup* parent, XmlString& defNamespace, HashMap<XmlString, XmlString>& namespaces, const HashMap<XmlString, XmlString>& namespacesParent, Ref<XmlElement>& element, List<XmlString>& listPrefixMappings, sl_size& posNameStart, sl_size& lenName, sl_bool& flagEmptyTag);
+		
+		void parseEndTag(const CT* name, sl_size lenName);
+		
+		void endElement(XmlElement* element, const List<XmlString>& listPrefixMappings);
+		
 		void parseElement(XmlNodeGroup* parent, const XmlString& defNamespace, const HashMap<XmlString, XmlString>& namespaces);
 		
 		void parseText(XmlNodeGroup* parent);
@@ -1532,6 +1541,7 @@ namespace slib
 	SLIB_STATIC_STRING(_g_xml_error_msg_element_attr_duplicate, "Attribute name is already specified")
 	SLIB_STATIC_STRING(_g_xml_error_msg_content_include_lt, "Content must not include less-than(<) character")
 	SLIB_STATIC_STRING(_g_xml_error_msg_document_not_wellformed, "Document must be well-formed")
+	SLIB_STATIC_STRING(_g_xml_error_msg_file_not_opened, "Source file is not opened")
 
 #define CALL_CALLBACK(NAME, NODE, ...) \
 	{ \
@@ -1567,6 +1577,7 @@ namespace slib
 		lineNumber = 1;
 		columnNumber = 1;
 		posForLineColumn = 0;
+		offsetSource = 0;
 
 		buf = sl_null;
 		len = 0;
@@ -1627,8 +1638,8 @@ namespace slib
 				}
 				calcLineNumber();
 				node->setSourceFilePath(sourceFilePath);
-				node->setStartPositionInSource(posStart);
-				node->setEndPositionInSource(posEnd);
+				node->setStartPositionInSource(offsetSource + posStart);
+				node->setEndPositionInSource(offsetSource + posEnd);
 				node->setLineNumberInSource(lineNumber);
 				node->setColumnNumberInSource(columnNumber);
 				if (!(parent->addChild(node))) {
@@ -1765,8 +1776,8 @@ namespace slib
 								REPORT_ERROR(_g_xml_error_msg_memory_lack)
 							}
 							comment->setSourceFilePath(sourceFilePath);
-							comment->setStartPositionInSource(startComment);
-							comment->setEndPositionInSource(pos + 3);
+							comment->setStartPositionInSource(offsetSource + startComment);
+							comment->setEndPositionInSource(offsetSource + pos + 3);
 							comment->setLineNumberInSource(startLine);
 							comment->setColumnNumberInSource(startColumn);
 							if (!(parent->addChild(comment))) {
@@ -1813,8 +1824,8 @@ namespace slib
 							REPORT_ERROR(_g_xml_error_msg_memory_lack)
 						}
 						text->setSourceFilePath(sourceFilePath);
-						text->setStartPositionInSource(startCDATA);
-						text->setEndPositionInSource(pos + 3);
+						text->setStartPositionInSource(offsetSource + startCDATA);
+						text->setEndPositionInSource(offsetSource + pos + 3);
 						text->setLineNumberInSource(startLine);
 						text->setColumnNumberInSource(startColumn);
 						if (!(parent->addChild(text))) {
@@ -1875,8 +1886,8 @@ namespace slib
 							REPORT_ERROR(_g_xml_error_msg_memory_lack)
 						}
 						PI->setSourceFilePath(sourceFilePath);
-						PI->setStartPositionInSource(startPI);
-						PI->setEndPositionInSource(pos + 2);
+						PI->setStartPositionInSource(offsetSource + startPI);
+						PI->setEndPositionInSource(offsetSource + pos + 2);
 						PI->setLineNumberInSource(startLine);
 						PI->setColumnNumberInSource(startColumn);
 						if (!(parent->addChild(PI))) {
@@ -1992,28 +2003,24 @@ namespace slib
 	}
 
 	template <class ST, class CT, class BT>
-	void _priv_Xml_Parser<ST, CT, BT>::parseElement(XmlNodeGroup* parent, const XmlString& _defNamespace, const HashMap<XmlString, XmlString>& _namespaces)
+	void _priv_Xml_Parser<ST, CT, BT>::parseStartTag(XmlNodeGroup* parent, XmlString& defNamespace, HashMap<XmlString, XmlString>& namespaces, const HashMap<XmlString, XmlString>& namespacesParent, Ref<XmlElement>& element, List<XmlString>& listPrefixMappings, sl_size& posNameStart, sl_size& lenName, sl_bool& flagEmptyTag)
 	{
-		XmlString defNamespace = _defNamespace;
-		HashMap<XmlString, XmlString> namespaces = _namespaces;
-		
 		calcLineNumber();
 		sl_size startLine = lineNumber;
 		sl_size startColumn = columnNumber;
-		sl_size posNameStart = pos;
+		posNameStart = pos;
 		XmlString name;
 		parseName(name);
 		if (flagError) {
 			return;
 		}
-		sl_size lenName = pos - posNameStart;
+		lenName = pos - posNameStart;
 		
-		Ref<XmlElement> element = new XmlElement;
+		element = new XmlElement;
 		if (element.isNull()) {
 			REPORT_ERROR(_g_xml_error_msg_memory_lack)
 		}
 		
-		CList<XmlString> listPrefixMappings;
 		sl_size indexAttr = 0;
 		
 		while (pos < len) {
@@ -2074,8 +2081,8 @@ namespace slib
 						}
 						CALL_CALLBACK(onStartPrefixMapping, element.get(), XmlString::null(), defNamespace);
 					} else if (prefix == "xmlns" && attr.localName.isNotEmpty() && attr.value.isNotEmpty()) {
-						if (namespaces == _namespaces) {
-							namespaces = _namespaces.duplicate();
+						if (namespaces == namespacesParent) {
+							namespaces = namespacesParent.duplicate();
 						}
 						if (!(namespaces.put(attr.localName, attr.value))) {
 							REPORT_ERROR(_g_xml_error_msg_memory_lack)
@@ -2095,7 +2102,7 @@ namespace slib
 		if (pos >= len) {
 			REPORT_ERROR(_g_xml_error_msg_element_tag_not_end)
 		}
-		sl_bool flagEmptyTag = sl_false;
+		flagEmptyTag = sl_false;
 		if (buf[pos] == '/') {
 			if (pos + 1 < len && buf[pos+1] == '>') {
 				flagEmptyTag = sl_true;
@@ -2108,12 +2115,12 @@ namespace slib
 		}
 		
 		element->setSourceFilePath(sourceFilePath);
-		element->setStartPositionInSource(posNameStart);
+		element->setStartPositionInSource(offsetSource + posNameStart);
 		element->setLineNumberInSource(startLine);
 		element->setColumnNumberInSource(startColumn);
-		element->setEndPositionInSource(pos);
-		element->setStartContentPositionInSource(posNameStart);
-		element->setEndContentPositionInSource(posNameStart);
+		element->setEndPositionInSource(offsetSource + pos);
+		element->setStartContentPositionInSource(offsetSource + posNameStart);
+		element->setEndContentPositionInSource(offsetSource + posNameStart);
 
 		XmlString prefix, uri, localName;
 		processPrefix(name, defNamespace, namespaces, prefix, uri, localName);
@@ -2128,7 +2135,68 @@ namespace slib
 		}
 		CALL_CALLBACK(onStartElement, element.get(), element.get())
 		if (!flagEmptyTag) {
-			element->setStartContentPositionInSource(pos);
+			element->setStartContentPositionInSource(offsetSource + pos);
+		}
+	}
+
+	template <class ST, class CT, class BT>
+	void _priv_Xml_Parser<ST, CT, BT>::parseEndTag(const CT* name, sl_size lenName)
+	{
+		// `pos` is just after `</`
+		if (pos + lenName >= len) {
+			REPORT_ERROR(_g_xml_error_msg_element_tag_not_matching_end_tag)
+		}
+		if (!(Base::equalsMemory(name, buf + pos, lenName * sizeof(CT)))) {
+			REPORT_ERROR(_g_xml_error_msg_element_tag_not_matching_end_tag)
+		}
+		pos += lenName;
+		CT ch = buf[pos];
+		if (ch != '>') {
+			if (SLIB_CHAR_IS_WHITE_SPACE(ch)) {
+				pos++;
+				escapeWhiteSpaces();
+			} else {
+				REPORT_ERROR(_g_xml_error_msg_name_invalid_char)
+			}
+		}
+		if (pos >= len) {
+			REPORT_ERROR(_g_xml_error_msg_element_tag_not_end)
+		}
+		if (buf[pos] != '>') {
+			REPORT_ERROR(_g_xml_error_msg_element_tag_not_end)
+		}
+		pos++;
+	}
+
+	template <class ST, class CT, class BT>
+	void _priv_Xml_Parser<ST, CT, BT>::endElement(XmlElement* element, const List<XmlString>& listPrefixMappings)
+	{
+		element->setEndPositionInSource(offsetSource + pos);
+		CALL_CALLBACK(onEndElement, element, element);
+		if (param.flagProcessNamespaces) {
+			ListLocker<XmlString> prefixes(listPrefixMappings);
+			for (sl_size i = 0; i < prefixes.count; i++) {
+				CALL_CALLBACK(onEndPrefixMapping, element, prefixes[i]);
+			}
+		}
+	}
+
+	template <class ST, class CT, class BT>
+	void _priv_Xml_Parser<ST, CT, BT>::parseElement(XmlNodeGroup* parent, const XmlString& _defNamespace, const HashMap<XmlString, XmlString>& _namespaces)
+	{
+		XmlString defNamespace = _defNamespace;
+		HashMap<XmlString, XmlString> namespaces = _namespaces;
+		
+		Ref<XmlElement> element;
+		List<XmlString> listPrefixMappings;
+		sl_size posNameStart = 0;
+		sl_size lenName = 0;
+		sl_bool flagEmptyTag = sl_false;
+		parseStartTag(parent, defNamespace, namespaces, _namespaces, element, listPrefixMappings, posNameStart, lenName, flagEmptyTag);
+		if (flagError) {
+			return;
+		}
+		if (!flagEmptyTag) {
 			parseNodes(parent ? element.get() : sl_null, defNamespace, namespaces);
 			if (flagError) {
 				return;
@@ -2139,37 +2207,14 @@ namespace slib
 			if (buf[pos] != '<' || buf[pos+1] != '/') {
 				REPORT_ERROR(_g_xml_error_msg_element_tag_not_matching_end_tag)
 			}
-			element->setEndContentPositionInSource(pos);
+			element->setEndContentPositionInSource(offsetSource + pos);
 			pos += 2;
-			if (!(Base::equalsMemory(buf + posNameStart, buf + pos, lenName * sizeof(CT)))) {
-				REPORT_ERROR(_g_xml_error_msg_element_tag_not_matching_end_tag)
-			}
-			pos += lenName;
-			CT ch = buf[pos];
-			if (ch != '>') {
-				if (SLIB_CHAR_IS_WHITE_SPACE(ch)) {
-					pos++;
-					escapeWhiteSpaces();
-				} else {
-					REPORT_ERROR(_g_xml_error_msg_name_invalid_char)
-				}
-			}
-			if (pos >= len) {
-				REPORT_ERROR(_g_xml_error_msg_element_tag_not_end)
-			}
-			if (buf[pos] != '>') {
-				REPORT_ERROR(_g_xml_error_msg_element_tag_not_end)
-			}
-			pos++;
-		}
-		element->setEndPositionInSource(pos);
-		CALL_CALLBACK(onEndElement, element.get(), element.get());
-		if (param.flagProcessNamespaces) {
-			ListLocker<XmlString> prefixes(listPrefixMappings);
-			for (sl_size i = 0; i < prefixes.count; i++) {
-				CALL_CALLBACK(onEndPrefixMapping, element.get(), prefixes[i]);
+			parseEndTag(buf + posNameStart, lenName);
+			if (flagError) {
+				return;
 			}
 		}
+		endElement(element.get(), listPrefixMappings);
 	}
 
 	template <class ST, class CT, class BT>
@@ -2242,8 +2287,8 @@ namespace slib
 						REPORT_ERROR(_g_xml_error_msg_memory_lack)
 					}
 					node->setSourceFilePath(sourceFilePath);
-					node->setStartPositionInSource(startText);
-					node->setEndPositionInSource(pos);
+					node->setStartPositionInSource(offsetSource + startText);
+					node->setEndPositionInSource(offsetSource + pos);
 					node->setLineNumberInSource(startLine);
 					node->setColumnNumberInSource(startColumn);
 					if (!(parent->addChild(node))) {
@@ -2440,6 +2485,519 @@ namespace slib
 		return _priv_Xml_Parser<XmlString, sl_char16, XmlStringBuffer>::parseXml(filePath, xml.getData(), xml.getLength(), param);
 	}
 
+
+	class _priv_XmlPushParser : public XmlPushParser, public _priv_Xml_Parser<String, sl_char8, StringBuffer>
+	{
+	public:
+		typedef sl_char8 CT;
+		
+		struct Frame
+		{
+			Ref<XmlElement> element;
+			// raw name to match the end tag
+			String name;
+			XmlString defNamespace;
+			HashMap<XmlString, XmlString> namespaces;
+			List<XmlString> listPrefixMappings;
+		};
+		
+		// pending data: [pos, m_sizeData) is not parsed yet
+		sl_char8* m_data;
+		sl_size m_sizeData;
+		sl_size m_capacity;
+		
+		// the search for the end of the pending node resumes from here
+		sl_size m_posScanned;
+		sl_char8 m_chQuote;
+		
+		CList<Frame> m_stack;
+		
+		sl_bool m_flagStarted;
+		sl_bool m_flagEnded;
+		
+		Ref<AsyncStream> m_stream;
+		Memory m_memRead;
+		Function<void(XmlPushParser*)> m_onEnd;
+		
+	public:
+		_priv_XmlPushParser(const XmlParseParam& _param)
+		{
+			param = _param;
+			param.flagError = sl_false;
+			control.characterSize = 1;
+			
+			m_data = sl_null;
+			m_sizeData = 0;
+			m_capacity = 0;
+			
+			m_posScanned = 0;
+			m_chQuote = 0;
+			
+			m_flagStarted = sl_false;
+			m_flagEnded = sl_false;
+		}
+		
+		~_priv_XmlPushParser()
+		{
+			if (m_data) {
+				Base::freeMemory(m_data);
+			}
+		}
+		
+	public:
+		sl_bool put(const void* data, sl_size size) override
+		{
+			ObjectLocker lock(this);
+			if (flagError || m_flagEnded) {
+				return sl_false;
+			}
+			if (!(_append(data, size))) {
+				flagError = sl_true;
+				errorMessage = _g_xml_error_msg_memory_lack;
+			} else {
+				_process(sl_false);
+			}
+			if (flagError) {
+				_onError();
+				return sl_false;
+			}
+			return sl_true;
+		}
+		
+		sl_bool end() override
+		{
+			ObjectLocker lock(this);
+			if (m_flagEnded || flagError) {
+				m_flagEnded = sl_true;
+				return !flagError;
+			}
+			m_flagEnded = sl_true;
+			_process(sl_true);
+			if (!flagError) {
+				_end();
+			}
+			if (flagError) {
+				_onError();
+				return sl_false;
+			}
+			return sl_true;
+		}
+		
+		sl_bool isEnded() override
+		{
+			return m_flagEnded;
+		}
+		
+		sl_bool isError() override
+		{
+			return flagError;
+		}
+		
+		const XmlParseParam& getParam() override
+		{
+			return param;
+		}
+		
+	public:
+		sl_bool _append(const void* data, sl_size size)
+		{
+			if (pos) {
+				// drops the parsed data
+				len = m_sizeData;
+				calcLineNumber();
+				sl_size n = m_sizeData - pos;
+				if (n) {
+					Base::moveMemory(m_data, m_data + pos, n);
+				}
+				m_sizeData = n;
+				m_posScanned -= pos;
+				offsetSource += pos;
+				posForLineColumn = 0;
+				pos = 0;
+			}
+			if (!size) {
+				return sl_true;
+			}
+			sl_size sizeNew = m_sizeData + size;
+			if (sizeNew > m_capacity) {
+				sl_size capacity = m_capacity ? m_capacity : 1024;
+				while (capacity < sizeNew) {
+					capacity <<= 1;
+				}
+				sl_char8* dataNew = (sl_char8*)(Base::createMemory(capacity));
+				if (!dataNew) {
+					return sl_false;
+				}
+				if (m_data) {
+					Base::copyMemory(dataNew, m_data, m_sizeData);
+					Base::freeMemory(m_data);
+				}
+				m_data = dataNew;
+				m_capacity = capacity;
+			}
+			Base::copyMemory(m_data + m_sizeData, data, size);
+			m_sizeData = sizeNew;
+			return sl_true;
+		}
+		
+		sl_bool _findString(const char* str, sl_size lenStr, sl_size start, sl_size& posEnd)
+		{
+			sl_size i = Math::max(start, m_posScanned);
+			for (; i + lenStr <= m_sizeData; i++) {
+				if (Base::equalsMemory(m_data + i, str, lenStr)) {
+					posEnd = i + lenStr;
+					return sl_true;
+				}
+			}
+			m_posScanned = i;
+			return sl_false;
+		}
+		
+		// finds '>' outside of the attribute values, or '<' which makes the tag invalid
+		sl_bool _findTagEnd(sl_size start, sl_size& posEnd)
+		{
+			sl_size i = Math::max(start, m_posScanned);
+			for (; i < m_sizeData; i++) {
+				sl_char8 ch = m_data[i];
+				if (ch == '<') {
+					posEnd = m_sizeData;
+					return sl_true;
+				}
+				if (m_chQuote) {
+					if (ch == m_chQuote) {
+						m_chQuote = 0;
+					}
+				} else if (ch == '\"' || ch == '\'') {
+					m_chQuote = ch;
+				} else if (ch == '>') {
+					posEnd = i + 1;
+					return sl_true;
+				}
+			}
+			m_posScanned = i;
+			return sl_false;
+		}
+		
+		// returns `false` when more data is required to complete the node
+		sl_bool _findNodeEnd(sl_bool flagEnd, sl_size& posEnd)
+		{
+			const sl_char8* s = m_data;
+			sl_size n = m_sizeData;
+			if (s[pos] == '<') {
+				if (pos + 1 < n) {
+					sl_char8 ch = s[pos + 1];
+					if (ch == '!') {
+						if (pos + 3 < n && s[pos + 2] == '-' && s[pos + 3] == '-') {
+							if (_findString("-->", 3, pos + 4, posEnd)) {
+								return sl_true;
+							}
+						} else if (pos + 8 < n) {
+							if (Base::equalsMemory(s + pos + 2, "[CDATA[", 7)) {
+								if (_findString("]]>", 3, pos + 9, posEnd)) {
+									return sl_true;
+								}
+							} else {
+								// invalid markup
+								posEnd = n;
+								return sl_true;
+							}
+						}
+					} else if (ch == '?') {
+						if (_findString("?>", 2, pos + 2, posEnd)) {
+							return sl_true;
+						}
+					} else {
+						if (_findTagEnd(pos + 1, posEnd)) {
+							return sl_true;
+						}
+					}
+				}
+			} else {
+				sl_size i = Math::max(pos, m_posScanned);
+				for (; i < n; i++) {
+					if (s[i] == '<') {
+						posEnd = i;
+						return sl_true;
+					}
+				}
+				m_posScanned = i;
+			}
+			if (flagEnd) {
+				// the parsers report the errors of incomplete node
+				posEnd = n;
+				return sl_true;
+			}
+			return sl_false;
+		}
+		
+		void _process(sl_bool flagEnd)
+		{
+			buf = m_data;
+			len = m_sizeData;
+			control.source.sz8 = m_data;
+			control.source.len = m_sizeData;
+			if (!m_flagStarted) {
+				if (m_sizeData < 3 && !flagEnd) {
+					return;
+				}
+				m_flagStarted = sl_true;
+				// skips UTF-8 BOM
+				if (m_sizeData >= 3 && (sl_uint8)(m_data[0]) == 0xEF && (sl_uint8)(m_data[1]) == 0xBB && (sl_uint8)(m_data[2]) == 0xBF) {
+					pos = 3;
+					posForLineColumn = 3;
+					m_posScanned = 3;
+				}
+				CALL_CALLBACK(onStartDocument, sl_null, sl_null)
+			}
+			while (pos < m_sizeData) {
+				sl_size posEnd;
+				if (!(_findNodeEnd(flagEnd, posEnd))) {
+					return;
+				}
+				len = posEnd;
+				if (buf[pos] == '<') { // Element, Comment, PI, CDATA
+					pos++;
+					sl_char8 ch = pos < len ? buf[pos] : 0;
+					if (ch == '!') { // Comment, CDATA
+						pos++;
+						if (pos + 1 < len && buf[pos] == '-' && buf[pos+1] == '-') { // Comment
+							pos += 2;
+							parseComment(sl_null);
+						} else if (pos + 6 < len && Base::equalsMemory(buf + pos, "[CDATA[", 7)) { // CDATA
+							pos += 7;
+							parseCDATA(sl_null);
+						} else {
+							REPORT_ERROR(_g_xml_error_msg_invalid_markup)
+						}
+					} else if (ch == '?') { // PI
+						pos++;
+						parsePI(sl_null);
+					} else if (ch == '/') { // Element End Tag
+						pos++;
+						_parseEndTag();
+					} else { // Element
+						_parseStartTag();
+					}
+				} else {
+					parseText(sl_null);
+				}
+				if (flagError) {
+					return;
+				}
+				len = m_sizeData;
+				m_posScanned = pos;
+				m_chQuote = 0;
+			}
+		}
+		
+		void _parseStartTag()
+		{
+			Frame frame;
+			HashMap<XmlString, XmlString> namespacesParent;
+			sl_size nStack = m_stack.getCount();
+			if (nStack) {
+				Frame& parent = m_stack.getData()[nStack - 1];
+				frame.defNamespace = parent.defNamespace;
+				frame.namespaces = parent.namespaces;
+				namespacesParent = parent.namespaces;
+			}
+			sl_size posNameStart = 0;
+			sl_size lenName = 0;
+			sl_bool flagEmptyTag = sl_false;
+			parseStartTag(sl_null, frame.defNamespace, frame.namespaces, namespacesParent, frame.element, frame.listPrefixMappings, posNameStart, lenName, flagEmptyTag);
+			if (flagError) {
+				return;
+			}
+			if (flagEmptyTag) {
+				endElement(frame.element.get(), frame.listPrefixMappings);
+				return;
+			}
+			frame.name = String(buf + posNameStart, lenName);
+			if (frame.name.isNull()) {
+				REPORT_ERROR(_g_xml_error_msg_memory_lack)
+			}
+			if (!(m_stack.add_NoLock(frame))) {
+				REPORT_ERROR(_g_xml_error_msg_memory_lack)
+			}
+		}
+		
+		void _parseEndTag()
+		{
+			sl_size nStack = m_stack.getCount();
+			if (!nStack) {
+				pos -= 2;
+				REPORT_ERROR(_g_xml_error_msg_document_not_wellformed)
+			}
+			Frame& frame = m_stack.getData()[nStack - 1];
+			frame.element->setEndContentPositionInSource(offsetSource + pos - 2);
+			parseEndTag(frame.name.getData(), frame.name.getLength());
+			if (flagError) {
+				return;
+			}
+			endElement(frame.element.get(), frame.listPrefixMappings);
+			if (flagError) {
+				return;
+			}
+			m_stack.popBack_NoLock();
+		}
+		
+		void _end()
+		{
+			len = m_sizeData;
+			if (m_stack.getCount()) {
+				REPORT_ERROR(_g_xml_error_msg_element_tag_not_matching_end_tag)
+			}
+			CALL_CALLBACK(onEndDocument, sl_null, sl_null)
+		}
+		
+		void _onError()
+		{
+			len = m_sizeData;
+			if (pos > len) {
+				pos = len;
+			}
+			calcLineNumber();
+			param.flagError = sl_true;
+			param.errorPosition = offsetSource + pos;
+			param.errorLine = lineNumber;
+			param.errorColumn = columnNumber;
+			param.errorMessage = errorMessage;
+			if (param.flagLogError) {
+				LogError("Xml", param.getErrorText());
+			}
+		}
+		
+		sl_bool _readStream()
+		{
+			Ref<AsyncStream> stream = m_stream;
+			if (stream.isNull()) {
+				return sl_false;
+			}
+			return stream->read(m_memRead.getData(), (sl_uint32)(m_memRead.getSize()), SLIB_FUNCTION_REF(_priv_XmlPushParser, _onReadStream, this));
+		}
+		
+		void _onReadStream(AsyncStreamResult& result)
+		{
+			if (result.size) {
+				if (!(put(result.data, result.size))) {
+					_endStream();
+					return;
+				}
+			}
+			if (result.flagError || !(_readStream())) {
+				_endStream();
+			}
+		}
+		
+		void _endStream()
+		{
+			end();
+			m_stream.setNull();
+			m_memRead.setNull();
+			m_onEnd(this);
+		}
+		
+	};
+
+	SLIB_DEFINE_OBJECT(XmlPushParser, Object)
+	
+	XmlPushParser::XmlPushParser()
+	{
+	}
+	
+	XmlPushParser::~XmlPushParser()
+	{
+	}
+
+	Ref<XmlPushParser> XmlPushParser::create(const XmlParseParam& param)
+	{
+		return new _priv_XmlPushParser(param);
+	}
+	
+	static sl_bool _priv_XmlPushParser_parse(IReader* reader, const String& sourceFilePath, XmlParseParam& param, sl_size chunkSize)
+	{
+		if (!chunkSize) {
+			chunkSize = SLIB_XML_PUSH_PARSER_CHUNK_SIZE;
+		}
+		Memory mem = Memory::create(chunkSize);
+		Ref<_priv_XmlPushParser> parser = new _priv_XmlPushParser(param);
+		if (mem.isNull() || parser.isNull()) {
+			param.flagError = sl_true;
+			param.errorMessage = _g_xml_error_msg_memory_lack;
+			return sl_false;
+		}
+		parser->sourceFilePath = sourceFilePath;
+		sl_char8* chunk = (sl_char8*)(mem.getData());
+		for (;;) {
+			sl_reg n = reader->readFully(chunk, chunkSize);
+			if (n > 0) {
+				if (!(parser->put(chunk, n))) {
+					break;
+				}
+			}
+			if (n < (sl_reg)chunkSize) {
+				break;
+			}
+		}
+		parser->end();
+		const XmlParseParam& result = parser->param;
+		param.flagError = result.flagError;
+		if (result.flagError) {
+			param.errorPosition = result.errorPosition;
+			param.errorLine = result.errorLine;
+			param.errorColumn = result.errorColumn;
+			param.errorMessage = result.errorMessage;
+			return sl_false;
+		}
+		return sl_true;
+	}
+	
+	sl_bool XmlPushParser::parse(IReader* reader, XmlParseParam& param, sl_size chunkSize)
+	{
+		param.flagError = sl_false;
+		if (!reader) {
+			param.flagError = sl_true;
+			param.errorMessage = _g_xml_error_msg_unknown;
+			return sl_false;
+		}
+		return _priv_XmlPushParser_parse(reader, String::null(), param, chunkSize);
+	}
+	
+	sl_bool XmlPushParser::parseFile(const String& filePath, XmlParseParam& param, sl_size chunkSize)
+	{
+		param.flagError = sl_false;
+		Ref<File> file = File::openForRead(filePath);
+		if (file.isNull()) {
+			param.flagError = sl_true;
+			param.errorMessage = _g_xml_error_msg_file_not_opened;
+			return sl_false;
+		}
+		return _priv_XmlPushParser_parse(file.get(), filePath, param, chunkSize);
+	}
+	
+	Ref<XmlPushParser> XmlPushParser::parse(const Ref<AsyncStream>& stream, const XmlParseParam& param, const Function<void(XmlPushParser*)>& onEnd, sl_uint32 chunkSize)
+	{
+		if (stream.isNull()) {
+			return sl_null;
+		}
+		if (!chunkSize) {
+			chunkSize = SLIB_XML_PUSH_PARSER_CHUNK_SIZE;
+		}
+		Ref<_priv_XmlPushParser> parser = new _priv_XmlPushParser(param);
+		if (parser.isNotNull()) {
+			parser->m_memRead = Memory::create(chunkSize);
+			if (parser->m_memRead.isNotNull()) {
+				parser->m_stream = stream;
+				parser->m_onEnd = onEnd;
+				if (parser->_readStream()) {
+					return parser;
+				}
+				parser->m_stream.setNull();
+			}
+		}
+		return sl_null;
+	}
+
 	
 	XmlString Xml::encodeTextToEntities(const XmlString& text)
 	{
@@ -23,6 +23,28 @@
 #include "slib/crypto/openssl.h"
 
 #include "openssl/ssl.h"
+#include "openssl/kdf.h"
+
+#include "slib/core/mio.h"
+
+#if defined(SLIB_PLATFORM_IS_LINUX) && defined(__has_include)
+#	if __has_include(<linux/tls.h>)
+#		define SLIB_OPENSSL_SUPPORT_KERNEL_TLS
+#	endif
+#endif
+
+#if defined(SLIB_OPENSSL_SUPPORT_KERNEL_TLS)
+#	include <sys/socket.h>
+#	include <netinet/in.h>
+#	include <netinet/tcp.h>
+#	include <linux/tls.h>
+#	ifndef TCP_ULP
+#		define TCP_ULP 31
+#	endif
+#	ifndef SOL_TLS
+#		define SOL_TLS 282
+#	endif
+#endif
 
 namespace slib
 {
@@ -87,6 +109,199 @@ namespace slib
 	}
 #endif
 	
+#if defined(SLIB_OPENSSL_SUPPORT_KERNEL_TLS)
+	class _priv_OpenSSL_KernelTls
+	{
+	public:
+		union CryptoInfo
+		{
+			tls_crypto_info info;
+			tls12_crypto_info_aes_gcm_128 aes_gcm_128;
+			tls12_crypto_info_aes_gcm_256 aes_gcm_256;
+		};
+		
+	public:
+		// HKDF-Expand-Label (RFC 8446, Section 7.1) with empty context
+		static sl_bool expandLabel(const EVP_MD* md, const Memory& secret, const char* label, void* output, sl_uint32 size)
+		{
+			sl_uint8 info[64];
+			sl_size lenLabel = Base::getStringLength(label);
+			if (lenLabel + 10 > sizeof(info)) {
+				return sl_false;
+			}
+			info[0] = (sl_uint8)(size >> 8);
+			info[1] = (sl_uint8)size;
+			info[2] = (sl_uint8)(lenLabel + 6);
+			Base::copyMemory(info + 3, "tls13 ", 6);
+			Base::copyMemory(info + 9, label, lenLabel);
+			info[9 + lenLabel] = 0;
+			sl_bool bRet = sl_false;
+			EVP_PKEY_CTX* pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, sl_null);
+			if (pctx) {
+				size_t len = size;
+				if (EVP_PKEY_derive_init(pctx) > 0 &&
+					EVP_PKEY_CTX_hkdf_mode(pctx, EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0 &&
+					EVP_PKEY_CTX_set_hkdf_md(pctx, md) > 0 &&
+					EVP_PKEY_CTX_set1_hkdf_key(pctx, (unsigned char*)(secret.getData()), (int)(secret.getSize())) > 0 &&
+					EVP_PKEY_CTX_add1_hkdf_info(pctx, info, (int)(lenLabel + 10)) > 0 &&
+					EVP_PKEY_derive(pctx, (unsigned char*)output, &len) > 0) {
+					bRet = len == size;
+				}
+				EVP_PKEY_CTX_free(pctx);
+			}
+			return bRet;
+		}
+		
+		// key_block = PRF(master_secret, "key expansion", server_random + client_random) (RFC 5246, Section 6.3)
+		static sl_bool expandKeyBlock(SSL* ssl, const EVP_MD* md, void* output, sl_uint32 size)
+		{
+			SSL_SESSION* session = SSL_get_session(ssl);
+			if (!session) {
+				return sl_false;
+			}
+			sl_uint8 master[SSL_MAX_MASTER_KEY_LENGTH];
+			sl_uint8 randomClient[SSL3_RANDOM_SIZE];
+			sl_uint8 randomServer[SSL3_RANDOM_SIZE];
+			size_t lenMaster = SSL_SESSION_get_master_key(session, master, sizeof(master));
+			if (!lenMaster) {
+				return sl_false;
+			}
+			if (SSL_get_client_random(ssl, randomClient, sizeof(randomClient)) != sizeof(randomClient)) {
+				return sl_false;
+			}
+			if (SSL_get_server_random(ssl, randomServer, sizeof(randomServer)) != sizeof(randomServer)) {
+				return sl_false;
+			}
+			sl_bool bRet = sl_false;
+			EVP_PKEY_CTX* pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, sl_null);
+			if (pctx) {
+				size_t len = size;
+				if (EVP_PKEY_derive_init(pctx) > 0 &&
+					EVP_PKEY_CTX_set_tls1_prf_md(pctx, md) > 0 &&
+					EVP_PKEY_CTX_set1_tls1_prf_secret(pctx, master, (int)lenMaster) > 0 &&
+					EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, "key expansion", 13) > 0 &&
+					EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, randomServer, sizeof(randomServer)) > 0 &&
+					EVP_PKEY_CTX_add1_tls1_prf_seed(pctx, randomClient, sizeof(randomClient)) > 0 &&
+					EVP_PKEY_derive(pctx, (unsigned char*)output, &len) > 0) {
+					bRet = len == size;
+				}
+				EVP_PKEY_CTX_free(pctx);
+			}
+			Base::zeroMemory(master, sizeof(master));
+			return bRet;
+		}
+		
+		static void setCryptoInfo(CryptoInfo& out, sl_uint16 version, sl_uint32 sizeKey, const sl_uint8* key, const sl_uint8* iv, const sl_uint8* salt, sl_uint64 seq)
+		{
+			Base::zeroMemory(&out, sizeof(out));
+			out.info.version = version;
+			sl_uint8 bufSeq[8];
+			MIO::writeUint64BE(bufSeq, seq);
+			if (sizeKey == 16) {
+				out.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+				Base::copyMemory(out.aes_gcm_128.key, key, 16);
+				Base::copyMemory(out.aes_gcm_128.iv, iv ? iv : bufSeq, 8);
+				Base::copyMemory(out.aes_gcm_128.salt, salt, 4);
+				Base::copyMemory(out.aes_gcm_128.rec_seq, bufSeq, 8);
+			} else {
+				out.info.cipher_type = TLS_CIPHER_AES_GCM_256;
+				Base::copyMemory(out.aes_gcm_256.key, key, 32);
+				Base::copyMemory(out.aes_gcm_256.iv, iv ? iv : bufSeq, 8);
+				Base::copyMemory(out.aes_gcm_256.salt, salt, 4);
+				Base::copyMemory(out.aes_gcm_256.rec_seq, bufSeq, 8);
+			}
+		}
+		
+		static sl_uint32 getCryptoInfoSize(const CryptoInfo& info)
+		{
+			if (info.info.cipher_type == TLS_CIPHER_AES_GCM_128) {
+				return sizeof(tls12_crypto_info_aes_gcm_128);
+			} else {
+				return sizeof(tls12_crypto_info_aes_gcm_256);
+			}
+		}
+		
+		static sl_bool getCryptoInfo(SSL* ssl, const Memory& secretClient, const Memory& secretServer, CryptoInfo& tx, CryptoInfo& rx)
+		{
+			const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+			if (!cipher) {
+				return sl_false;
+			}
+			sl_uint32 sizeKey;
+			int nid = SSL_CIPHER_get_cipher_nid(cipher);
+			if (nid == NID_aes_128_gcm) {
+				sizeKey = 16;
+			} else if (nid == NID_aes_256_gcm) {
+				sizeKey = 32;
+			} else {
+				return sl_false;
+			}
+			const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+			if (!md) {
+				return sl_false;
+			}
+			sl_bool flagServer = SSL_is_server(ssl) ? sl_true : sl_false;
+			int version = SSL_version(ssl);
+			if (version == TLS1_3_VERSION) {
+				if (secretClient.isNull() || secretServer.isNull()) {
+					return sl_false;
+				}
+				sl_uint8 keyClient[32], ivClient[12], keyServer[32], ivServer[12];
+				if (!(expandLabel(md, secretClient, "key", keyClient, sizeKey) && expandLabel(md, secretClient, "iv", ivClient, 12))) {
+					return sl_false;
+				}
+				if (!(expandLabel(md, secretServer, "key", keyServer, sizeKey) && expandLabel(md, secretServer, "iv", ivServer, 12))) {
+					return sl_false;
+				}
+				// application traffic starts at sequence number 0 (no post-handshake message is sent before offloading)
+				if (flagServer) {
+					setCryptoInfo(tx, TLS_1_3_VERSION, sizeKey, keyServer, ivServer + 4, ivServer, 0);
+					setCryptoInfo(rx, TLS_1_3_VERSION, sizeKey, keyClient, ivClient + 4, ivClient, 0);
+				} else {
+					setCryptoInfo(tx, TLS_1_3_VERSION, sizeKey, keyClient, ivClient + 4, ivClient, 0);
+					setCryptoInfo(rx, TLS_1_3_VERSION, sizeKey, keyServer, ivServer + 4, ivServer, 0);
+				}
+				Base::zeroMemory(keyClient, sizeof(keyClient));
+				Base::zeroMemory(keyServer, sizeof(keyServer));
+				return sl_true;
+			} else if (version == TLS1_2_VERSION) {
+				// client_write_key, server_write_key, client_write_IV, server_write_IV (AEAD ciphers have no MAC key)
+				sl_uint8 block[72];
+				sl_uint32 sizeBlock = (sizeKey << 1) + 8;
+				if (!(expandKeyBlock(ssl, md, block, sizeBlock))) {
+					return sl_false;
+				}
+				sl_uint8* keyClient = block;
+				sl_uint8* keyServer = block + sizeKey;
+				sl_uint8* saltClient = block + (sizeKey << 1);
+				sl_uint8* saltServer = saltClient + 4;
+				// `Finished` message is the first record protected by the negotiated keys, so application data starts at 1
+				if (flagServer) {
+					setCryptoInfo(tx, TLS_1_2_VERSION, sizeKey, keyServer, sl_null, saltServer, 1);
+					setCryptoInfo(rx, TLS_1_2_VERSION, sizeKey, keyClient, sl_null, saltClient, 1);
+				} else {
+					setCryptoInfo(tx, TLS_1_2_VERSION, sizeKey, keyClient, sl_null, saltClient, 1);
+					setCryptoInfo(rx, TLS_1_2_VERSION, sizeKey, keyServer, sl_null, saltServer, 1);
+				}
+				Base::zeroMemory(block, sizeof(block));
+				return sl_true;
+			}
+			return sl_false;
+		}
+		
+		static sl_bool setUlp(sl_file handle)
+		{
+			return setsockopt((int)handle, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) == 0;
+		}
+		
+		static sl_bool install(sl_file handle, sl_bool flagTx, const CryptoInfo& info)
+		{
+			return setsockopt((int)handle, SOL_TLS, flagTx ? TLS_TX : TLS_RX, &info, getCryptoInfoSize(info)) == 0;
+		}
+		
+	};
+#endif
+	
 	class _priv_OpenSSL_KeyStore : public Referable
 	{
 	public:
@@ -298,6 +513,9 @@ namespace slib
 					if (keyStores.isNotEmpty() || param.serverName.isNotEmpty()) {
 						SSL_CTX_set_client_hello_cb(ctx, client_hello_callback, ret.get());
 					}
+#if defined(SLIB_OPENSSL_SUPPORT_KERNEL_TLS)
+					SSL_CTX_set_keylog_callback(ctx, keylog_callback);
+#endif
 					return ret;
 				}
 				SSL_CTX_free(ctx);
@@ -310,6 +528,8 @@ namespace slib
 			return preverify;
 		}
 		
+		static void keylog_callback(const SSL* ssl, const char* line);
+		
 		static int client_hello_callback(SSL* ssl, int* al, void* arg)
 		{
 			_priv_OpenSSL_Context* context = (_priv_OpenSSL_Context*)arg;
@@ -378,6 +598,16 @@ namespace slib
 		sl_bool m_flagHandshaking;
 		sl_bool m_flagInitHandshake;
 		Function<void(TlsStreamResult&)> m_onHandshake;
+		
+		sl_bool m_flagKernelTls;
+		sl_bool m_flagKernelTlsPendingSending;
+		sl_bool m_flagKernelTlsSending;
+		sl_bool m_flagKernelTlsReceiving;
+		Memory m_secretClientTraffic;
+		Memory m_secretServerTraffic;
+#if defined(SLIB_OPENSSL_SUPPORT_KERNEL_TLS)
+		_priv_OpenSSL_KernelTls::CryptoInfo m_cryptoInfoSending;
+#endif
 
 	protected:
 		_priv_OpenSSL_Stream(const Ref<AsyncStream>& baseStream)
@@ -393,6 +623,11 @@ namespace slib
 			
 			m_flagHandshaking = sl_true;
 			m_flagInitHandshake = sl_false;
+			
+			m_flagKernelTls = sl_false;
+			m_flagKernelTlsPendingSending = sl_false;
+			m_flagKernelTlsSending = sl_false;
+			m_flagKernelTlsReceiving = sl_false;
 		}
 
 		void init() override
@@ -430,6 +665,10 @@ namespace slib
 			Ref<_priv_OpenSSL_Stream> ret = create(stream, param);
 			if (ret.isNotNull()) {
 				ret->m_onHandshake = param.onHandshake;
+				if (ret->m_flagKernelTls) {
+					// NewSessionTicket messages would be sent after handshake, and advance the sequence number of the offloaded records
+					SSL_set_num_tickets(ret->m_ssl, 0);
+				}
 				SSL_set_accept_state(ret->m_ssl);
 				if (param.flagAutoStartHandshake) {
 					ret->handshake();
@@ -480,6 +719,13 @@ namespace slib
 							BIO_set_callback_ex(wbio, write_callback);
 							ret->m_bufReadingBase = bufReading;
 							ret->m_bufWritingBase = bufWriting;
+#if defined(SLIB_OPENSSL_SUPPORT_KERNEL_TLS)
+							if (param.flagKernelTls) {
+								ret->m_flagKernelTls = sl_true;
+								SSL_set_app_data(ssl, ret.get());
+								SSL_set_options(ssl, SSL_OP_NO_RENEGOTIATION);
+							}
+#endif
 							return ret;
 						}
 					}
@@ -610,6 +856,9 @@ namespace slib
 				if (m_requestWrite.isNull()) {
 					return;
 				}
+				if (m_flagKernelTlsPendingSending || m_flagKernelTlsSending) {
+					return;
+				}
 				for (;;) {
 					int ret = -1;
 					if (!m_flagWritingError) {
@@ -677,6 +926,9 @@ namespace slib
 			m_flagWritingBase = sl_false;
 			doIO(lock);
 			startWritingBase();
+			if (m_flagKernelTlsPendingSending) {
+				startKernelTlsSending();
+			}
 		}
 		
 		void doIO(ObjectLocker& lock)
@@ -710,6 +962,9 @@ namespace slib
 			int ret = SSL_connect(m_ssl);
 			if (ret == 1) {
 				m_flagHandshaking = sl_false;
+				if (m_flagKernelTls) {
+					prepareKernelTls();
+				}
 				lock.unlock();
 				if (m_onHandshake.isNotNull()) {
 					TlsStreamResult result(this);
@@ -732,6 +987,124 @@ namespace slib
 			}
 		}
 		
+		void prepareKernelTls()
+		{
+#if defined(SLIB_OPENSSL_SUPPORT_KERNEL_TLS)
+			Ref<AsyncIoInstance> instance = m_baseStream->getIoInstance();
+			if (instance.isNull()) {
+				return;
+			}
+			sl_file handle = instance->getHandle();
+			if (handle == SLIB_FILE_INVALID_HANDLE) {
+				return;
+			}
+			_priv_OpenSSL_KernelTls::CryptoInfo infoReceiving;
+			sl_bool flagSuccess = _priv_OpenSSL_KernelTls::getCryptoInfo(m_ssl, m_secretClientTraffic, m_secretServerTraffic, m_cryptoInfoSending, infoReceiving);
+			m_secretClientTraffic.setNull();
+			m_secretServerTraffic.setNull();
+			if (!flagSuccess) {
+				Base::zeroMemory(&infoReceiving, sizeof(infoReceiving));
+				return;
+			}
+			if (!(_priv_OpenSSL_KernelTls::setUlp(handle))) {
+				// `tls` module is not loaded
+				Base::zeroMemory(&m_cryptoInfoSending, sizeof(m_cryptoInfoSending));
+				Base::zeroMemory(&infoReceiving, sizeof(infoReceiving));
+				return;
+			}
+			// Receiving can be offloaded only if no record of the peer is buffered in user-space, and the sequence number is known (TLS 1.3 server may send NewSessionTicket)
+			if (!m_flagReadingBase && !(BIO_ctrl_pending(m_rbio)) && !(SSL_has_pending(m_ssl))) {
+				if (SSL_is_server(m_ssl) || SSL_version(m_ssl) != TLS1_3_VERSION) {
+					if (_priv_OpenSSL_KernelTls::install(handle, sl_false, infoReceiving)) {
+						m_flagKernelTlsReceiving = sl_true;
+						Ref<AsyncStreamRequest> request = m_requestRead;
+						m_requestRead.setNull();
+						while (request.isNotNull()) {
+							readKernelTls(request);
+							if (!(m_queueRead.pop_NoLock(&request))) {
+								break;
+							}
+						}
+					}
+				}
+			}
+			Base::zeroMemory(&infoReceiving, sizeof(infoReceiving));
+			m_flagKernelTlsPendingSending = sl_true;
+			startKernelTlsSending();
+#endif
+		}
+		
+		void startKernelTlsSending()
+		{
+#if defined(SLIB_OPENSSL_SUPPORT_KERNEL_TLS)
+			if (m_flagWritingBase || m_sizeWritingBase > 0 || BIO_ctrl_pending(m_wbio)) {
+				// records encrypted in user-space (such as `Finished`) should be sent before installing the keys
+				return;
+			}
+			m_flagKernelTlsPendingSending = sl_false;
+			Ref<AsyncIoInstance> instance = m_baseStream->getIoInstance();
+			if (instance.isNotNull()) {
+				if (_priv_OpenSSL_KernelTls::install(instance->getHandle(), sl_true, m_cryptoInfoSending)) {
+					m_flagKernelTlsSending = sl_true;
+				}
+			}
+			Base::zeroMemory(&m_cryptoInfoSending, sizeof(m_cryptoInfoSending));
+			if (m_flagKernelTlsSending) {
+				Ref<AsyncStreamRequest> request = m_requestWrite;
+				m_requestWrite.setNull();
+				m_sizeWritten = 0;
+				while (request.isNotNull()) {
+					writeKernelTls(request);
+					if (!(m_queueWrite.pop_NoLock(&request))) {
+						break;
+					}
+				}
+			} else if (m_requestWrite.isNotNull()) {
+				addTask(m_doStartWriting);
+			}
+#endif
+		}
+		
+		void readKernelTls(const Ref<AsyncStreamRequest>& request)
+		{
+			if (!(m_baseStream->read(request->data, request->size, SLIB_BIND_WEAKREF(void(AsyncStreamResult&), _priv_OpenSSL_Stream, onKernelTlsIO, this, request), request->userObject.get()))) {
+				request->runCallback(this, 0, sl_true);
+			}
+		}
+		
+		void writeKernelTls(const Ref<AsyncStreamRequest>& request)
+		{
+			if (!(m_baseStream->write(request->data, request->size, SLIB_BIND_WEAKREF(void(AsyncStreamResult&), _priv_OpenSSL_Stream, onKernelTlsIO, this, request), request->userObject.get()))) {
+				request->runCallback(this, 0, sl_true);
+			}
+		}
+		
+		void onKernelTlsIO(const Ref<AsyncStreamRequest>& request, AsyncStreamResult& result)
+		{
+			request->runCallback(this, result.size, result.flagError);
+		}
+		
+	public:
+		void setTrafficSecret(sl_bool flagClient, const Memory& secret)
+		{
+			ObjectLocker lock(this);
+			if (flagClient) {
+				m_secretClientTraffic = secret;
+			} else {
+				m_secretServerTraffic = secret;
+			}
+		}
+		
+		sl_bool isKernelTlsSending() override
+		{
+			return m_flagKernelTlsSending;
+		}
+		
+		sl_bool isKernelTlsReceiving() override
+		{
+			return m_flagKernelTlsReceiving;
+		}
+		
 	public:
 		SSL* getSSL() override
 		{
@@ -767,6 +1140,9 @@ namespace slib
 			if (request.isNull()) {
 				return sl_false;
 			}
+			if (m_flagKernelTlsReceiving) {
+				return m_baseStream->read(data, size, SLIB_BIND_WEAKREF(void(AsyncStreamResult&), _priv_OpenSSL_Stream, onKernelTlsIO, this, request), userObject);
+			}
 			if (m_requestRead.isNull()) {
 				m_requestRead = request;
 				startReadingBase();
@@ -789,6 +1165,9 @@ namespace slib
 			if (request.isNull()) {
 				return sl_false;
 			}
+			if (m_flagKernelTlsSending) {
+				return m_baseStream->write(data, size, SLIB_BIND_WEAKREF(void(AsyncStreamResult&), _priv_OpenSSL_Stream, onKernelTlsIO, this, request), userObject);
+			}
 			if (m_requestWrite.isNull()) {
 				m_requestWrite = request;
 				m_sizeWritten = 0;
@@ -799,6 +1178,34 @@ namespace slib
 			return sl_true;
 		}
 		
+		sl_bool isSendFileSupported() override
+		{
+			ObjectLocker lock(this);
+			if (m_baseStream.isNull()) {
+				return sl_false;
+			}
+			if (m_flagKernelTlsSending) {
+				return m_baseStream->isSendFileSupported();
+			}
+			return sl_false;
+		}
+		
+		sl_bool sendFile(const Ref<File>& file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject) override
+		{
+			ObjectLocker lock(this);
+			if (m_baseStream.isNull()) {
+				return sl_false;
+			}
+			if (!m_flagKernelTlsSending) {
+				return sl_false;
+			}
+			Ref<AsyncStreamRequest> request = AsyncStreamRequest::createWrite(sl_null, size, userObject, callback);
+			if (request.isNull()) {
+				return sl_false;
+			}
+			return m_baseStream->sendFile(file, offset, size, SLIB_BIND_WEAKREF(void(AsyncStreamResult&), _priv_OpenSSL_Stream, onKernelTlsIO, this, request), userObject);
+		}
+		
 		sl_bool addTask(const Function<void()>& callback) override
 		{
 			ObjectLocker lock(this);
@@ -810,6 +1217,28 @@ namespace slib
 		
 	};
 	
+	void _priv_OpenSSL_Context::keylog_callback(const SSL* ssl, const char* line)
+	{
+		// TLS 1.3 application traffic secrets are needed to offload the records to kernel TLS
+		_priv_OpenSSL_Stream* stream = (_priv_OpenSSL_Stream*)(SSL_get_app_data(ssl));
+		if (!stream) {
+			return;
+		}
+		sl_bool flagClient;
+		if (Base::equalsMemory(line, "CLIENT_TRAFFIC_SECRET_0 ", 24)) {
+			flagClient = sl_true;
+		} else if (Base::equalsMemory(line, "SERVER_TRAFFIC_SECRET_0 ", 24)) {
+			flagClient = sl_false;
+		} else {
+			return;
+		}
+		String s(line);
+		sl_reg index = s.lastIndexOf(' ');
+		if (index > 0) {
+			stream->setTrafficSecret(flagClient, s.substring(index + 1).parseHexString());
+		}
+	}
+	
 	Ref<OpenSSL_Context> OpenSSL::createContext(const TlsContextParam& param)
 	{
 		return Ref<OpenSSL_Context>::from(_priv_OpenSSL_Context::create(param));
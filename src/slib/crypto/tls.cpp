@@ -86,7 +86,8 @@ namespace slib
 	TlsStreamParam::TlsStreamParam():
 		readingBufferSize(0x40000),
 		writingBufferSize(0x40000),
-		flagAutoStartHandshake(sl_true)
+		flagAutoStartHandshake(sl_true),
+		flagKernelTls(sl_false)
 	{
 	}
 	
@@ -125,5 +126,15 @@ namespace slib
 	TlsAsyncStream::~TlsAsyncStream()
 	{
 	}
+	
+	sl_bool TlsAsyncStream::isKernelTlsSending()
+	{
+		return sl_false;
+	}
+	
+	sl_bool TlsAsyncStream::isKernelTlsReceiving()
+	{
+		return sl_false;
+	}
 
 }
@@ -25,6 +25,8 @@
 #include "slib/graphics/yuv.h"
 #include "slib/core/compile_optimize.h"
 
+#include "slib/graphics/detail/image_simd.h"
+
 namespace slib
 {
 
@@ -1260,8 +1262,98 @@ namespace slib
 		}
 	}
 
+	// gets the byte offsets of r, g, b, a in the samples of packed RGB formats (-1 for no alpha)
+	static sl_bool _priv_BitmapData_getPackedRGBLayout(BitmapFormat format, sl_int32* indices, sl_bool& flagPA)
+	{
+		flagPA = BitmapFormats::isPrecomputedAlpha(format);
+		switch (format) {
+			case BitmapFormat::RGBA:
+			case BitmapFormat::RGBA_PA:
+				indices[0] = 0; indices[1] = 1; indices[2] = 2; indices[3] = 3;
+				return sl_true;
+			case BitmapFormat::BGRA:
+			case BitmapFormat::BGRA_PA:
+				indices[0] = 2; indices[1] = 1; indices[2] = 0; indices[3] = 3;
+				return sl_true;
+			case BitmapFormat::ARGB:
+			case BitmapFormat::ARGB_PA:
+				indices[0] = 1; indices[1] = 2; indices[2] = 3; indices[3] = 0;
+				return sl_true;
+			case BitmapFormat::ABGR:
+			case BitmapFormat::ABGR_PA:
+				indices[0] = 3; indices[1] = 2; indices[2] = 1; indices[3] = 0;
+				return sl_true;
+			case BitmapFormat::RGB:
+				indices[0] = 0; indices[1] = 1; indices[2] = 2; indices[3] = -1;
+				return sl_true;
+			case BitmapFormat::BGR:
+				indices[0] = 2; indices[1] = 1; indices[2] = 0; indices[3] = -1;
+				return sl_true;
+			default:
+				break;
+		}
+		return sl_false;
+	}
+	
+	// vectorized conversion between packed RGB formats, giving the same result as `readSample`/`writeSample`
+	static sl_bool _priv_BitmapData_copyPixels_PackedRGB(sl_uint32 width, sl_uint32 height, BitmapFormat src_format, sl_uint8* src, sl_int32 src_pitch, sl_int32 src_sample_stride, BitmapFormat dst_format, sl_uint8* dst, sl_int32 dst_pitch, sl_int32 dst_sample_stride)
+	{
+		sl_int32 src_indices[4], dst_indices[4];
+		sl_bool src_PA, dst_PA;
+		if (!(_priv_BitmapData_getPackedRGBLayout(src_format, src_indices, src_PA))) {
+			return sl_false;
+		}
+		if (!(_priv_BitmapData_getPackedRGBLayout(dst_format, dst_indices, dst_PA))) {
+			return sl_false;
+		}
+		sl_int32 src_bytes = src_indices[3] < 0 ? 3 : 4;
+		sl_int32 dst_bytes = dst_indices[3] < 0 ? 3 : 4;
+		if (src_sample_stride != src_bytes || dst_sample_stride != dst_bytes) {
+			return sl_false;
+		}
+		if (src_bytes == 3 && dst_bytes == 3) {
+			return sl_false;
+		}
+		if (src_PA && dst_bytes == 3) {
+			return sl_false;
+		}
+		sl_uint8 order[4];
+		for (sl_uint32 k = 0; k < 4; k++) {
+			if (dst_indices[k] >= 0) {
+				order[dst_indices[k]] = src_indices[k] >= 0 ? (sl_uint8)(src_indices[k]) : 255;
+			}
+		}
+		for (sl_uint32 i = 0; i < height; i++) {
+			if (src_bytes == 4) {
+				if (dst_bytes == 4) {
+					_priv_ImageSimd::shuffleRow_4to4(dst, src, width, order);
+				} else {
+					_priv_ImageSimd::shuffleRow_4to3(dst, src, width, order);
+				}
+			} else {
+				_priv_ImageSimd::shuffleRow_3to4(dst, src, width, order);
+			}
+			if (src_PA) {
+				if (!dst_PA) {
+					_priv_ImageSimd::unpremultiplyRow(dst, width, dst_indices[3]);
+				}
+			} else {
+				// opaque samples are not changed by premultiplying
+				if (dst_PA && src_bytes == 4) {
+					_priv_ImageSimd::premultiplyRow(dst, width, dst_indices[3]);
+				}
+			}
+			src += src_pitch;
+			dst += dst_pitch;
+		}
+		return sl_true;
+	}
+
 	static void _priv_BitmapData_copyPixels_Normal(sl_uint32 width, sl_uint32 height, BitmapFormat src_format, sl_uint8* src, sl_int32 src_pitch, sl_int32 src_sample_stride, BitmapFormat dst_format, sl_uint8* dst, sl_int32 dst_pitch, sl_int32 dst_sample_stride)
 	{
+		if (_priv_BitmapData_copyPixels_PackedRGB(width, height, src_format, src, src_pitch, src_sample_stride, dst_format, dst, dst_pitch, dst_sample_stride)) {
+			return;
+		}
 		switch (src_format) {
 #define __CASE(FORMAT) \
 			case BitmapFormat::FORMAT: \
@@ -1703,8 +1795,62 @@ namespace slib
 		}
 	}
 
+	// 32 bit RGB layouts which the frame converters of `YUV` handle directly
+	static sl_bool _priv_BitmapData_getYUVFrameLayout(BitmapFormat format, sl_int32 sample_stride, sl_bool flagWriting, sl_bool& flagBGRA)
+	{
+		if (sample_stride != 4) {
+			return sl_false;
+		}
+		switch (format) {
+			case BitmapFormat::RGBA:
+				flagBGRA = sl_false;
+				return sl_true;
+			case BitmapFormat::BGRA:
+				flagBGRA = sl_true;
+				return sl_true;
+			// opaque colors are same in premultiplied alpha
+			case BitmapFormat::RGBA_PA:
+				flagBGRA = sl_false;
+				return flagWriting;
+			case BitmapFormat::BGRA_PA:
+				flagBGRA = sl_true;
+				return flagWriting;
+			default:
+				break;
+		}
+		return sl_false;
+	}
+	
+	static sl_bool _priv_BitmapData_getYUV420Components(const BitmapData& bd, ColorComponentBuffer* components)
+	{
+		if (bd.getColorComponentBuffers(components) != 3) {
+			return sl_false;
+		}
+		if (components[0].sampleStride != 1) {
+			return sl_false;
+		}
+		return components[1].sampleStride == components[2].sampleStride && components[1].sampleStride > 0;
+	}
+	
+	static sl_bool _priv_BitmapData_copyPixels_YUV420ToRGBA(sl_uint32 width, sl_uint32 height, BitmapData& src, BitmapFormat dst_format, sl_uint8* dst, sl_int32 dst_pitch, sl_int32 dst_sample_stride)
+	{
+		sl_bool flagBGRA;
+		if (!(_priv_BitmapData_getYUVFrameLayout(dst_format, dst_sample_stride, sl_true, flagBGRA))) {
+			return sl_false;
+		}
+		ColorComponentBuffer c[3];
+		if (!(_priv_BitmapData_getYUV420Components(src, c))) {
+			return sl_false;
+		}
+		YUV::convertYUV420ToRGBA(width, height, (sl_uint8*)(c[0].data), c[0].pitch, (sl_uint8*)(c[1].data), c[1].pitch, (sl_uint8*)(c[2].data), c[2].pitch, (sl_uint32)(c[1].sampleStride), dst, dst_pitch, flagBGRA);
+		return sl_true;
+	}
+	
 	static void _priv_BitmapData_copyPixels_YUV420ToOtherNormal(sl_uint32 width, sl_uint32 height, BitmapData& src, BitmapFormat dst_format, sl_uint8* dst, sl_int32 dst_pitch, sl_int32 dst_sample_stride)
 	{
+		if (_priv_BitmapData_copyPixels_YUV420ToRGBA(width, height, src, dst_format, dst, dst_pitch, dst_sample_stride)) {
+			return;
+		}
 		switch (dst_format) {
 #define __CASE(FORMAT) \
 			case BitmapFormat::FORMAT: \
@@ -2010,8 +2156,25 @@ namespace slib
 		}
 	}
 
+	static sl_bool _priv_BitmapData_copyPixels_RGBAToYUV420(sl_uint32 width, sl_uint32 height, BitmapFormat src_format, sl_uint8* src, sl_int32 src_pitch, sl_int32 src_sample_stride, BitmapData& dst)
+	{
+		sl_bool flagBGRA;
+		if (!(_priv_BitmapData_getYUVFrameLayout(src_format, src_sample_stride, sl_false, flagBGRA))) {
+			return sl_false;
+		}
+		ColorComponentBuffer c[3];
+		if (!(_priv_BitmapData_getYUV420Components(dst, c))) {
+			return sl_false;
+		}
+		YUV::convertRGBAToYUV420(width, height, src, src_pitch, (sl_uint8*)(c[0].data), c[0].pitch, (sl_uint8*)(c[1].data), c[1].pitch, (sl_uint8*)(c[2].data), c[2].pitch, (sl_uint32)(c[1].sampleStride), flagBGRA);
+		return sl_true;
+	}
+
 	void _priv_BitmapData_copyPixels_OtherNormalToYUV420(sl_uint32 width, sl_uint32 height, BitmapFormat src_format, sl_uint8* src, sl_int32 src_pitch, sl_int32 src_sample_stride, BitmapData& dst)
 	{
+		if (_priv_BitmapData_copyPixels_RGBAToYUV420(width, height, src_format, src, src_pitch, src_sample_stride, dst)) {
+			return;
+		}
 		switch (src_format) {
 #define __CASE(FORMAT) \
 			case BitmapFormat::FORMAT: \
@@ -2259,12 +2422,7 @@ namespace slib
 						if (bytesPerSample == src_stride && bytesPerSample == dst_stride) {
 							sl_uint32 n = bytesPerSample * width;
 							for (sl_uint32 i = 0; i < height; i++) {
-								sl_uint8* s = src_row;
-								sl_uint8* d = dst_row;
-								for (sl_uint32 k = 0; k < n; k++) {
-									*d = *s;
-									d++; s++;
-								}
+								Base::copyMemory(dst_row, src_row, n);
 								src_row += src_pitch;
 								dst_row += dst_pitch;
 							}
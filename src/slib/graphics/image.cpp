@@ -25,6 +25,30 @@
 #include "slib/core/file.h"
 #include "slib/core/asset.h"
 #include "slib/core/scoped.h"
+#include "slib/core/parallel.h"
+
+#include "slib/core/detail/simd.h"
+#include "slib/graphics/detail/image_simd.h"
+
+#if defined(SLIB_ARCH_IS_X64) || (defined(SLIB_ARCH_IS_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#	define SLIB_IMAGE_SIMD_X86
+#	include <emmintrin.h>
+#	include <tmmintrin.h>
+#	include <immintrin.h>
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#	endif
+#	if defined(__GNUC__) || defined(__clang__)
+#		define PRIV_TARGET_SSSE3 __attribute__((target("ssse3")))
+#		define PRIV_TARGET_AVX2 __attribute__((target("avx2")))
+#	else
+#		define PRIV_TARGET_SSSE3
+#		define PRIV_TARGET_AVX2
+#	endif
+#elif defined(SLIB_ARCH_IS_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define SLIB_IMAGE_SIMD_NEON
+#	include <arm_neon.h>
+#endif
 
 namespace slib
 {
@@ -452,15 +476,1264 @@ namespace slib
 		return sl_null;
 	}
 
+#define PRIV_IMAGE_SIMD_BASE 1
+#define PRIV_IMAGE_SIMD_SSSE3 2
+#define PRIV_IMAGE_SIMD_AVX2 4
+
+	// supported features under `_priv_Simd::setLevelLimit()`
+	static sl_uint32 _priv_ImageSimd_getFeatures()
+	{
+		switch (_priv_Simd::getLevel()) {
+			case _priv_Simd::None:
+				return 0;
+			case _priv_Simd::Base:
+				return PRIV_IMAGE_SIMD_BASE;
+			case _priv_Simd::SSSE3:
+				return PRIV_IMAGE_SIMD_BASE | PRIV_IMAGE_SIMD_SSSE3;
+			default:
+				return PRIV_IMAGE_SIMD_BASE | PRIV_IMAGE_SIMD_SSSE3 | PRIV_IMAGE_SIMD_AVX2;
+		}
+	}
+
+#if defined(SLIB_IMAGE_SIMD_X86)
+	
+	// x / 255 (0 <= x <= 65025)
+	SLIB_INLINE static __m128i _priv_ImageSimd_div255_SSE2(__m128i x)
+	{
+		return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+	}
+	
+	SLIB_INLINE static __m128i _priv_ImageSimd_blend_SSE2(__m128i d, __m128i s, __m128i zero)
+	{
+		// src alpha is blended with 255 in `Color::blend_PA_NPA`
+		__m128i s1 = _mm_or_si128(s, _mm_set1_epi32((int)0xFF000000));
+		__m128i sa = _mm_unpacklo_epi8(s, zero);
+		sa = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sa, 0xFF), 0xFF);
+		__m128i ia = _mm_sub_epi16(_mm_set1_epi16(255), sa);
+		__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), ia), _mm_mullo_epi16(_mm_unpacklo_epi8(s1, zero), sa));
+		sa = _mm_unpackhi_epi8(s, zero);
+		sa = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sa, 0xFF), 0xFF);
+		ia = _mm_sub_epi16(_mm_set1_epi16(255), sa);
+		__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), ia), _mm_mullo_epi16(_mm_unpackhi_epi8(s1, zero), sa));
+		return _mm_packus_epi16(_priv_ImageSimd_div255_SSE2(lo), _priv_ImageSimd_div255_SSE2(hi));
+	}
+	
+	template <sl_bool flagConstantSource>
+	static sl_size _priv_ImageSimd_blendRow_SSE2(Color* dst, const Color* src, sl_size count)
+	{
+		__m128i zero = _mm_setzero_si128();
+		__m128i s = _mm_set1_epi32(*((const int*)src));
+		sl_size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			if (!flagConstantSource) {
+				s = _mm_loadu_si128((const __m128i*)(src + i));
+			}
+			__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+			_mm_storeu_si128((__m128i*)(dst + i), _priv_ImageSimd_blend_SSE2(d, s, zero));
+		}
+		return i;
+	}
+	
+	PRIV_TARGET_AVX2 SLIB_INLINE static __m256i _priv_ImageSimd_div255_AVX2(__m256i x)
+	{
+		return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+	}
+	
+	template <sl_bool flagConstantSource>
+	PRIV_TARGET_AVX2 static sl_size _priv_ImageSimd_blendRow_AVX2(Color* dst, const Color* src, sl_size count)
+	{
+		__m256i zero = _mm256_setzero_si256();
+		__m256i alpha = _mm256_set1_epi32((int)0xFF000000);
+		__m256i c255 = _mm256_set1_epi16(255);
+		__m256i maskAlpha = _mm256_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15, 6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+		__m256i s = _mm256_set1_epi32(*((const int*)src));
+		sl_size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			if (!flagConstantSource) {
+				s = _mm256_loadu_si256((const __m256i*)(src + i));
+			}
+			__m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+			__m256i s1 = _mm256_or_si256(s, alpha);
+			__m256i sa = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(s, zero), maskAlpha);
+			__m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), _mm256_sub_epi16(c255, sa)), _mm256_mullo_epi16(_mm256_unpacklo_epi8(s1, zero), sa));
+			sa = _mm256_shuffle_epi8(_mm256_unpackhi_epi8(s, zero), maskAlpha);
+			__m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), _mm256_sub_epi16(c255, sa)), _mm256_mullo_epi16(_mm256_unpackhi_epi8(s1, zero), sa));
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_packus_epi16(_priv_ImageSimd_div255_AVX2(lo), _priv_ImageSimd_div255_AVX2(hi)));
+		}
+		return i;
+	}
+	
+	SLIB_INLINE static __m128i _priv_ImageSimd_premultiply_SSE2(__m128i p, __m128i zero, sl_uint32 indexAlpha)
+	{
+		__m128i one = _mm_set1_epi16(1);
+		__m128i lo = _mm_unpacklo_epi8(p, zero);
+		__m128i hi = _mm_unpackhi_epi8(p, zero);
+		__m128i alo, ahi;
+		if (indexAlpha) {
+			alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0xFF), 0xFF);
+			ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0xFF), 0xFF);
+		} else {
+			alo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, 0), 0);
+			ahi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, 0), 0);
+		}
+		lo = _mm_srli_epi16(_mm_mullo_epi16(lo, _mm_add_epi16(alo, one)), 8);
+		hi = _mm_srli_epi16(_mm_mullo_epi16(hi, _mm_add_epi16(ahi, one)), 8);
+		__m128i mask = _mm_set1_epi32(indexAlpha ? (int)0xFF000000 : 0xFF);
+		return _mm_or_si128(_mm_andnot_si128(mask, _mm_packus_epi16(lo, hi)), _mm_and_si128(mask, p));
+	}
+	
+	static sl_size _priv_ImageSimd_premultiplyRow_SSE2(sl_uint8* data, sl_size count, sl_uint32 indexAlpha)
+	{
+		__m128i zero = _mm_setzero_si128();
+		sl_size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i* p = (__m128i*)(data + (i << 2));
+			_mm_storeu_si128(p, _priv_ImageSimd_premultiply_SSE2(_mm_loadu_si128(p), zero, indexAlpha));
+		}
+		return i;
+	}
+	
+	SLIB_INLINE static __m128i _priv_ImageSimd_unpremultiplyPixel_SSE2(__m128i c, sl_uint32 indexAlpha)
+	{
+		// (c << 8) / (a + 1) is exact in single precision, because c << 8 < 2^16 and a + 1 <= 256
+		__m128 a = _mm_cvtepi32_ps(indexAlpha ? _mm_shuffle_epi32(c, 0xFF) : _mm_shuffle_epi32(c, 0));
+		a = _mm_add_ps(a, _mm_set1_ps(1.0f));
+		__m128 f = _mm_mul_ps(_mm_cvtepi32_ps(c), _mm_set1_ps(256.0f));
+		return _mm_cvttps_epi32(_mm_div_ps(f, a));
+	}
+	
+	static sl_size _priv_ImageSimd_unpremultiplyRow_SSE2(sl_uint8* data, sl_size count, sl_uint32 indexAlpha)
+	{
+		__m128i zero = _mm_setzero_si128();
+		__m128i mask = _mm_set1_epi32(indexAlpha ? (int)0xFF000000 : 0xFF);
+		sl_size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128i* p = (__m128i*)(data + (i << 2));
+			__m128i v = _mm_loadu_si128(p);
+			__m128i lo = _mm_unpacklo_epi8(v, zero);
+			__m128i hi = _mm_unpackhi_epi8(v, zero);
+			__m128i c0 = _priv_ImageSimd_unpremultiplyPixel_SSE2(_mm_unpacklo_epi16(lo, zero), indexAlpha);
+			__m128i c1 = _priv_ImageSimd_unpremultiplyPixel_SSE2(_mm_unpackhi_epi16(lo, zero), indexAlpha);
+			__m128i c2 = _priv_ImageSimd_unpremultiplyPixel_SSE2(_mm_unpacklo_epi16(hi, zero), indexAlpha);
+			__m128i c3 = _priv_ImageSimd_unpremultiplyPixel_SSE2(_mm_unpackhi_epi16(hi, zero), indexAlpha);
+			// saturating packs clamp the results to 255
+			__m128i r = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+			_mm_storeu_si128(p, _mm_or_si128(_mm_andnot_si128(mask, r), _mm_and_si128(mask, v)));
+		}
+		return i;
+	}
+	
+	static __m128i _priv_ImageSimd_getShuffleMask(const sl_uint8* order, sl_uint32 nOrder, sl_uint32 bytesPerSampleSrc, sl_uint32 nBytes)
+	{
+		SLIB_ALIGN(16) sl_uint8 mask[16];
+		for (sl_uint32 i = 0; i < 16; i++) {
+			if (i < nBytes) {
+				sl_uint32 k = i % nOrder;
+				if (order[k] == 255) {
+					mask[i] = 0x80;
+				} else {
+					mask[i] = (sl_uint8)((i / nOrder) * bytesPerSampleSrc + order[k]);
+				}
+			} else {
+				mask[i] = 0x80;
+			}
+		}
+		return _mm_load_si128((const __m128i*)mask);
+	}
+	
+	PRIV_TARGET_SSSE3 static sl_size _priv_ImageSimd_shuffleRow_4to4_SSSE3(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[4])
+	{
+		__m128i mask = _priv_ImageSimd_getShuffleMask(order, 4, 4, 16);
+		sl_size i = 0;
+		for (; i + 4 <= count; i += 4) {
+			_mm_storeu_si128((__m128i*)(dst + (i << 2)), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + (i << 2))), mask));
+		}
+		return i;
+	}
+	
+	PRIV_TARGET_AVX2 static sl_size _priv_ImageSimd_shuffleRow_4to4_AVX2(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[4])
+	{
+		__m128i m = _priv_ImageSimd_getShuffleMask(order, 4, 4, 16);
+		__m256i mask = _mm256_inserti128_si256(_mm256_castsi128_si256(m), m, 1);
+		sl_size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			_mm256_storeu_si256((__m256i*)(dst + (i << 2)), _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(src + (i << 2))), mask));
+		}
+		return i;
+	}
+	
+	PRIV_TARGET_SSSE3 static sl_size _priv_ImageSimd_shuffleRow_4to3_SSSE3(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[3])
+	{
+		__m128i mask = _priv_ImageSimd_getShuffleMask(order, 3, 4, 12);
+		sl_size i = 0;
+		// 16 bytes are stored for 4 samples (12 bytes), so leave enough room at the end of the row
+		for (; i + 6 <= count; i += 4) {
+			_mm_storeu_si128((__m128i*)(dst + i * 3), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + (i << 2))), mask));
+		}
+		return i;
+	}
+	
+	PRIV_TARGET_SSSE3 static sl_size _priv_ImageSimd_shuffleRow_3to4_SSSE3(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[4])
+	{
+		__m128i mask = _priv_ImageSimd_getShuffleMask(order, 4, 3, 16);
+		SLIB_ALIGN(16) sl_uint8 alpha[16];
+		for (sl_uint32 k = 0; k < 16; k++) {
+			alpha[k] = order[k & 3] == 255 ? 255 : 0;
+		}
+		__m128i a = _mm_load_si128((const __m128i*)alpha);
+		sl_size i = 0;
+		// 16 bytes are loaded for 4 samples (12 bytes), so leave enough room at the end of the row
+		for (; i + 6 <= count; i += 4) {
+			_mm_storeu_si128((__m128i*)(dst + (i << 2)), _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i * 3)), mask), a));
+		}
+		return i;
+	}
+#endif
+
+#if defined(SLIB_IMAGE_SIMD_NEON)
+	// x / 255 (0 <= x <= 65025)
+	SLIB_INLINE static uint8x8_t _priv_ImageSimd_div255_NEON(uint16x8_t x)
+	{
+		return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+	}
+	
+	SLIB_INLINE static uint8x16_t _priv_ImageSimd_blend_NEON(uint8x16_t d, uint8x16_t s, uint8x16_t sa, uint8x16_t ia)
+	{
+		uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(d), vget_low_u8(ia)), vget_low_u8(s), vget_low_u8(sa));
+		uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(d), vget_high_u8(ia)), vget_high_u8(s), vget_high_u8(sa));
+		return vcombine_u8(_priv_ImageSimd_div255_NEON(lo), _priv_ImageSimd_div255_NEON(hi));
+	}
+	
+	template <sl_bool flagConstantSource>
+	static sl_size _priv_ImageSimd_blendRow_NEON(Color* dst, const Color* src, sl_size count)
+	{
+		uint8x16x4_t s;
+		s.val[0] = vdupq_n_u8(src->r);
+		s.val[1] = vdupq_n_u8(src->g);
+		s.val[2] = vdupq_n_u8(src->b);
+		s.val[3] = vdupq_n_u8(src->a);
+		uint8x16_t c255 = vdupq_n_u8(255);
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			if (!flagConstantSource) {
+				s = vld4q_u8((const uint8_t*)(src + i));
+			}
+			uint8x16x4_t d = vld4q_u8((const uint8_t*)(dst + i));
+			uint8x16_t ia = vsubq_u8(c255, s.val[3]);
+			d.val[0] = _priv_ImageSimd_blend_NEON(d.val[0], s.val[0], s.val[3], ia);
+			d.val[1] = _priv_ImageSimd_blend_NEON(d.val[1], s.val[1], s.val[3], ia);
+			d.val[2] = _priv_ImageSimd_blend_NEON(d.val[2], s.val[2], s.val[3], ia);
+			// src alpha is blended with 255 in `Color::blend_PA_NPA`
+			d.val[3] = _priv_ImageSimd_blend_NEON(d.val[3], c255, s.val[3], ia);
+			vst4q_u8((uint8_t*)(dst + i), d);
+		}
+		return i;
+	}
+	
+	SLIB_INLINE static uint8x16_t _priv_ImageSimd_premultiply_NEON(uint8x16_t c, uint8x16_t a)
+	{
+		// (c * (a + 1)) >> 8
+		uint16x8_t lo = vaddw_u8(vmull_u8(vget_low_u8(c), vget_low_u8(a)), vget_low_u8(c));
+		uint16x8_t hi = vaddw_u8(vmull_u8(vget_high_u8(c), vget_high_u8(a)), vget_high_u8(c));
+		return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+	}
+	
+	static sl_size _priv_ImageSimd_premultiplyRow_NEON(sl_uint8* data, sl_size count, sl_uint32 indexAlpha)
+	{
+		sl_uint32 i0 = indexAlpha ? 0 : 1;
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			uint8_t* p = (uint8_t*)(data + (i << 2));
+			uint8x16x4_t v = vld4q_u8(p);
+			uint8x16_t a = v.val[indexAlpha];
+			v.val[i0] = _priv_ImageSimd_premultiply_NEON(v.val[i0], a);
+			v.val[i0 + 1] = _priv_ImageSimd_premultiply_NEON(v.val[i0 + 1], a);
+			v.val[i0 + 2] = _priv_ImageSimd_premultiply_NEON(v.val[i0 + 2], a);
+			vst4q_u8(p, v);
+		}
+		return i;
+	}
+	
+#if defined(SLIB_ARCH_IS_ARM64)
+	SLIB_INLINE static uint16x4_t _priv_ImageSimd_unpremultiply_NEON(uint16x4_t c, float32x4_t a)
+	{
+		// (c << 8) / (a + 1) is exact in single precision, because c << 8 < 2^16 and a + 1 <= 256
+		float32x4_t f = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(c)), 256.0f);
+		return vqmovn_u32(vcvtq_u32_f32(vdivq_f32(f, a)));
+	}
+	
+	SLIB_INLINE static uint8x16_t _priv_ImageSimd_unpremultiply_NEON(uint8x16_t c, float32x4_t* a)
+	{
+		uint16x8_t lo = vmovl_u8(vget_low_u8(c));
+		uint16x8_t hi = vmovl_u8(vget_high_u8(c));
+		uint16x8_t rlo = vcombine_u16(_priv_ImageSimd_unpremultiply_NEON(vget_low_u16(lo), a[0]), _priv_ImageSimd_unpremultiply_NEON(vget_high_u16(lo), a[1]));
+		uint16x8_t rhi = vcombine_u16(_priv_ImageSimd_unpremultiply_NEON(vget_low_u16(hi), a[2]), _priv_ImageSimd_unpremultiply_NEON(vget_high_u16(hi), a[3]));
+		return vcombine_u8(vqmovn_u16(rlo), vqmovn_u16(rhi));
+	}
+	
+	static sl_size _priv_ImageSimd_unpremultiplyRow_NEON(sl_uint8* data, sl_size count, sl_uint32 indexAlpha)
+	{
+		sl_uint32 i0 = indexAlpha ? 0 : 1;
+		float32x4_t one = vdupq_n_f32(1.0f);
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			uint8_t* p = (uint8_t*)(data + (i << 2));
+			uint8x16x4_t v = vld4q_u8(p);
+			uint16x8_t alo = vmovl_u8(vget_low_u8(v.val[indexAlpha]));
+			uint16x8_t ahi = vmovl_u8(vget_high_u8(v.val[indexAlpha]));
+			float32x4_t a[4];
+			a[0] = vaddq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(alo))), one);
+			a[1] = vaddq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(alo))), one);
+			a[2] = vaddq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(ahi))), one);
+			a[3] = vaddq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(ahi))), one);
+			v.val[i0] = _priv_ImageSimd_unpremultiply_NEON(v.val[i0], a);
+			v.val[i0 + 1] = _priv_ImageSimd_unpremultiply_NEON(v.val[i0 + 1], a);
+			v.val[i0 + 2] = _priv_ImageSimd_unpremultiply_NEON(v.val[i0 + 2], a);
+			vst4q_u8(p, v);
+		}
+		return i;
+	}
+#endif
+	
+	static sl_size _priv_ImageSimd_shuffleRow_4to4_NEON(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[4])
+	{
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			uint8x16x4_t s = vld4q_u8((const uint8_t*)(src + (i << 2)));
+			uint8x16x4_t d;
+			d.val[0] = s.val[order[0]];
+			d.val[1] = s.val[order[1]];
+			d.val[2] = s.val[order[2]];
+			d.val[3] = s.val[order[3]];
+			vst4q_u8((uint8_t*)(dst + (i << 2)), d);
+		}
+		return i;
+	}
+	
+	static sl_size _priv_ImageSimd_shuffleRow_4to3_NEON(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[3])
+	{
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			uint8x16x4_t s = vld4q_u8((const uint8_t*)(src + (i << 2)));
+			uint8x16x3_t d;
+			d.val[0] = s.val[order[0]];
+			d.val[1] = s.val[order[1]];
+			d.val[2] = s.val[order[2]];
+			vst3q_u8((uint8_t*)(dst + i * 3), d);
+		}
+		return i;
+	}
+	
+	static sl_size _priv_ImageSimd_shuffleRow_3to4_NEON(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[4])
+	{
+		uint8x16_t c255 = vdupq_n_u8(255);
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			uint8x16x3_t s = vld3q_u8((const uint8_t*)(src + i * 3));
+			uint8x16x4_t d;
+			for (sl_uint32 k = 0; k < 4; k++) {
+				d.val[k] = order[k] == 255 ? c255 : s.val[order[k]];
+			}
+			vst4q_u8((uint8_t*)(dst + (i << 2)), d);
+		}
+		return i;
+	}
+#endif
+
+	void _priv_ImageSimd::fillRow(Color* dst, const Color& color, sl_size count)
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			__m128i c = _mm_set1_epi32(*((const int*)&color));
+			for (; i + 4 <= count; i += 4) {
+				_mm_storeu_si128((__m128i*)(dst + i), c);
+			}
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			uint32x4_t c = vdupq_n_u32(*((const uint32_t*)&color));
+			for (; i + 4 <= count; i += 4) {
+				vst1q_u32((uint32_t*)(dst + i), c);
+			}
+		}
+#endif
+		for (; i < count; i++) {
+			dst[i] = color;
+		}
+	}
+	
+	void _priv_ImageSimd::blendRow_PA_NPA(Color* dst, const Color* src, sl_size count)
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		sl_uint32 features = _priv_ImageSimd_getFeatures();
+		if (features & PRIV_IMAGE_SIMD_AVX2) {
+			i = _priv_ImageSimd_blendRow_AVX2<sl_false>(dst, src, count);
+		} else if (features & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_blendRow_SSE2<sl_false>(dst, src, count);
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_blendRow_NEON<sl_false>(dst, src, count);
+		}
+#endif
+		for (; i < count; i++) {
+			dst[i].blend_PA_NPA(src[i]);
+		}
+	}
+	
+	void _priv_ImageSimd::blendColorRow_PA_NPA(Color* dst, const Color& color, sl_size count)
+	{
+		if (color.a == 255) {
+			fillRow(dst, color, count);
+			return;
+		}
+		if (!(color.a)) {
+			// blending transparent color gives `(c * 255) / 255`
+			return;
+		}
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		sl_uint32 features = _priv_ImageSimd_getFeatures();
+		if (features & PRIV_IMAGE_SIMD_AVX2) {
+			i = _priv_ImageSimd_blendRow_AVX2<sl_true>(dst, &color, count);
+		} else if (features & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_blendRow_SSE2<sl_true>(dst, &color, count);
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_blendRow_NEON<sl_true>(dst, &color, count);
+		}
+#endif
+		for (; i < count; i++) {
+			dst[i].blend_PA_NPA(color);
+		}
+	}
+	
+	void _priv_ImageSimd::shuffleRow_4to4(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[4])
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		sl_uint32 features = _priv_ImageSimd_getFeatures();
+		if (features & PRIV_IMAGE_SIMD_AVX2) {
+			i = _priv_ImageSimd_shuffleRow_4to4_AVX2(dst, src, count, order);
+		} else if (features & PRIV_IMAGE_SIMD_SSSE3) {
+			i = _priv_ImageSimd_shuffleRow_4to4_SSSE3(dst, src, count, order);
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_shuffleRow_4to4_NEON(dst, src, count, order);
+		}
+#endif
+		dst += i << 2;
+		src += i << 2;
+		for (; i < count; i++) {
+			sl_uint8 c0 = src[order[0]];
+			sl_uint8 c1 = src[order[1]];
+			sl_uint8 c2 = src[order[2]];
+			sl_uint8 c3 = src[order[3]];
+			dst[0] = c0;
+			dst[1] = c1;
+			dst[2] = c2;
+			dst[3] = c3;
+			dst += 4;
+			src += 4;
+		}
+	}
+	
+	void _priv_ImageSimd::shuffleRow_4to3(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[3])
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_SSSE3) {
+			i = _priv_ImageSimd_shuffleRow_4to3_SSSE3(dst, src, count, order);
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_shuffleRow_4to3_NEON(dst, src, count, order);
+		}
+#endif
+		dst += i * 3;
+		src += i << 2;
+		for (; i < count; i++) {
+			dst[0] = src[order[0]];
+			dst[1] = src[order[1]];
+			dst[2] = src[order[2]];
+			dst += 3;
+			src += 4;
+		}
+	}
+	
+	void _priv_ImageSimd::shuffleRow_3to4(sl_uint8* dst, const sl_uint8* src, sl_size count, const sl_uint8 order[4])
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_SSSE3) {
+			i = _priv_ImageSimd_shuffleRow_3to4_SSSE3(dst, src, count, order);
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_shuffleRow_3to4_NEON(dst, src, count, order);
+		}
+#endif
+		dst += i << 2;
+		src += i * 3;
+		for (; i < count; i++) {
+			for (sl_uint32 k = 0; k < 4; k++) {
+				dst[k] = order[k] == 255 ? 255 : src[order[k]];
+			}
+			dst += 4;
+			src += 3;
+		}
+	}
+	
+	void _priv_ImageSimd::premultiplyRow(sl_uint8* data, sl_size count, sl_uint32 indexAlpha)
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_premultiplyRow_SSE2(data, count, indexAlpha);
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_premultiplyRow_NEON(data, count, indexAlpha);
+		}
+#endif
+		sl_uint32 i0 = indexAlpha ? 0 : 1;
+		data += i << 2;
+		for (; i < count; i++) {
+			sl_uint32 a = data[indexAlpha];
+			a++;
+			data[i0] = (sl_uint8)((data[i0] * a) >> 8);
+			data[i0 + 1] = (sl_uint8)((data[i0 + 1] * a) >> 8);
+			data[i0 + 2] = (sl_uint8)((data[i0 + 2] * a) >> 8);
+			data += 4;
+		}
+	}
+	
+	void _priv_ImageSimd::unpremultiplyRow(sl_uint8* data, sl_size count, sl_uint32 indexAlpha)
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_unpremultiplyRow_SSE2(data, count, indexAlpha);
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON) && defined(SLIB_ARCH_IS_ARM64)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_unpremultiplyRow_NEON(data, count, indexAlpha);
+		}
+#endif
+		sl_uint32 i0 = indexAlpha ? 0 : 1;
+		data += i << 2;
+		for (; i < count; i++) {
+			sl_uint32 a = data[indexAlpha];
+			a++;
+			data[i0] = (sl_uint8)(Math::clamp0_255((data[i0] << 8) / a));
+			data[i0 + 1] = (sl_uint8)(Math::clamp0_255((data[i0 + 1] << 8) / a));
+			data[i0 + 2] = (sl_uint8)(Math::clamp0_255((data[i0 + 2] << 8) / a));
+			data += 4;
+		}
+	}
+	
+#if defined(SLIB_IMAGE_SIMD_X86)
+	class _priv_ImageSimd_YUVConstants_SSE2
+	{
+	public:
+		__m128i zero;
+		__m128i c128;
+		__m128i c255;
+		__m128i mask8;
+		__m128i mask16;
+		__m128i yg;
+		__m128i yb;
+		__m128i ub;
+		__m128i ug;
+		__m128i vg;
+		__m128i vr;
+		// coefficients for the channels in memory order
+		__m128i y0, y1, y2;
+		__m128i u0, u1, u2;
+		__m128i v0, v1, v2;
+		__m128i offsetY;
+		__m128i offsetUV;
+
+	public:
+		_priv_ImageSimd_YUVConstants_SSE2(const _priv_YUVMatrix& m, sl_bool flagBGRA)
+		{
+			zero = _mm_setzero_si128();
+			c128 = _mm_set1_epi16(128);
+			c255 = _mm_set1_epi16(255);
+			mask8 = _mm_set1_epi32(0xFF);
+			mask16 = _mm_set1_epi32(0xFFFF);
+			yg = _mm_set1_epi16((short)(m.yg));
+			yb = _mm_set1_epi16(m.yb);
+			ub = _mm_set1_epi16(m.ub);
+			ug = _mm_set1_epi16(m.ug);
+			vg = _mm_set1_epi16(m.vg);
+			vr = _mm_set1_epi16(m.vr);
+			y0 = _mm_set1_epi16(flagBGRA ? m.by : m.ry);
+			y1 = _mm_set1_epi16(m.gy);
+			y2 = _mm_set1_epi16(flagBGRA ? m.ry : m.by);
+			u0 = _mm_set1_epi16(flagBGRA ? m.bu : m.ru);
+			u1 = _mm_set1_epi16(m.gu);
+			u2 = _mm_set1_epi16(flagBGRA ? m.ru : m.bu);
+			v0 = _mm_set1_epi16(flagBGRA ? m.bv : m.rv);
+			v1 = _mm_set1_epi16(m.gv);
+			v2 = _mm_set1_epi16(flagBGRA ? m.rv : m.bv);
+			offsetY = _mm_set1_epi16((short)(m.offsetY));
+			offsetUV = _mm_set1_epi16((short)(m.offsetUV));
+		}
+
+	};
+
+	// y, u, v: 8 samples in 16 bit lanes. returns the channels in memory order (16 bit lanes, not clamped)
+	SLIB_INLINE static void _priv_ImageSimd_YUVToRGB_SSE2(const _priv_ImageSimd_YUVConstants_SSE2& k, __m128i y, __m128i u, __m128i v, sl_bool flagBGRA, __m128i& c0, __m128i& c1, __m128i& c2)
+	{
+		y = _mm_add_epi16(_mm_mulhi_epu16(_mm_or_si128(y, _mm_slli_epi16(y, 8)), k.yg), k.yb);
+		u = _mm_sub_epi16(u, k.c128);
+		v = _mm_sub_epi16(v, k.c128);
+		__m128i b = _mm_srai_epi16(_mm_adds_epi16(y, _mm_mullo_epi16(u, k.ub)), 6);
+		c1 = _mm_srai_epi16(_mm_subs_epi16(y, _mm_add_epi16(_mm_mullo_epi16(u, k.ug), _mm_mullo_epi16(v, k.vg))), 6);
+		__m128i r = _mm_srai_epi16(_mm_adds_epi16(y, _mm_mullo_epi16(v, k.vr)), 6);
+		if (flagBGRA) {
+			c0 = b;
+			c2 = r;
+		} else {
+			c0 = r;
+			c2 = b;
+		}
+	}
+
+	// stores 8 pixels from 16 bit lanes
+	SLIB_INLINE static void _priv_ImageSimd_storeRGBA_SSE2(const _priv_ImageSimd_YUVConstants_SSE2& k, sl_uint8* dst, __m128i c0, __m128i c1, __m128i c2)
+	{
+		__m128i p0 = _mm_packus_epi16(c0, c2);
+		__m128i p1 = _mm_packus_epi16(c1, k.c255);
+		__m128i lo = _mm_unpacklo_epi8(p0, p1);
+		__m128i hi = _mm_unpackhi_epi8(p0, p1);
+		_mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(lo, hi));
+		_mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(lo, hi));
+	}
+
+	// interleaved chroma (8 bytes) -> duplicated u, v in 16 bit lanes
+	SLIB_INLINE static void _priv_ImageSimd_splitUV_SSE2(const _priv_ImageSimd_YUVConstants_SSE2& k, __m128i c, __m128i& first, __m128i& second)
+	{
+		first = _mm_and_si128(c, k.mask16);
+		first = _mm_or_si128(first, _mm_slli_epi32(first, 16));
+		second = _mm_srli_epi32(c, 16);
+		second = _mm_or_si128(second, _mm_slli_epi32(second, 16));
+	}
+
+	// Y of 8 pixels (two 4-pixel vectors) in 16 bit lanes
+	SLIB_INLINE static __m128i _priv_ImageSimd_RGBToY_SSE2(const _priv_ImageSimd_YUVConstants_SSE2& k, __m128i a, __m128i b)
+	{
+		__m128i c0 = _mm_packs_epi32(_mm_and_si128(a, k.mask8), _mm_and_si128(b, k.mask8));
+		__m128i c1 = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(a, 8), k.mask8), _mm_and_si128(_mm_srli_epi32(b, 8), k.mask8));
+		__m128i c2 = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(a, 16), k.mask8), _mm_and_si128(_mm_srli_epi32(b, 16), k.mask8));
+		return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(c0, k.y0), _mm_mullo_epi16(c1, k.y1)), _mm_add_epi16(_mm_mullo_epi16(c2, k.y2), k.offsetY)), 8);
+	}
+
+	// U and V of 4 pixels in the 16 bit lanes 0~3 (repeated in 4~7)
+	SLIB_INLINE static void _priv_ImageSimd_RGBToUV_SSE2(const _priv_ImageSimd_YUVConstants_SSE2& k, __m128i c, __m128i& u, __m128i& v)
+	{
+		__m128i c0 = _mm_and_si128(c, k.mask8);
+		c0 = _mm_packs_epi32(c0, c0);
+		__m128i c1 = _mm_and_si128(_mm_srli_epi32(c, 8), k.mask8);
+		c1 = _mm_packs_epi32(c1, c1);
+		__m128i c2 = _mm_and_si128(_mm_srli_epi32(c, 16), k.mask8);
+		c2 = _mm_packs_epi32(c2, c2);
+		u = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(c0, k.u0), _mm_mullo_epi16(c1, k.u1)), _mm_add_epi16(_mm_mullo_epi16(c2, k.u2), k.offsetUV)), 8);
+		v = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(c0, k.v0), _mm_mullo_epi16(c1, k.v1)), _mm_add_epi16(_mm_mullo_epi16(c2, k.v2), k.offsetUV)), 8);
+	}
+
+	// rounded average of the adjacent pixels of 8 pixels (two 4-pixel vectors)
+	SLIB_INLINE static __m128i _priv_ImageSimd_averagePairs_SSE2(__m128i a, __m128i b)
+	{
+		__m128 fa = _mm_castsi128_ps(a);
+		__m128 fb = _mm_castsi128_ps(b);
+		return _mm_avg_epu8(_mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(2, 0, 2, 0))), _mm_castps_si128(_mm_shuffle_ps(fa, fb, _MM_SHUFFLE(3, 1, 3, 1))));
+	}
+
+	static sl_size _priv_ImageSimd_convertYUV420ToRGBARow_SSE2(sl_uint8* dst, const sl_uint8* y, const sl_uint8* u, const sl_uint8* v, sl_uint32 strideUV, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		_priv_ImageSimd_YUVConstants_SSE2 k(m, flagBGRA);
+		sl_bool flagUFirst = u < v;
+		const sl_uint8* uv = flagUFirst ? u : v;
+		sl_size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m128i vy = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(y + i)), k.zero);
+			__m128i vu, vv;
+			if (strideUV == 1) {
+				sl_size j = i >> 1;
+				vu = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*((const int*)(u + j))), k.zero);
+				vu = _mm_unpacklo_epi16(vu, vu);
+				vv = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*((const int*)(v + j))), k.zero);
+				vv = _mm_unpacklo_epi16(vv, vv);
+			} else {
+				__m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(uv + i)), k.zero);
+				if (flagUFirst) {
+					_priv_ImageSimd_splitUV_SSE2(k, c, vu, vv);
+				} else {
+					_priv_ImageSimd_splitUV_SSE2(k, c, vv, vu);
+				}
+			}
+			__m128i c0, c1, c2;
+			_priv_ImageSimd_YUVToRGB_SSE2(k, vy, vu, vv, flagBGRA, c0, c1, c2);
+			_priv_ImageSimd_storeRGBA_SSE2(k, dst + (i << 2), c0, c1, c2);
+		}
+		return i;
+	}
+
+	static sl_size _priv_ImageSimd_convertRGBAToYUV420Rows_SSE2(sl_uint8* y0, sl_uint8* y1, sl_uint8* u, sl_uint8* v, sl_uint32 strideUV, const sl_uint8* src0, const sl_uint8* src1, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		_priv_ImageSimd_YUVConstants_SSE2 k(m, flagBGRA);
+		sl_bool flagUFirst = u < v;
+		sl_uint8* uv = flagUFirst ? u : v;
+		sl_size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m128i a0 = _mm_loadu_si128((const __m128i*)(src0 + (i << 2)));
+			__m128i b0 = _mm_loadu_si128((const __m128i*)(src0 + (i << 2) + 16));
+			__m128i a1 = _mm_loadu_si128((const __m128i*)(src1 + (i << 2)));
+			__m128i b1 = _mm_loadu_si128((const __m128i*)(src1 + (i << 2) + 16));
+			__m128i t = _priv_ImageSimd_RGBToY_SSE2(k, a0, b0);
+			_mm_storel_epi64((__m128i*)(y0 + i), _mm_packus_epi16(t, t));
+			t = _priv_ImageSimd_RGBToY_SSE2(k, a1, b1);
+			_mm_storel_epi64((__m128i*)(y1 + i), _mm_packus_epi16(t, t));
+			__m128i c = _priv_ImageSimd_averagePairs_SSE2(_mm_avg_epu8(a0, a1), _mm_avg_epu8(b0, b1));
+			__m128i cu, cv;
+			_priv_ImageSimd_RGBToUV_SSE2(k, c, cu, cv);
+			cu = _mm_packus_epi16(cu, cu);
+			cv = _mm_packus_epi16(cv, cv);
+			if (strideUV == 1) {
+				sl_size j = i >> 1;
+				*((int*)(u + j)) = _mm_cvtsi128_si32(cu);
+				*((int*)(v + j)) = _mm_cvtsi128_si32(cv);
+			} else {
+				_mm_storel_epi64((__m128i*)(uv + i), flagUFirst ? _mm_unpacklo_epi8(cu, cv) : _mm_unpacklo_epi8(cv, cu));
+			}
+		}
+		return i;
+	}
+
+	static sl_size _priv_ImageSimd_convertYUYVToRGBARow_SSE2(sl_uint8* dst, const sl_uint8* src, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		_priv_ImageSimd_YUVConstants_SSE2 k(m, flagBGRA);
+		__m128i maskLow = _mm_set1_epi16(0xFF);
+		sl_size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m128i s = _mm_loadu_si128((const __m128i*)(src + (i << 1)));
+			__m128i vu, vv;
+			_priv_ImageSimd_splitUV_SSE2(k, _mm_srli_epi16(s, 8), vu, vv);
+			__m128i c0, c1, c2;
+			_priv_ImageSimd_YUVToRGB_SSE2(k, _mm_and_si128(s, maskLow), vu, vv, flagBGRA, c0, c1, c2);
+			_priv_ImageSimd_storeRGBA_SSE2(k, dst + (i << 2), c0, c1, c2);
+		}
+		return i;
+	}
+
+	static sl_size _priv_ImageSimd_convertRGBAToYUYVRow_SSE2(sl_uint8* dst, const sl_uint8* src, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		_priv_ImageSimd_YUVConstants_SSE2 k(m, flagBGRA);
+		sl_size i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m128i a = _mm_loadu_si128((const __m128i*)(src + (i << 2)));
+			__m128i b = _mm_loadu_si128((const __m128i*)(src + (i << 2) + 16));
+			__m128i vy = _priv_ImageSimd_RGBToY_SSE2(k, a, b);
+			__m128i cu, cv;
+			_priv_ImageSimd_RGBToUV_SSE2(k, _priv_ImageSimd_averagePairs_SSE2(a, b), cu, cv);
+			_mm_storeu_si128((__m128i*)(dst + (i << 1)), _mm_or_si128(vy, _mm_slli_epi16(_mm_unpacklo_epi16(cu, cv), 8)));
+		}
+		return i;
+	}
+
+	PRIV_TARGET_AVX2 static sl_size _priv_ImageSimd_convertYUV420ToRGBARow_AVX2(sl_uint8* dst, const sl_uint8* y, const sl_uint8* u, const sl_uint8* v, sl_uint32 strideUV, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		_priv_ImageSimd_YUVConstants_SSE2 k(m, flagBGRA);
+		__m256i c128 = _mm256_set1_epi16(128);
+		__m256i yg = _mm256_set1_epi16((short)(m.yg));
+		__m256i yb = _mm256_set1_epi16(m.yb);
+		__m256i ub = _mm256_set1_epi16(m.ub);
+		__m256i ug = _mm256_set1_epi16(m.ug);
+		__m256i vg = _mm256_set1_epi16(m.vg);
+		__m256i vr = _mm256_set1_epi16(m.vr);
+		__m128i maskLow = _mm_set1_epi16(0xFF);
+		sl_bool flagUFirst = u < v;
+		const sl_uint8* uv = flagUFirst ? u : v;
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			__m256i vy = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(y + i)));
+			__m128i cu, cv;
+			if (strideUV == 1) {
+				sl_size j = i >> 1;
+				cu = _mm_loadl_epi64((const __m128i*)(u + j));
+				cv = _mm_loadl_epi64((const __m128i*)(v + j));
+			} else {
+				__m128i c = _mm_loadu_si128((const __m128i*)(uv + i));
+				__m128i first = _mm_and_si128(c, maskLow);
+				first = _mm_packus_epi16(first, first);
+				__m128i second = _mm_srli_epi16(c, 8);
+				second = _mm_packus_epi16(second, second);
+				if (flagUFirst) {
+					cu = first;
+					cv = second;
+				} else {
+					cu = second;
+					cv = first;
+				}
+			}
+			__m256i vu = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpacklo_epi8(cu, cu)), c128);
+			__m256i vv = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpacklo_epi8(cv, cv)), c128);
+			vy = _mm256_add_epi16(_mm256_mulhi_epu16(_mm256_or_si256(vy, _mm256_slli_epi16(vy, 8)), yg), yb);
+			__m256i b = _mm256_srai_epi16(_mm256_adds_epi16(vy, _mm256_mullo_epi16(vu, ub)), 6);
+			__m256i g = _mm256_srai_epi16(_mm256_subs_epi16(vy, _mm256_add_epi16(_mm256_mullo_epi16(vu, ug), _mm256_mullo_epi16(vv, vg))), 6);
+			__m256i r = _mm256_srai_epi16(_mm256_adds_epi16(vy, _mm256_mullo_epi16(vv, vr)), 6);
+			if (flagBGRA) {
+				__m256i t = r;
+				r = b;
+				b = t;
+			}
+			_priv_ImageSimd_storeRGBA_SSE2(k, dst + (i << 2), _mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b));
+			_priv_ImageSimd_storeRGBA_SSE2(k, dst + (i << 2) + 32, _mm256_extracti128_si256(r, 1), _mm256_extracti128_si256(g, 1), _mm256_extracti128_si256(b, 1));
+		}
+		return i;
+	}
+
+	PRIV_TARGET_AVX2 static sl_size _priv_ImageSimd_convertRGBAToYUV420Rows_AVX2(sl_uint8* y0, sl_uint8* y1, sl_uint8* u, sl_uint8* v, sl_uint32 strideUV, const sl_uint8* src0, const sl_uint8* src1, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		__m256i mask8 = _mm256_set1_epi32(0xFF);
+		__m256i ky0 = _mm256_set1_epi16(flagBGRA ? m.by : m.ry);
+		__m256i ky1 = _mm256_set1_epi16(m.gy);
+		__m256i ky2 = _mm256_set1_epi16(flagBGRA ? m.ry : m.by);
+		__m256i ku0 = _mm256_set1_epi16(flagBGRA ? m.bu : m.ru);
+		__m256i ku1 = _mm256_set1_epi16(m.gu);
+		__m256i ku2 = _mm256_set1_epi16(flagBGRA ? m.ru : m.bu);
+		__m256i kv0 = _mm256_set1_epi16(flagBGRA ? m.bv : m.rv);
+		__m256i kv1 = _mm256_set1_epi16(m.gv);
+		__m256i kv2 = _mm256_set1_epi16(flagBGRA ? m.rv : m.bv);
+		__m256i offsetY = _mm256_set1_epi16((short)(m.offsetY));
+		__m256i offsetUV = _mm256_set1_epi16((short)(m.offsetUV));
+		sl_bool flagUFirst = u < v;
+		sl_uint8* uv = flagUFirst ? u : v;
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			const sl_uint8* s[2] = {src0 + (i << 2), src1 + (i << 2)};
+			sl_uint8* d[2] = {y0 + i, y1 + i};
+			__m256i a[2], b[2];
+			for (sl_uint32 row = 0; row < 2; row++) {
+				a[row] = _mm256_loadu_si256((const __m256i*)(s[row]));
+				b[row] = _mm256_loadu_si256((const __m256i*)(s[row] + 32));
+				// lanes are ordered as (a0~3, b0~3, a4~7, b4~7)
+				__m256i c0 = _mm256_packs_epi32(_mm256_and_si256(a[row], mask8), _mm256_and_si256(b[row], mask8));
+				__m256i c1 = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(a[row], 8), mask8), _mm256_and_si256(_mm256_srli_epi32(b[row], 8), mask8));
+				__m256i c2 = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(a[row], 16), mask8), _mm256_and_si256(_mm256_srli_epi32(b[row], 16), mask8));
+				__m256i t = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(c0, ky0), _mm256_mullo_epi16(c1, ky1)), _mm256_add_epi16(_mm256_mullo_epi16(c2, ky2), offsetY)), 8);
+				t = _mm256_permute4x64_epi64(t, 0xD8);
+				_mm_storeu_si128((__m128i*)(d[row]), _mm_packus_epi16(_mm256_castsi256_si128(t), _mm256_extracti128_si256(t, 1)));
+			}
+			__m256 fa = _mm256_castsi256_ps(_mm256_avg_epu8(a[0], a[1]));
+			__m256 fb = _mm256_castsi256_ps(_mm256_avg_epu8(b[0], b[1]));
+			// lanes are ordered as (0, 1, 4, 5, 2, 3, 6, 7)
+			__m256i c = _mm256_avg_epu8(_mm256_castps_si256(_mm256_shuffle_ps(fa, fb, _MM_SHUFFLE(2, 0, 2, 0))), _mm256_castps_si256(_mm256_shuffle_ps(fa, fb, _MM_SHUFFLE(3, 1, 3, 1))));
+			__m256i c0 = _mm256_and_si256(c, mask8);
+			c0 = _mm256_packs_epi32(c0, c0);
+			__m256i c1 = _mm256_and_si256(_mm256_srli_epi32(c, 8), mask8);
+			c1 = _mm256_packs_epi32(c1, c1);
+			__m256i c2 = _mm256_and_si256(_mm256_srli_epi32(c, 16), mask8);
+			c2 = _mm256_packs_epi32(c2, c2);
+			__m256i tu = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(c0, ku0), _mm256_mullo_epi16(c1, ku1)), _mm256_add_epi16(_mm256_mullo_epi16(c2, ku2), offsetUV)), 8);
+			__m256i tv = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(c0, kv0), _mm256_mullo_epi16(c1, kv1)), _mm256_add_epi16(_mm256_mullo_epi16(c2, kv2), offsetUV)), 8);
+			__m128i cu = _mm_unpacklo_epi32(_mm256_castsi256_si128(tu), _mm256_extracti128_si256(tu, 1));
+			cu = _mm_packus_epi16(cu, cu);
+			__m128i cv = _mm_unpacklo_epi32(_mm256_castsi256_si128(tv), _mm256_extracti128_si256(tv, 1));
+			cv = _mm_packus_epi16(cv, cv);
+			if (strideUV == 1) {
+				sl_size j = i >> 1;
+				_mm_storel_epi64((__m128i*)(u + j), cu);
+				_mm_storel_epi64((__m128i*)(v + j), cv);
+			} else {
+				_mm_storeu_si128((__m128i*)(uv + i), flagUFirst ? _mm_unpacklo_epi8(cu, cv) : _mm_unpacklo_epi8(cv, cu));
+			}
+		}
+		return i;
+	}
+#endif
+
+#if defined(SLIB_IMAGE_SIMD_NEON)
+	class _priv_ImageSimd_YUVConstants_NEON
+	{
+	public:
+		uint8x8_t c128;
+		uint16x4_t yg;
+		int16x8_t yb;
+		int16x8_t ub;
+		int16x8_t ug;
+		int16x8_t vg;
+		int16x8_t vr;
+		uint8x8_t ry, gy, by;
+		int16x8_t ru, gu, bu;
+		int16x8_t rv, gv, bv;
+		uint16x8_t offsetY;
+		uint16x8_t offsetUV;
+
+	public:
+		_priv_ImageSimd_YUVConstants_NEON(const _priv_YUVMatrix& m)
+		{
+			c128 = vdup_n_u8(128);
+			yg = vdup_n_u16(m.yg);
+			yb = vdupq_n_s16(m.yb);
+			ub = vdupq_n_s16(m.ub);
+			ug = vdupq_n_s16(m.ug);
+			vg = vdupq_n_s16(m.vg);
+			vr = vdupq_n_s16(m.vr);
+			ry = vdup_n_u8((sl_uint8)(m.ry));
+			gy = vdup_n_u8((sl_uint8)(m.gy));
+			by = vdup_n_u8((sl_uint8)(m.by));
+			ru = vdupq_n_s16(m.ru);
+			gu = vdupq_n_s16(m.gu);
+			bu = vdupq_n_s16(m.bu);
+			rv = vdupq_n_s16(m.rv);
+			gv = vdupq_n_s16(m.gv);
+			bv = vdupq_n_s16(m.bv);
+			offsetY = vdupq_n_u16(m.offsetY);
+			offsetUV = vdupq_n_u16(m.offsetUV);
+		}
+
+	};
+
+	SLIB_INLINE static uint8x8x4_t _priv_ImageSimd_YUVToRGB_NEON(const _priv_ImageSimd_YUVConstants_NEON& k, uint8x8_t y8, uint8x8_t u8, uint8x8_t v8, sl_bool flagBGRA)
+	{
+		uint16x8_t y = vmovl_u8(y8);
+		y = vorrq_u16(y, vshlq_n_u16(y, 8));
+		uint16x8_t y1 = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(y), k.yg), 16), vshrn_n_u32(vmull_u16(vget_high_u16(y), k.yg), 16));
+		int16x8_t yb = vaddq_s16(vreinterpretq_s16_u16(y1), k.yb);
+		int16x8_t u = vreinterpretq_s16_u16(vsubl_u8(u8, k.c128));
+		int16x8_t v = vreinterpretq_s16_u16(vsubl_u8(v8, k.c128));
+		uint8x8_t b = vqshrun_n_s16(vqaddq_s16(yb, vmulq_s16(u, k.ub)), 6);
+		uint8x8_t g = vqshrun_n_s16(vqsubq_s16(yb, vaddq_s16(vmulq_s16(u, k.ug), vmulq_s16(v, k.vg))), 6);
+		uint8x8_t r = vqshrun_n_s16(vqaddq_s16(yb, vmulq_s16(v, k.vr)), 6);
+		uint8x8x4_t ret;
+		ret.val[0] = flagBGRA ? b : r;
+		ret.val[1] = g;
+		ret.val[2] = flagBGRA ? r : b;
+		ret.val[3] = vdup_n_u8(255);
+		return ret;
+	}
+
+	SLIB_INLINE static uint8x8_t _priv_ImageSimd_RGBToY_NEON(const _priv_ImageSimd_YUVConstants_NEON& k, uint8x8_t r, uint8x8_t g, uint8x8_t b)
+	{
+		return vshrn_n_u16(vmlal_u8(vmlal_u8(vmlal_u8(k.offsetY, r, k.ry), g, k.gy), b, k.by), 8);
+	}
+
+	SLIB_INLINE static uint8x8_t _priv_ImageSimd_RGBToChroma_NEON(const _priv_ImageSimd_YUVConstants_NEON& k, uint8x8_t r, uint8x8_t g, uint8x8_t b, int16x8_t kr, int16x8_t kg, int16x8_t kb)
+	{
+		int16x8_t t = vmulq_s16(vreinterpretq_s16_u16(vmovl_u8(r)), kr);
+		t = vmlaq_s16(t, vreinterpretq_s16_u16(vmovl_u8(g)), kg);
+		t = vmlaq_s16(t, vreinterpretq_s16_u16(vmovl_u8(b)), kb);
+		return vshrn_n_u16(vaddq_u16(vreinterpretq_u16_s16(t), k.offsetUV), 8);
+	}
+
+	// rounded average of the adjacent pixels
+	SLIB_INLINE static uint8x8_t _priv_ImageSimd_averagePairs_NEON(uint8x16_t c)
+	{
+		uint8x8x2_t t = vuzp_u8(vget_low_u8(c), vget_high_u8(c));
+		return vrhadd_u8(t.val[0], t.val[1]);
+	}
+
+	static sl_size _priv_ImageSimd_convertYUV420ToRGBARow_NEON(sl_uint8* dst, const sl_uint8* y, const sl_uint8* u, const sl_uint8* v, sl_uint32 strideUV, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		_priv_ImageSimd_YUVConstants_NEON k(m);
+		sl_bool flagUFirst = u < v;
+		const sl_uint8* uv = flagUFirst ? u : v;
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			uint8x16_t vy = vld1q_u8(y + i);
+			uint8x8_t cu, cv;
+			if (strideUV == 1) {
+				sl_size j = i >> 1;
+				cu = vld1_u8(u + j);
+				cv = vld1_u8(v + j);
+			} else {
+				uint8x8x2_t c = vld2_u8(uv + i);
+				cu = c.val[flagUFirst ? 0 : 1];
+				cv = c.val[flagUFirst ? 1 : 0];
+			}
+			uint8x8x2_t du = vzip_u8(cu, cu);
+			uint8x8x2_t dv = vzip_u8(cv, cv);
+			vst4_u8(dst + (i << 2), _priv_ImageSimd_YUVToRGB_NEON(k, vget_low_u8(vy), du.val[0], dv.val[0], flagBGRA));
+			vst4_u8(dst + (i << 2) + 32, _priv_ImageSimd_YUVToRGB_NEON(k, vget_high_u8(vy), du.val[1], dv.val[1], flagBGRA));
+		}
+		return i;
+	}
+
+	static sl_size _priv_ImageSimd_convertRGBAToYUV420Rows_NEON(sl_uint8* y0, sl_uint8* y1, sl_uint8* u, sl_uint8* v, sl_uint32 strideUV, const sl_uint8* src0, const sl_uint8* src1, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		_priv_ImageSimd_YUVConstants_NEON k(m);
+		sl_uint32 iR = flagBGRA ? 2 : 0;
+		sl_uint32 iB = 2 - iR;
+		sl_bool flagUFirst = u < v;
+		sl_uint8* uv = flagUFirst ? u : v;
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			uint8x16x4_t p0 = vld4q_u8(src0 + (i << 2));
+			uint8x16x4_t p1 = vld4q_u8(src1 + (i << 2));
+			vst1q_u8(y0 + i, vcombine_u8(_priv_ImageSimd_RGBToY_NEON(k, vget_low_u8(p0.val[iR]), vget_low_u8(p0.val[1]), vget_low_u8(p0.val[iB])), _priv_ImageSimd_RGBToY_NEON(k, vget_high_u8(p0.val[iR]), vget_high_u8(p0.val[1]), vget_high_u8(p0.val[iB]))));
+			vst1q_u8(y1 + i, vcombine_u8(_priv_ImageSimd_RGBToY_NEON(k, vget_low_u8(p1.val[iR]), vget_low_u8(p1.val[1]), vget_low_u8(p1.val[iB])), _priv_ImageSimd_RGBToY_NEON(k, vget_high_u8(p1.val[iR]), vget_high_u8(p1.val[1]), vget_high_u8(p1.val[iB]))));
+			uint8x8_t r = _priv_ImageSimd_averagePairs_NEON(vrhaddq_u8(p0.val[iR], p1.val[iR]));
+			uint8x8_t g = _priv_ImageSimd_averagePairs_NEON(vrhaddq_u8(p0.val[1], p1.val[1]));
+			uint8x8_t b = _priv_ImageSimd_averagePairs_NEON(vrhaddq_u8(p0.val[iB], p1.val[iB]));
+			uint8x8_t cu = _priv_ImageSimd_RGBToChroma_NEON(k, r, g, b, k.ru, k.gu, k.bu);
+			uint8x8_t cv = _priv_ImageSimd_RGBToChroma_NEON(k, r, g, b, k.rv, k.gv, k.bv);
+			if (strideUV == 1) {
+				sl_size j = i >> 1;
+				vst1_u8(u + j, cu);
+				vst1_u8(v + j, cv);
+			} else {
+				uint8x8x2_t c;
+				c.val[0] = flagUFirst ? cu : cv;
+				c.val[1] = flagUFirst ? cv : cu;
+				vst2_u8(uv + i, c);
+			}
+		}
+		return i;
+	}
+
+	static sl_size _priv_ImageSimd_convertYUYVToRGBARow_NEON(sl_uint8* dst, const sl_uint8* src, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		_priv_ImageSimd_YUVConstants_NEON k(m);
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			// (Y0, U, Y1, V) x 8
+			uint8x8x4_t s = vld4_u8(src + (i << 1));
+			uint8x8x4_t even = _priv_ImageSimd_YUVToRGB_NEON(k, s.val[0], s.val[1], s.val[3], flagBGRA);
+			uint8x8x4_t odd = _priv_ImageSimd_YUVToRGB_NEON(k, s.val[2], s.val[1], s.val[3], flagBGRA);
+			uint8x8x4_t lo, hi;
+			for (sl_uint32 c = 0; c < 4; c++) {
+				uint8x8x2_t t = vzip_u8(even.val[c], odd.val[c]);
+				lo.val[c] = t.val[0];
+				hi.val[c] = t.val[1];
+			}
+			vst4_u8(dst + (i << 2), lo);
+			vst4_u8(dst + (i << 2) + 32, hi);
+		}
+		return i;
+	}
+
+	static sl_size _priv_ImageSimd_convertRGBAToYUYVRow_NEON(sl_uint8* dst, const sl_uint8* src, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		_priv_ImageSimd_YUVConstants_NEON k(m);
+		sl_uint32 iR = flagBGRA ? 2 : 0;
+		sl_uint32 iB = 2 - iR;
+		sl_size i = 0;
+		for (; i + 16 <= count; i += 16) {
+			uint8x16x4_t p = vld4q_u8(src + (i << 2));
+			uint8x8_t ylo = _priv_ImageSimd_RGBToY_NEON(k, vget_low_u8(p.val[iR]), vget_low_u8(p.val[1]), vget_low_u8(p.val[iB]));
+			uint8x8_t yhi = _priv_ImageSimd_RGBToY_NEON(k, vget_high_u8(p.val[iR]), vget_high_u8(p.val[1]), vget_high_u8(p.val[iB]));
+			uint8x8x2_t vy = vuzp_u8(ylo, yhi);
+			uint8x8_t r = _priv_ImageSimd_averagePairs_NEON(p.val[iR]);
+			uint8x8_t g = _priv_ImageSimd_averagePairs_NEON(p.val[1]);
+			uint8x8_t b = _priv_ImageSimd_averagePairs_NEON(p.val[iB]);
+			uint8x8x4_t d;
+			d.val[0] = vy.val[0];
+			d.val[1] = _priv_ImageSimd_RGBToChroma_NEON(k, r, g, b, k.ru, k.gu, k.bu);
+			d.val[2] = vy.val[1];
+			d.val[3] = _priv_ImageSimd_RGBToChroma_NEON(k, r, g, b, k.rv, k.gv, k.bv);
+			vst4_u8(dst + (i << 1), d);
+		}
+		return i;
+	}
+#endif
+
+	void _priv_ImageSimd::convertYUV420ToRGBARow(sl_uint8* dst, const sl_uint8* y, const sl_uint8* u, const sl_uint8* v, sl_uint32 strideUV, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86) || defined(SLIB_IMAGE_SIMD_NEON)
+		sl_uint32 features = _priv_ImageSimd_getFeatures();
+		if ((features & PRIV_IMAGE_SIMD_BASE) && (strideUV == 1 || (strideUV == 2 && (v == u + 1 || u == v + 1)))) {
+#	if defined(SLIB_IMAGE_SIMD_X86)
+			if (features & PRIV_IMAGE_SIMD_AVX2) {
+				i = _priv_ImageSimd_convertYUV420ToRGBARow_AVX2(dst, y, u, v, strideUV, count, m, flagBGRA);
+			}
+			// the remaining (8 ~ 15) pixels still take SSE2
+			i += _priv_ImageSimd_convertYUV420ToRGBARow_SSE2(dst + (i << 2), y + i, u + (i >> 1) * strideUV, v + (i >> 1) * strideUV, strideUV, count - i, m, flagBGRA);
+#	else
+			i = _priv_ImageSimd_convertYUV420ToRGBARow_NEON(dst, y, u, v, strideUV, count, m, flagBGRA);
+#	endif
+		}
+#endif
+		sl_uint32 iR = flagBGRA ? 2 : 0;
+		sl_uint32 iB = 2 - iR;
+		for (; i < count; i++) {
+			sl_size j = (i >> 1) * strideUV;
+			sl_uint8* d = dst + (i << 2);
+			m.toRGB(y[i], u[j], v[j], d[iR], d[1], d[iB]);
+			d[3] = 255;
+		}
+	}
+
+	void _priv_ImageSimd::convertRGBAToYUV420Rows(sl_uint8* y0, sl_uint8* y1, sl_uint8* u, sl_uint8* v, sl_uint32 strideUV, const sl_uint8* src0, const sl_uint8* src1, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86) || defined(SLIB_IMAGE_SIMD_NEON)
+		sl_uint32 features = _priv_ImageSimd_getFeatures();
+		if ((features & PRIV_IMAGE_SIMD_BASE) && (strideUV == 1 || (strideUV == 2 && (v == u + 1 || u == v + 1)))) {
+#	if defined(SLIB_IMAGE_SIMD_X86)
+			if (features & PRIV_IMAGE_SIMD_AVX2) {
+				i = _priv_ImageSimd_convertRGBAToYUV420Rows_AVX2(y0, y1, u, v, strideUV, src0, src1, count, m, flagBGRA);
+			}
+			// the remaining (8 ~ 15) pixels still take SSE2
+			i += _priv_ImageSimd_convertRGBAToYUV420Rows_SSE2(y0 + i, y1 + i, u + (i >> 1) * strideUV, v + (i >> 1) * strideUV, strideUV, src0 + (i << 2), src1 + (i << 2), count - i, m, flagBGRA);
+#	else
+			i = _priv_ImageSimd_convertRGBAToYUV420Rows_NEON(y0, y1, u, v, strideUV, src0, src1, count, m, flagBGRA);
+#	endif
+		}
+#endif
+		sl_uint32 iR = flagBGRA ? 2 : 0;
+		sl_uint32 iB = 2 - iR;
+		for (; i < count; i += 2) {
+			const sl_uint8* p00 = src0 + (i << 2);
+			const sl_uint8* p10 = src1 + (i << 2);
+			const sl_uint8* p01 = p00;
+			const sl_uint8* p11 = p10;
+			y0[i] = m.getY(p00[iR], p00[1], p00[iB]);
+			y1[i] = m.getY(p10[iR], p10[1], p10[iB]);
+			if (i + 1 < count) {
+				p01 += 4;
+				p11 += 4;
+				y0[i + 1] = m.getY(p01[iR], p01[1], p01[iB]);
+				y1[i + 1] = m.getY(p11[iR], p11[1], p11[iB]);
+			}
+			sl_uint32 c[3];
+			for (sl_uint32 k = 0; k < 3; k++) {
+				c[k] = ((((sl_uint32)p00[k] + p10[k] + 1) >> 1) + (((sl_uint32)p01[k] + p11[k] + 1) >> 1) + 1) >> 1;
+			}
+			sl_size j = (i >> 1) * strideUV;
+			u[j] = m.getU(c[iR], c[1], c[iB]);
+			v[j] = m.getV(c[iR], c[1], c[iB]);
+		}
+	}
+
+	void _priv_ImageSimd::convertYUYVToRGBARow(sl_uint8* dst, const sl_uint8* src, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_convertYUYVToRGBARow_SSE2(dst, src, count, m, flagBGRA);
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_convertYUYVToRGBARow_NEON(dst, src, count, m, flagBGRA);
+		}
+#endif
+		sl_uint32 iR = flagBGRA ? 2 : 0;
+		sl_uint32 iB = 2 - iR;
+		for (; i < count; i++) {
+			const sl_uint8* s = src + ((i >> 1) << 2);
+			sl_uint8* d = dst + (i << 2);
+			m.toRGB(s[(i & 1) << 1], s[1], s[3], d[iR], d[1], d[iB]);
+			d[3] = 255;
+		}
+	}
+
+	void _priv_ImageSimd::convertRGBAToYUYVRow(sl_uint8* dst, const sl_uint8* src, sl_size count, const _priv_YUVMatrix& m, sl_bool flagBGRA)
+	{
+		sl_size i = 0;
+#if defined(SLIB_IMAGE_SIMD_X86)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_convertRGBAToYUYVRow_SSE2(dst, src, count, m, flagBGRA);
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) {
+			i = _priv_ImageSimd_convertRGBAToYUYVRow_NEON(dst, src, count, m, flagBGRA);
+		}
+#endif
+		sl_uint32 iR = flagBGRA ? 2 : 0;
+		sl_uint32 iB = 2 - iR;
+		for (; i < count; i += 2) {
+			const sl_uint8* p0 = src + (i << 2);
+			const sl_uint8* p1 = i + 1 < count ? p0 + 4 : p0;
+			sl_uint8* d = dst + (i << 1);
+			sl_uint32 c[3];
+			for (sl_uint32 k = 0; k < 3; k++) {
+				c[k] = ((sl_uint32)p0[k] + p1[k] + 1) >> 1;
+			}
+			d[0] = m.getY(p0[iR], p0[1], p0[iB]);
+			d[1] = m.getU(c[iR], c[1], c[iB]);
+			d[2] = m.getY(p1[iR], p1[1], p1[iB]);
+			d[3] = m.getV(c[iR], c[1], c[iB]);
+		}
+	}
+
+	SLIB_INLINE static void _priv_ImageSimd_sumBlock(sl_uint32* sum, const Color* src, sl_uint32 width, sl_uint32 height, sl_int32 stride, sl_bool flagSimd)
+	{
+#if defined(SLIB_IMAGE_SIMD_X86)
+		if (flagSimd) {
+			__m128i zero = _mm_setzero_si128();
+			__m128i acc = zero;
+			for (sl_uint32 y = 0; y < height; y++) {
+				sl_uint32 x = 0;
+				for (; x + 2 <= width; x += 2) {
+					__m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(src + x)), zero);
+					acc = _mm_add_epi32(acc, _mm_add_epi32(_mm_unpacklo_epi16(v, zero), _mm_unpackhi_epi16(v, zero)));
+				}
+				if (x < width) {
+					__m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(*((const int*)(src + x))), zero);
+					acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v, zero));
+				}
+				src += stride;
+			}
+			_mm_storeu_si128((__m128i*)sum, acc);
+			return;
+		}
+#elif defined(SLIB_IMAGE_SIMD_NEON)
+		if (flagSimd) {
+			uint32x4_t acc = vdupq_n_u32(0);
+			for (sl_uint32 y = 0; y < height; y++) {
+				sl_uint32 x = 0;
+				for (; x + 2 <= width; x += 2) {
+					uint16x8_t v = vmovl_u8(vld1_u8((const uint8_t*)(src + x)));
+					acc = vaddq_u32(acc, vaddl_u16(vget_low_u16(v), vget_high_u16(v)));
+				}
+				if (x < width) {
+					const Color& c = src[x];
+					uint32_t t[4] = {c.r, c.g, c.b, c.a};
+					acc = vaddq_u32(acc, vld1q_u32(t));
+				}
+				src += stride;
+			}
+			vst1q_u32(sum, acc);
+			return;
+		}
+#endif
+		sl_uint32 r = 0;
+		sl_uint32 g = 0;
+		sl_uint32 b = 0;
+		sl_uint32 a = 0;
+		for (sl_uint32 y = 0; y < height; y++) {
+			for (sl_uint32 x = 0; x < width; x++) {
+				r += src[x].r;
+				g += src[x].g;
+				b += src[x].b;
+				a += src[x].a;
+			}
+			src += stride;
+		}
+		sum[0] = r;
+		sum[1] = g;
+		sum[2] = b;
+		sum[3] = a;
+	}
+
+	void _priv_ImageSimd::sumBlock(sl_uint32* sum, const Color* src, sl_uint32 width, sl_uint32 height, sl_int32 stride)
+	{
+		_priv_ImageSimd_sumBlock(sum, src, width, height, stride, (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) != 0);
+	}
+
 	void Image::fillColor(const Color& color)
 	{
-		Color* colorsDst;
 		Color* colorsDstLine = m_desc.colors;
 		for (sl_uint32 y = 0; y < m_desc.height; y++) {
-			colorsDst = colorsDstLine;
-			for (sl_uint32 x = 0; x < m_desc.width; x++) {
-				colorsDst[x] = color;
-			}
+			_priv_ImageSimd::fillRow(colorsDstLine, color, m_desc.width);
 			colorsDstLine += m_desc.stride;
 		}
 	}
@@ -474,9 +1747,7 @@ namespace slib
 			Color* colorsDst = dst.colors;
 			Color color = *(src.colors);
 			for (sl_uint32 y = 0; y < dst.height; y++) {
-				for (sl_uint32 x = 0; x < dst.width; x++) {
-					BLEND_OP::blend(colorsDst[x], color);
-				}
+				BLEND_OP::blendColorRow(colorsDst, color, dst.width);
 				colorsDst += dst.stride;
 			}
 		}
@@ -491,9 +1762,7 @@ namespace slib
 			Color* colorsDst = dst.colors;
 			const Color* colorsSrc = src.colors;
 			for (sl_uint32 y = 0; y < dst.height; y++) {
-				for (sl_uint32 x = 0; x < dst.width; x++) {
-					BLEND_OP::blend(colorsDst[x], colorsSrc[x]);
-				}
+				BLEND_OP::blendRow(colorsDst, colorsSrc, dst.width);
 				colorsDst += dst.stride;
 				colorsSrc += src.stride;
 			}
@@ -583,6 +1852,48 @@ namespace slib
 	class _priv_ImageStretch_Smooth_LinearFilter
 	{
 	public:
+#if defined(SLIB_IMAGE_SIMD_X86) && defined(SLIB_ARCH_IS_X64)
+		// same operations in the same order as the scalar code, so the results are identical
+		SLIB_INLINE static __m128 loadColor(const Color& c)
+		{
+			__m128i zero = _mm_setzero_si128();
+			return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*((const int*)&c)), zero), zero));
+		}
+		
+		SLIB_INLINE static void storeColor(Color& _out, __m128 c)
+		{
+			__m128i t = _mm_cvttps_epi32(c);
+			t = _mm_packs_epi32(t, t);
+			*((int*)&_out) = _mm_cvtsi128_si32(_mm_packus_epi16(t, t));
+		}
+		
+		SLIB_INLINE static void getColorAt(Color& _out, const Color* colors, float fx, float fy, sl_uint32 stride, const _priv_ImageStretch_FilterParam& px, const _priv_ImageStretch_FilterParam& py)
+		{
+			float sx = 1 - fx;
+			float ex = fx;
+			float sy = 1 - fy;
+			float ey = fy;
+			__m128 c = _mm_mul_ps(loadColor(*colors), _mm_set1_ps(sx * sy));
+			c = _mm_add_ps(c, _mm_mul_ps(loadColor(colors[1]), _mm_set1_ps(ex * sy)));
+			c = _mm_add_ps(c, _mm_mul_ps(loadColor(colors[stride]), _mm_set1_ps(sx * ey)));
+			c = _mm_add_ps(c, _mm_mul_ps(loadColor(colors[stride + 1]), _mm_set1_ps(ex * ey)));
+			storeColor(_out, c);
+		}
+		
+		SLIB_INLINE static void getColorAtX(Color& _out, const Color* colors, float fx, const _priv_ImageStretch_FilterParam& px)
+		{
+			__m128 c = _mm_mul_ps(loadColor(*colors), _mm_set1_ps(1 - fx));
+			c = _mm_add_ps(c, _mm_mul_ps(loadColor(colors[1]), _mm_set1_ps(fx)));
+			storeColor(_out, c);
+		}
+		
+		SLIB_INLINE static void getColorAtY(Color& _out, const Color* colors, float fy, sl_uint32 stride, const _priv_ImageStretch_FilterParam& py)
+		{
+			__m128 c = _mm_mul_ps(loadColor(*colors), _mm_set1_ps(1 - fy));
+			c = _mm_add_ps(c, _mm_mul_ps(loadColor(colors[stride]), _mm_set1_ps(fy)));
+			storeColor(_out, c);
+		}
+#else
 		SLIB_INLINE static void getColorAt(Color& _out, const Color* colors, float fx, float fy, sl_uint32 stride, const _priv_ImageStretch_FilterParam& px, const _priv_ImageStretch_FilterParam& py)
 		{
 			const Color& c00 = *colors;
@@ -638,6 +1949,7 @@ namespace slib
 			_out.b = (sl_uint8)(b);
 			_out.a = (sl_uint8)(a);
 		}
+#endif
 
 	};
 
@@ -1100,7 +2412,7 @@ namespace slib
 			if (fx == 0) {
 				return;
 			}
-			sl_uint32 dx, sx;
+			sl_uint32 dx;
 			
 			sl_uint32 dh = dst.height;
 			sl_uint32 sh = src.height;
@@ -1108,7 +2420,7 @@ namespace slib
 			if (fy == 0) {
 				return;
 			}
-			sl_uint32 dy, sy;
+			sl_uint32 dy;
 			
 			Color* colorsDst = dst.colors;
 			const Color* colorsSrc = src.colors;
@@ -1116,30 +2428,19 @@ namespace slib
 			
 			sl_uint32 area = fx * fy;
 			sl_uint32 n = Math::getMostSignificantBits(area) - 1;
+			sl_bool flagSimd = (_priv_ImageSimd_getFeatures() & PRIV_IMAGE_SIMD_BASE) != 0;
 			if (area == (1U << n)) {
 				for (dy = 0; dy < dst.height; dy++) {
 					const Color* cs = colorsSrc;
 					for (dx = 0; dx < dst.width; dx++) {
-						sl_uint32 r = 0;
-						sl_uint32 g = 0;
-						sl_uint32 b = 0;
-						sl_uint32 a = 0;
-						const Color* c = cs;
-						for (sy = 0; sy < fy; sy++) {
-							for (sx = 0; sx < fx; sx++) {
-								r += c[sx].r;
-								g += c[sx].g;
-								b += c[sx].b;
-								a += c[sx].a;
-							}
-							c += src.stride;
-						}
+						sl_uint32 sum[4];
+						_priv_ImageSimd_sumBlock(sum, cs, fx, fy, src.stride, flagSimd);
 						cs += fx;
 						Color& t = colorsDst[dx];
-						t.r = (sl_uint8)(r >> n);
-						t.g = (sl_uint8)(g >> n);
-						t.b = (sl_uint8)(b >> n);
-						t.a = (sl_uint8)(a >> n);
+						t.r = (sl_uint8)(sum[0] >> n);
+						t.g = (sl_uint8)(sum[1] >> n);
+						t.b = (sl_uint8)(sum[2] >> n);
+						t.a = (sl_uint8)(sum[3] >> n);
 					}
 					colorsDst += dst.stride;
 					colorsSrc += ly;
@@ -1148,26 +2449,14 @@ namespace slib
 				for (dy = 0; dy < dst.height; dy++) {
 					const Color* cs = colorsSrc;
 					for (dx = 0; dx < dst.width; dx++) {
-						sl_uint32 r = 0;
-						sl_uint32 g = 0;
-						sl_uint32 b = 0;
-						sl_uint32 a = 0;
-						const Color* c = cs;
-						for (sy = 0; sy < fy; sy++) {
-							for (sx = 0; sx < fx; sx++) {
-								r += c[sx].r;
-								g += c[sx].g;
-								b += c[sx].b;
-								a += c[sx].a;
-							}
-							c += src.stride;
-						}
+						sl_uint32 sum[4];
+						_priv_ImageSimd_sumBlock(sum, cs, fx, fy, src.stride, flagSimd);
 						cs += fx;
 						Color& t = colorsDst[dx];
-						t.r = (sl_uint8)(r / area);
-						t.g = (sl_uint8)(g / area);
-						t.b = (sl_uint8)(b / area);
-						t.a = (sl_uint8)(a / area);
+						t.r = (sl_uint8)(sum[0] / area);
+						t.g = (sl_uint8)(sum[1] / area);
+						t.b = (sl_uint8)(sum[2] / area);
+						t.a = (sl_uint8)(sum[3] / area);
 					}
 					colorsDst += dst.stride;
 					colorsSrc += ly;
@@ -1184,6 +2473,16 @@ namespace slib
 		{
 			dst = src;
 		}
+		
+		SLIB_INLINE static void blendRow(Color* dst, const Color* src, sl_uint32 count)
+		{
+			Base::copyMemory(dst, src, count << 2);
+		}
+		
+		SLIB_INLINE static void blendColorRow(Color* dst, const Color& color, sl_uint32 count)
+		{
+			_priv_ImageSimd::fillRow(dst, color, count);
+		}
 	};
 
 	class _priv_ImageBlend_SrcAlpha
@@ -1193,6 +2492,280 @@ namespace slib
 		{
 			dst.blend_PA_NPA(src);
 		}
+		
+		SLIB_INLINE static void blendRow(Color* dst, const Color* src, sl_uint32 count)
+		{
+			_priv_ImageSimd::blendRow_PA_NPA(dst, src, count);
+		}
+		
+		SLIB_INLINE static void blendColorRow(Color* dst, const Color& color, sl_uint32 count)
+		{
+			_priv_ImageSimd::blendColorRow_PA_NPA(dst, color, count);
+		}
+	};
+
+	class _priv_ImageResampler
+	{
+	public:
+		enum
+		{
+			WeightBits = 14,
+			// fractional bits of the intermediate (horizontally filtered) samples
+			IntermediateBits = 6
+		};
+		
+		struct Contribution
+		{
+			sl_int32 start;
+			sl_int32 count;
+			sl_int32 offsetWeights;
+		};
+		
+		class Filter
+		{
+		public:
+			sl_uint32 dstSize;
+			float support;
+			Array<Contribution> contributions;
+			Array<sl_int16> weights;
+			
+		public:
+			sl_bool prepare(StretchMode mode, sl_uint32 srcSize, sl_uint32 _dstSize)
+			{
+				dstSize = _dstSize;
+				float scale = (float)dstSize / (float)srcSize;
+				float filterScale = scale < 1 ? scale : 1;
+				support = getSupport(mode) / filterScale;
+				sl_int32 nMaxTaps = (sl_int32)(Math::ceil(support)) * 2 + 1;
+				contributions = Array<Contribution>::create(dstSize);
+				weights = Array<sl_int16>::create(dstSize * nMaxTaps);
+				if (contributions.isNull() || weights.isNull()) {
+					return sl_false;
+				}
+				Contribution* contribs = contributions.getData();
+				sl_int16* w = weights.getData();
+				SLIB_SCOPED_BUFFER(float, 64, f, nMaxTaps);
+				if (!f) {
+					return sl_false;
+				}
+				sl_int32 n = (sl_int32)srcSize;
+				for (sl_uint32 i = 0; i < dstSize; i++) {
+					float center = ((float)i + 0.5f) / scale - 0.5f;
+					sl_int32 left = (sl_int32)(Math::ceil(center - support));
+					sl_int32 right = (sl_int32)(Math::floor(center + support));
+					if (right - left + 1 > nMaxTaps) {
+						right = left + nMaxTaps - 1;
+					}
+					// taps outside of the image are folded into the edge pixels
+					sl_int32 start = left < 0 ? 0 : left;
+					sl_int32 end = right >= n ? n - 1 : right;
+					if (end < start) {
+						start = end = Math::clamp(left, (sl_int32)0, n - 1);
+					}
+					sl_int32 count = end - start + 1;
+					for (sl_int32 k = 0; k < count; k++) {
+						f[k] = 0;
+					}
+					float sum = 0;
+					for (sl_int32 j = left; j <= right; j++) {
+						float v = getWeight(mode, ((float)j - center) * filterScale);
+						sl_int32 k = Math::clamp(j, start, end) - start;
+						f[k] += v;
+						sum += v;
+					}
+					if (Math::isAlmostZero(sum)) {
+						for (sl_int32 k = 0; k < count; k++) {
+							f[k] = 0;
+						}
+						f[Math::clamp((sl_int32)(center + 0.5f), start, end) - start] = 1;
+						sum = 1;
+					}
+					// normalize to fixed point, and give the rounding error to the largest weight
+					sl_int32 total = 0;
+					sl_int32 kMax = 0;
+					for (sl_int32 k = 0; k < count; k++) {
+						sl_int32 iw = (sl_int32)(Math::round(f[k] / sum * (float)(1 << WeightBits)));
+						w[k] = (sl_int16)iw;
+						total += iw;
+						if (w[k] > w[kMax]) {
+							kMax = k;
+						}
+					}
+					w[kMax] = (sl_int16)(w[kMax] + (1 << WeightBits) - total);
+					contribs[i].start = start;
+					contribs[i].count = count;
+					contribs[i].offsetWeights = (sl_int32)(w - weights.getData());
+					w += count;
+				}
+				return sl_true;
+			}
+			
+			static float getSupport(StretchMode mode)
+			{
+				if (mode == StretchMode::Lanczos3) {
+					return 3;
+				}
+				return 2;
+			}
+			
+			static float getWeight(StretchMode mode, float x)
+			{
+				if (x < 0) {
+					x = -x;
+				}
+				if (mode == StretchMode::Lanczos3) {
+					if (x < 0.000001f) {
+						return 1;
+					}
+					if (x >= 3) {
+						return 0;
+					}
+					float t = x * SLIB_PI;
+					return 3 * Math::sin(t) * Math::sin(t / 3) / (t * t);
+				} else {
+					// Mitchell-Netravali, B = C = 1/3
+					const float B = 1.0f / 3.0f;
+					const float C = 1.0f / 3.0f;
+					if (x < 1) {
+						return ((12 - 9 * B - 6 * C) * x * x * x + (-18 + 12 * B + 6 * C) * x * x + (6 - 2 * B)) / 6;
+					} else if (x < 2) {
+						return ((-B - 6 * C) * x * x * x + (6 * B + 30 * C) * x * x + (-12 * B - 48 * C) * x + (8 * B + 24 * C)) / 6;
+					}
+					return 0;
+				}
+			}
+			
+		};
+		
+		static void filterRowX(sl_int16* _out, const Color* src, const Filter& fx)
+		{
+			const Contribution* contribs = fx.contributions.getData();
+			const sl_int16* weights = fx.weights.getData();
+			const sl_int32 shift = WeightBits + 8 - IntermediateBits - 8;
+			const sl_int32 round = 1 << (shift - 1);
+			for (sl_uint32 dx = 0; dx < fx.dstSize; dx++) {
+				const Contribution& c = contribs[dx];
+				const sl_int16* w = weights + c.offsetWeights;
+				const Color* s = src + c.start;
+				sl_int32 r = 0;
+				sl_int32 g = 0;
+				sl_int32 b = 0;
+				sl_int32 a = 0;
+				for (sl_int32 k = 0; k < c.count; k++) {
+					sl_int32 f = w[k];
+					r += f * s[k].r;
+					g += f * s[k].g;
+					b += f * s[k].b;
+					a += f * s[k].a;
+				}
+				_out[0] = (sl_int16)((r + round) >> shift);
+				_out[1] = (sl_int16)((g + round) >> shift);
+				_out[2] = (sl_int16)((b + round) >> shift);
+				_out[3] = (sl_int16)((a + round) >> shift);
+				_out += 4;
+			}
+		}
+		
+		static void filterRowY(Color* _out, const sl_int16* rows, sl_uint32 pitch, sl_uint32 width, const Contribution& c, const sl_int16* w)
+		{
+			const sl_int32 shift = WeightBits + IntermediateBits;
+			const sl_int32 round = 1 << (shift - 1);
+			sl_uint32 n = width << 2;
+			SLIB_SCOPED_BUFFER(sl_int32, 4096, acc, n);
+			if (!acc) {
+				return;
+			}
+			for (sl_uint32 i = 0; i < n; i++) {
+				acc[i] = round;
+			}
+			for (sl_int32 k = 0; k < c.count; k++) {
+				sl_int32 f = w[k];
+				const sl_int16* row = rows + k * pitch;
+				for (sl_uint32 i = 0; i < n; i++) {
+					acc[i] += f * row[i];
+				}
+			}
+			sl_uint8* o = (sl_uint8*)_out;
+			for (sl_uint32 i = 0; i < n; i++) {
+				o[i] = (sl_uint8)(Math::clamp0_255(acc[i] >> shift));
+			}
+		}
+		
+		template <class BLEND_OP>
+		static void resample(ImageDesc& dst, const ImageDesc& src, StretchMode mode)
+		{
+			Filter fx, fy;
+			if (!(fx.prepare(mode, src.width, dst.width))) {
+				return;
+			}
+			if (!(fy.prepare(mode, src.height, dst.height))) {
+				return;
+			}
+			sl_uint32 dh = dst.height;
+			// strips of the destination rows are resampled in parallel; each strip filters horizontally only the source rows it needs
+			sl_uint32 nStrips = 1;
+			if ((sl_uint64)(src.width) * (sl_uint64)(src.height) >= 0x40000) {
+				nStrips = Parallel::getConcurrency() * 4;
+				if (nStrips > dh / 8) {
+					nStrips = dh / 8;
+				}
+				if (!nStrips) {
+					nStrips = 1;
+				}
+			}
+			sl_uint32 heightStrip = (dh + nStrips - 1) / nStrips;
+			nStrips = (dh + heightStrip - 1) / heightStrip;
+			const Filter* pfx = &fx;
+			const Filter* pfy = &fy;
+			ImageDesc* pdst = &dst;
+			const ImageDesc* psrc = &src;
+			Parallel::run(nStrips, [pfx, pfy, pdst, psrc, heightStrip](sl_size index) {
+				resampleStrip<BLEND_OP>(*pdst, *psrc, *pfx, *pfy, (sl_uint32)index * heightStrip, heightStrip);
+			});
+		}
+		
+		template <class BLEND_OP>
+		static void resampleStrip(ImageDesc& dst, const ImageDesc& src, const Filter& fx, const Filter& fy, sl_uint32 dy0, sl_uint32 n)
+		{
+			sl_uint32 dy1 = dy0 + n;
+			if (dy1 > dst.height) {
+				dy1 = dst.height;
+			}
+			if (dy0 >= dy1) {
+				return;
+			}
+			const Contribution* contribs = fy.contributions.getData();
+			sl_int32 sy0 = contribs[dy0].start;
+			sl_int32 sy1 = sy0;
+			for (sl_uint32 dy = dy0; dy < dy1; dy++) {
+				const Contribution& c = contribs[dy];
+				if (c.start < sy0) {
+					sy0 = c.start;
+				}
+				if (c.start + c.count > sy1) {
+					sy1 = c.start + c.count;
+				}
+			}
+			sl_uint32 pitch = dst.width << 2;
+			Array<sl_int16> bufRows = Array<sl_int16>::create((sl_size)pitch * (sy1 - sy0));
+			SLIB_SCOPED_BUFFER(Color, 1024, bufColors, dst.width);
+			if (bufRows.isNull() || !bufColors) {
+				return;
+			}
+			sl_int16* rows = bufRows.getData();
+			for (sl_int32 sy = sy0; sy < sy1; sy++) {
+				filterRowX(rows + (sy - sy0) * pitch, src.colors + sy * src.stride, fx);
+			}
+			const sl_int16* weights = fy.weights.getData();
+			Color* colorsDst = dst.colors + dy0 * dst.stride;
+			for (sl_uint32 dy = dy0; dy < dy1; dy++) {
+				const Contribution& c = contribs[dy];
+				filterRowY(bufColors, rows + (c.start - sy0) * pitch, pitch, dst.width, c, weights + c.offsetWeights);
+				BLEND_OP::blendRow(colorsDst, bufColors, dst.width);
+				colorsDst += dst.stride;
+			}
+		}
+		
 	};
 
 	class _priv_ImageStretch
@@ -1228,6 +2801,17 @@ namespace slib
 			_priv_ImageStretch::template stretch<_priv_ImageStretch_FillColor>(dst, src, blend);
 			return;
 		}
+		if (stretch == StretchMode::Mitchell || stretch == StretchMode::Lanczos3) {
+			switch (blend) {
+				case BlendMode::Copy:
+					_priv_ImageResampler::resample<_priv_ImageBlend_Copy>(dst, src, stretch);
+					break;
+				case BlendMode::SrcAlpha:
+					_priv_ImageResampler::resample<_priv_ImageBlend_SrcAlpha>(dst, src, stretch);
+					break;
+			}
+			return;
+		}
 		if (stretch == StretchMode::Nearest) {
 			_priv_ImageStretch::template stretch<_priv_ImageStretch_Nearest>(dst, src, blend);
 		} else if (stretch == StretchMode::Linear) {
@@ -1489,7 +3073,10 @@ namespace slib
 
 	Ref<Image> Image::loadFromFile(const String& filePath)
 	{
-		Memory mem = File::readAllBytes(filePath);
+		Memory mem = MappedFile::mapAll(filePath);
+		if (mem.isNull()) {
+			mem = File::readAllBytes(filePath);
+		}
 		if (mem.isNotNull()) {
 			return loadFromMemory(mem);
 		}
@@ -1525,7 +3112,10 @@ namespace slib
 	
 	Ref<AnimationDrawable> Image::loadAnimationFromFile(const String& filePath)
 	{
-		Memory mem = File::readAllBytes(filePath);
+		Memory mem = MappedFile::mapAll(filePath);
+		if (mem.isNull()) {
+			mem = File::readAllBytes(filePath);
+		}
 		if (mem.isNotNull()) {
 			return loadAnimationFromMemory(mem);
 		}
@@ -25,6 +25,8 @@
 #include "slib/core/file.h"
 #include "slib/core/scoped.h"
 
+#include "slib/graphics/detail/image_simd.h"
+
 #include <stdio.h>
 #include <setjmp.h>
 #if defined(SLIB_PLATFORM_IS_APPLE)
@@ -51,21 +53,49 @@ namespace slib
 		longjmp(err->setjmp_buffer, 1);
 	}
 
-	Ref<Image> Image::loadJPEG(const void* content, sl_size size)
+	static void _priv_ImageJpeg_fitSize(sl_uint32 width, sl_uint32 height, sl_uint32 requiredWidth, sl_uint32 requiredHeight, sl_uint32& outWidth, sl_uint32& outHeight)
+	{
+		float fw = (float)requiredWidth / (float)width;
+		float fh = (float)requiredHeight / (float)height;
+		float f = SLIB_MIN(fw, fh);
+		outWidth = (sl_uint32)((float)width * f);
+		outHeight = (sl_uint32)((float)height * f);
+	}
+
+	static sl_uint32 _priv_ImageJpeg_getScaleDenominator(sl_uint32 width, sl_uint32 height, sl_uint32 minWidth, sl_uint32 minHeight, sl_bool flagKeepAspectRatio)
+	{
+		if (!minWidth && !minHeight) {
+			return 1;
+		}
+		if (flagKeepAspectRatio && width && height) {
+			_priv_ImageJpeg_fitSize(width, height, minWidth, minHeight, minWidth, minHeight);
+		}
+		sl_uint32 denom = 8;
+		while (denom > 1) {
+			// libjpeg rounds up the scaled size
+			if ((width + denom - 1) / denom >= minWidth && (height + denom - 1) / denom >= minHeight) {
+				break;
+			}
+			denom >>= 1;
+		}
+		return denom;
+	}
+
+	static sl_bool _priv_ImageJpeg_decode(const void* content, sl_size size, sl_uint32 minWidth, sl_uint32 minHeight, sl_bool flagKeepAspectRatio, const Function<sl_bool(sl_uint32, sl_uint32)>& onStart, const Function<void(sl_uint32, const Color*)>& onRow)
 	{
 		if (!content || !size) {
-			return sl_null;
+			return sl_false;
 		}
+		
+		// Don't put any object requiring destruction in this frame: `longjmp` would skip it
 		jpeg_decompress_struct cinfo;
 		_slib_image_ext_jpeg_error_mgr jerr;
 		cinfo.err = jpeg_std_error(&(jerr.pub));
 		jerr.pub.error_exit = _slib_image_jpeg_error_exit;
 
-		Ref<Image> ret;
-
 		if (setjmp(jerr.setjmp_buffer)) {
 			jpeg_destroy_decompress(&cinfo);
-			return sl_null;
+			return sl_false;
 		}
 
 		jpeg_create_decompress(&cinfo);
@@ -75,37 +105,199 @@ namespace slib
 		jpeg_read_header(&cinfo, 1);
 
 		cinfo.out_color_space = JCS_RGB;
+		cinfo.scale_num = 1;
+		cinfo.scale_denom = _priv_ImageJpeg_getScaleDenominator(cinfo.image_width, cinfo.image_height, minWidth, minHeight, flagKeepAspectRatio);
 
 		jpeg_start_decompress(&cinfo);
 
 		sl_uint32 width = cinfo.output_width;
 		sl_uint32 height = cinfo.output_height;
-		ret = Image::create(width, height);
-		if (ret.isNotNull()) {
-			JSAMPROW row_pointer[1];
-			SLIB_SCOPED_BUFFER(sl_uint8, 4096, row, width*3);
-			if (row) {
-				row_pointer[0] = (JSAMPROW)(row);
-				Color* pixels = ret->getColors();
-				sl_uint32 stride = ret->getStride();
-				while (cinfo.output_scanline < height) {
-					jpeg_read_scanlines(&cinfo, row_pointer, 1);
-					sl_uint8* p = row;
-					for (sl_uint32 i = 0; i < width; i++) {
-						pixels[i].r = *(p++);
-						pixels[i].g = *(p++);
-						pixels[i].b = *(p++);
-						pixels[i].a = 255;
-					}
-					pixels += stride;
-				}
+		
+		if (!width || !height || (onStart.isNotNull() && !(onStart(width, height)))) {
+			jpeg_destroy_decompress(&cinfo);
+			return sl_false;
+		}
+
+		// allocated in the image pool, and released by `jpeg_destroy_decompress()`
+		JSAMPARRAY rows = (*(cinfo.mem->alloc_sarray))((j_common_ptr)&cinfo, JPOOL_IMAGE, width * 3, 1);
+		JSAMPARRAY colors = (*(cinfo.mem->alloc_sarray))((j_common_ptr)&cinfo, JPOOL_IMAGE, width * 4, 1);
+		
+		static const sl_uint8 order[] = {0, 1, 2, 255};
+		while (cinfo.output_scanline < height) {
+			sl_uint32 y = cinfo.output_scanline;
+			if (jpeg_read_scanlines(&cinfo, rows, 1) != 1) {
+				break;
 			}
+			_priv_ImageSimd::shuffleRow_3to4(colors[0], rows[0], width, order);
+			onRow(y, (Color*)(colors[0]));
 		}
 
 		jpeg_finish_decompress(&cinfo);
 		jpeg_destroy_decompress(&cinfo);
 
-		return ret;
+		return sl_true;
+	}
+
+	Ref<Image> Image::loadJPEG(const void* content, sl_size size)
+	{
+		return loadJPEG(content, size, 0, 0);
+	}
+
+	Ref<Image> Image::loadJPEG(const void* content, sl_size size, sl_uint32 minWidth, sl_uint32 minHeight)
+	{
+		Ref<Image> ret;
+		Color* pixels = sl_null;
+		sl_reg stride = 0;
+		sl_uint32 width = 0;
+		sl_bool flagSuccess = _priv_ImageJpeg_decode(content, size, minWidth, minHeight, sl_false, [&ret, &pixels, &stride, &width](sl_uint32 _width, sl_uint32 _height) {
+			ret = Image::create(_width, _height);
+			if (ret.isNull()) {
+				return sl_false;
+			}
+			pixels = ret->getColors();
+			stride = ret->getStride();
+			width = _width;
+			return sl_true;
+		}, [&pixels, &stride, &width](sl_uint32 y, const Color* colors) {
+			Base::copyMemory(pixels + y * stride, colors, width << 2);
+		});
+		if (flagSuccess) {
+			return ret;
+		}
+		return sl_null;
+	}
+
+	class _priv_ImageJpeg_BoxReducer
+	{
+	public:
+		sl_uint32 srcWidth;
+		sl_uint32 srcHeight;
+		sl_uint32 dstWidth;
+		sl_uint32 dstHeight;
+		Ref<Image> image;
+		// destination column of each source column
+		Array<sl_uint32> mapX;
+		// source columns summed into each destination column
+		Array<sl_uint32> countX;
+		// r, g, b sums of the current destination row
+		Array<sl_uint32> sums;
+		sl_uint32 rowCurrent;
+		sl_uint32 countY;
+
+	public:
+		sl_bool prepare(sl_uint32 _srcWidth, sl_uint32 _srcHeight, sl_uint32 requiredWidth, sl_uint32 requiredHeight, sl_bool flagKeepAspectRatio)
+		{
+			srcWidth = _srcWidth;
+			srcHeight = _srcHeight;
+			if (flagKeepAspectRatio) {
+				_priv_ImageJpeg_fitSize(srcWidth, srcHeight, requiredWidth, requiredHeight, dstWidth, dstHeight);
+			} else {
+				dstWidth = requiredWidth;
+				dstHeight = requiredHeight;
+			}
+			if (dstWidth > srcWidth) {
+				dstWidth = srcWidth;
+			}
+			if (dstHeight > srcHeight) {
+				dstHeight = srcHeight;
+			}
+			if (!dstWidth) {
+				dstWidth = 1;
+			}
+			if (!dstHeight) {
+				dstHeight = 1;
+			}
+			image = Image::create(dstWidth, dstHeight);
+			if (image.isNull()) {
+				return sl_false;
+			}
+			mapX = Array<sl_uint32>::create(srcWidth);
+			countX = Array<sl_uint32>::create(dstWidth);
+			sums = Array<sl_uint32>::create(dstWidth * 3);
+			if (mapX.isNull() || countX.isNull() || sums.isNull()) {
+				return sl_false;
+			}
+			sl_uint32* m = mapX.getData();
+			sl_uint32* c = countX.getData();
+			Base::zeroMemory(c, dstWidth * sizeof(sl_uint32));
+			for (sl_uint32 x = 0; x < srcWidth; x++) {
+				sl_uint32 dx = (sl_uint32)((sl_uint64)x * dstWidth / srcWidth);
+				m[x] = dx;
+				c[dx]++;
+			}
+			Base::zeroMemory(sums.getData(), dstWidth * 3 * sizeof(sl_uint32));
+			rowCurrent = 0;
+			countY = 0;
+			return sl_true;
+		}
+
+		void addRow(sl_uint32 y, const Color* colors)
+		{
+			sl_uint32 dy = (sl_uint32)((sl_uint64)y * dstHeight / srcHeight);
+			if (dy != rowCurrent) {
+				flush();
+				rowCurrent = dy;
+			}
+			sl_uint32* m = mapX.getData();
+			sl_uint32* s = sums.getData();
+			for (sl_uint32 x = 0; x < srcWidth; x++) {
+				sl_uint32* p = s + m[x] * 3;
+				p[0] += colors[x].r;
+				p[1] += colors[x].g;
+				p[2] += colors[x].b;
+			}
+			countY++;
+		}
+
+		void flush()
+		{
+			if (!countY) {
+				return;
+			}
+			sl_uint32* c = countX.getData();
+			sl_uint32* s = sums.getData();
+			Color* d = image->getColors() + (sl_reg)rowCurrent * image->getStride();
+			for (sl_uint32 x = 0; x < dstWidth; x++) {
+				sl_uint32 n = c[x] * countY;
+				sl_uint32 h = n >> 1;
+				d[x].r = (sl_uint8)((s[0] + h) / n);
+				d[x].g = (sl_uint8)((s[1] + h) / n);
+				d[x].b = (sl_uint8)((s[2] + h) / n);
+				d[x].a = 255;
+				s[0] = 0;
+				s[1] = 0;
+				s[2] = 0;
+				s += 3;
+			}
+			countY = 0;
+		}
+
+	};
+
+	sl_bool Image::decodeJPEG(const void* content, sl_size size, sl_uint32 minWidth, sl_uint32 minHeight, const Function<sl_bool(sl_uint32 width, sl_uint32 height)>& onStart, const Function<void(sl_uint32 y, const Color* colors)>& onRow)
+	{
+		if (onRow.isNull()) {
+			return sl_false;
+		}
+		return _priv_ImageJpeg_decode(content, size, minWidth, minHeight, sl_false, onStart, onRow);
+	}
+
+	Ref<Image> Image::loadJPEGToSmall(const void* content, sl_size size, sl_uint32 requiredWidth, sl_uint32 requiredHeight, sl_bool flagKeepAspectRatio)
+	{
+		if (!requiredWidth || !requiredHeight) {
+			return sl_null;
+		}
+		_priv_ImageJpeg_BoxReducer reducer;
+		sl_bool flagSuccess = _priv_ImageJpeg_decode(content, size, requiredWidth, requiredHeight, flagKeepAspectRatio, [&reducer, requiredWidth, requiredHeight, flagKeepAspectRatio](sl_uint32 width, sl_uint32 height) {
+			return reducer.prepare(width, height, requiredWidth, requiredHeight, flagKeepAspectRatio);
+		}, [&reducer](sl_uint32 y, const Color* colors) {
+			reducer.addRow(y, colors);
+		});
+		if (flagSuccess) {
+			reducer.flush();
+			return reducer.image;
+		}
+		return sl_null;
 	}
 
 	Memory Image::saveJPEG(const Ref<Image>& image, float quality)
@@ -22,40 +22,179 @@
 
 #include "slib/graphics/yuv.h"
 
-#include "slib/core/math.h"
+#include "slib/graphics/detail/image_simd.h"
+#include "slib/core/parallel.h"
 
-#define YUV_YG 18997 /* round(1.164 * 64 * 256 * 256 / 257) */
-#define YUV_YGB 1160 /* 1.164 * 64 * 16 - adjusted for even error distribution */
-#define YUV_UB -128 /* -min(128, round(2.018 * 64)) */
-#define YUV_UG 25 /* -round(-0.391 * 64) */
-#define YUV_VG 52 /* -round(-0.813 * 64) */
-#define YUV_VR -102 /* -round(1.596 * 64) */
-#define YUV_BB (YUV_UB * 128 - YUV_YGB)
-#define YUV_BG (YUV_UG * 128 + YUV_VG * 128 - YUV_YGB)
-#define YUV_BR (YUV_VR * 128 - YUV_YGB)
+#define PRIV_YUV_PARALLEL_MIN_PIXELS 0x40000
 
 namespace slib
 {
+	
+	/*
+		YUV -> RGB
+			yg = round(Y gain * 64 * 256 * 256 / 257)
+			yb = -(Y gain * 64 * Y offset) + 32 (rounding)
+			ub, ug, vg, vr = round(coefficient * 64)
+		Limited BT.601 keeps the former constants (ub is clipped to 128).
+	 
+		RGB -> YUV
+			coefficients are scaled by 256 (limited range: 219/255 for Y, 224/255 for UV), rounded so that U and V coefficients sum to zero
+	*/
+	static const _priv_YUVMatrix _priv_YUV_matrices[] = {
+		// BT601
+		{18997, -1160, 128, 25, 52, 102, 66, 129, 25, -38, -74, 112, 112, -94, -18, 0x1080, 0x8080},
+		// BT601_Full
+		{16320, 32, 113, 22, 46, 90, 77, 150, 29, -43, -84, 127, 127, -107, -20, 0x0080, 0x807F},
+		// BT709
+		{18997, -1160, 135, 14, 34, 115, 47, 157, 16, -26, -86, 112, 112, -102, -10, 0x1080, 0x8080},
+		// BT709_Full
+		{16320, 32, 119, 12, 30, 101, 54, 183, 19, -29, -99, 128, 128, -116, -12, 0x0080, 0x807F}
+	};
+	
+	const _priv_YUVMatrix& _priv_YUVMatrix::get(YUVMatrix matrix)
+	{
+		sl_uint32 index = (sl_uint32)matrix;
+		if (index >= sizeof(_priv_YUV_matrices) / sizeof(_priv_YUVMatrix)) {
+			index = 0;
+		}
+		return _priv_YUV_matrices[index];
+	}
 
 	void YUV::convertRGBToYUV(sl_uint8 R, sl_uint8 G, sl_uint8 B, sl_uint8& Y, sl_uint8& U, sl_uint8& V)
 	{
-		sl_int32 _r = R;
-		sl_int32 _g = G;
-		sl_int32 _b = B;
-		Y = (sl_uint8)(Math::clamp0_255((66 * _r + 129 * _g + 25 * _b + 0x1080) >> 8)); // y
-		U = (sl_uint8)(Math::clamp0_255((112 * _b - 74 * _g - 38 * _r + 0x8080) >> 8)); // u
-		V = (sl_uint8)(Math::clamp0_255((112 * _r - 94 * _g - 18 * _b + 0x8080) >> 8)); // v
+		const _priv_YUVMatrix& m = _priv_YUV_matrices[0];
+		Y = m.getY(R, G, B);
+		U = m.getU(R, G, B);
+		V = m.getV(R, G, B);
 	}
 
 	void YUV::convertYUVToRGB(sl_uint8 Y, sl_uint8 U, sl_uint8 V, sl_uint8& R, sl_uint8& G, sl_uint8& B)
 	{
-		sl_int32 _y = Y;
-		sl_int32 _u = U;
-		sl_int32 _v = V;
-		sl_int32 y1 = (sl_uint32)(_y * 0x0101 * YUV_YG) >> 16;
-		B = (sl_uint8)(Math::clamp0_255((sl_int32)(YUV_BB - (_u * YUV_UB) + y1) >> 6));
-		G = (sl_uint8)(Math::clamp0_255((sl_int32)(YUV_BG - (_v * YUV_VG + _u * YUV_UG) + y1) >> 6));
-		R = (sl_uint8)(Math::clamp0_255((sl_int32)(YUV_BR - (_v * YUV_VR) + y1) >> 6));
+		_priv_YUV_matrices[0].toRGB(Y, U, V, R, G, B);
+	}
+	
+	void YUV::convertRGBToYUV(YUVMatrix matrix, sl_uint8 R, sl_uint8 G, sl_uint8 B, sl_uint8& Y, sl_uint8& U, sl_uint8& V)
+	{
+		const _priv_YUVMatrix& m = _priv_YUVMatrix::get(matrix);
+		Y = m.getY(R, G, B);
+		U = m.getU(R, G, B);
+		V = m.getV(R, G, B);
+	}
+	
+	void YUV::convertYUVToRGB(YUVMatrix matrix, sl_uint8 Y, sl_uint8 U, sl_uint8 V, sl_uint8& R, sl_uint8& G, sl_uint8& B)
+	{
+		_priv_YUVMatrix::get(matrix).toRGB(Y, U, V, R, G, B);
+	}
+	
+	// calls `task(rowStart, rowEnd)` for the bands of the frame. Bands start at even rows so that they don't share 4:2:0 chroma rows
+	template <class TASK>
+	static void _priv_YUV_runBands(sl_uint32 width, sl_uint32 height, const TASK& task)
+	{
+		sl_uint32 nPairs = (height + 1) >> 1;
+		sl_uint32 nBands = 1;
+		if ((sl_uint64)width * height >= PRIV_YUV_PARALLEL_MIN_PIXELS) {
+			nBands = Parallel::getConcurrency() * 2;
+			if (nBands > nPairs) {
+				nBands = nPairs;
+			}
+		}
+		if (nBands < 2) {
+			task(0, height);
+			return;
+		}
+		Parallel::run(nBands, [nBands, nPairs, height, &task](sl_size iBand) {
+			sl_uint32 start = (sl_uint32)((sl_uint64)nPairs * iBand / nBands) << 1;
+			sl_uint32 end = (sl_uint32)((sl_uint64)nPairs * (iBand + 1) / nBands) << 1;
+			if (end > height) {
+				end = height;
+			}
+			task(start, end);
+		});
+	}
+	
+	void YUV::convertYUV420ToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* y, sl_int32 pitchY, const sl_uint8* u, sl_int32 pitchU, const sl_uint8* v, sl_int32 pitchV, sl_uint32 strideUV, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		if (!width || !height) {
+			return;
+		}
+		const _priv_YUVMatrix& m = _priv_YUVMatrix::get(matrix);
+		_priv_YUV_runBands(width, height, [&](sl_uint32 start, sl_uint32 end) {
+			for (sl_uint32 i = start; i < end; i++) {
+				sl_uint32 k = i >> 1;
+				_priv_ImageSimd::convertYUV420ToRGBARow(rgba + (sl_reg)pitchRGBA * i, y + (sl_reg)pitchY * i, u + (sl_reg)pitchU * k, v + (sl_reg)pitchV * k, strideUV, width, m, flagBGRA);
+			}
+		});
+	}
+	
+	void YUV::convertRGBAToYUV420(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* y, sl_int32 pitchY, sl_uint8* u, sl_int32 pitchU, sl_uint8* v, sl_int32 pitchV, sl_uint32 strideUV, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		if (!width || !height) {
+			return;
+		}
+		const _priv_YUVMatrix& m = _priv_YUVMatrix::get(matrix);
+		_priv_YUV_runBands(width, height, [&](sl_uint32 start, sl_uint32 end) {
+			for (sl_uint32 i = start; i < end; i += 2) {
+				sl_uint32 i1 = i + 1 < height ? i + 1 : i;
+				sl_uint32 k = i >> 1;
+				_priv_ImageSimd::convertRGBAToYUV420Rows(y + (sl_reg)pitchY * i, y + (sl_reg)pitchY * i1, u + (sl_reg)pitchU * k, v + (sl_reg)pitchV * k, strideUV, rgba + (sl_reg)pitchRGBA * i, rgba + (sl_reg)pitchRGBA * i1, width, m, flagBGRA);
+			}
+		});
+	}
+	
+	void YUV::convertI420ToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* y, sl_int32 pitchY, const sl_uint8* u, sl_int32 pitchU, const sl_uint8* v, sl_int32 pitchV, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		convertYUV420ToRGBA(width, height, y, pitchY, u, pitchU, v, pitchV, 1, rgba, pitchRGBA, flagBGRA, matrix);
+	}
+	
+	void YUV::convertRGBAToI420(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* y, sl_int32 pitchY, sl_uint8* u, sl_int32 pitchU, sl_uint8* v, sl_int32 pitchV, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		convertRGBAToYUV420(width, height, rgba, pitchRGBA, y, pitchY, u, pitchU, v, pitchV, 1, flagBGRA, matrix);
+	}
+	
+	void YUV::convertNV12ToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* y, sl_int32 pitchY, const sl_uint8* uv, sl_int32 pitchUV, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		convertYUV420ToRGBA(width, height, y, pitchY, uv, pitchUV, uv + 1, pitchUV, 2, rgba, pitchRGBA, flagBGRA, matrix);
+	}
+	
+	void YUV::convertRGBAToNV12(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* y, sl_int32 pitchY, sl_uint8* uv, sl_int32 pitchUV, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		convertRGBAToYUV420(width, height, rgba, pitchRGBA, y, pitchY, uv, pitchUV, uv + 1, pitchUV, 2, flagBGRA, matrix);
+	}
+	
+	void YUV::convertNV21ToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* y, sl_int32 pitchY, const sl_uint8* vu, sl_int32 pitchVU, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		convertYUV420ToRGBA(width, height, y, pitchY, vu + 1, pitchVU, vu, pitchVU, 2, rgba, pitchRGBA, flagBGRA, matrix);
+	}
+	
+	void YUV::convertRGBAToNV21(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* y, sl_int32 pitchY, sl_uint8* vu, sl_int32 pitchVU, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		convertRGBAToYUV420(width, height, rgba, pitchRGBA, y, pitchY, vu + 1, pitchVU, vu, pitchVU, 2, flagBGRA, matrix);
+	}
+	
+	void YUV::convertYUYVToRGBA(sl_uint32 width, sl_uint32 height, const sl_uint8* yuyv, sl_int32 pitchYUYV, sl_uint8* rgba, sl_int32 pitchRGBA, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		if (!width || !height) {
+			return;
+		}
+		const _priv_YUVMatrix& m = _priv_YUVMatrix::get(matrix);
+		_priv_YUV_runBands(width, height, [&](sl_uint32 start, sl_uint32 end) {
+			for (sl_uint32 i = start; i < end; i++) {
+				_priv_ImageSimd::convertYUYVToRGBARow(rgba + (sl_reg)pitchRGBA * i, yuyv + (sl_reg)pitchYUYV * i, width, m, flagBGRA);
+			}
+		});
+	}
+	
+	void YUV::convertRGBAToYUYV(sl_uint32 width, sl_uint32 height, const sl_uint8* rgba, sl_int32 pitchRGBA, sl_uint8* yuyv, sl_int32 pitchYUYV, sl_bool flagBGRA, YUVMatrix matrix)
+	{
+		if (!width || !height) {
+			return;
+		}
+		const _priv_YUVMatrix& m = _priv_YUVMatrix::get(matrix);
+		_priv_YUV_runBands(width, height, [&](sl_uint32 start, sl_uint32 end) {
+			for (sl_uint32 i = start; i < end; i++) {
+				_priv_ImageSimd::convertRGBAToYUYVRow(yuyv + (sl_reg)pitchYUYV * i, rgba + (sl_reg)pitchRGBA * i, width, m, flagBGRA);
+			}
+		});
 	}
 
 }
@@ -26,8 +26,11 @@
 #include "slib/core/scoped.h"
 #include "slib/core/mio.h"
 #include "slib/core/log.h"
+#include "slib/core/system.h"
+#include "slib/core/sort.h"
 
 #define PRIV_MAX_NAME SLIB_NETWORK_DNS_NAME_MAX_LENGTH
+#define PRIV_RECORD_TYPE_OPT 41
 
 namespace slib
 {
@@ -654,7 +657,7 @@ namespace slib
 		return sl_null;
 	}
 
-	Memory DnsPacket::buildHostAddressAnswerPacket(sl_uint16 id, const String& hostName, const IPv4Address& hostAddress)
+	Memory DnsPacket::buildHostAddressAnswerPacket(sl_uint16 id, const String& hostName, const IPv4Address& hostAddress, sl_uint32 TTL)
 	{
 		char buf[4096];
 		Base::zeroMemory(buf, sizeof(buf));
@@ -680,6 +683,7 @@ namespace slib
 			if (offset > 0) {
 				DnsResponseRecord recordResponse;
 				recordResponse.setName(hostName);
+				recordResponse.setTTL(TTL);
 				offset = recordResponse.buildRecord_A(buf, offset, 1024, hostAddress);
 				if (offset > 0) {
 					return Memory::create(buf, offset);
@@ -704,7 +708,7 @@ namespace slib
 			recordQuestion.setName(hostName);
 			recordQuestion.setType(DnsRecordType::A);
 			offset = recordQuestion.buildRecord(buf, offset, 1024);
-			if (offset == 0) {
+			if (offset > 0) {
 				return Memory::create(buf, offset);
 			}
 		}
@@ -713,6 +717,415 @@ namespace slib
 		
 	}
 
+/*************************************************************
+				DnsCache
+*************************************************************/
+
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(DnsCacheParam)
+	
+	DnsCacheParam::DnsCacheParam()
+	{
+		shardsCount = 0;
+		maximumEntriesCount = 65536;
+		minimumTTL = 0;
+		maximumTTL = 86400;
+		negativeTTL = 60;
+		prefetchPercent = 10;
+		prefetchHitsCount = 2;
+	}
+	
+	
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(DnsCacheStatistics)
+	
+	DnsCacheStatistics::DnsCacheStatistics()
+	{
+		countHits = 0;
+		countNegativeHits = 0;
+		countMisses = 0;
+		countPrefetches = 0;
+		countEvictions = 0;
+		countEntries = 0;
+	}
+	
+	
+	static sl_uint32 _priv_DnsCache_skipQuestions(const sl_uint8* message, sl_uint32 size)
+	{
+		DnsHeader* header = (DnsHeader*)message;
+		sl_uint32 offset = sizeof(DnsHeader);
+		sl_uint32 n = header->getQuestionsCount();
+		for (sl_uint32 i = 0; i < n; i++) {
+			DnsQuestionRecord record;
+			offset = record.parseRecord(message, offset, size);
+			if (offset == 0) {
+				return 0;
+			}
+		}
+		return offset;
+	}
+	
+	// smallest TTL of the answer records, or the TTL of SOA record in the authority section for the negative answers (RFC 2308)
+	static sl_bool _priv_DnsCache_getTTL(const sl_uint8* message, sl_uint32 size, sl_bool flagNegative, sl_uint32& outTTL)
+	{
+		DnsHeader* header = (DnsHeader*)message;
+		sl_uint32 offset = _priv_DnsCache_skipQuestions(message, size);
+		if (offset == 0) {
+			return sl_false;
+		}
+		sl_bool flagFound = sl_false;
+		sl_uint32 TTL = 0;
+		sl_uint32 nAnswers = header->getAnswersCount();
+		sl_uint32 n = nAnswers;
+		if (flagNegative) {
+			n += header->getAuthoritiesCount();
+		}
+		for (sl_uint32 i = 0; i < n; i++) {
+			DnsResponseRecord record;
+			offset = record.parseRecord(message, offset, size);
+			if (offset == 0) {
+				return sl_false;
+			}
+			if (flagNegative) {
+				if (i >= nAnswers && record.getType() == DnsRecordType::SOA && record.getDataLength() >= 22) {
+					// MINIMUM field is the last 32 bits of SOA data
+					sl_uint32 minimum = MIO::readUint32BE(message + record.getDataOffset() + record.getDataLength() - 4);
+					outTTL = Math::min(record.getTTL(), minimum);
+					return sl_true;
+				}
+			} else {
+				if ((sl_uint32)(record.getType()) != PRIV_RECORD_TYPE_OPT) {
+					if (!flagFound || record.getTTL() < TTL) {
+						TTL = record.getTTL();
+						flagFound = sl_true;
+					}
+				}
+			}
+		}
+		if (flagFound) {
+			outTTL = TTL;
+		}
+		return flagFound;
+	}
+	
+	
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(DnsCacheAnswer)
+	
+	DnsCacheAnswer::DnsCacheAnswer()
+	{
+		responseCode = DnsResponseCode::NoError;
+		TTL = 0;
+		elapsedSeconds = 0;
+		flagNegative = sl_false;
+		flagPrefetch = sl_false;
+	}
+	
+	Memory DnsCacheAnswer::buildMessage(sl_uint16 id) const
+	{
+		sl_uint32 size = (sl_uint32)(message.getSize());
+		if (size < sizeof(DnsHeader)) {
+			return sl_null;
+		}
+		Memory ret = Memory::create(message.getData(), size);
+		if (ret.isNull()) {
+			return sl_null;
+		}
+		sl_uint8* buf = (sl_uint8*)(ret.getData());
+		DnsHeader* header = (DnsHeader*)buf;
+		header->setId(id);
+		if (elapsedSeconds) {
+			sl_uint32 offset = _priv_DnsCache_skipQuestions(buf, size);
+			if (offset == 0) {
+				return ret;
+			}
+			sl_uint32 n = header->getAnswersCount() + header->getAuthoritiesCount() + header->getAdditionalsCount();
+			for (sl_uint32 i = 0; i < n; i++) {
+				DnsResponseRecord record;
+				offset = record.parseRecord(buf, offset, size);
+				if (offset == 0) {
+					break;
+				}
+				if ((sl_uint32)(record.getType()) != PRIV_RECORD_TYPE_OPT) {
+					sl_uint32 TTL = record.getTTL();
+					if (TTL > elapsedSeconds) {
+						TTL -= elapsedSeconds;
+					} else {
+						TTL = 0;
+					}
+					// TTL is followed by RDLENGTH
+					MIO::writeUint32BE(buf + record.getDataOffset() - 6, TTL);
+				}
+			}
+		}
+		return ret;
+	}
+	
+	
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(DnsCacheEntry)
+	
+	DnsCacheEntry::DnsCacheEntry()
+	{
+		responseCode = DnsResponseCode::NoError;
+		timeStored = 0;
+		timeExpire = 0;
+		TTL = 0;
+		countHits = 0;
+		flagNegative = sl_false;
+		flagPrefetched = sl_false;
+	}
+	
+	
+	DnsCacheShard::DnsCacheShard()
+	{
+	}
+	
+	
+	SLIB_DEFINE_OBJECT(DnsCache, Object)
+	
+	DnsCache::DnsCache()
+	{
+		m_shards = sl_null;
+		m_nShards = 0;
+		m_nMaxEntriesPerShard = 0;
+	}
+	
+	DnsCache::~DnsCache()
+	{
+		if (m_shards) {
+			NewHelper<DnsCacheShard>::free(m_shards, m_nShards);
+		}
+	}
+	
+	Ref<DnsCache> DnsCache::create(const DnsCacheParam& param)
+	{
+		sl_uint32 nShards = param.shardsCount;
+		if (!nShards) {
+			nShards = System::getProcessorsCount();
+			if (!nShards) {
+				nShards = 1;
+			}
+		}
+		DnsCacheShard* shards = NewHelper<DnsCacheShard>::create(nShards);
+		if (!shards) {
+			return sl_null;
+		}
+		Ref<DnsCache> ret = new DnsCache;
+		if (ret.isNull()) {
+			NewHelper<DnsCacheShard>::free(shards, nShards);
+			return sl_null;
+		}
+		ret->m_param = param;
+		ret->m_shards = shards;
+		ret->m_nShards = nShards;
+		sl_uint32 nMax = param.maximumEntriesCount / nShards;
+		if (!nMax) {
+			nMax = 1;
+		}
+		ret->m_nMaxEntriesPerShard = nMax;
+		return ret;
+	}
+	
+	Ref<DnsCache> DnsCache::create()
+	{
+		DnsCacheParam param;
+		return create(param);
+	}
+	
+	String DnsCache::getKey(const String& name, DnsRecordType type)
+	{
+		return name.toLower() + "#" + String::fromUint32((sl_uint32)type);
+	}
+	
+	DnsCacheShard* DnsCache::_getShard(const String& key)
+	{
+		// rehashed, so that the entries of a shard are still spread over the buckets of its map
+		return m_shards + (Rehash(Hash<String>()(key)) % m_nShards);
+	}
+	
+	sl_bool DnsCache::get(const String& name, DnsRecordType type, DnsCacheAnswer& _out)
+	{
+		String key = getKey(name, type);
+		DnsCacheShard* shard = _getShard(key);
+		sl_uint64 now = m_timeCounter.getElapsedMilliseconds();
+		MutexLocker lock(&(shard->lock));
+		HashMapNode<String, DnsCacheEntry>* node = shard->entries.find_NoLock(key);
+		if (!node) {
+			shard->statistics.countMisses++;
+			return sl_false;
+		}
+		DnsCacheEntry& entry = node->value;
+		if (now >= entry.timeExpire) {
+			shard->entries.removeAt(node);
+			shard->statistics.countMisses++;
+			return sl_false;
+		}
+		entry.countHits++;
+		_out.message = entry.message;
+		_out.packet = entry.packet;
+		_out.responseCode = entry.responseCode;
+		_out.TTL = (sl_uint32)((entry.timeExpire - now) / 1000);
+		_out.elapsedSeconds = (sl_uint32)((now - entry.timeStored) / 1000);
+		_out.flagNegative = entry.flagNegative;
+		_out.flagPrefetch = sl_false;
+		if (m_param.prefetchPercent && !(entry.flagPrefetched) && entry.countHits >= m_param.prefetchHitsCount) {
+			if ((entry.timeExpire - now) * 100 < (sl_uint64)(entry.TTL) * 1000 * m_param.prefetchPercent) {
+				entry.flagPrefetched = sl_true;
+				_out.flagPrefetch = sl_true;
+				shard->statistics.countPrefetches++;
+			}
+		}
+		shard->statistics.countHits++;
+		if (entry.flagNegative) {
+			shard->statistics.countNegativeHits++;
+		}
+		return sl_true;
+	}
+	
+	sl_bool DnsCache::put(const String& name, DnsRecordType type, const void* _message, sl_uint32 size, sl_uint32* outTTL)
+	{
+		if (size < sizeof(DnsHeader)) {
+			return sl_false;
+		}
+		const sl_uint8* message = (const sl_uint8*)_message;
+		DnsHeader* header = (DnsHeader*)message;
+		if (header->isQuestion() || header->isTC()) {
+			return sl_false;
+		}
+		DnsResponseCode code = header->getResponseCode();
+		sl_bool flagNegative;
+		if (code == DnsResponseCode::NameError) {
+			flagNegative = sl_true;
+		} else if (code == DnsResponseCode::NoError) {
+			flagNegative = header->getAnswersCount() == 0;
+		} else {
+			return sl_false;
+		}
+		sl_uint32 TTL;
+		if (_priv_DnsCache_getTTL(message, size, flagNegative, TTL)) {
+			if (TTL < m_param.minimumTTL) {
+				TTL = m_param.minimumTTL;
+			}
+			if (TTL > m_param.maximumTTL) {
+				TTL = m_param.maximumTTL;
+			}
+		} else {
+			if (!flagNegative) {
+				return sl_false;
+			}
+			TTL = m_param.negativeTTL;
+		}
+		if (!TTL) {
+			return sl_false;
+		}
+		DnsCacheEntry entry;
+		if (!(entry.packet.parsePacket(message, size))) {
+			return sl_false;
+		}
+		entry.message = Memory::create(message, size);
+		if (entry.message.isNull()) {
+			return sl_false;
+		}
+		sl_uint64 now = m_timeCounter.getElapsedMilliseconds();
+		entry.responseCode = code;
+		entry.timeStored = now;
+		entry.timeExpire = now + (sl_uint64)TTL * 1000;
+		entry.TTL = TTL;
+		entry.flagNegative = flagNegative;
+		
+		String key = getKey(name, type);
+		DnsCacheShard* shard = _getShard(key);
+		MutexLocker lock(&(shard->lock));
+		sl_bool flagInsert = sl_false;
+		if (!(shard->entries.put_NoLock(Move(key), Move(entry), &flagInsert))) {
+			return sl_false;
+		}
+		if (flagInsert && shard->entries.getCount() > m_nMaxEntriesPerShard) {
+			_evict(shard, now);
+		}
+		if (outTTL) {
+			*outTTL = TTL;
+		}
+		return sl_true;
+	}
+	
+	void DnsCache::remove(const String& name, DnsRecordType type)
+	{
+		String key = getKey(name, type);
+		DnsCacheShard* shard = _getShard(key);
+		MutexLocker lock(&(shard->lock));
+		shard->entries.remove_NoLock(key);
+	}
+	
+	void DnsCache::removeAll()
+	{
+		for (sl_uint32 i = 0; i < m_nShards; i++) {
+			DnsCacheShard* shard = m_shards + i;
+			MutexLocker lock(&(shard->lock));
+			shard->entries.removeAll_NoLock();
+		}
+	}
+	
+	void DnsCache::getStatistics(DnsCacheStatistics& _out)
+	{
+		DnsCacheStatistics ret;
+		for (sl_uint32 i = 0; i < m_nShards; i++) {
+			DnsCacheShard* shard = m_shards + i;
+			MutexLocker lock(&(shard->lock));
+			DnsCacheStatistics& s = shard->statistics;
+			ret.countHits += s.countHits;
+			ret.countNegativeHits += s.countNegativeHits;
+			ret.countMisses += s.countMisses;
+			ret.countPrefetches += s.countPrefetches;
+			ret.countEvictions += s.countEvictions;
+			ret.countEntries += shard->entries.getCount();
+		}
+		_out = ret;
+	}
+	
+	/*
+		Removes the expired entries, and then the entries expiring first
+		until 7/8 of the capacity is left, so that a full shard is scanned
+		once per `capacity / 8` insertions.
+	*/
+	void DnsCache::_evict(DnsCacheShard* shard, sl_uint64 now)
+	{
+		typedef HashMapNode<String, DnsCacheEntry> NODE;
+		CHashMap<String, DnsCacheEntry>& entries = shard->entries;
+		NODE* node = entries.getFirstNode();
+		while (node) {
+			NODE* next = node->getNext();
+			if (now >= node->value.timeExpire) {
+				entries.removeAt(node);
+			}
+			node = next;
+		}
+		sl_size nLimit = m_nMaxEntriesPerShard - m_nMaxEntriesPerShard / 8;
+		sl_size n = entries.getCount();
+		if (n <= nLimit) {
+			return;
+		}
+		sl_uint64* expires = NewHelper<sl_uint64>::create(n);
+		if (!expires) {
+			return;
+		}
+		sl_size k = 0;
+		node = entries.getFirstNode();
+		while (node && k < n) {
+			expires[k++] = node->value.timeExpire;
+			node = node->getNext();
+		}
+		QuickSort::sortAsc(expires, k);
+		sl_uint64 threshold = expires[n - nLimit - 1];
+		NewHelper<sl_uint64>::free(expires, n);
+		node = entries.getFirstNode();
+		while (node && entries.getCount() > nLimit) {
+			NODE* next = node->getNext();
+			if (node->value.timeExpire <= threshold) {
+				entries.removeAt(node);
+				shard->statistics.countEvictions++;
+			}
+			node = next;
+		}
+	}
+
 /*************************************************************
 				DnsClient
 *************************************************************/
@@ -721,6 +1134,7 @@ namespace slib
 	
 	DnsClientParam::DnsClientParam()
 	{
+		questionTimeout = 5000;
 	}
 
 	
@@ -729,6 +1143,7 @@ namespace slib
 	DnsClient::DnsClient()
 	{
 		m_idLast = 0;
+		m_questionTimeout = 5000;
 	}
 
 	DnsClient::~DnsClient()
@@ -740,6 +1155,8 @@ namespace slib
 		Ref<DnsClient> ret = new DnsClient;
 		if (ret.isNotNull()) {
 			ret->m_onAnswer = param.onAnswer;
+			ret->m_cache = param.cache;
+			ret->m_questionTimeout = param.questionTimeout;
 			AsyncUdpSocketParam up;
 			up.onReceiveFrom = SLIB_FUNCTION_WEAKREF(DnsClient, _onReceiveFrom, ret);
 			up.packetSize = 4096;
@@ -754,11 +1171,21 @@ namespace slib
 
 	void DnsClient::sendQuestion(const SocketAddress& serverAddress, const String& hostName)
 	{
-		sl_uint16 id = m_idLast++;
-		Memory mem = DnsPacket::buildQuestionPacket(id, hostName);
-		if (mem.isNotNull()) {
-			m_udp->sendTo(serverAddress, mem);
+		if (m_cache.isNotNull()) {
+			DnsCacheAnswer answer;
+			if (m_cache->get(hostName, DnsRecordType::A, answer)) {
+				if (answer.flagPrefetch) {
+					_sendQuestion(serverAddress, hostName, sl_true);
+				}
+				// delivered from the I/O loop as the answers from the server
+				Ref<AsyncIoLoop> loop = m_udp->getIoLoop();
+				if (loop.isNotNull()) {
+					loop->addTask(SLIB_BIND_WEAKREF(void(), DnsClient, _onAnswer, this, serverAddress, answer.packet));
+				}
+				return;
+			}
 		}
+		_sendQuestion(serverAddress, hostName, sl_false);
 	}
 
 	void DnsClient::sendQuestion(const IPv4Address& serverIp, const String& hostName)
@@ -766,10 +1193,65 @@ namespace slib
 		sendQuestion(SocketAddress(serverIp, SLIB_NETWORK_DNS_PORT), hostName);
 	}
 
+	Ref<DnsCache> DnsClient::getCache()
+	{
+		return m_cache;
+	}
+
+	void DnsClient::_sendQuestion(const SocketAddress& serverAddress, const String& hostName, sl_bool flagPrefetch)
+	{
+		String key = serverAddress.toString() + "/" + hostName.toLower();
+		sl_uint32 now = System::getTickCount();
+		sl_uint16 id;
+		{
+			MutexLocker lock(&m_lockQuestions);
+			PendingQuestion* pending = m_mapQuestions.getItemPointer(key);
+			if (pending) {
+				if (now - pending->timeStart < m_questionTimeout) {
+					if (!flagPrefetch) {
+						pending->flagPrefetch = sl_false;
+					}
+					return;
+				}
+			}
+			id = m_idLast++;
+			PendingQuestion question;
+			question.id = id;
+			question.timeStart = now;
+			question.flagPrefetch = flagPrefetch;
+			m_mapQuestions.put_NoLock(key, question);
+		}
+		Memory mem = DnsPacket::buildQuestionPacket(id, hostName);
+		if (mem.isNotNull()) {
+			m_udp->sendTo(serverAddress, mem);
+		}
+	}
+
 	void DnsClient::_onReceiveFrom(AsyncUdpSocket* socket, const SocketAddress& address, void* data, sl_uint32 sizeReceive)
 	{
 		DnsPacket packet;
 		if (packet.parsePacket(data, sizeReceive)) {
+			if (packet.questions.getCount() == 1) {
+				DnsPacket::Question& question = (packet.questions.getData())[0];
+				String key = address.toString() + "/" + question.name.toLower();
+				sl_bool flagPending = sl_false;
+				sl_bool flagPrefetch = sl_false;
+				{
+					MutexLocker lock(&m_lockQuestions);
+					PendingQuestion* pending = m_mapQuestions.getItemPointer(key);
+					if (pending && pending->id == packet.id) {
+						flagPending = sl_true;
+						flagPrefetch = pending->flagPrefetch;
+						m_mapQuestions.remove_NoLock(key);
+					}
+				}
+				if (flagPending && m_cache.isNotNull()) {
+					m_cache->put(question.name, question.type, data, sizeReceive);
+				}
+				if (flagPrefetch) {
+					return;
+				}
+			}
 			_onAnswer(address, packet);
 		}
 	}
@@ -809,6 +1291,10 @@ namespace slib
 		flagEncryptDefaultForward = sl_false;
 
 		flagAutoStart = sl_true;
+
+		flagCache = sl_true;
+
+		forwardTimeout = 5000;
 	}
 
 	void DnsServerParam::parse(const Json& conf)
@@ -822,6 +1308,11 @@ namespace slib
 		IPv4Address defaultForwardAddressIp = IPv4Address(8, 8, 4, 4);
 		defaultForwardAddressIp.parse(conf.getItem("forward_dns").getString());
 		defaultForwardAddress = SocketAddress(defaultForwardAddressIp, SLIB_NETWORK_DNS_PORT);
+
+		flagCache = conf.getItem("cache").getBoolean(sl_true);
+		cacheParam.maximumEntriesCount = conf.getItem("cache_size").getUint32(cacheParam.maximumEntriesCount);
+		cacheParam.minimumTTL = conf.getItem("cache_min_ttl").getUint32(cacheParam.minimumTTL);
+		cacheParam.maximumTTL = conf.getItem("cache_max_ttl").getUint32(cacheParam.maximumTTL);
 	}
 
 
@@ -833,6 +1324,7 @@ namespace slib
 		m_flagRunning = sl_false;
 
 		m_lastForwardId = 0;
+		m_forwardTimeout = 5000;
 
 		m_flagEncryptDefaultForward = sl_false;
 		m_flagProxy = sl_false;
@@ -852,8 +1344,9 @@ namespace slib
 		if (ret.isNotNull()) {
 
 			AsyncUdpSocketParam up;
-			up.onReceiveFrom = SLIB_FUNCTION_WEAKREF(DnsServer, _onReceiveFrom, ret);
+			up.onReceiveBatch = SLIB_FUNCTION_WEAKREF(DnsServer, _onReceiveBatch, ret);
 			up.packetSize = 4096;
+			up.receiveBatchCount = 64;
 			up.ioLoop = param.ioLoop;
 			up.flagAutoStart = sl_false;
 			
@@ -883,6 +1376,14 @@ namespace slib
 				ret->m_defaultForwardAddress = param.defaultForwardAddress;
 				ret->m_flagEncryptDefaultForward = param.flagEncryptDefaultForward;
 
+				if (param.flagCache) {
+					ret->m_cache = param.cache;
+					if (ret->m_cache.isNull()) {
+						ret->m_cache = DnsCache::create(param.cacheParam);
+					}
+				}
+				ret->m_forwardTimeout = param.forwardTimeout;
+
 				ret->m_onResolve = param.onResolve;
 				ret->m_onCache = param.onCache;
 
@@ -938,6 +1439,11 @@ namespace slib
 		return m_flagRunning;
 	}
 
+	Ref<DnsCache> DnsServer::getCache()
+	{
+		return m_cache;
+	}
+
 	void DnsServer::_processReceivedDnsQuestion(const SocketAddress& clientAddress, sl_uint16 id, const String& hostName, sl_bool flagEncryptedRequest)
 	{
 		if (hostName.indexOf('.') < 0) {
@@ -956,158 +1462,264 @@ namespace slib
 			_sendPacket(flagEncryptedRequest, clientAddress, _buildHostAddressAnswerPacket(id, hostName, rp.hostAddress, flagEncryptedRequest));
 			return;
 		}
+		// the question is still forwarded after answering from the resolver, to notify the resolved addresses
+		sl_bool flagAnswered = sl_false;
 		if (rp.hostAddress.isNotZero()) {
 			_sendPacket(flagEncryptedRequest, clientAddress, _buildHostAddressAnswerPacket(id, hostName, rp.hostAddress, flagEncryptedRequest));
+			flagAnswered = sl_true;
 		}
-		
-		// forward DNS request
-		{
-			sl_uint16 idForward = m_lastForwardId++;
-			ForwardElement fe;
-			fe.requestedId = id;
-			fe.requestedHostName = hostName;
-			fe.flagEncrypted = flagEncryptedRequest;
-			if (rp.hostAddress.isNotZero()) {
-				fe.clientAddress.ip.setNone();
-				fe.clientAddress.port = 0;
-			} else {
-				fe.clientAddress = clientAddress;
+		if (m_cache.isNotNull()) {
+			DnsCacheAnswer answer;
+			if (m_cache->get(hostName, DnsRecordType::A, answer)) {
+				if (!flagAnswered) {
+					IPv4Address address;
+					if (answer.flagNegative) {
+						address.setZero();
+					} else {
+						address = _resolveAnswer(answer.packet, hostName, sl_false);
+					}
+					_sendPacket(flagEncryptedRequest, clientAddress, _buildHostAddressAnswerPacket(id, hostName, address, flagEncryptedRequest, answer.TTL));
+				}
+				if (!(answer.flagPrefetch)) {
+					return;
+				}
+				flagAnswered = sl_true;
 			}
-			m_mapForward.put(idForward, fe);
-			_sendPacket(rp.flagEncryptForward, rp.forwardAddress, _buildQuestionPacket(idForward, hostName, rp.flagEncryptForward));
 		}
-
+		if (flagAnswered) {
+			_forwardQuestion(hostName, DnsRecordType::A, sl_null, rp.forwardAddress, rp.flagEncryptForward, sl_null, 0);
+		} else {
+			ForwardClient client;
+			client.clientAddress = clientAddress;
+			client.requestedId = id;
+			client.flagEncrypted = flagEncryptedRequest;
+			_forwardQuestion(hostName, DnsRecordType::A, &client, rp.forwardAddress, rp.flagEncryptForward, sl_null, 0);
+		}
 	}
 
-	void DnsServer::_processReceivedDnsAnswer(const DnsPacket& packet)
+	void DnsServer::_processReceivedDnsAnswer(const DnsPacket& packet, const void* data, sl_uint32 size)
 	{
-
-		sl_uint16 idForward = packet.id;
-
 		ForwardElement fe;
-		if (m_mapForward.get(idForward, &fe)) {
-
-			m_mapForward.remove(idForward);
+		if (!(_takeForward(packet.id, fe))) {
+			return;
+		}
+		sl_uint32 TTL = 0;
+		if (m_cache.isNotNull()) {
+			m_cache->put(fe.requestedHostName, fe.requestedType, data, size, &TTL);
+		}
+		IPv4Address resolvedAddress = _resolveAnswer(packet, fe.requestedHostName, sl_true);
+		ListElements<ForwardClient> clients(fe.clients);
+		for (sl_size i = 0; i < clients.count; i++) {
+			ForwardClient& client = clients[i];
+			_sendPacket(client.flagEncrypted, client.clientAddress, _buildHostAddressAnswerPacket(client.requestedId, fe.requestedHostName, resolvedAddress, client.flagEncrypted, TTL));
+		}
+	}
 
-			String reqNameLower = fe.requestedHostName.toLower();
+	IPv4Address DnsServer::_resolveAnswer(const DnsPacket& packet, const String& hostName, sl_bool flagNotifyCache)
+	{
+		String reqNameLower = hostName.toLower();
 
-			IPv4Address resolvedAddress;
-			resolvedAddress.setZero();
+		IPv4Address resolvedAddress;
+		resolvedAddress.setZero();
 
-			CHashMap<String, IPv4Address> aliasAddresses4;
-			CHashMap<String, IPv6Address> aliasAddresses6;
-			// address
-			{
-				ListElements<DnsPacket::Address> addresses(packet.addresses);
-				sl_size n = addresses.count;
-				for (sl_size i = 0; i < n; i++) {
-					DnsPacket::Address& address = addresses[n - 1 - i];
-					if (address.address.isNotNone()) {
-						if (address.address.isIPv4() && address.address.getIPv4().isHost()) {
+		CHashMap<String, IPv4Address> aliasAddresses4;
+		CHashMap<String, IPv6Address> aliasAddresses6;
+		// address
+		{
+			ListElements<DnsPacket::Address> addresses(packet.addresses);
+			sl_size n = addresses.count;
+			for (sl_size i = 0; i < n; i++) {
+				DnsPacket::Address& address = addresses[n - 1 - i];
+				if (address.address.isNotNone()) {
+					if (address.address.isIPv4() && address.address.getIPv4().isHost()) {
+						if (flagNotifyCache) {
 							_onCache(address.name, address.address);
-							aliasAddresses4.put_NoLock(address.name.toLower(), address.address.getIPv4());
-						} else if (address.address.isIPv6()) {
+						}
+						aliasAddresses4.put_NoLock(address.name.toLower(), address.address.getIPv4());
+					} else if (address.address.isIPv6()) {
+						if (flagNotifyCache) {
 							_onCache(address.name, address.address);
-							aliasAddresses6.put_NoLock(address.name.toLower(), address.address.getIPv6());
 						}
-						if (reqNameLower == address.name.toLower()) {
-							if (resolvedAddress.isZero()) {
-								resolvedAddress = address.address.getIPv4();
-							}
+						aliasAddresses6.put_NoLock(address.name.toLower(), address.address.getIPv6());
+					}
+					if (reqNameLower == address.name.toLower()) {
+						if (resolvedAddress.isZero()) {
+							resolvedAddress = address.address.getIPv4();
 						}
 					}
 				}
 			}
-			// alias
-			{
-				List<DnsPacket::Alias> aliasesProcess = packet.aliases.duplicate_NoLock();
-				sl_bool flagProcess = sl_true;
-				while (flagProcess) {
-					flagProcess = sl_false;
-					List<DnsPacket::Alias> aliasesNoProcess;
-					ListElements<DnsPacket::Alias> aliases(aliasesProcess);
-					sl_size n = aliases.count;
-					for (sl_size i = 0; i < n; i++) {
-						DnsPacket::Alias& alias = aliases[n - 1 - i];
-						IPv4Address addr4;
-						IPv6Address addr6;
-						sl_bool flagAddr = sl_false;
-						if (aliasAddresses4.get_NoLock(alias.alias.toLower(), &addr4)) {
-							aliasAddresses4.put_NoLock(alias.name.toLower(), addr4);
+		}
+		// alias
+		{
+			List<DnsPacket::Alias> aliasesProcess = packet.aliases.duplicate_NoLock();
+			sl_bool flagProcess = sl_true;
+			while (flagProcess) {
+				flagProcess = sl_false;
+				List<DnsPacket::Alias> aliasesNoProcess;
+				ListElements<DnsPacket::Alias> aliases(aliasesProcess);
+				sl_size n = aliases.count;
+				for (sl_size i = 0; i < n; i++) {
+					DnsPacket::Alias& alias = aliases[n - 1 - i];
+					IPv4Address addr4;
+					IPv6Address addr6;
+					sl_bool flagAddr = sl_false;
+					if (aliasAddresses4.get_NoLock(alias.alias.toLower(), &addr4)) {
+						aliasAddresses4.put_NoLock(alias.name.toLower(), addr4);
+						if (flagNotifyCache) {
 							_onCache(alias.name, addr4);
-							if (reqNameLower == alias.name.toLower()) {
-								if (resolvedAddress.isZero()) {
-									resolvedAddress = addr4;
-								}
+						}
+						if (reqNameLower == alias.name.toLower()) {
+							if (resolvedAddress.isZero()) {
+								resolvedAddress = addr4;
 							}
-							flagProcess = sl_true;
-							flagAddr = sl_true;
 						}
-						if (aliasAddresses6.get_NoLock(alias.alias.toLower(), &addr6)) {
-							aliasAddresses6.put_NoLock(alias.name.toLower(), addr6);
+						flagProcess = sl_true;
+						flagAddr = sl_true;
+					}
+					if (aliasAddresses6.get_NoLock(alias.alias.toLower(), &addr6)) {
+						aliasAddresses6.put_NoLock(alias.name.toLower(), addr6);
+						if (flagNotifyCache) {
 							_onCache(alias.name, addr6);
-							flagProcess = sl_true;
-							flagAddr = sl_true;
-						}
-						if (!flagAddr) {
-							aliasesNoProcess.add_NoLock(alias);
 						}
+						flagProcess = sl_true;
+						flagAddr = sl_true;
+					}
+					if (!flagAddr) {
+						aliasesNoProcess.add_NoLock(alias);
 					}
-					aliasesProcess = aliasesNoProcess;
 				}
-			}
-			if (fe.clientAddress.isValid()) {
-				_sendPacket(fe.flagEncrypted, fe.clientAddress, _buildHostAddressAnswerPacket(fe.requestedId, fe.requestedHostName, resolvedAddress, fe.flagEncrypted));
+				aliasesProcess = aliasesNoProcess;
 			}
 		}
+		return resolvedAddress;
 	}
 
 	void DnsServer::_processReceivedProxyQuestion(const SocketAddress& clientAddress, void* data, sl_uint32 size, sl_bool flagEncryptedRequest)
 	{
 		DnsHeader* header = (DnsHeader*)data;
 
-		sl_uint16 idForward = m_lastForwardId++;
+		ForwardClient client;
+		client.clientAddress = clientAddress;
+		client.requestedId = header->getId();
+		client.flagEncrypted = flagEncryptedRequest;
 
-		ForwardElement fe;
-		fe.requestedId = header->getId();
-		fe.flagEncrypted = flagEncryptedRequest;
-		fe.clientAddress = clientAddress;
-
-		header->setId(idForward);
-		Memory packet = Memory::create(data, size);
-		if (m_flagEncryptDefaultForward) {
-			packet = m_encrypt.encrypt_CBC_PKCS7Padding(packet);
-		}
-		if (packet.isNull()) {
+		// only the standard queries having single question are cached and coalesced
+		DnsQuestionRecord question;
+		if (header->getOpcode() != DnsOpcode::Query || header->getQuestionsCount() != 1 || !(question.parseRecord(data, sizeof(DnsHeader), size))) {
+			_forwardQuestion(String::null(), DnsRecordType::A, &client, m_defaultForwardAddress, m_flagEncryptDefaultForward, data, size);
 			return;
 		}
 
-		m_mapForward.put(idForward, fe);
-
-		_sendPacket(m_flagEncryptDefaultForward, m_defaultForwardAddress, packet);
+		if (m_cache.isNotNull()) {
+			DnsCacheAnswer answer;
+			if (m_cache->get(question.getName(), question.getType(), answer)) {
+				Memory packet = answer.buildMessage(client.requestedId);
+				if (flagEncryptedRequest) {
+					packet = m_encrypt.encrypt_CBC_PKCS7Padding(packet);
+				}
+				_sendPacket(flagEncryptedRequest, clientAddress, packet);
+				if (answer.flagPrefetch) {
+					_forwardQuestion(question.getName(), question.getType(), sl_null, m_defaultForwardAddress, m_flagEncryptDefaultForward, data, size);
+				}
+				return;
+			}
+		}
 
+		_forwardQuestion(question.getName(), question.getType(), &client, m_defaultForwardAddress, m_flagEncryptDefaultForward, data, size);
 	}
 
 	void DnsServer::_processReceivedProxyAnswer(void* data, sl_uint32 size)
 	{
 		DnsHeader* header = (DnsHeader*)data;
-		sl_uint16 idForward = header->getId();
 		ForwardElement fe;
-		if (m_mapForward.get(idForward, &fe)) {
-
-			m_mapForward.remove(idForward);
-
-			header->setId(fe.requestedId);
+		if (!(_takeForward(header->getId(), fe))) {
+			return;
+		}
+		if (m_cache.isNotNull() && fe.key.isNotEmpty()) {
+			m_cache->put(fe.requestedHostName, fe.requestedType, data, size);
+		}
+		ListElements<ForwardClient> clients(fe.clients);
+		for (sl_size i = 0; i < clients.count; i++) {
+			ForwardClient& client = clients[i];
+			header->setId(client.requestedId);
 			Memory packet = Memory::create(data, size);
-			if (fe.flagEncrypted) {
+			if (client.flagEncrypted) {
 				packet = m_encrypt.encrypt_CBC_PKCS7Padding(packet);
 			}
+			_sendPacket(client.flagEncrypted, client.clientAddress, packet);
+		}
+	}
+
+	void DnsServer::_forwardQuestion(const String& hostName, DnsRecordType type, const ForwardClient* client, const SocketAddress& forwardAddress, sl_bool flagEncryptForward, const void* message, sl_uint32 size)
+	{
+		String key;
+		if (hostName.isNotEmpty()) {
+			key = DnsCache::getKey(hostName, type) + "@" + forwardAddress.toString();
+		}
+		sl_uint32 now = System::getTickCount();
+		sl_uint16 idForward;
+		{
+			MutexLocker lock(&m_lockForward);
+			if (key.isNotEmpty()) {
+				if (m_mapForwardQuestions.get_NoLock(key, &idForward)) {
+					HashMapNode<sl_uint16, ForwardElement>* node = m_mapForward.find_NoLock(idForward);
+					if (node) {
+						ForwardElement& fe = node->value;
+						if (now - fe.timeStart < m_forwardTimeout) {
+							if (client) {
+								fe.clients.add_NoLock(*client);
+							}
+							return;
+						}
+						// no answer from the upstream server, forwarded again
+						m_mapForward.removeAt(node);
+					}
+				}
+			}
+			idForward = m_lastForwardId++;
+			ForwardElement fe;
+			fe.requestedHostName = hostName;
+			fe.requestedType = type;
+			fe.key = key;
+			if (client) {
+				fe.clients.add_NoLock(*client);
+			}
+			fe.timeStart = now;
+			m_mapForward.put_NoLock(idForward, Move(fe));
+			if (key.isNotEmpty()) {
+				m_mapForwardQuestions.put_NoLock(key, idForward);
+			}
+		}
+		Memory packet;
+		if (message) {
+			packet = Memory::create(message, size);
 			if (packet.isNull()) {
 				return;
 			}
+			((DnsHeader*)(packet.getData()))->setId(idForward);
+			if (flagEncryptForward) {
+				packet = m_encrypt.encrypt_CBC_PKCS7Padding(packet);
+			}
+		} else {
+			packet = _buildQuestionPacket(idForward, hostName, flagEncryptForward);
+		}
+		_sendPacket(flagEncryptForward, forwardAddress, packet);
+	}
 
-			_sendPacket(fe.flagEncrypted, fe.clientAddress, packet);
+	sl_bool DnsServer::_takeForward(sl_uint16 idForward, ForwardElement& _out)
+	{
+		MutexLocker lock(&m_lockForward);
+		if (m_mapForward.remove_NoLock(idForward, &_out)) {
+			if (_out.key.isNotEmpty()) {
+				sl_uint16 id;
+				if (m_mapForwardQuestions.get_NoLock(_out.key, &id) && id == idForward) {
+					m_mapForwardQuestions.remove_NoLock(_out.key);
+				}
+			}
+			return sl_true;
 		}
+		return sl_false;
 	}
 
 	void DnsServer::_sendPacket(sl_bool flagEncrypted, const SocketAddress& targetAddress, const Memory& packet)
@@ -1134,9 +1746,9 @@ namespace slib
 		return mem;
 	}
 
-	Memory DnsServer::_buildHostAddressAnswerPacket(sl_uint16 id, const String& hostName, const IPv4Address& hostAddress, sl_bool flagEncrypt)
+	Memory DnsServer::_buildHostAddressAnswerPacket(sl_uint16 id, const String& hostName, const IPv4Address& hostAddress, sl_bool flagEncrypt, sl_uint32 TTL)
 	{
-		Memory mem = DnsPacket::buildHostAddressAnswerPacket(id, hostName, hostAddress);
+		Memory mem = DnsPacket::buildHostAddressAnswerPacket(id, hostName, hostAddress, TTL);
 		if (flagEncrypt) {
 			return m_encrypt.encrypt_CBC_PKCS7Padding(mem);
 		}
@@ -1178,12 +1790,20 @@ namespace slib
 						}
 					}
 				} else {
-					_processReceivedDnsAnswer(packet);
+					_processReceivedDnsAnswer(packet, buf, size);
 				}
 			}
 		}
 	}
 
+	void DnsServer::_onReceiveBatch(AsyncUdpSocket* socket, SocketDatagram* datagrams, sl_uint32 count)
+	{
+		// the answers are queued, and sent together by the I/O loop after this batch
+		for (sl_uint32 i = 0; i < count; i++) {
+			_onReceiveFrom(socket, datagrams[i].address, datagrams[i].data, datagrams[i].size);
+		}
+	}
+
 	void DnsServer::_onResolve(DnsResolveHostParam& param)
 	{
 		m_onResolve(this, param);
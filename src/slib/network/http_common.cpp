@@ -181,6 +181,8 @@ namespace slib
 	DEFINE_HTTP_HEADER(AcceptRanges, "Accept-Ranges")
 	DEFINE_HTTP_HEADER(ContentRange, "Content-Range")
 	DEFINE_HTTP_HEADER(LastModified, "Last-Modified")
+	DEFINE_HTTP_HEADER(Vary, "Vary")
+	DEFINE_HTTP_HEADER(Age, "Age")
 
 	sl_reg HttpHeaders::parseHeaders(HttpHeaderMap& map, const void* _data, sl_size size)
 	{
@@ -2024,9 +2026,8 @@ namespace slib
 		if (posCurrent == size) {
 			return 0;
 		}
-		String strResponseCode = String::fromUtf8(data + posStart, posCurrent - posStart);
 		sl_uint32 code;
-		if (!(strResponseCode.parseUint32(10, &code))) {
+		if (!(StringView(data + posStart, posCurrent - posStart).parseUint32(10, &code))) {
 			return -1;
 		}
 		m_responseCode = (HttpStatus)code;
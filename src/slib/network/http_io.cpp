@@ -76,6 +76,11 @@ namespace slib
 		return m_bufferOutput.getOutputLength();
 	}
 
+	sl_bool HttpOutputBuffer::mergeOutput(Memory& _out) const
+	{
+		return m_bufferOutput.mergeOutput(_out);
+	}
+
 /***********************************************************************
 						HttpHeaderReader
 ***********************************************************************/
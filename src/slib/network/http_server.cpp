@@ -29,6 +29,10 @@
 #include "slib/core/log.h"
 #include "slib/core/json.h"
 #include "slib/core/content_type.h"
+#include "slib/core/string_buffer.h"
+#include "slib/core/new_helper.h"
+#include "slib/core/sort.h"
+#include "slib/crypto/zlib.h"
 
 #define SERVER_TAG "HTTP SERVER"
 
@@ -192,6 +196,7 @@ namespace slib
 		m_flagClosed = sl_true;
 		m_flagReading = sl_false;
 		m_flagKeepAlive = sl_true;
+		m_flagWritingResponse = sl_false;
 	}
 
 	HttpServerConnection::~HttpServerConnection()
@@ -202,23 +207,21 @@ namespace slib
 	Ref<HttpServerConnection> HttpServerConnection::create(HttpServer* server, AsyncStream* io)
 	{
 		if (server && io) {
-			Memory bufRead = Memory::create(SIZE_READ_BUF);
-			if (bufRead.isNotNull()) {
-				Ref<HttpServerConnection> ret = new HttpServerConnection;
-				if (ret.isNotNull()) {
-					AsyncOutputParam op;
-					op.stream = io;
-					op.onEnd = SLIB_FUNCTION_WEAKREF(HttpServerConnection, onAsyncOutputEnd, ret);
-					op.bufferSize = SIZE_COPY_BUF;
-					Ref<AsyncOutput> output = AsyncOutput::create(op);
-					if (output.isNotNull()) {
-						ret->m_server = server;
-						ret->m_io = io;
-						ret->m_output = output;
-						ret->m_bufRead = bufRead;
-						ret->m_flagClosed = sl_false;
-						return ret;
-					}
+			Ref<HttpServerConnection> ret = new HttpServerConnection;
+			if (ret.isNotNull()) {
+				AsyncOutputParam op;
+				op.stream = io;
+				op.onEnd = SLIB_FUNCTION_WEAKREF(HttpServerConnection, onAsyncOutputEnd, ret);
+				op.bufferSize = SIZE_COPY_BUF;
+				Ref<AsyncOutput> output = AsyncOutput::create(op);
+				if (output.isNotNull()) {
+					ret->m_server = server;
+					ret->m_io = io;
+					ret->m_output = output;
+					ret->m_callbackRead = SLIB_FUNCTION_WEAKREF(HttpServerConnection, onReadStream, ret);
+					ret->m_flagClosed = sl_false;
+					ret->m_entryTimeout.callback = SLIB_FUNCTION_WEAKREF(HttpServerConnection, _onTimeout, ret);
+					return ret;
 				}
 			}
 		}
@@ -233,6 +236,8 @@ namespace slib
 		}
 		m_flagClosed = sl_true;
 		
+		_setTimeout(0);
+		
 		Ref<HttpServer> server = m_server;
 		if (server.isNotNull()) {
 			server->closeConnection(this);
@@ -247,6 +252,10 @@ namespace slib
 		if (data && size > 0) {
 			_processInput(data, size);
 		} else {
+			Ref<HttpServer> server = m_server;
+			if (server.isNotNull()) {
+				_setTimeout(server->getParam().idleTimeout);
+			}
 			_read();
 		}
 	}
@@ -276,7 +285,8 @@ namespace slib
 			return;
 		}
 		m_flagReading = sl_true;
-		if (!(m_io->readToMemory(m_bufRead, SLIB_FUNCTION_WEAKREF(HttpServerConnection, onReadStream, this)))) {
+		// the read buffer is borrowed from the shared pool only while the input is processed
+		if (!(m_io->readPooled(SIZE_READ_BUF, m_callbackRead))) {
 			m_flagReading = sl_false;
 			close();
 		}
@@ -306,6 +316,7 @@ namespace slib
 			}
 			m_contextCurrent = _context;
 			_context->setProcessingByThread(param.flagProcessByThreads);
+			_setTimeout(param.requestHeaderTimeout);
 		}
 		HttpServerContext* context = _context.get();
 		if (context->m_requestHeader.isNull()) {
@@ -339,6 +350,7 @@ namespace slib
 				}
 				context->applyQueryToParameters();
 				if (server->preprocessRequest(context)) {
+					_setTimeout(0);
 					return;
 				}
 			} else {
@@ -359,6 +371,7 @@ namespace slib
 			if (context->m_requestBodyBuffer.getSize() >= context->m_requestContentLength) {
 
 				m_contextCurrent.setNull();
+				_setTimeout(0);
 
 				context->m_requestBody = context->m_requestBodyBuffer.merge();
 				if (context->m_requestContentLength > 0 && context->m_requestBody.isNull()) {
@@ -391,6 +404,8 @@ namespace slib
 				}
 				return;
 			}
+			
+			_setTimeout(param.requestBodyTimeout);
 		}
 		_read();
 	}
@@ -433,6 +448,7 @@ namespace slib
 			return;
 		}
 		m_output->mergeBuffer(&(context->m_bufferOutput));
+		m_flagWritingResponse = sl_true;
 		if (context->isKeepAlive()) {
 			m_output->startWriting();
 			start();
@@ -453,10 +469,61 @@ namespace slib
 		}
 	}
 
+	void HttpServerConnection::_setTimeout(sl_uint32 timeout)
+	{
+		Ref<HttpServer> server = m_server;
+		if (server.isNull()) {
+			return;
+		}
+		Ref<AsyncIoLoop> loop = server->getAsyncIoLoop();
+		if (loop.isNull()) {
+			return;
+		}
+		if (timeout) {
+			loop->addTimeout(&m_entryTimeout, timeout);
+		} else {
+			loop->removeTimeout(&m_entryTimeout);
+		}
+	}
+
+	void HttpServerConnection::_onTimeout()
+	{
+		ObjectLocker lock(this);
+		if (m_flagClosed) {
+			return;
+		}
+		if (m_entryTimeout.isScheduled()) {
+			// rescheduled while expiring
+			return;
+		}
+		Ref<HttpServer> server = m_server;
+		if (server.isNull()) {
+			return;
+		}
+		const HttpServerParam& param = server->getParam();
+		if (m_flagWritingResponse && m_contextCurrent.isNull()) {
+			// idle time is counted after the response is sent
+			_setTimeout(param.idleTimeout);
+			return;
+		}
+		if (param.flagLogDebug) {
+			Log(SERVER_TAG, "[%s] Connection Timeout", String::fromPointerValue(this));
+		}
+		close();
+	}
+
 	void HttpServerConnection::onAsyncOutputEnd(AsyncOutput* output, sl_bool flagError)
 	{
+		m_flagWritingResponse = sl_false;
 		if (flagError || !m_flagKeepAlive) {
 			close();
+			return;
+		}
+		if (m_contextCurrent.isNull()) {
+			Ref<HttpServer> server = m_server;
+			if (server.isNotNull()) {
+				_setTimeout(server->getParam().idleTimeout);
+			}
 		}
 	}
 
@@ -702,7 +769,7 @@ namespace slib
 		return route->createRoute(subPath);
 	}
 	
-	HttpServerRoute* HttpServerRoute::getRoute(const String& path, HashMap<String, String>& parameters)
+	HttpServerRoute* HttpServerRoute::getRoute(const StringView& path, HashMap<String, String>& parameters)
 	{
 		sl_reg indexStart = 0;
 		if (path.startsWith('/')) {
@@ -712,15 +779,15 @@ namespace slib
 			return this;
 		}
 		sl_reg indexSubpath = path.indexOf('/', indexStart);
-		String name;
-		String subPath;
+		StringView name;
+		StringView subPath;
 		if (indexSubpath < 0) {
 			name = path.substring(indexStart);
 		} else {
 			name = path.substring(indexStart, indexSubpath);
 			subPath = path.substring(indexSubpath);
 		}
-		HttpServerRoute* route = routes.getItemPointer(name);
+		HttpServerRoute* route = routes.getItemPointerByKey(name);
 		if (route) {
 			HashMap<String, String> subParams;
 			route = route->getRoute(subPath, subParams);
@@ -738,7 +805,7 @@ namespace slib
 				HashMap<String, String> subParams;
 				route = route->getRoute(subPath, subParams);
 				if (route) {
-					parameters.put_NoLock(list[i].first, Url::decodeUriComponentByUTF8(name));
+					parameters.put_NoLock(list[i].first, Url::decodeUriComponentByUTF8(name.toString()));
 					if (subParams.isNotNull()) {
 						parameters.putAll_NoLock(subParams);
 					}
@@ -991,6 +1058,436 @@ namespace slib
 		add(HttpMethod::Unknown, path, onRequest);
 	}
 	
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(HttpResponseCacheRule)
+	
+	HttpResponseCacheRule::HttpResponseCacheRule()
+	{
+		TTL = 60;
+		staleWhileRevalidate = 0;
+		flagIgnoreQuery = sl_false;
+		flagGzip = sl_true;
+		lockTimeout = 5000;
+	}
+	
+	
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(HttpResponseCacheParam)
+	
+	HttpResponseCacheParam::HttpResponseCacheParam()
+	{
+		maximumEntriesCount = 4096;
+		maximumContentSize = 0x100000;
+		minimumGzipSize = 256;
+		gzipLevel = 6;
+	}
+	
+	
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(HttpResponseCacheStatistics)
+	
+	HttpResponseCacheStatistics::HttpResponseCacheStatistics()
+	{
+		countHits = 0;
+		countStaleHits = 0;
+		countMisses = 0;
+		countCollapsed = 0;
+		countEvictions = 0;
+		countEntries = 0;
+	}
+	
+	
+	HttpResponseCacheEntry::HttpResponseCacheEntry()
+	{
+		code = HttpStatus::OK;
+		timeStored = 0;
+		timeExpire = 0;
+		timeStale = 0;
+		flagValid = sl_false;
+		flagUpdating = sl_false;
+	}
+	
+	HttpResponseCacheEntry::~HttpResponseCacheEntry()
+	{
+	}
+	
+	
+	SLIB_STATIC_STRING(_g_priv_http_response_cache_gzip, "gzip");
+	
+	static sl_bool _priv_HttpResponseCache_isAcceptingGzip(HttpServerContext* context)
+	{
+		return context->getRequestHeader(HttpHeaders::AcceptEncoding).indexOf(_g_priv_http_response_cache_gzip) >= 0;
+	}
+	
+	SLIB_DEFINE_OBJECT(HttpResponseCache, Object)
+	
+	HttpResponseCache::HttpResponseCache()
+	{
+	}
+	
+	HttpResponseCache::~HttpResponseCache()
+	{
+	}
+	
+	Ref<HttpResponseCache> HttpResponseCache::create(const HttpResponseCacheParam& param)
+	{
+		Ref<HttpResponseCache> ret = new HttpResponseCache;
+		if (ret.isNotNull()) {
+			ret->m_param = param;
+			if (!(ret->m_param.maximumEntriesCount)) {
+				ret->m_param.maximumEntriesCount = 1;
+			}
+		}
+		return ret;
+	}
+	
+	Ref<HttpResponseCache> HttpResponseCache::create()
+	{
+		HttpResponseCacheParam param;
+		return create(param);
+	}
+	
+	static HttpServerRoute* _priv_HttpResponseCache_createRoute(HashMap<HttpMethod, HttpServerRoute>& routes, HttpMethod method, const String& path)
+	{
+		HttpServerRoute* route = routes.getItemPointer(method);
+		if (!route) {
+			route = &(routes.emplace_NoLock(method).node->value);
+		}
+		return route->createRoute(path);
+	}
+	
+	void HttpResponseCache::add(HttpServerRouter& router, HttpMethod method, const String& path, const HttpResponseCacheRule& rule)
+	{
+		Ref<HttpResponseCache> cache = this;
+		// the handlers already registered on the route (for example authentication) run first
+		HttpServerRoute* route = _priv_HttpResponseCache_createRoute(router.preRoutes, method, path);
+		Function<sl_bool(HttpServer*, HttpServerContext*)> onPreRequest = route->onRequest;
+		route->onRequest = [cache, rule, onPreRequest](HttpServer* server, HttpServerContext* context) {
+			if (onPreRequest.isNotNull() && onPreRequest(server, context)) {
+				return sl_true;
+			}
+			return cache->processRequest(context, rule);
+		};
+		route = _priv_HttpResponseCache_createRoute(router.postRoutes, method, path);
+		Function<sl_bool(HttpServer*, HttpServerContext*)> onPostRequest = route->onRequest;
+		route->onRequest = [cache, rule, onPostRequest](HttpServer* server, HttpServerContext* context) {
+			sl_bool ret = sl_false;
+			if (onPostRequest.isNotNull()) {
+				ret = onPostRequest(server, context);
+			}
+			cache->processResponse(context, rule);
+			return ret;
+		};
+	}
+	
+	void HttpResponseCache::GET(HttpServerRouter& router, const String& path, const HttpResponseCacheRule& rule)
+	{
+		add(router, HttpMethod::GET, path, rule);
+	}
+	
+	void HttpResponseCache::remove(HttpMethod method, const String& path)
+	{
+		String prefix = HttpMethods::toString(method) + " " + path + "?";
+		typedef HashMapNode< String, Ref<HttpResponseCacheEntry> > NODE;
+		MutexLocker lock(&m_lock);
+		NODE* node = m_entries.getFirstNode();
+		while (node) {
+			NODE* next = node->getNext();
+			if (node->key.startsWith(prefix) && node->value->flagValid) {
+				m_entries.removeAt(node);
+			}
+			node = next;
+		}
+	}
+	
+	void HttpResponseCache::removeAll()
+	{
+		typedef HashMapNode< String, Ref<HttpResponseCacheEntry> > NODE;
+		MutexLocker lock(&m_lock);
+		NODE* node = m_entries.getFirstNode();
+		while (node) {
+			NODE* next = node->getNext();
+			if (node->value->flagValid) {
+				m_entries.removeAt(node);
+			}
+			node = next;
+		}
+	}
+	
+	HttpResponseCacheStatistics HttpResponseCache::getStatistics()
+	{
+		MutexLocker lock(&m_lock);
+		HttpResponseCacheStatistics ret = m_statistics;
+		ret.countEntries = m_entries.getCount();
+		return ret;
+	}
+	
+	sl_bool HttpResponseCache::processRequest(HttpServerContext* context, const HttpResponseCacheRule& rule)
+	{
+		if (!(rule.TTL)) {
+			return sl_false;
+		}
+		String key = _getKey(context, rule);
+		sl_uint64 now = m_timeCounter.getElapsedMilliseconds();
+		Ref<HttpResponseCacheEntry> entry;
+		Ref<Event> event;
+		{
+			MutexLocker lock(&m_lock);
+			m_entries.get_NoLock(key, &entry);
+			if (entry.isNotNull()) {
+				if (entry->flagValid) {
+					if (now < entry->timeExpire) {
+						m_statistics.countHits++;
+						lock.unlock();
+						_writeResponse(context, rule, entry.get(), now);
+						return sl_true;
+					}
+					if (entry->flagUpdating) {
+						if (now < entry->timeStale) {
+							m_statistics.countHits++;
+							m_statistics.countStaleHits++;
+							lock.unlock();
+							_writeResponse(context, rule, entry.get(), now);
+							return sl_true;
+						}
+						event = entry->eventUpdated;
+					}
+				} else {
+					event = entry->eventUpdated;
+				}
+			} else {
+				entry = new HttpResponseCacheEntry;
+				if (entry.isNull()) {
+					return sl_false;
+				}
+				m_entries.put_NoLock(key, entry);
+				if (m_entries.getCount() > m_param.maximumEntriesCount) {
+					_evict(now);
+				}
+			}
+			if (event.isNull()) {
+				// this request updates the entry
+				event = Event::create(sl_false);
+				if (event.isNull()) {
+					return sl_false;
+				}
+				entry->flagUpdating = sl_true;
+				entry->eventUpdated = event;
+				m_statistics.countMisses++;
+				m_mapUpdating.put(context, Pair< String, Ref<HttpResponseCacheEntry> >(key, entry));
+				return sl_false;
+			}
+		}
+		// an identical request is updating the entry
+		if (rule.lockTimeout && context->isProcessingByThread()) {
+			event->wait(rule.lockTimeout);
+			now = m_timeCounter.getElapsedMilliseconds();
+			MutexLocker lock(&m_lock);
+			if (m_entries.get_NoLock(key, &entry)) {
+				if (entry->flagValid && now < entry->timeStale) {
+					m_statistics.countHits++;
+					m_statistics.countCollapsed++;
+					lock.unlock();
+					_writeResponse(context, rule, entry.get(), now);
+					return sl_true;
+				}
+			}
+		}
+		MutexLocker lock(&m_lock);
+		m_statistics.countMisses++;
+		return sl_false;
+	}
+	
+	void HttpResponseCache::processResponse(HttpServerContext* context, const HttpResponseCacheRule& rule)
+	{
+		Pair< String, Ref<HttpResponseCacheEntry> > updating;
+		if (!(m_mapUpdating.remove(context, &updating))) {
+			return;
+		}
+		const String& key = updating.first;
+		HttpResponseCacheEntry* entryOld = updating.second.get();
+		Ref<HttpResponseCacheEntry> entryNew;
+		
+		do {
+			if (context->isAsynchronousResponse() || !(context->isProcessed())) {
+				break;
+			}
+			if (context->getResponseCode() != HttpStatus::OK) {
+				break;
+			}
+			if (context->containsResponseHeader(HttpHeaders::SetCookie)) {
+				break;
+			}
+			if (context->containsResponseHeader(HttpHeaders::CacheControl)) {
+				HttpCacheControlResponse cc = context->getResponseCacheControl();
+				if (cc.no_store || cc.no_cache || cc.private_) {
+					break;
+				}
+			}
+			Memory content;
+			if (!(context->mergeOutput(content))) {
+				break;
+			}
+			if (content.getSize() > m_param.maximumContentSize) {
+				break;
+			}
+			entryNew = new HttpResponseCacheEntry;
+			if (entryNew.isNull()) {
+				break;
+			}
+			entryNew->code = HttpStatus::OK;
+			entryNew->content = content;
+			sl_size sizeContent = content.getSize();
+			if (rule.flagGzip && sizeContent >= m_param.minimumGzipSize && !(context->containsResponseHeader(HttpHeaders::ContentEncoding))) {
+				Memory gzip = Zlib::compressGzip(content.getData(), sizeContent, m_param.gzipLevel);
+				if (gzip.isNotNull() && gzip.getSize() < sizeContent) {
+					entryNew->contentGzip = gzip;
+				}
+			}
+			List<String> vary = rule.varyHeaders.duplicate();
+			if (entryNew->contentGzip.isNotNull()) {
+				vary.add_NoLock(HttpHeaders::AcceptEncoding);
+			}
+			if (vary.isNotEmpty()) {
+				context->setResponseHeader(HttpHeaders::Vary, HttpHeaders::mergeValues(vary));
+			}
+			List< Pair<String, String> > headers;
+			for (auto& item : context->getResponseHeaders()) {
+				if (item.key != HttpHeaders::ContentLength && item.key != HttpHeaders::Age) {
+					headers.add_NoLock(Pair<String, String>(item.key, item.value));
+				}
+			}
+			entryNew->headers = Move(headers);
+			sl_uint64 now = m_timeCounter.getElapsedMilliseconds();
+			entryNew->timeStored = now;
+			entryNew->timeExpire = now + (sl_uint64)(rule.TTL) * 1000;
+			entryNew->timeStale = entryNew->timeExpire + (sl_uint64)(rule.staleWhileRevalidate) * 1000;
+			entryNew->flagValid = sl_true;
+			if (entryNew->contentGzip.isNotNull() && _priv_HttpResponseCache_isAcceptingGzip(context)) {
+				context->clearOutput();
+				context->write(entryNew->contentGzip);
+				context->setResponseContentEncoding(_g_priv_http_response_cache_gzip);
+			}
+		} while (0);
+		
+		Ref<Event> event;
+		{
+			MutexLocker lock(&m_lock);
+			Ref<HttpResponseCacheEntry> entryCurrent;
+			m_entries.get_NoLock(key, &entryCurrent);
+			if (entryNew.isNotNull()) {
+				m_entries.put_NoLock(key, entryNew);
+				if (m_entries.getCount() > m_param.maximumEntriesCount) {
+					_evict(entryNew->timeStored);
+				}
+			} else if (entryCurrent.get() == entryOld) {
+				if (entryOld->flagValid) {
+					entryOld->flagUpdating = sl_false;
+				} else {
+					m_entries.remove_NoLock(key);
+				}
+			}
+			event = Move(entryOld->eventUpdated);
+		}
+		if (event.isNotNull()) {
+			event->set();
+		}
+	}
+	
+	String HttpResponseCache::_getKey(HttpServerContext* context, const HttpResponseCacheRule& rule)
+	{
+		StringBuffer buf;
+		buf.add(HttpMethods::toString(context->getMethod()));
+		buf.addStatic(" ", 1);
+		buf.add(context->getPath());
+		buf.addStatic("?", 1);
+		if (!(rule.flagIgnoreQuery)) {
+			if (rule.queryParameters.isNotEmpty()) {
+				ListElements<String> names(rule.queryParameters);
+				for (sl_size i = 0; i < names.count; i++) {
+					buf.add(names[i]);
+					buf.addStatic("=", 1);
+					buf.add(context->getQueryParameter(names[i]));
+					buf.addStatic("&", 1);
+				}
+			} else {
+				buf.add(context->getQuery());
+			}
+		}
+		if (rule.varyHeaders.isNotEmpty()) {
+			ListElements<String> names(rule.varyHeaders);
+			for (sl_size i = 0; i < names.count; i++) {
+				buf.addStatic("\n", 1);
+				buf.add(context->getRequestHeader(names[i]));
+			}
+		}
+		return buf.merge();
+	}
+	
+	void HttpResponseCache::_writeResponse(HttpServerContext* context, const HttpResponseCacheRule& rule, HttpResponseCacheEntry* entry, sl_uint64 now)
+	{
+		context->setResponseCode(entry->code);
+		ListElements< Pair<String, String> > headers(entry->headers);
+		for (sl_size i = 0; i < headers.count; i++) {
+			context->addResponseHeader(headers[i].first, headers[i].second);
+		}
+		context->setResponseHeader(HttpHeaders::Age, String::fromUint64((now - entry->timeStored) / 1000));
+		if (entry->contentGzip.isNotNull() && _priv_HttpResponseCache_isAcceptingGzip(context)) {
+			context->setResponseContentEncoding(_g_priv_http_response_cache_gzip);
+			context->write(entry->contentGzip);
+		} else {
+			context->write(entry->content);
+		}
+	}
+	
+	void HttpResponseCache::_evict(sl_uint64 now)
+	{
+		typedef HashMapNode< String, Ref<HttpResponseCacheEntry> > NODE;
+		NODE* node = m_entries.getFirstNode();
+		while (node) {
+			NODE* next = node->getNext();
+			HttpResponseCacheEntry* entry = node->value.get();
+			if (entry->flagValid && !(entry->flagUpdating) && now >= entry->timeStale) {
+				m_entries.removeAt(node);
+			}
+			node = next;
+		}
+		sl_size nLimit = m_param.maximumEntriesCount - m_param.maximumEntriesCount / 8;
+		sl_size n = m_entries.getCount();
+		if (n <= nLimit) {
+			return;
+		}
+		sl_uint64* stales = NewHelper<sl_uint64>::create(n);
+		if (!stales) {
+			return;
+		}
+		sl_size k = 0;
+		node = m_entries.getFirstNode();
+		while (node && k < n) {
+			HttpResponseCacheEntry* entry = node->value.get();
+			if (entry->flagValid && !(entry->flagUpdating)) {
+				stales[k++] = entry->timeStale;
+			}
+			node = node->getNext();
+		}
+		if (k) {
+			QuickSort::sortAsc(stales, k);
+			sl_size nRemove = n - nLimit;
+			if (nRemove > k) {
+				nRemove = k;
+			}
+			sl_uint64 threshold = stales[nRemove - 1];
+			node = m_entries.getFirstNode();
+			while (node && m_entries.getCount() > nLimit) {
+				NODE* next = node->getNext();
+				HttpResponseCacheEntry* entry = node->value.get();
+				if (entry->flagValid && !(entry->flagUpdating) && entry->timeStale <= threshold) {
+					m_entries.removeAt(node);
+					m_statistics.countEvictions++;
+				}
+				node = next;
+			}
+		}
+		NewHelper<sl_uint64>::free(stales, n);
+	}
+	
 	
 	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(HttpServerParam)
 
@@ -1006,6 +1503,11 @@ namespace slib
 		
 		maxRequestHeadersSize = 0x10000; // 64KB
 		maxRequestBodySize = 0x2000000; // 32MB
+		maxMappedFileSize = 0;
+		
+		idleTimeout = 60000; // 60s
+		requestHeaderTimeout = 30000; // 30s
+		requestBodyTimeout = 60000; // 60s
 		
 		flagAllowCrossOrigin = sl_false;
 		
@@ -1053,6 +1555,23 @@ namespace slib
 			if (conf["max_request_body"].getString().parseUint32(10, &n)) {
 				maxRequestBodySize = n * 1024 * 1024;
 			}
+			if (conf["max_mapped_file"].getString().parseUint32(10, &n)) {
+				maxMappedFileSize = n * 1024 * 1024;
+			}
+		}
+		
+		// timeouts are configured in seconds
+		{
+			sl_uint32 n;
+			if (conf["idle_timeout"].getString().parseUint32(10, &n)) {
+				idleTimeout = n * 1000;
+			}
+			if (conf["request_header_timeout"].getString().parseUint32(10, &n)) {
+				requestHeaderTimeout = n * 1000;
+			}
+			if (conf["request_body_timeout"].getString().parseUint32(10, &n)) {
+				requestBodyTimeout = n * 1000;
+			}
 		}
 	}
 	
@@ -1333,6 +1852,19 @@ namespace slib
 				return sl_true;
 			}
 			
+			// the mapped views are used only when the connection can't send the file by itself (sendfile)
+			sl_bool flagMapFile = sl_false;
+			if (m_param.maxMappedFileSize) {
+				flagMapFile = sl_true;
+				Ref<HttpServerConnection> connection = context->getConnection();
+				if (connection.isNotNull()) {
+					Ref<AsyncStream> io = connection->getIO();
+					if (io.isNotNull() && io->isSendFileSupported()) {
+						flagMapFile = sl_false;
+					}
+				}
+			}
+			
 			String rangeHeader = context->getRequestRange();
 			
 			if (rangeHeader.isNotEmpty()) {
@@ -1342,6 +1874,17 @@ namespace slib
 				
 				if (processRangeRequest(context, totalSize, rangeHeader, start, len)) {
 
+					if (flagMapFile && len <= m_param.maxMappedFileSize) {
+						Ref<MappedFile> file = MappedFile::open(path, MappedFileMode::ReadSequential);
+						if (file.isNotNull()) {
+							Memory mem = file->map(start, (sl_size)len);
+							if (mem.isNotNull()) {
+								context->write(mem);
+								return sl_true;
+							}
+						}
+					}
+
 					Ref<AsyncFile> file = AsyncFile::openForRead(path, m_threadPool);
 					if (file.isNotNull()) {
 						file->seek(start);
@@ -1355,6 +1898,13 @@ namespace slib
 				
 			} else {
 				if (totalSize > 100000) {
+					if (flagMapFile && totalSize <= m_param.maxMappedFileSize) {
+						Memory mem = MappedFile::mapAll(path);
+						if (mem.isNotNull()) {
+							context->write(mem);
+							return sl_true;
+						}
+					}
 					context->copyFromFile(path, m_threadPool);
 					return sl_true;
 				} else {
@@ -1394,8 +1944,8 @@ namespace slib
 			context->setResponseCode(HttpStatus::BadRequest);
 			return sl_false;
 		}
-		String s1 = range.substring(6, indexSplit);
-		String s2 = range.substring(indexSplit+1);
+		StringView s1 = StringView(range).substring(6, indexSplit);
+		StringView s2 = StringView(range).substring(indexSplit+1);
 		sl_uint64 n1 = 0;
 		sl_uint64 n2 = 0;
 		if (s1.isNotEmpty()) {
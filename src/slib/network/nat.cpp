@@ -23,6 +23,7 @@
 #include "slib/network/nat.h"
 
 #include "slib/core/new_helper.h"
+#include "slib/core/system.h"
 
 namespace slib
 {
@@ -40,6 +41,11 @@ namespace slib
 		udpPortEnd = 60000;
 
 		icmpEchoIdentifier = 30000;
+		
+		tcpPortTimeout = 7440000;
+		udpPortTimeout = 300000;
+		
+		shardsCount = 0;
 	}
 
 	
@@ -63,10 +69,19 @@ namespace slib
 	{
 		ObjectLocker lock(this);
 		m_param = param;
-		m_mappingTcp.setup(param.tcpPortBegin, param.tcpPortEnd);
-		m_mappingUdp.setup(param.udpPortBegin, param.udpPortEnd);
+		sl_uint32 nShards = param.shardsCount;
+		if (!nShards) {
+			nShards = System::getProcessorsCount();
+		}
+		m_mappingTcp.setup(param.tcpPortBegin, param.tcpPortEnd, param.tcpPortTimeout, nShards);
+		m_mappingUdp.setup(param.udpPortBegin, param.udpPortEnd, param.udpPortTimeout, nShards);
 	}
 
+	/*
+		The checksums are adjusted incrementally (RFC 1624) instead of being recomputed
+		over the whole packet, so they are not verified here: a corrupted packet keeps
+		its invalid checksum after the translation, and is dropped by the receiver.
+	*/
 	sl_bool NatTable::translateOutgoingPacket(IPv4Packet* ipHeader, void* ipContent, sl_uint32 sizeContent)
 	{
 		IPv4Address addressTarget = m_param.targetAddress;
@@ -76,31 +91,41 @@ namespace slib
 		NetworkInternetProtocol protocol = ipHeader->getProtocol();
 		if (protocol == NetworkInternetProtocol::TCP) {
 			TcpSegment* tcp = (TcpSegment*)(ipContent);
-			if (tcp->check(ipHeader, sizeContent)) {
+			if (tcp->checkSize(sizeContent)) {
+				IPv4Address addressSource = ipHeader->getSourceAddress();
+				sl_uint16 portSource = tcp->getSourcePort();
 				sl_uint16 targetPort;
-				if (m_mappingTcp.mapToExternalPort(SocketAddress(ipHeader->getSourceAddress(), tcp->getSourcePort()), targetPort)) {
+				if (m_mappingTcp.mapToExternalPort(SocketAddress(addressSource, portSource), targetPort)) {
 					tcp->setSourcePort(targetPort);
 					ipHeader->setSourceAddress(addressTarget);
-					tcp->updateChecksum(ipHeader, sizeContent);
-					ipHeader->updateChecksum();
+					sl_uint16 checksum = TCP_IP::adjustChecksum(tcp->getChecksum(), addressSource, addressTarget);
+					tcp->setChecksum(TCP_IP::adjustChecksum(checksum, portSource, targetPort));
+					ipHeader->setChecksum(TCP_IP::adjustChecksum(ipHeader->getChecksum(), addressSource, addressTarget));
 					return sl_true;
 				}
 			}
 		} else if (protocol == NetworkInternetProtocol::UDP) {
 			UdpDatagram* udp = (UdpDatagram*)(ipContent);
-			if (udp->check(ipHeader, sizeContent)) {
+			if (udp->checkSize(sizeContent)) {
+				IPv4Address addressSource = ipHeader->getSourceAddress();
+				sl_uint16 portSource = udp->getSourcePort();
 				sl_uint16 targetPort;
-				if (m_mappingUdp.mapToExternalPort(SocketAddress(ipHeader->getSourceAddress(), udp->getSourcePort()), targetPort)) {
+				if (m_mappingUdp.mapToExternalPort(SocketAddress(addressSource, portSource), targetPort)) {
 					udp->setSourcePort(targetPort);
 					ipHeader->setSourceAddress(addressTarget);
-					udp->updateChecksum(ipHeader);
-					ipHeader->updateChecksum();
+					sl_uint16 checksum = udp->getChecksum();
+					if (checksum) {
+						checksum = TCP_IP::adjustChecksum(checksum, addressSource, addressTarget);
+						checksum = TCP_IP::adjustChecksum(checksum, portSource, targetPort);
+						udp->setChecksum(checksum ? checksum : 0xFFFF);
+					}
+					ipHeader->setChecksum(TCP_IP::adjustChecksum(ipHeader->getChecksum(), addressSource, addressTarget));
 					return sl_true;
 				}
 			}
 		} else if (protocol == NetworkInternetProtocol::ICMP) {
 			IcmpHeaderFormat* icmp = (IcmpHeaderFormat*)(ipContent);
-			if (icmp->check(sizeContent)) {
+			if (sizeContent >= sizeof(IcmpHeaderFormat)) {
 				if (icmp->getType() == IcmpType::Echo) {
 					IcmpEchoAddress address;
 					address.ip = ipHeader->getSourceAddress();
@@ -110,8 +135,9 @@ namespace slib
 					icmp->setEchoIdentifier(m_param.icmpEchoIdentifier);
 					icmp->setEchoSequenceNumber(sn);
 					ipHeader->setSourceAddress(addressTarget);
-					icmp->updateChecksum(sizeContent);
-					ipHeader->updateChecksum();
+					sl_uint16 checksum = TCP_IP::adjustChecksum(icmp->getChecksum(), address.identifier, m_param.icmpEchoIdentifier);
+					icmp->setChecksum(TCP_IP::adjustChecksum(checksum, address.sequenceNumber, sn));
+					ipHeader->setChecksum(TCP_IP::adjustChecksum(ipHeader->getChecksum(), address.ip, addressTarget));
 					return sl_true;
 				}
 			}
@@ -131,45 +157,57 @@ namespace slib
 		NetworkInternetProtocol protocol = ipHeader->getProtocol();
 		if (protocol == NetworkInternetProtocol::TCP) {
 			TcpSegment* tcp = (TcpSegment*)(ipContent);
-			if (tcp->check(ipHeader, sizeContent)) {
+			if (tcp->checkSize(sizeContent)) {
+				sl_uint16 portTarget = tcp->getDestinationPort();
 				SocketAddress addressSource;
-				if (m_mappingTcp.mapToInternalAddress(tcp->getDestinationPort(), addressSource)) {
-					ipHeader->setDestinationAddress(addressSource.ip.getIPv4());
+				if (m_mappingTcp.mapToInternalAddress(portTarget, addressSource)) {
+					IPv4Address ipSource = addressSource.ip.getIPv4();
+					ipHeader->setDestinationAddress(ipSource);
 					tcp->setDestinationPort(addressSource.port);
-					tcp->updateChecksum(ipHeader, sizeContent);
-					ipHeader->updateChecksum();
+					sl_uint16 checksum = TCP_IP::adjustChecksum(tcp->getChecksum(), addressTarget, ipSource);
+					tcp->setChecksum(TCP_IP::adjustChecksum(checksum, portTarget, addressSource.port));
+					ipHeader->setChecksum(TCP_IP::adjustChecksum(ipHeader->getChecksum(), addressTarget, ipSource));
 					return sl_true;
 				}
 			}
 		} else if (protocol == NetworkInternetProtocol::UDP) {
-			UdpDatagram* udp = (UdpDatagram*)(ipHeader->getContent());
-			if (udp->check(ipHeader, sizeContent)) {
+			UdpDatagram* udp = (UdpDatagram*)(ipContent);
+			if (udp->checkSize(sizeContent)) {
+				sl_uint16 portTarget = udp->getDestinationPort();
 				SocketAddress addressSource;
-				if (m_mappingUdp.mapToInternalAddress(udp->getDestinationPort(), addressSource)) {
-					ipHeader->setDestinationAddress(addressSource.ip.getIPv4());
+				if (m_mappingUdp.mapToInternalAddress(portTarget, addressSource)) {
+					IPv4Address ipSource = addressSource.ip.getIPv4();
+					ipHeader->setDestinationAddress(ipSource);
 					udp->setDestinationPort(addressSource.port);
-					udp->updateChecksum(ipHeader);
-					ipHeader->updateChecksum();
+					sl_uint16 checksum = udp->getChecksum();
+					if (checksum) {
+						checksum = TCP_IP::adjustChecksum(checksum, addressTarget, ipSource);
+						checksum = TCP_IP::adjustChecksum(checksum, portTarget, addressSource.port);
+						udp->setChecksum(checksum ? checksum : 0xFFFF);
+					}
+					ipHeader->setChecksum(TCP_IP::adjustChecksum(ipHeader->getChecksum(), addressTarget, ipSource));
 					return sl_true;
 				}
 			}
 		} else if (protocol == NetworkInternetProtocol::ICMP) {
 			IcmpHeaderFormat* icmp = (IcmpHeaderFormat*)(ipContent);
-			if (icmp->check(sizeContent)) {
+			if (sizeContent >= sizeof(IcmpHeaderFormat)) {
 				IcmpType type = icmp->getType();
 				if (type == IcmpType::EchoReply) {
 					if (icmp->getEchoIdentifier() == m_param.icmpEchoIdentifier) {
 						IcmpEchoElement element;
 						if (m_mapIcmpEchoIncoming.get(icmp->getEchoSequenceNumber(), &element)) {
 							ipHeader->setDestinationAddress(element.addressSource.ip);
+							sl_uint16 checksum = TCP_IP::adjustChecksum(icmp->getChecksum(), m_param.icmpEchoIdentifier, element.addressSource.identifier);
+							icmp->setChecksum(TCP_IP::adjustChecksum(checksum, icmp->getEchoSequenceNumber(), element.addressSource.sequenceNumber));
 							icmp->setEchoIdentifier(element.addressSource.identifier);
 							icmp->setEchoSequenceNumber(element.addressSource.sequenceNumber);
-							icmp->updateChecksum(sizeContent);
-							ipHeader->updateChecksum();
+							ipHeader->setChecksum(TCP_IP::adjustChecksum(ipHeader->getChecksum(), addressTarget, element.addressSource.ip));
 							return sl_true;
 						}
 					}
 				} else if (type == IcmpType::DestinationUnreachable || type == IcmpType::TimeExceeded) {
+					// rare and small: the checksums are recomputed
 					IPv4Packet* ipOrig = (IPv4Packet*)(icmp->getContent());
 					sl_uint32 sizeOrig = sizeContent - sizeof(IcmpHeaderFormat);
 					if (sizeOrig == sizeof(IPv4Packet)+8 && IPv4Packet::checkHeader(ipOrig, sizeOrig) && ipOrig->getDestinationAddress() == addressTarget) {
@@ -209,6 +247,7 @@ namespace slib
 
 	sl_uint16 NatTable::getMappedIcmpEchoSequenceNumber(const IcmpEchoAddress& address)
 	{
+		MutexLocker lock(&m_lockIcmpEcho);
 		IcmpEchoElement element;
 		if (m_mapIcmpEchoOutgoing.get(address, &element)) {
 			return element.sequenceNumberTarget;
@@ -225,12 +264,41 @@ namespace slib
 	}
 
 	
-	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(NatTablePort)
-	
 	NatTablePort::NatTablePort()
 	{
 		flagActive = sl_false;
-		timeLastAccess.setZero();
+		timeLastAccess = 0;
+	}
+	
+	NatTablePort::~NatTablePort()
+	{
+	}
+	
+	NatTablePort::NatTablePort(const NatTablePort& other): flagActive(other.flagActive), addressSource(other.addressSource), timeLastAccess(other.timeLastAccess)
+	{
+	}
+	
+	NatTablePort::NatTablePort(NatTablePort&& other): flagActive(other.flagActive), addressSource(other.addressSource), timeLastAccess(other.timeLastAccess)
+	{
+	}
+	
+	NatTablePort& NatTablePort::operator=(const NatTablePort& other)
+	{
+		flagActive = other.flagActive;
+		addressSource = other.addressSource;
+		timeLastAccess = other.timeLastAccess;
+		return *this;
+	}
+	
+	NatTablePort& NatTablePort::operator=(NatTablePort&& other)
+	{
+		return *this = (const NatTablePort&)other;
+	}
+	
+	
+	NatTableMappingShard::NatTableMappingShard(): timeouts(1000)
+	{
+		pos = 0;
 	}
 	
 
@@ -238,118 +306,173 @@ namespace slib
 	{
 		m_ports = sl_null;
 		m_nPorts = 0;
-		m_pos = 0;
+		
+		m_shards = sl_null;
+		m_nShards = 0;
 
 		m_portBegin = 0;
 		m_portEnd = 0;
+		m_timeout = 0;
 	}
 
 	NatTableMapping::~NatTableMapping()
 	{
-		NewHelper<NatTablePort>::free(m_ports, m_nPorts);
+		_free();
 	}
 
-	void NatTableMapping::setup(sl_uint16 portBegin, sl_uint16 portEnd)
+	void NatTableMapping::setup(sl_uint16 portBegin, sl_uint16 portEnd, sl_uint32 timeout, sl_uint32 nShards)
 	{
 		ObjectLocker lock(this);
 
-		m_mapPorts.removeAll_NoLock();
-
-		if (m_ports) {
-			NewHelper<NatTablePort>::free(m_ports, m_nPorts);
-			m_ports = sl_null;
-		}
-		m_pos = 0;
-		m_nPorts = 0;
+		_free();
 
 		m_portBegin = portBegin;
 		m_portEnd = portEnd;
+		m_timeout = timeout;
 		if (portEnd >= portBegin) {
-			m_nPorts = portEnd - portBegin + 1;
-			m_ports = NewHelper<NatTablePort>::create(m_nPorts);
+			sl_uint32 nPorts = portEnd - portBegin + 1;
+			if (!nShards) {
+				nShards = 1;
+			}
+			if (nShards > nPorts) {
+				nShards = nPorts;
+			}
+			m_shards = NewHelper<NatTableMappingShard>::create(nShards);
+			if (!m_shards) {
+				return;
+			}
+			m_ports = NewHelper<NatTablePort>::create(nPorts);
+			if (!m_ports) {
+				NewHelper<NatTableMappingShard>::free(m_shards, nShards);
+				m_shards = sl_null;
+				return;
+			}
+			for (sl_uint32 k = 0; k < nPorts; k++) {
+				m_ports[k].entryTimeout.callback = SLIB_BIND_CLASS(void(), NatTableMapping, _onExpirePort, this, k);
+			}
+			m_nShards = nShards;
+			m_nPorts = nPorts;
 		}
 	}
 
 	sl_bool NatTableMapping::mapToExternalPort(const SocketAddress& address, sl_uint16& _port)
 	{
-		ObjectLocker lock(this);
-
-		if (!m_ports) {
-			return sl_false;
-		}
-		sl_uint32 n = m_nPorts;
-		if (!n) {
+		sl_uint32 nShards = m_nShards;
+		if (!nShards) {
 			return sl_false;
 		}
+		sl_uint32 indexShard = (sl_uint32)(Hash<SocketAddress>()(address) % nShards);
+		NatTableMappingShard& shard = m_shards[indexShard];
+		
+		MutexLocker lock(&shard.lock);
+		
+		shard.timeouts.process();
+		sl_uint64 now = shard.timeouts.getElapsedMilliseconds();
 
 		sl_uint16 port;
-		if (m_mapPorts.get_NoLock(address, &port)) {
-			if (port >= m_portBegin && port <= m_portEnd) {
-				m_ports[port - m_portBegin].timeLastAccess = Time::now();
-				_port = port;
-				return sl_true;
-			} else {
-				m_mapPorts.remove_NoLock(address);
-			}
+		if (shard.mapPorts.get_NoLock(address, &port)) {
+			m_ports[port - m_portBegin].timeLastAccess = now;
+			_port = port;
+			return sl_true;
 		}
 
-		sl_uint16 pos = m_pos;
-		n *= 2;
-		sl_int64 timeAccessMin = 0;
-		sl_int64 timeAccessMax = 0;
+		// ports of this shard: indexShard + i * nShards
+		sl_uint32 n = (m_nPorts - indexShard + nShards - 1) / nShards;
+		sl_uint32 pos = shard.pos;
+		sl_uint32 indexOldest = 0;
+		sl_uint64 timeOldest = 0;
 		for (sl_uint32 i = 0; i < n; i++) {
-			if (!(m_ports[pos].flagActive)) {
-				port = pos + m_portBegin;
-				m_ports[pos].flagActive = sl_true;
-				m_ports[pos].addressSource = address;
-				m_ports[pos].timeLastAccess = Time::now();
-				m_mapPorts.put_NoLock(address, port);
+			sl_uint32 k = indexShard + pos * nShards;
+			pos++;
+			if (pos >= n) {
+				pos = 0;
+			}
+			NatTablePort& item = m_ports[k];
+			if (!(item.flagActive)) {
+				item.flagActive = sl_true;
+				item.addressSource = address;
+				item.timeLastAccess = now;
+				port = (sl_uint16)(k + m_portBegin);
+				shard.mapPorts.put_NoLock(address, port);
+				if (m_timeout) {
+					shard.timeouts.add(&(item.entryTimeout), m_timeout);
+				}
+				shard.pos = pos;
 				_port = port;
-				m_pos = (pos + 1) % m_nPorts;
 				return sl_true;
-			} else {
-				sl_int64 t = m_ports[pos].timeLastAccess.toInt();
-				if (t > timeAccessMax) {
-					timeAccessMax = t;
-				}
-				if (timeAccessMin == 0 || t < timeAccessMin) {
-					timeAccessMin = t;
-				}
 			}
-			pos = (pos + 1) % m_nPorts;
-			if (i == m_nPorts) {
-				sl_int64 mid = (timeAccessMin + timeAccessMax) / 2;
-				for (sl_uint16 k = 0; k < m_nPorts; k++) {
-					if (m_ports[k].flagActive) {
-						if (m_ports[k].timeLastAccess.toInt() <= mid) {
-							m_ports[k].flagActive = sl_false;
-							m_mapPorts.remove_NoLock(m_ports[k].addressSource);
-						}
-					}
-				}
+			if (!i || item.timeLastAccess < timeOldest) {
+				indexOldest = k;
+				timeOldest = item.timeLastAccess;
 			}
 		}
-		return sl_false;
+		
+		// all the ports of the shard are in use: reuses the least recently accessed one
+		NatTablePort& item = m_ports[indexOldest];
+		shard.mapPorts.remove_NoLock(item.addressSource);
+		item.addressSource = address;
+		item.timeLastAccess = now;
+		port = (sl_uint16)(indexOldest + m_portBegin);
+		shard.mapPorts.put_NoLock(address, port);
+		if (m_timeout) {
+			shard.timeouts.add(&(item.entryTimeout), m_timeout);
+		}
+		_port = port;
+		return sl_true;
 	}
 
 	sl_bool NatTableMapping::mapToInternalAddress(sl_uint16 port, SocketAddress& address)
 	{
-		ObjectLocker lock(this);
-		if (!m_ports) {
-			return sl_false;
-		}
-		if (!m_nPorts) {
+		sl_uint32 nShards = m_nShards;
+		if (!nShards) {
 			return sl_false;
 		}
 		if (port >= m_portBegin && port <= m_portEnd) {
 			sl_uint32 k = port - m_portBegin;
-			if (m_ports[k].flagActive) {
-				m_ports[k].timeLastAccess = Time::now();
-				address = m_ports[k].addressSource;
+			NatTableMappingShard& shard = m_shards[k % nShards];
+			MutexLocker lock(&shard.lock);
+			shard.timeouts.process();
+			NatTablePort& item = m_ports[k];
+			if (item.flagActive) {
+				item.timeLastAccess = shard.timeouts.getElapsedMilliseconds();
+				address = item.addressSource;
 				return sl_true;
 			}
 		}
 		return sl_false;
 	}
 	
+	void NatTableMapping::_free()
+	{
+		// the ports are freed before the shards, to unlink their entries from the timing wheels
+		if (m_ports) {
+			NewHelper<NatTablePort>::free(m_ports, m_nPorts);
+			m_ports = sl_null;
+		}
+		if (m_shards) {
+			NewHelper<NatTableMappingShard>::free(m_shards, m_nShards);
+			m_shards = sl_null;
+		}
+		m_nPorts = 0;
+		m_nShards = 0;
+	}
+	
+	void NatTableMapping::_onExpirePort(sl_uint32 index)
+	{
+		NatTableMappingShard& shard = m_shards[index % m_nShards];
+		MutexLocker lock(&shard.lock);
+		NatTablePort& item = m_ports[index];
+		if (!(item.flagActive)) {
+			return;
+		}
+		// the access time is refreshed without rescheduling the entry
+		sl_uint64 now = shard.timeouts.getElapsedMilliseconds();
+		if (now < item.timeLastAccess + m_timeout) {
+			shard.timeouts.add(&(item.entryTimeout), item.timeLastAccess + m_timeout - now);
+			return;
+		}
+		item.flagActive = sl_false;
+		shard.mapPorts.remove_NoLock(item.addressSource);
+	}
+	
 }
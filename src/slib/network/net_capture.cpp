@@ -31,10 +31,22 @@
 #include "slib/network/tcpip.h"
 #include "slib/network/ethernet.h"
 
+#if defined(SLIB_PLATFORM_IS_LINUX)
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
 #define TAG "NetCapture"
 
 #define MAX_PACKET_SIZE 65535
 
+#define PACKET_RING_TX_FRAME_SIZE 4096
+
 namespace slib
 {
 	
@@ -45,6 +57,13 @@ namespace slib
 	}
 	
 	
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(NetCaptureStatistics)
+	
+	NetCaptureStatistics::NetCaptureStatistics(): countPackets(0), countDrops(0), countFreezes(0)
+	{
+	}
+	
+	
 	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(NetCaptureDeviceInfo)
 	
 	NetCaptureDeviceInfo::NetCaptureDeviceInfo(): flagLoopback(sl_false)
@@ -63,6 +82,14 @@ namespace slib
 		
 		preferedLinkDeviceType = NetworkLinkDeviceType::Ethernet;
 		
+		threadsCount = 1;
+		fanoutMode = NetCaptureFanoutMode::Hash;
+		fanoutGroupId = 0;
+		ringBlockSize = 0x100000; // 1MB
+		ringBlocksCount = 64;
+		ringBlockTimeout = 10;
+		ringTxFramesCount = 256;
+		
 		flagAutoStart = sl_true;
 	}
 	
@@ -87,6 +114,27 @@ namespace slib
 		return sl_null;
 	}
 	
+	sl_bool NetCapture::getStatistics(NetCaptureStatistics& _out)
+	{
+		ListElements<NetCaptureStatistics> list(getRingStatistics());
+		if (!(list.count)) {
+			return sl_false;
+		}
+		NetCaptureStatistics sum;
+		for (sl_size i = 0; i < list.count; i++) {
+			sum.countPackets += list[i].countPackets;
+			sum.countDrops += list[i].countDrops;
+			sum.countFreezes += list[i].countFreezes;
+		}
+		_out = sum;
+		return sl_true;
+	}
+	
+	List<NetCaptureStatistics> NetCapture::getRingStatistics()
+	{
+		return sl_null;
+	}
+	
 	void NetCapture::_initWithParam(const NetCaptureParam& param)
 	{
 		m_onCapturePacket = param.onCapturePacket;
@@ -524,6 +572,473 @@ namespace slib
 	}
 	
 	
+#if defined(SLIB_PLATFORM_IS_LINUX)
+	
+	class _priv_NetPacketRing : public Referable
+	{
+	public:
+		Ref<Socket> socket;
+		Ref<SocketEvent> event;
+		Ref<Thread> thread;
+		
+		sl_uint8* memory;
+		sl_size sizeMemory;
+		sl_uint32 sizeBlock; // RX
+		sl_uint32 countBlocks; // RX
+		sl_uint32 countFrames; // TX
+		sl_uint32 indexFrame; // TX
+		
+		NetCaptureStatistics statistics;
+		Mutex lockStatistics;
+		
+	public:
+		_priv_NetPacketRing()
+		{
+			memory = sl_null;
+			sizeMemory = 0;
+			sizeBlock = 0;
+			countBlocks = 0;
+			countFrames = 0;
+			indexFrame = 0;
+		}
+		
+		~_priv_NetPacketRing()
+		{
+			if (memory) {
+				::munmap(memory, sizeMemory);
+			}
+		}
+		
+	public:
+		static Ref<_priv_NetPacketRing> createRx(NetworkLinkDeviceType deviceType, sl_uint32 iface, const NetCaptureParam& param)
+		{
+			Ref<Socket> socket;
+			if (deviceType == NetworkLinkDeviceType::Raw) {
+				socket = Socket::openPacketDatagram(NetworkLinkProtocol::All);
+			} else {
+				socket = Socket::openPacketRaw(NetworkLinkProtocol::All);
+			}
+			if (socket.isNull()) {
+				LogError(TAG, "Failed to create Packet socket");
+				return sl_null;
+			}
+			int fd = (int)(socket->getHandle());
+			int version = TPACKET_V3;
+			if (::setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+				LogError(TAG, "TPACKET_V3 is not supported");
+				return sl_null;
+			}
+			// block size: power of 2, not less than a page
+			sl_uint32 sizeBlock = (sl_uint32)(::getpagesize());
+			while (sizeBlock < param.ringBlockSize) {
+				sizeBlock <<= 1;
+			}
+			sl_uint32 countBlocks = param.ringBlocksCount;
+			if (countBlocks < 2) {
+				countBlocks = 2;
+			}
+			tpacket_req3 req;
+			Base::zeroMemory(&req, sizeof(req));
+			req.tp_block_size = sizeBlock;
+			req.tp_block_nr = countBlocks;
+			req.tp_frame_size = TPACKET_ALIGNMENT << 7;
+			req.tp_frame_nr = sizeBlock / req.tp_frame_size * countBlocks;
+			req.tp_retire_blk_tov = param.ringBlockTimeout;
+			req.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+			if (::setsockopt(fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
+				LogError(TAG, "Failed to create RX ring: block size=%d, blocks=%d", sizeBlock, countBlocks);
+				return sl_null;
+			}
+			sl_size sizeMemory = (sl_size)sizeBlock * countBlocks;
+			void* memory = ::mmap(sl_null, sizeMemory, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (memory == MAP_FAILED) {
+				LogError(TAG, "Failed to map RX ring");
+				return sl_null;
+			}
+			Ref<_priv_NetPacketRing> ret = new _priv_NetPacketRing;
+			if (ret.isNull()) {
+				::munmap(memory, sizeMemory);
+				return sl_null;
+			}
+			ret->socket = socket;
+			ret->memory = (sl_uint8*)memory;
+			ret->sizeMemory = sizeMemory;
+			ret->sizeBlock = sizeBlock;
+			ret->countBlocks = countBlocks;
+			if (!(ret->bind(iface, NetworkLinkProtocol::All))) {
+				return sl_null;
+			}
+			socket->setNonBlockingMode(sl_true);
+			ret->event = SocketEvent::createRead(socket);
+			if (ret->event.isNull()) {
+				return sl_null;
+			}
+			return ret;
+		}
+		
+		static Ref<_priv_NetPacketRing> createTx(sl_uint32 iface, const NetCaptureParam& param)
+		{
+			// protocol 0: the socket receives nothing
+			Ref<Socket> socket = Socket::open(SocketType::PacketRaw, 0);
+			if (socket.isNull()) {
+				return sl_null;
+			}
+			int fd = (int)(socket->getHandle());
+			int version = TPACKET_V2;
+			if (::setsockopt(fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+				return sl_null;
+			}
+			tpacket_req req;
+			Base::zeroMemory(&req, sizeof(req));
+			req.tp_block_size = PACKET_RING_TX_FRAME_SIZE;
+			req.tp_block_nr = param.ringTxFramesCount;
+			req.tp_frame_size = PACKET_RING_TX_FRAME_SIZE;
+			req.tp_frame_nr = param.ringTxFramesCount;
+			if (::setsockopt(fd, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) < 0) {
+				return sl_null;
+			}
+			sl_size sizeMemory = (sl_size)PACKET_RING_TX_FRAME_SIZE * param.ringTxFramesCount;
+			void* memory = ::mmap(sl_null, sizeMemory, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (memory == MAP_FAILED) {
+				return sl_null;
+			}
+			Ref<_priv_NetPacketRing> ret = new _priv_NetPacketRing;
+			if (ret.isNull()) {
+				::munmap(memory, sizeMemory);
+				return sl_null;
+			}
+			ret->socket = socket;
+			ret->memory = (sl_uint8*)memory;
+			ret->sizeMemory = sizeMemory;
+			ret->countFrames = param.ringTxFramesCount;
+			if (!(ret->bind(iface, (NetworkLinkProtocol)0))) {
+				return sl_null;
+			}
+			return ret;
+		}
+		
+		sl_bool bind(sl_uint32 iface, NetworkLinkProtocol protocol)
+		{
+			sockaddr_ll addr;
+			Base::zeroMemory(&addr, sizeof(addr));
+			addr.sll_family = AF_PACKET;
+			addr.sll_protocol = htons((sl_uint16)protocol);
+			addr.sll_ifindex = (int)iface;
+			if (::bind((int)(socket->getHandle()), (sockaddr*)&addr, sizeof(addr)) < 0) {
+				LogError(TAG, "Failed to bind Packet socket to the interface: %d", iface);
+				return sl_false;
+			}
+			return sl_true;
+		}
+		
+		sl_bool joinFanout(NetCaptureFanoutMode mode, sl_uint16 groupId)
+		{
+			sl_uint32 type = (sl_uint32)mode;
+			if (mode == NetCaptureFanoutMode::Hash) {
+				type |= PACKET_FANOUT_FLAG_DEFRAG;
+			}
+			int arg = (int)(groupId | (type << 16));
+			if (::setsockopt((int)(socket->getHandle()), SOL_PACKET, PACKET_FANOUT, &arg, sizeof(arg)) < 0) {
+				LogError(TAG, "Failed to join the fanout group: %d", groupId);
+				return sl_false;
+			}
+			return sl_true;
+		}
+		
+		NetCaptureStatistics getStatistics()
+		{
+			// the kernel resets the counters on every read
+			tpacket_stats_v3 st;
+			Base::zeroMemory(&st, sizeof(st));
+			socklen_t len = sizeof(st);
+			MutexLocker lock(&lockStatistics);
+			if (::getsockopt((int)(socket->getHandle()), SOL_PACKET, PACKET_STATISTICS, &st, &len) == 0) {
+				statistics.countPackets += st.tp_packets;
+				statistics.countDrops += st.tp_drops;
+				statistics.countFreezes += st.tp_freeze_q_cnt;
+			}
+			return statistics;
+		}
+		
+	};
+	
+	class _priv_NetPacketRingCapture : public NetCapture
+	{
+	public:
+		NetworkLinkDeviceType m_deviceType;
+		sl_uint32 m_ifaceIndex;
+		
+		CList< Ref<_priv_NetPacketRing> > m_rings;
+		AtomicRef<_priv_NetPacketRing> m_ringTx;
+		Mutex m_lockTx;
+		
+		sl_bool m_flagInit;
+		sl_bool m_flagRunning;
+		
+	public:
+		_priv_NetPacketRingCapture()
+		{
+			m_deviceType = NetworkLinkDeviceType::Ethernet;
+			m_ifaceIndex = 0;
+			
+			m_flagInit = sl_false;
+			m_flagRunning = sl_false;
+		}
+		
+		~_priv_NetPacketRingCapture()
+		{
+			release();
+		}
+		
+	public:
+		static Ref<_priv_NetPacketRingCapture> create(const NetCaptureParam& param)
+		{
+			sl_uint32 iface = 0;
+			String deviceName = param.deviceName;
+			if (deviceName.isNotEmpty()) {
+				iface = Network::getInterfaceIndexFromName(deviceName);
+				if (iface == 0) {
+					LogError(TAG, "Failed to find the interface index of device: %s", deviceName);
+					return sl_null;
+				}
+			}
+			NetworkLinkDeviceType deviceType = param.preferedLinkDeviceType;
+			if (deviceType != NetworkLinkDeviceType::Raw) {
+				deviceType = NetworkLinkDeviceType::Ethernet;
+			}
+			sl_uint32 nThreads = param.threadsCount;
+			if (!nThreads) {
+				nThreads = 1;
+			}
+			sl_uint16 groupId = param.fanoutGroupId;
+			if (!groupId) {
+				static sl_int32 counter = 0;
+				groupId = (sl_uint16)(::getpid() + Base::interlockedIncrement32(&counter));
+				if (!groupId) {
+					groupId = 1;
+				}
+			}
+			Ref<_priv_NetPacketRingCapture> ret = new _priv_NetPacketRingCapture;
+			if (ret.isNull()) {
+				return sl_null;
+			}
+			ret->_initWithParam(param);
+			ret->m_deviceType = deviceType;
+			ret->m_ifaceIndex = iface;
+			for (sl_uint32 i = 0; i < nThreads; i++) {
+				Ref<_priv_NetPacketRing> ring = _priv_NetPacketRing::createRx(deviceType, iface, param);
+				if (ring.isNull()) {
+					return sl_null;
+				}
+				if (nThreads > 1) {
+					if (!(ring->joinFanout(param.fanoutMode, groupId))) {
+						return sl_null;
+					}
+				}
+				ring->thread = Thread::create(SLIB_BIND_CLASS(void(), _priv_NetPacketRingCapture, _run, ret.get(), ring.get()));
+				if (ring->thread.isNull()) {
+					LogError(TAG, "Failed to create thread");
+					return sl_null;
+				}
+				ret->m_rings.add_NoLock(ring);
+			}
+			if (iface > 0) {
+				if (param.flagPromiscuous) {
+					Ref<_priv_NetPacketRing> ring;
+					ret->m_rings.getAt_NoLock(0, &ring);
+					if (!(ring->socket->setPromiscuousMode(deviceName, sl_true))) {
+						Log(TAG, "Failed to set promiscuous mode to the network device: %s", deviceName);
+					}
+				}
+				if (deviceType == NetworkLinkDeviceType::Ethernet && param.ringTxFramesCount > 0) {
+					ret->m_ringTx = _priv_NetPacketRing::createTx(iface, param);
+					if (ret->m_ringTx.isNull()) {
+						Log(TAG, "Failed to create TX ring, packets are sent by the socket");
+					}
+				}
+			}
+			ret->m_flagInit = sl_true;
+			if (param.flagAutoStart) {
+				ret->start();
+			}
+			return ret;
+		}
+		
+		void release()
+		{
+			ObjectLocker lock(this);
+			if (!m_flagInit) {
+				return;
+			}
+			m_flagInit = sl_false;
+			
+			m_flagRunning = sl_false;
+			
+			ListElements< Ref<_priv_NetPacketRing> > rings(m_rings);
+			for (sl_size i = 0; i < rings.count; i++) {
+				rings[i]->thread->finish();
+				rings[i]->event->set();
+			}
+			for (sl_size i = 0; i < rings.count; i++) {
+				rings[i]->thread->finishAndWait();
+			}
+			m_rings.removeAll();
+			m_ringTx.setNull();
+		}
+		
+		void start()
+		{
+			ObjectLocker lock(this);
+			if (!m_flagInit) {
+				return;
+			}
+			
+			if (m_flagRunning) {
+				return;
+			}
+			ListElements< Ref<_priv_NetPacketRing> > rings(m_rings);
+			for (sl_size i = 0; i < rings.count; i++) {
+				if (rings[i]->thread->start()) {
+					m_flagRunning = sl_true;
+				}
+			}
+		}
+		
+		sl_bool isRunning()
+		{
+			return m_flagRunning;
+		}
+		
+		void _run(_priv_NetPacketRing* ring)
+		{
+			NetCapturePacket packet;
+			sl_uint32 indexBlock = 0;
+			while (Thread::isNotStoppingCurrent()) {
+				tpacket_block_desc* desc = (tpacket_block_desc*)(ring->memory + (sl_size)indexBlock * ring->sizeBlock);
+				if (!(((volatile sl_uint32&)(desc->hdr.bh1.block_status)) & TP_STATUS_USER)) {
+					ring->event->wait();
+					continue;
+				}
+				__sync_synchronize();
+				sl_uint32 n = desc->hdr.bh1.num_pkts;
+				tpacket3_hdr* hdr = (tpacket3_hdr*)((sl_uint8*)desc + desc->hdr.bh1.offset_to_first_pkt);
+				for (sl_uint32 i = 0; i < n; i++) {
+					packet.data = (sl_uint8*)hdr + hdr->tp_mac;
+					packet.length = hdr->tp_snaplen;
+					packet.time = Time::fromUnixTime(hdr->tp_sec) + (sl_int64)(hdr->tp_nsec / 1000);
+					_onCapturePacket(packet);
+					hdr = (tpacket3_hdr*)((sl_uint8*)hdr + hdr->tp_next_offset);
+				}
+				// returns the block to the kernel
+				__sync_synchronize();
+				((volatile sl_uint32&)(desc->hdr.bh1.block_status)) = TP_STATUS_KERNEL;
+				indexBlock++;
+				if (indexBlock >= ring->countBlocks) {
+					indexBlock = 0;
+				}
+			}
+		}
+		
+		NetworkLinkDeviceType getLinkType()
+		{
+			return m_deviceType;
+		}
+		
+		sl_bool sendPacket(const void* buf, sl_uint32 size)
+		{
+			if (m_ifaceIndex == 0) {
+				return sl_false;
+			}
+			if (!m_flagInit) {
+				return sl_false;
+			}
+			Ref<_priv_NetPacketRing> tx = m_ringTx;
+			if (tx.isNotNull()) {
+				sl_uint32 offsetData = TPACKET2_HDRLEN - sizeof(sockaddr_ll);
+				if (size + offsetData <= PACKET_RING_TX_FRAME_SIZE) {
+					int fd = (int)(tx->socket->getHandle());
+					MutexLocker lock(&m_lockTx);
+					tpacket2_hdr* hdr = (tpacket2_hdr*)(tx->memory + (sl_size)(tx->indexFrame) * PACKET_RING_TX_FRAME_SIZE);
+					volatile sl_uint32& status = (volatile sl_uint32&)(hdr->tp_status);
+					if (status & (TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING)) {
+						// the ring is full: waits until the pending frames are sent
+						::send(fd, sl_null, 0, 0);
+						__sync_synchronize();
+						if (status & (TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING)) {
+							return sl_false;
+						}
+					}
+					Base::copyMemory((sl_uint8*)hdr + offsetData, buf, size);
+					hdr->tp_len = size;
+					__sync_synchronize();
+					status = TP_STATUS_SEND_REQUEST;
+					tx->indexFrame++;
+					if (tx->indexFrame >= tx->countFrames) {
+						tx->indexFrame = 0;
+					}
+					return ::send(fd, sl_null, 0, MSG_DONTWAIT) >= 0 || errno == EAGAIN || errno == ENOBUFS;
+				}
+			}
+			L2PacketInfo info;
+			info.type = L2PacketType::OutGoing;
+			info.iface = m_ifaceIndex;
+			if (m_deviceType == NetworkLinkDeviceType::Ethernet) {
+				EthernetFrame* frame = (EthernetFrame*)buf;
+				if (size < EthernetFrame::HeaderSize) {
+					return sl_false;
+				}
+				info.protocol = frame->getProtocol();
+				info.setMacAddress(frame->getDestinationAddress());
+			} else {
+				info.protocol = NetworkLinkProtocol::IPv4;
+				info.clearAddress();
+			}
+			Ref<Socket> socket = tx.isNotNull() ? tx->socket : _getFirstSocket();
+			if (socket.isNotNull()) {
+				sl_uint32 ret = socket->sendPacket(buf, size, info);
+				if (ret == size) {
+					return sl_true;
+				}
+			}
+			return sl_false;
+		}
+		
+		List<NetCaptureStatistics> getRingStatistics()
+		{
+			List<NetCaptureStatistics> ret;
+			ListElements< Ref<_priv_NetPacketRing> > rings(m_rings);
+			for (sl_size i = 0; i < rings.count; i++) {
+				ret.add_NoLock(rings[i]->getStatistics());
+			}
+			return ret;
+		}
+		
+		Ref<Socket> _getFirstSocket()
+		{
+			Ref<_priv_NetPacketRing> ring;
+			if (m_rings.getAt(0, &ring)) {
+				return ring->socket;
+			}
+			return sl_null;
+		}
+		
+	};
+	
+	Ref<NetCapture> NetCapture::createPacketRing(const NetCaptureParam& param)
+	{
+		return _priv_NetPacketRingCapture::create(param);
+	}
+	
+#else
+	
+	Ref<NetCapture> NetCapture::createPacketRing(const NetCaptureParam& param)
+	{
+		return sl_null;
+	}
+	
+#endif
+	
+	
 	LinuxCookedPacketType LinuxCookedFrame::getPacketType() const
 	{
 		return (LinuxCookedPacketType)(MIO::readUint16BE(m_packetType));
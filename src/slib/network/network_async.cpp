@@ -31,10 +31,23 @@ namespace slib
 			AsyncTcpSocket
 ********************************************/
 
+	SLIB_DEFINE_OBJECT(AsyncTcpSendFileRequest, AsyncStreamRequest)
+	
+	AsyncTcpSendFileRequest::AsyncTcpSendFileRequest(const Ref<File>& _file, sl_uint64 _offset, sl_uint32 size, Referable* userObject, const Function<void(AsyncStreamResult&)>& callback)
+	 : AsyncStreamRequest(sl_null, size, userObject, callback, sl_false), file(_file), offset(_offset)
+	{
+	}
+	
+	AsyncTcpSendFileRequest::~AsyncTcpSendFileRequest()
+	{
+	}
+	
 	AsyncTcpSocketInstance::AsyncTcpSocketInstance()
 	{
 		m_flagRequestConnect = sl_false;
 		m_flagSupportingConnect = sl_true;
+		m_flagSupportingSendFile = sl_false;
+		m_flagSupportingPooledRead = sl_false;
 	}
 
 	AsyncTcpSocketInstance::~AsyncTcpSocketInstance()
@@ -51,6 +64,16 @@ namespace slib
 		return m_flagSupportingConnect;
 	}
 
+	sl_bool AsyncTcpSocketInstance::isSupportingSendFile()
+	{
+		return m_flagSupportingSendFile;
+	}
+
+	sl_bool AsyncTcpSocketInstance::isSupportingPooledRead()
+	{
+		return m_flagSupportingPooledRead;
+	}
+
 	sl_bool AsyncTcpSocketInstance::connect(const SocketAddress& address)
 	{
 		m_flagRequestConnect = sl_true;
@@ -58,6 +81,33 @@ namespace slib
 		return sl_true;
 	}
 
+	sl_bool AsyncTcpSocketInstance::sendFile(const Ref<File>& file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject)
+	{
+		if (!m_flagSupportingSendFile) {
+			return sl_false;
+		}
+		if (file.isNull()) {
+			return sl_false;
+		}
+		Ref<AsyncTcpSendFileRequest> request = new AsyncTcpSendFileRequest(file, offset, size, userObject, callback);
+		if (request.isNotNull()) {
+			return addWriteRequest(Ref<AsyncStreamRequest>::from(request));
+		}
+		return sl_false;
+	}
+
+	sl_bool AsyncTcpSocketInstance::readPooled(sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject)
+	{
+		if (!m_flagSupportingPooledRead) {
+			return sl_false;
+		}
+		Ref<AsyncStreamRequest> request = AsyncStreamRequest::createPooledRead(size, userObject, callback);
+		if (request.isNotNull()) {
+			return addReadRequest(request);
+		}
+		return sl_false;
+	}
+
 	void AsyncTcpSocketInstance::_onReceive(AsyncStreamRequest* req, sl_uint32 size, sl_bool flagError)
 	{
 		Ref<AsyncTcpSocket> object = Ref<AsyncTcpSocket>::from(getObject());
@@ -230,6 +280,48 @@ namespace slib
 		return AsyncStreamBase::write(mem.getData(), (sl_uint32)(mem.getSize()), callback, mem.ref.get());
 	}
 	
+	sl_bool AsyncTcpSocket::isSendFileSupported()
+	{
+		Ref<AsyncTcpSocketInstance> instance = _getIoInstance();
+		if (instance.isNotNull()) {
+			return instance->isSupportingSendFile();
+		}
+		return sl_false;
+	}
+
+	sl_bool AsyncTcpSocket::sendFile(const Ref<File>& file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject)
+	{
+		Ref<AsyncIoLoop> loop = getIoLoop();
+		if (loop.isNull()) {
+			return sl_false;
+		}
+		Ref<AsyncTcpSocketInstance> instance = _getIoInstance();
+		if (instance.isNotNull()) {
+			if (instance->sendFile(file, offset, size, callback, userObject)) {
+				loop->requestOrder(instance.get());
+				return sl_true;
+			}
+		}
+		return sl_false;
+	}
+	
+	sl_bool AsyncTcpSocket::readPooled(sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject)
+	{
+		Ref<AsyncTcpSocketInstance> instance = _getIoInstance();
+		if (instance.isNotNull() && instance->isSupportingPooledRead()) {
+			Ref<AsyncIoLoop> loop = getIoLoop();
+			if (loop.isNull()) {
+				return sl_false;
+			}
+			if (instance->readPooled(size, callback, userObject)) {
+				loop->requestOrder(instance.get());
+				return sl_true;
+			}
+			return sl_false;
+		}
+		return AsyncStream::readPooled(size, callback, userObject);
+	}
+	
 	Ref<AsyncTcpSocketInstance> AsyncTcpSocket::_getIoInstance()
 	{
 		return Ref<AsyncTcpSocketInstance>::from(AsyncStreamBase::getIoInstance());
@@ -472,6 +564,8 @@ namespace slib
 	AsyncUdpSocketInstance::AsyncUdpSocketInstance()
 	{
 		m_flagRunning = sl_false;
+		m_sizePacket = 0;
+		m_countReceiveBatch = 1;
 	}
 
 	AsyncUdpSocketInstance::~AsyncUdpSocketInstance()
@@ -522,6 +616,28 @@ namespace slib
 		return sl_false;
 	}
 
+	sl_bool AsyncUdpSocketInstance::sendTo(const SocketAddress& addressTo, const Memory* packets, sl_uint32 count)
+	{
+		if (isOpened()) {
+			if (m_queueSendRequests.getCount() + count <= UDP_QUEUE_MAX_SIZE) {
+				LinkedQueue<SendRequest> queue;
+				for (sl_uint32 i = 0; i < count; i++) {
+					if (packets[i].isNotNull()) {
+						SendRequest request;
+						request.addressTo = addressTo;
+						request.data = packets[i];
+						if (!(queue.push_NoLock(request))) {
+							return sl_false;
+						}
+					}
+				}
+				m_queueSendRequests.merge(&queue);
+				return sl_true;
+			}
+		}
+		return sl_false;
+	}
+
 	void AsyncUdpSocketInstance::_onReceive(const SocketAddress& address, sl_uint32 size)
 	{
 		Ref<AsyncUdpSocket> object = Ref<AsyncUdpSocket>::from(getObject());
@@ -530,6 +646,14 @@ namespace slib
 		}
 	}
 
+	void AsyncUdpSocketInstance::_onReceive(SocketDatagram* datagrams, sl_uint32 count)
+	{
+		Ref<AsyncUdpSocket> object = Ref<AsyncUdpSocket>::from(getObject());
+		if (object.isNotNull()) {
+			object->_onReceive(datagrams, count);
+		}
+	}
+
 	
 	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(AsyncUdpSocketParam)
 
@@ -540,6 +664,7 @@ namespace slib
 		flagAutoStart = sl_false;
 		flagLogError = sl_false;
 		packetSize = 65536;
+		receiveBatchCount = 1;
 	}
 
 
@@ -595,7 +720,11 @@ namespace slib
 			socket->setOption_Broadcast(sl_true);
 		}
 		
-		Ref<AsyncUdpSocketInstance> instance = _createInstance(socket, param.packetSize);
+		sl_uint32 receiveBatchCount = param.receiveBatchCount;
+		if (receiveBatchCount < 1) {
+			receiveBatchCount = 1;
+		}
+		Ref<AsyncUdpSocketInstance> instance = _createInstance(socket, param.packetSize, receiveBatchCount);
 		if (instance.isNotNull()) {
 			Ref<AsyncIoLoop> loop = param.ioLoop;
 			if (loop.isNull()) {
@@ -607,6 +736,7 @@ namespace slib
 			Ref<AsyncUdpSocket> ret = new AsyncUdpSocket;
 			if (ret.isNotNull()) {
 				ret->m_onReceiveFrom = param.onReceiveFrom;
+				ret->m_onReceiveBatch = param.onReceiveBatch;
 				instance->setObject(ret.get());
 				ret->setIoInstance(instance.get());
 				ret->setIoLoop(loop);
@@ -703,6 +833,22 @@ namespace slib
 		return sl_false;
 	}
 
+	sl_bool AsyncUdpSocket::sendTo(const SocketAddress& addressTo, const Memory* packets, sl_uint32 count)
+	{
+		Ref<AsyncIoLoop> loop = getIoLoop();
+		if (loop.isNull()) {
+			return sl_false;
+		}
+		Ref<AsyncUdpSocketInstance> instance = _getIoInstance();
+		if (instance.isNotNull()) {
+			if (instance->sendTo(addressTo, packets, count)) {
+				loop->requestOrder(instance.get());
+				return sl_true;
+			}
+		}
+		return sl_false;
+	}
+
 	Ref<AsyncUdpSocketInstance> AsyncUdpSocket::_getIoInstance()
 	{
 		return Ref<AsyncUdpSocketInstance>::from(AsyncIoObject::getIoInstance());
@@ -710,7 +856,26 @@ namespace slib
 
 	void AsyncUdpSocket::_onReceive(const SocketAddress& address, void* data, sl_uint32 sizeReceived)
 	{
-		m_onReceiveFrom(this, address, data, sizeReceived);
+		if (m_onReceiveBatch.isNotNull()) {
+			SocketDatagram datagram;
+			datagram.address = address;
+			datagram.data = data;
+			datagram.size = sizeReceived;
+			m_onReceiveBatch(this, &datagram, 1);
+		} else {
+			m_onReceiveFrom(this, address, data, sizeReceived);
+		}
+	}
+
+	void AsyncUdpSocket::_onReceive(SocketDatagram* datagrams, sl_uint32 count)
+	{
+		if (m_onReceiveBatch.isNotNull()) {
+			m_onReceiveBatch(this, datagrams, count);
+		} else {
+			for (sl_uint32 i = 0; i < count; i++) {
+				m_onReceiveFrom(this, datagrams[i].address, datagrams[i].data, datagrams[i].size);
+			}
+		}
 	}
 
 }
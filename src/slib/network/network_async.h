@@ -33,6 +33,21 @@
 
 namespace slib
 {
+	
+	class SLIB_EXPORT AsyncTcpSendFileRequest : public AsyncStreamRequest
+	{
+		SLIB_DECLARE_OBJECT
+		
+	public:
+		Ref<File> file;
+		sl_uint64 offset;
+		
+	public:
+		AsyncTcpSendFileRequest(const Ref<File>& file, sl_uint64 offset, sl_uint32 size, Referable* userObject, const Function<void(AsyncStreamResult&)>& callback);
+		
+		~AsyncTcpSendFileRequest();
+		
+	};
 
 	class SLIB_EXPORT AsyncTcpSocketInstance : public AsyncStreamInstance
 	{
@@ -46,9 +61,17 @@ namespace slib
 		
 		sl_bool isSupportingConnect();
 		
+		sl_bool isSupportingSendFile();
+		
+		sl_bool isSupportingPooledRead();
+		
 	public:
 		sl_bool connect(const SocketAddress& address);
 		
+		sl_bool sendFile(const Ref<File>& file, sl_uint64 offset, sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject);
+		
+		sl_bool readPooled(sl_uint32 size, const Function<void(AsyncStreamResult&)>& callback, Referable* userObject);
+		
 	protected:
 		void _onReceive(AsyncStreamRequest* req, sl_uint32 size, sl_bool flagError);
 		
@@ -60,6 +83,8 @@ namespace slib
 		AtomicRef<Socket> m_socket;
 		
 		sl_bool m_flagSupportingConnect;
+		sl_bool m_flagSupportingSendFile;
+		sl_bool m_flagSupportingPooledRead;
 		sl_bool m_flagRequestConnect;
 		SocketAddress m_addressRequestConnect;
 		
@@ -111,14 +136,20 @@ namespace slib
 		
 		sl_bool sendTo(const SocketAddress& address, const Memory& data);
 		
+		sl_bool sendTo(const SocketAddress& address, const Memory* packets, sl_uint32 count);
+		
 	protected:
 		void _onReceive(const SocketAddress& address, sl_uint32 size);
 		
+		void _onReceive(SocketDatagram* datagrams, sl_uint32 count);
+		
 	protected:
 		AtomicRef<Socket> m_socket;
 
 		sl_bool m_flagRunning;
-		Memory m_buffer;
+		Memory m_buffer; // `m_countReceiveBatch` packets
+		sl_uint32 m_sizePacket;
+		sl_uint32 m_countReceiveBatch;
 		
 		struct SendRequest
 		{
@@ -26,6 +26,15 @@
 
 #include "network_async.h"
 
+#include "slib/core/new_helper.h"
+
+#if defined(SLIB_PLATFORM_IS_LINUX)
+#	include <sys/sendfile.h>
+#	include <errno.h>
+#endif
+
+#define UDP_SEND_BATCH_COUNT 64
+
 namespace slib
 {
 
@@ -62,6 +71,10 @@ namespace slib
 						if (ret.isNotNull()) {
 							ret->m_socket = socket;
 							ret->setHandle(handle);
+#if defined(SLIB_PLATFORM_IS_LINUX)
+							ret->m_flagSupportingSendFile = sl_true;
+#endif
+							ret->m_flagSupportingPooledRead = sl_true;
 							return ret;
 						}
 					}
@@ -76,6 +89,26 @@ namespace slib
 			m_socket.setNull();
 		}
 		
+		// returns positive: sent size, 0: would block, negative: error
+		sl_int64 sendFile(Socket* socket, AsyncTcpSendFileRequest* request, sl_uint32 size)
+		{
+#if defined(SLIB_PLATFORM_IS_LINUX)
+			Ref<File> file = request->file;
+			if (file.isNull()) {
+				return -1;
+			}
+			off_t offset = (off_t)(request->offset + m_sizeWritten);
+			ssize_t n = ::sendfile((int)(socket->getHandle()), (int)(file->getHandle()), &offset, size);
+			if (n > 0) {
+				return n;
+			}
+			if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+				return 0;
+			}
+#endif
+			return -1;
+		}
+		
 		void processRead(sl_bool flagError)
 		{
 			Ref<Socket> socket = m_socket;
@@ -97,14 +130,34 @@ namespace slib
 						return;
 					}
 				}
-				if (request->data && request->size) {
-					sl_int32 n = socket->receive((char*)(request->data), request->size);
+				if (request->size && (request->data || request->flagBorrowBuffer)) {
+					Memory mem;
+					void* data = request->data;
+					if (request->flagBorrowBuffer) {
+						mem = AsyncBufferPool::borrow(request->size);
+						data = mem.getData();
+						if (!data) {
+							_onReceive(request.get(), 0, sl_true);
+							return;
+						}
+					}
+					sl_int32 n = socket->receive((char*)data, request->size);
 					if (n > 0) {
-						_onReceive(request.get(), n, flagError);
+						if (mem.isNotNull()) {
+							request->data = data;
+							_onReceive(request.get(), n, flagError);
+							request->data = sl_null;
+							AsyncBufferPool::release(mem);
+						} else {
+							_onReceive(request.get(), n, flagError);
+						}
 					} else if (n < 0) {
+						AsyncBufferPool::release(mem);
 						_onReceive(request.get(), 0, sl_true);
 						return;
 					} else {
+						// give back the buffer while waiting, so that the idle connection holds no buffer
+						AsyncBufferPool::release(mem);
 						if (flagError) {
 							_onReceive(request.get(), 0, sl_true);
 						} else {
@@ -142,7 +195,31 @@ namespace slib
 						return;
 					}
 				}
-				if (request->data && request->size) {
+				if (IsInstanceOf<AsyncTcpSendFileRequest>(request)) {
+					if (request->size) {
+						sl_int64 n = sendFile(socket.get(), (AsyncTcpSendFileRequest*)(request.get()), request->size - m_sizeWritten);
+						if (n > 0) {
+							m_sizeWritten += (sl_uint32)n;
+							if (m_sizeWritten >= request->size) {
+								_onSend(request.get(), request->size, flagError);
+							} else {
+								m_requestWriting = request;
+							}
+						} else if (n < 0) {
+							_onSend(request.get(), m_sizeWritten, sl_true);
+							return;
+						} else {
+							if (flagError) {
+								_onSend(request.get(), m_sizeWritten, sl_true);
+							} else {
+								m_requestWriting = request;
+							}
+							return;
+						}
+					} else {
+						_onSend(request.get(), 0, sl_false);
+					}
+				} else if (request->data && request->size) {
 					sl_uint32 size = request->size - m_sizeWritten;
 					sl_int32 n = socket->send((char*)(request->data) + m_sizeWritten, size);
 					if (n > 0) {
@@ -314,29 +391,48 @@ namespace slib
 
 	class _priv_Unix_AsyncUdpSocketInstance : public AsyncUdpSocketInstance
 	{
+	public:
+		SocketDatagram* m_datagrams;
+		
 	public:
 		_priv_Unix_AsyncUdpSocketInstance()
 		{
+			m_datagrams = sl_null;
 		}
 		
 		~_priv_Unix_AsyncUdpSocketInstance()
 		{
 			close();
+			if (m_datagrams) {
+				NewHelper<SocketDatagram>::free(m_datagrams, m_countReceiveBatch);
+			}
 		}
 		
 	public:
-		static Ref<_priv_Unix_AsyncUdpSocketInstance> create(const Ref<Socket>& socket, const Memory& buffer)
+		static Ref<_priv_Unix_AsyncUdpSocketInstance> create(const Ref<Socket>& socket, sl_uint32 packetSize, sl_uint32 receiveBatchCount)
 		{
 			Ref<_priv_Unix_AsyncUdpSocketInstance> ret;
 			if (socket.isNotNull()) {
 				if (socket->setNonBlockingMode(sl_true)) {
 					sl_file handle = (sl_file)(socket->getHandle());
 					if (handle != SLIB_FILE_INVALID_HANDLE) {
+						Memory buffer = Memory::create((sl_size)packetSize * receiveBatchCount);
+						if (buffer.isNull()) {
+							return sl_null;
+						}
 						ret = new _priv_Unix_AsyncUdpSocketInstance();
 						if (ret.isNotNull()) {
+							if (receiveBatchCount > 1) {
+								ret->m_datagrams = NewHelper<SocketDatagram>::create(receiveBatchCount);
+								if (!(ret->m_datagrams)) {
+									return sl_null;
+								}
+							}
 							ret->m_socket = socket;
 							ret->setHandle(handle);
 							ret->m_buffer = buffer;
+							ret->m_sizePacket = packetSize;
+							ret->m_countReceiveBatch = receiveBatchCount;
 							return ret;
 						}
 					}
@@ -374,13 +470,34 @@ namespace slib
 			if (!(socket->isOpened())) {
 				return;
 			}
+			SendRequest requests[UDP_SEND_BATCH_COUNT];
+			SocketDatagram datagrams[UDP_SEND_BATCH_COUNT];
 			while (Thread::isNotStoppingCurrent()) {
-				SendRequest request;
-				if (m_queueSendRequests.pop(&request)) {
-					socket->sendTo(request.addressTo, request.data.getData(), (sl_uint32)(request.data.getSize()));
-				} else {
+				sl_uint32 n = 0;
+				while (n < UDP_SEND_BATCH_COUNT && m_queueSendRequests.pop(requests + n)) {
+					datagrams[n].address = requests[n].addressTo;
+					datagrams[n].data = requests[n].data.getData();
+					datagrams[n].size = (sl_uint32)(requests[n].data.getSize());
+					n++;
+				}
+				if (!n) {
 					break;
 				}
+				// as `sendTo` of a single datagram, the datagrams which can not be sent are dropped
+				sl_uint32 offset = 0;
+				while (offset < n) {
+					sl_int32 nSent = socket->sendTo(datagrams + offset, n - offset);
+					if (nSent > 0) {
+						offset += nSent;
+					} else if (nSent < 0) {
+						offset++;
+					} else {
+						break;
+					}
+				}
+				for (sl_uint32 i = 0; i < n; i++) {
+					requests[i].data.setNull();
+				}
 			}
 		}
 		
@@ -393,28 +510,41 @@ namespace slib
 			if (!(socket->isOpened())) {
 				return;
 			}
-			void* buf = m_buffer.getData();
-			sl_uint32 sizeBuf = (sl_uint32)(m_buffer.getSize());
-			while (Thread::isNotStoppingCurrent()) {
-				SocketAddress addr;
-				sl_int32 n = socket->receiveFrom(addr, buf, sizeBuf);
-				if (n > 0) {
-					_onReceive(addr, n);
-				} else {
-					break;
+			sl_uint8* buf = (sl_uint8*)(m_buffer.getData());
+			if (m_datagrams) {
+				sl_uint32 nBatch = m_countReceiveBatch;
+				sl_uint32 sizePacket = m_sizePacket;
+				while (Thread::isNotStoppingCurrent()) {
+					for (sl_uint32 i = 0; i < nBatch; i++) {
+						m_datagrams[i].data = buf + (sl_size)i * sizePacket;
+						m_datagrams[i].size = sizePacket;
+					}
+					sl_int32 n = socket->receiveFrom(m_datagrams, nBatch);
+					if (n > 0) {
+						_onReceive(m_datagrams, n);
+					} else {
+						break;
+					}
+				}
+			} else {
+				sl_uint32 sizeBuf = m_sizePacket;
+				while (Thread::isNotStoppingCurrent()) {
+					SocketAddress addr;
+					sl_int32 n = socket->receiveFrom(addr, buf, sizeBuf);
+					if (n > 0) {
+						_onReceive(addr, n);
+					} else {
+						break;
+					}
 				}
 			}
 		}
 
 	};
 
-	Ref<AsyncUdpSocketInstance> AsyncUdpSocket::_createInstance(const Ref<Socket>& socket, sl_uint32 packetSize)
+	Ref<AsyncUdpSocketInstance> AsyncUdpSocket::_createInstance(const Ref<Socket>& socket, sl_uint32 packetSize, sl_uint32 receiveBatchCount)
 	{
-		Memory buffer = Memory::create(packetSize);
-		if (buffer.isNotNull()) {
-			return _priv_Unix_AsyncUdpSocketInstance::create(socket, buffer);
-		}
-		return sl_null;
+		return _priv_Unix_AsyncUdpSocketInstance::create(socket, packetSize, receiveBatchCount);
 	}
 }
 
@@ -496,6 +496,7 @@ namespace slib
 							ret->m_socket = socket;
 							ret->setHandle(handle);
 							ret->m_buffer = buffer;
+							ret->m_sizePacket = (sl_uint32)(buffer.getSize());
 							return ret;
 						}
 					}
@@ -613,8 +614,9 @@ namespace slib
 
 	};
 
-	Ref<AsyncUdpSocketInstance> AsyncUdpSocket::_createInstance(const Ref<Socket>& socket, sl_uint32 packetSize)
+	Ref<AsyncUdpSocketInstance> AsyncUdpSocket::_createInstance(const Ref<Socket>& socket, sl_uint32 packetSize, sl_uint32 receiveBatchCount)
 	{
+		// overlapped receiving delivers one datagram per completion
 		Memory buffer = Memory::create(packetSize);
 		if (buffer.isNotNull()) {
 			return _priv_Win32AsyncUdpSocketInstance::create(socket, buffer);
@@ -49,9 +49,29 @@ typedef int SOCKET;
 #	define SOCKET_ERROR -1
 #endif
 
+#if defined(SLIB_PLATFORM_IS_LINUX)
+#	if !defined(SOL_UDP)
+#		define SOL_UDP 17
+#	endif
+#	if !defined(UDP_SEGMENT)
+#		define UDP_SEGMENT 103
+#	endif
+#	include <atomic>
+#endif
+
+// maximum number of datagrams passed to one system call
+#define PRIV_SOCKET_BATCH_MAX 64
+#define PRIV_SOCKET_GSO_SEGMENTS_MAX 64
+#define PRIV_SOCKET_GSO_SIZE_MAX 65000
+
 namespace slib
 {
 
+#if defined(SLIB_PLATFORM_IS_LINUX)
+	// cleared when the kernel or the device rejects UDP GSO
+	static std::atomic<sl_bool> _g_priv_socket_flagSupportedGSO(sl_true);
+#endif
+
 	void L2PacketInfo::setMacAddress(const MacAddress& address)
 	{
 		lenHardwareAddress = 6;
@@ -77,6 +97,15 @@ namespace slib
 		lenHardwareAddress = 0;
 		Base::zeroMemory(hardwareAddress, 8);
 	}
+	
+	
+	SLIB_DEFINE_CLASS_DEFAULT_MEMBERS(SocketDatagram)
+	
+	SocketDatagram::SocketDatagram()
+	{
+		data = sl_null;
+		size = 0;
+	}
 
 
 	SLIB_INLINE static sl_uint32 _priv_Socket_apply_address(SocketType type, sockaddr_storage& addr, SocketAddress in)
@@ -642,6 +671,196 @@ namespace slib
 		}
 	}
 
+	sl_int32 Socket::sendTo(const SocketDatagram* datagrams, sl_uint32 count)
+	{
+		if (!(isOpened())) {
+			_setClosedError();
+			return -1;
+		}
+		if (!(isDatagram() || isRaw())) {
+			_setError(SocketError::SendToIsNotSupported);
+			return -1;
+		}
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		sl_bool flagGSO = _g_priv_socket_flagSupportedGSO.load(std::memory_order_relaxed) && (m_type == SocketType::Datagram || m_type == SocketType::DatagramIPv6);
+		mmsghdr msgs[PRIV_SOCKET_BATCH_MAX];
+		iovec iovs[PRIV_SOCKET_BATCH_MAX];
+		sockaddr_storage addrs[PRIV_SOCKET_BATCH_MAX];
+		sl_uint64 controls[PRIV_SOCKET_BATCH_MAX][(CMSG_SPACE(sizeof(sl_uint16)) + 7) / 8];
+		sl_uint32 countsDatagram[PRIV_SOCKET_BATCH_MAX];
+		sl_uint32 nSent = 0;
+		while (nSent < count) {
+			Base::zeroMemory(msgs, sizeof(msgs));
+			sl_uint32 nMsgs = 0;
+			sl_uint32 nIovs = 0;
+			sl_bool flagSegmented = sl_false;
+			sl_uint32 i = nSent;
+			while (i < count && nIovs < PRIV_SOCKET_BATCH_MAX) {
+				const SocketDatagram& datagram = datagrams[i];
+				if (!(datagram.size)) {
+					// skipped as by `sendTo(address, buf, 0)`, and counted as sent with the preceding message
+					if (nMsgs) {
+						countsDatagram[nMsgs - 1]++;
+					} else {
+						nSent++;
+					}
+					i++;
+					continue;
+				}
+				sl_uint32 sizeAddr = _priv_Socket_apply_address(m_type, addrs[nMsgs], datagram.address);
+				if (!sizeAddr) {
+					break;
+				}
+				msghdr& hdr = msgs[nMsgs].msg_hdr;
+				hdr.msg_name = &(addrs[nMsgs]);
+				hdr.msg_namelen = (socklen_t)sizeAddr;
+				hdr.msg_iov = iovs + nIovs;
+				iovs[nIovs].iov_base = datagram.data;
+				iovs[nIovs].iov_len = datagram.size;
+				nIovs++;
+				sl_uint32 nSegments = 1;
+				if (flagGSO) {
+					sl_uint32 sizeTotal = datagram.size;
+					while (i + nSegments < count && nIovs < PRIV_SOCKET_BATCH_MAX && nSegments < PRIV_SOCKET_GSO_SEGMENTS_MAX) {
+						const SocketDatagram& next = datagrams[i + nSegments];
+						if (!(next.size) || next.size > datagram.size || sizeTotal + next.size > PRIV_SOCKET_GSO_SIZE_MAX) {
+							break;
+						}
+						if (next.address != datagram.address) {
+							break;
+						}
+						iovs[nIovs].iov_base = next.data;
+						iovs[nIovs].iov_len = next.size;
+						nIovs++;
+						nSegments++;
+						sizeTotal += next.size;
+						if (next.size < datagram.size) {
+							// only the last segment can be shorter
+							break;
+						}
+					}
+					if (nSegments > 1) {
+						hdr.msg_control = controls[nMsgs];
+						hdr.msg_controllen = CMSG_SPACE(sizeof(sl_uint16));
+						cmsghdr* cm = CMSG_FIRSTHDR(&hdr);
+						cm->cmsg_level = SOL_UDP;
+						cm->cmsg_type = UDP_SEGMENT;
+						cm->cmsg_len = CMSG_LEN(sizeof(sl_uint16));
+						*((sl_uint16*)CMSG_DATA(cm)) = (sl_uint16)(datagram.size);
+						flagSegmented = sl_true;
+					}
+				}
+				hdr.msg_iovlen = nSegments;
+				countsDatagram[nMsgs] = nSegments;
+				nMsgs++;
+				i += nSegments;
+			}
+			if (!nMsgs) {
+				if (nSent >= count) {
+					break;
+				}
+				// invalid address
+				if (nSent) {
+					return nSent;
+				}
+				_setError(SocketError::DestinationAddressRequired);
+				return -1;
+			}
+			int ret = ::sendmmsg((SOCKET)(m_socket), msgs, nMsgs, 0);
+			if (ret < 0) {
+				int err = errno;
+				if (flagSegmented && msgs[0].msg_hdr.msg_control && (err == EIO || err == EINVAL || err == ENOPROTOOPT || err == EOPNOTSUPP)) {
+					_g_priv_socket_flagSupportedGSO.store(sl_false, std::memory_order_relaxed);
+					flagGSO = sl_false;
+					continue;
+				}
+				if (_checkError() == SocketError::WouldBlock || nSent) {
+					return nSent;
+				}
+				return -1;
+			}
+			for (int k = 0; k < ret; k++) {
+				nSent += countsDatagram[k];
+			}
+			if ((sl_uint32)ret < nMsgs) {
+				break;
+			}
+		}
+		return nSent;
+#else
+		sl_uint32 nSent = 0;
+		for (; nSent < count; nSent++) {
+			const SocketDatagram& datagram = datagrams[nSent];
+			if (datagram.size) {
+				sl_int32 ret = sendTo(datagram.address, datagram.data, datagram.size);
+				if (ret <= 0) {
+					if (ret < 0 && !nSent) {
+						return -1;
+					}
+					break;
+				}
+			}
+		}
+		return nSent;
+#endif
+	}
+	
+	sl_int32 Socket::receiveFrom(SocketDatagram* datagrams, sl_uint32 count)
+	{
+		if (!(isOpened())) {
+			_setClosedError();
+			return -1;
+		}
+		if (!(isDatagram() || isRaw())) {
+			_setError(SocketError::ReceiveFromIsNotSupported);
+			return -1;
+		}
+#if defined(SLIB_PLATFORM_IS_LINUX)
+		if (count > PRIV_SOCKET_BATCH_MAX) {
+			count = PRIV_SOCKET_BATCH_MAX;
+		}
+		mmsghdr msgs[PRIV_SOCKET_BATCH_MAX];
+		iovec iovs[PRIV_SOCKET_BATCH_MAX];
+		sockaddr_storage addrs[PRIV_SOCKET_BATCH_MAX];
+		Base::zeroMemory(msgs, sizeof(mmsghdr) * count);
+		for (sl_uint32 i = 0; i < count; i++) {
+			iovs[i].iov_base = datagrams[i].data;
+			iovs[i].iov_len = datagrams[i].size;
+			msghdr& hdr = msgs[i].msg_hdr;
+			hdr.msg_name = &(addrs[i]);
+			hdr.msg_namelen = sizeof(sockaddr_storage);
+			hdr.msg_iov = iovs + i;
+			hdr.msg_iovlen = 1;
+		}
+		int ret = ::recvmmsg((SOCKET)(m_socket), msgs, count, 0, sl_null);
+		if (ret < 0) {
+			if (_checkError() == SocketError::WouldBlock) {
+				return 0;
+			}
+			return -1;
+		}
+		for (int i = 0; i < ret; i++) {
+			datagrams[i].address.setSystemSocketAddress(&(addrs[i]), msgs[i].msg_hdr.msg_namelen);
+			datagrams[i].size = msgs[i].msg_len;
+		}
+		return ret;
+#else
+		sl_uint32 nReceived = 0;
+		for (; nReceived < count; nReceived++) {
+			SocketDatagram& datagram = datagrams[nReceived];
+			sl_int32 ret = receiveFrom(datagram.address, datagram.data, datagram.size);
+			if (ret <= 0) {
+				if (ret < 0 && !nReceived) {
+					return -1;
+				}
+				break;
+			}
+			datagram.size = ret;
+		}
+		return nReceived;
+#endif
+	}
+
 	sl_int32 Socket::sendPacket(const void* buf, sl_uint32 size, const L2PacketInfo& info)
 	{
 #if defined(SLIB_PLATFORM_IS_LINUX)
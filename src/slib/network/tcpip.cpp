@@ -23,31 +23,264 @@
 #include "slib/network/tcpip.h"
 
 #include "slib/core/mio.h"
+#include "slib/core/endian.h"
+#include "slib/core/detail/simd.h"
+
+#include <string.h>
+
+#if defined(SLIB_ARCH_IS_X64) || (defined(SLIB_ARCH_IS_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#	define PRIV_TCPIP_SIMD_X86
+#	include <emmintrin.h>
+#	include <immintrin.h>
+#	if defined(__GNUC__) || defined(__clang__)
+#		define PRIV_TARGET_AVX2 __attribute__((target("avx2")))
+#	else
+#		define PRIV_TARGET_AVX2
+#	endif
+#elif defined(SLIB_ARCH_IS_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define PRIV_TCPIP_SIMD_NEON
+#	include <arm_neon.h>
+#endif
+
+// 32-bit lanes take 2 words of 16-bit per block, so they are flushed before they can overflow
+#define PRIV_TCPIP_SIMD_FLUSH_BLOCKS 16384
 
 namespace slib
 {
-
-	sl_uint16 TCP_IP::calculateOneComplementSum(const void* data, sl_size size, sl_uint32 add)
-	{
-		sl_uint32 sum = add;
-		sl_uint8* p = (sl_uint8*)data;
-		while (size > 1) {
-			sl_uint16 w = *((sl_uint8*)(p));
-			w = (w << 8) | *((sl_uint8*)(p + 1));
-			sum += w; // can be computed in either byte order
-			p += 2;
+	
+	/*
+		The kernels sum the 16-bit words in the host byte order, which gives the
+		byte-swapped one's complement sum on little-endian hosts (RFC 1071, 2.B).
+		The returned value is not folded.
+	*/
+	
+	template <sl_bool FLAG_COPY>
+	SLIB_INLINE static sl_uint64 _priv_TCPIP_sum_Scalar(sl_uint8* dst, const sl_uint8* src, sl_size size)
+	{
+		sl_uint64 sum = 0;
+		while (size >= 8) {
+			sl_uint32 w[2];
+			memcpy(w, src, 8);
+			if (FLAG_COPY) {
+				memcpy(dst, w, 8);
+				dst += 8;
+			}
+			sum += w[0];
+			sum += w[1];
+			src += 8;
+			size -= 8;
+		}
+		while (size >= 2) {
+			sl_uint16 w;
+			memcpy(&w, src, 2);
+			if (FLAG_COPY) {
+				memcpy(dst, &w, 2);
+				dst += 2;
+			}
+			sum += w;
+			src += 2;
 			size -= 2;
 		}
 		if (size) {
-			sl_uint16 w = *((sl_uint8*)p);
-			w = w << 8;
-			sum += w;
+			sl_uint8 b = *src;
+			if (FLAG_COPY) {
+				*dst = b;
+			}
+			if (Endian::isLE()) {
+				sum += b;
+			} else {
+				sum += (sl_uint16)b << 8;
+			}
 		}
-		while (sum >> 16) {
-			sum = (sum >> 16) + (sum & 0xffff); // 1's complement sum
+		return sum;
+	}
+	
+#if defined(PRIV_TCPIP_SIMD_X86)
+	SLIB_INLINE static sl_uint64 _priv_TCPIP_reduce_SSE2(__m128i v)
+	{
+		sl_uint32 w[4];
+		_mm_storeu_si128((__m128i*)w, v);
+		return (sl_uint64)(w[0]) + w[1] + w[2] + w[3];
+	}
+	
+	// processes 32 bytes per block
+	template <sl_bool FLAG_COPY>
+	static sl_uint64 _priv_TCPIP_sum_SSE2(sl_uint8* dst, const sl_uint8* src, sl_size nBlocks)
+	{
+		sl_uint64 sum = 0;
+		__m128i zero = _mm_setzero_si128();
+		while (nBlocks) {
+			sl_size n = nBlocks < PRIV_TCPIP_SIMD_FLUSH_BLOCKS ? nBlocks : PRIV_TCPIP_SIMD_FLUSH_BLOCKS;
+			nBlocks -= n;
+			__m128i acc0 = zero;
+			__m128i acc1 = zero;
+			for (sl_size i = 0; i < n; i++) {
+				__m128i v0 = _mm_loadu_si128((const __m128i*)src);
+				__m128i v1 = _mm_loadu_si128((const __m128i*)(src + 16));
+				if (FLAG_COPY) {
+					_mm_storeu_si128((__m128i*)dst, v0);
+					_mm_storeu_si128((__m128i*)(dst + 16), v1);
+					dst += 32;
+				}
+				acc0 = _mm_add_epi32(acc0, _mm_unpacklo_epi16(v0, zero));
+				acc1 = _mm_add_epi32(acc1, _mm_unpackhi_epi16(v0, zero));
+				acc0 = _mm_add_epi32(acc0, _mm_unpacklo_epi16(v1, zero));
+				acc1 = _mm_add_epi32(acc1, _mm_unpackhi_epi16(v1, zero));
+				src += 32;
+			}
+			sum += _priv_TCPIP_reduce_SSE2(acc0) + _priv_TCPIP_reduce_SSE2(acc1);
+		}
+		return sum;
+	}
+	
+	// processes 64 bytes per block
+	template <sl_bool FLAG_COPY>
+	PRIV_TARGET_AVX2 static sl_uint64 _priv_TCPIP_sum_AVX2(sl_uint8* dst, const sl_uint8* src, sl_size nBlocks)
+	{
+		sl_uint64 sum = 0;
+		__m256i zero = _mm256_setzero_si256();
+		while (nBlocks) {
+			sl_size n = nBlocks < PRIV_TCPIP_SIMD_FLUSH_BLOCKS ? nBlocks : PRIV_TCPIP_SIMD_FLUSH_BLOCKS;
+			nBlocks -= n;
+			__m256i acc0 = zero;
+			__m256i acc1 = zero;
+			for (sl_size i = 0; i < n; i++) {
+				__m256i v0 = _mm256_loadu_si256((const __m256i*)src);
+				__m256i v1 = _mm256_loadu_si256((const __m256i*)(src + 32));
+				if (FLAG_COPY) {
+					_mm256_storeu_si256((__m256i*)dst, v0);
+					_mm256_storeu_si256((__m256i*)(dst + 32), v1);
+					dst += 64;
+				}
+				acc0 = _mm256_add_epi32(acc0, _mm256_unpacklo_epi16(v0, zero));
+				acc1 = _mm256_add_epi32(acc1, _mm256_unpackhi_epi16(v0, zero));
+				acc0 = _mm256_add_epi32(acc0, _mm256_unpacklo_epi16(v1, zero));
+				acc1 = _mm256_add_epi32(acc1, _mm256_unpackhi_epi16(v1, zero));
+				src += 64;
+			}
+			__m256i acc = _mm256_add_epi64(_mm256_unpacklo_epi32(acc0, zero), _mm256_unpackhi_epi32(acc0, zero));
+			acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(acc1, zero));
+			acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(acc1, zero));
+			sl_uint64 w[4];
+			_mm256_storeu_si256((__m256i*)w, acc);
+			sum += w[0] + w[1] + w[2] + w[3];
 		}
 		return sum;
 	}
+#endif
+	
+#if defined(PRIV_TCPIP_SIMD_NEON)
+	// processes 32 bytes per block
+	template <sl_bool FLAG_COPY>
+	static sl_uint64 _priv_TCPIP_sum_NEON(sl_uint8* dst, const sl_uint8* src, sl_size nBlocks)
+	{
+		sl_uint64 sum = 0;
+		while (nBlocks) {
+			sl_size n = nBlocks < PRIV_TCPIP_SIMD_FLUSH_BLOCKS ? nBlocks : PRIV_TCPIP_SIMD_FLUSH_BLOCKS;
+			nBlocks -= n;
+			uint32x4_t acc0 = vdupq_n_u32(0);
+			uint32x4_t acc1 = vdupq_n_u32(0);
+			for (sl_size i = 0; i < n; i++) {
+				uint8x16_t v0 = vld1q_u8(src);
+				uint8x16_t v1 = vld1q_u8(src + 16);
+				if (FLAG_COPY) {
+					vst1q_u8(dst, v0);
+					vst1q_u8(dst + 16, v1);
+					dst += 32;
+				}
+				acc0 = vpadalq_u16(acc0, vreinterpretq_u16_u8(v0));
+				acc1 = vpadalq_u16(acc1, vreinterpretq_u16_u8(v1));
+				src += 32;
+			}
+			uint64x2_t acc = vaddq_u64(vpaddlq_u32(acc0), vpaddlq_u32(acc1));
+			sum += vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1);
+		}
+		return sum;
+	}
+#endif
+	
+	template <sl_bool FLAG_COPY>
+	static sl_uint16 _priv_TCPIP_calculateOneComplementSum(sl_uint8* dst, const sl_uint8* src, sl_size size, sl_uint32 add)
+	{
+		sl_uint64 sum = 0;
+#if defined(PRIV_TCPIP_SIMD_X86)
+		_priv_Simd::Level level = _priv_Simd::getLevel();
+		if (size >= 256 && level >= _priv_Simd::AVX2) {
+			sl_size nBlocks = size >> 6;
+			sum = _priv_TCPIP_sum_AVX2<FLAG_COPY>(dst, src, nBlocks);
+			nBlocks <<= 6;
+			src += nBlocks;
+			if (FLAG_COPY) {
+				dst += nBlocks;
+			}
+			size -= nBlocks;
+		}
+		if (size >= 32 && level != _priv_Simd::None) {
+			sl_size nBlocks = size >> 5;
+			sum += _priv_TCPIP_sum_SSE2<FLAG_COPY>(dst, src, nBlocks);
+			nBlocks <<= 5;
+			src += nBlocks;
+			if (FLAG_COPY) {
+				dst += nBlocks;
+			}
+			size -= nBlocks;
+		}
+#elif defined(PRIV_TCPIP_SIMD_NEON)
+		if (size >= 32 && _priv_Simd::getLevel() != _priv_Simd::None) {
+			sl_size nBlocks = size >> 5;
+			sum = _priv_TCPIP_sum_NEON<FLAG_COPY>(dst, src, nBlocks);
+			nBlocks <<= 5;
+			src += nBlocks;
+			if (FLAG_COPY) {
+				dst += nBlocks;
+			}
+			size -= nBlocks;
+		}
+#endif
+		sum += _priv_TCPIP_sum_Scalar<FLAG_COPY>(dst, src, size);
+		sum = (sum >> 32) + (sum & 0xffffffff);
+		sum = (sum >> 32) + (sum & 0xffffffff);
+		sl_uint32 s = (sl_uint32)sum;
+		s = (s >> 16) + (s & 0xffff);
+		s = (s >> 16) + (s & 0xffff);
+		if (Endian::isLE()) {
+			s = ((s & 0xff) << 8) | (s >> 8);
+		}
+		s += (add >> 16) + (add & 0xffff);
+		while (s >> 16) {
+			s = (s >> 16) + (s & 0xffff); // 1's complement sum
+		}
+		return (sl_uint16)s;
+	}
+	
+	// one's complement sum of a header without options
+	SLIB_INLINE static sl_uint16 _priv_TCPIP_sumHeader(const void* header, sl_size size)
+	{
+		if (size == IPv4Packet::HeaderSizeBeforeOptions) {
+			sl_uint32 w[5];
+			memcpy(w, header, 20);
+			sl_uint64 sum = (sl_uint64)(w[0]) + w[1] + w[2] + w[3] + w[4];
+			sum = (sum >> 32) + (sum & 0xffffffff);
+			sl_uint32 s = (sl_uint32)((sum >> 32) + (sum & 0xffffffff));
+			s = (s >> 16) + (s & 0xffff);
+			s = (s >> 16) + (s & 0xffff);
+			if (Endian::isLE()) {
+				s = ((s & 0xff) << 8) | (s >> 8);
+			}
+			return (sl_uint16)s;
+		}
+		return TCP_IP::calculateOneComplementSum(header, size);
+	}
+
+	sl_uint16 TCP_IP::calculateOneComplementSum(const void* data, sl_size size, sl_uint32 add)
+	{
+		return _priv_TCPIP_calculateOneComplementSum<sl_false>(sl_null, (const sl_uint8*)data, size, add);
+	}
+	
+	sl_uint16 TCP_IP::copyAndCalculateOneComplementSum(void* dst, const void* src, sl_size size, sl_uint32 add)
+	{
+		return _priv_TCPIP_calculateOneComplementSum<sl_true>((sl_uint8*)dst, (const sl_uint8*)src, size, add);
+	}
 	
 	// Referenced from RFC 1071
 	sl_uint16 TCP_IP::calculateChecksum(const void* data, sl_size size)
@@ -56,12 +289,31 @@ namespace slib
 		return (sl_uint16)(~sum); // 1's complement
 	}
 	
+	// Referenced from RFC 1624: HC' = ~(~HC + ~m + m')
+	sl_uint16 TCP_IP::adjustChecksum(sl_uint16 checksum, sl_uint16 valueOld, sl_uint16 valueNew)
+	{
+		sl_uint32 sum = (sl_uint16)(~checksum);
+		sum += (sl_uint16)(~valueOld);
+		sum += valueNew;
+		sum = (sum >> 16) + (sum & 0xffff);
+		sum += (sum >> 16);
+		return (sl_uint16)(~sum);
+	}
+	
+	sl_uint16 TCP_IP::adjustChecksum(sl_uint16 checksum, const IPv4Address& addressOld, const IPv4Address& addressNew)
+	{
+		sl_uint32 o = addressOld.getInt();
+		sl_uint32 n = addressNew.getInt();
+		checksum = adjustChecksum(checksum, (sl_uint16)(o >> 16), (sl_uint16)(n >> 16));
+		return adjustChecksum(checksum, (sl_uint16)o, (sl_uint16)n);
+	}
+	
 	
 	void IPv4Packet::updateChecksum()
 	{
 		_headerChecksum[0] = 0;
 		_headerChecksum[1] = 0;
-		setChecksum(TCP_IP::calculateChecksum(this, getHeaderSize()));
+		setChecksum((sl_uint16)(~(_priv_TCPIP_sumHeader(this, getHeaderSize()))));
 	}
 	
 	sl_bool IPv4Packet::checkChecksum() const
@@ -69,8 +321,7 @@ namespace slib
 		if ((_headerChecksum[0] | _headerChecksum[1]) == 0) {
 			return sl_true;
 		}
-		sl_uint16 checksum = TCP_IP::calculateChecksum(this, getHeaderSize());
-		return checksum == 0;
+		return _priv_TCPIP_sumHeader(this, getHeaderSize()) == 0xFFFF;
 	}
 	
 	sl_uint16 IPv4Packet::getChecksumForContent(const void* content, sl_uint16 sizeContent) const
@@ -122,6 +373,31 @@ namespace slib
 		return sl_true;
 	}
 	
+	sl_size IPv4Packet::checkHeaders(const void* const* packets, const sl_size* sizes, sl_size count, sl_bool* outResults)
+	{
+		sl_size nValid = 0;
+		for (sl_size i = 0; i < count; i++) {
+			sl_bool flag = checkHeader(packets[i], sizes[i]);
+			if (outResults) {
+				outResults[i] = flag;
+			}
+			if (flag) {
+				nValid++;
+			}
+		}
+		return nValid;
+	}
+	
+	void IPv4Packet::updateChecksums(IPv4Packet* const* packets, sl_size count)
+	{
+		for (sl_size i = 0; i < count; i++) {
+			IPv4Packet* packet = packets[i];
+			if (packet) {
+				packet->updateChecksum();
+			}
+		}
+	}
+	
 	sl_bool IPv4Packet::checkHeaderSize(const void* packet, sl_size sizePacket)
 	{
 		if (!packet) {
@@ -238,7 +238,7 @@ namespace slib
 	{
 		UrlRequest_AsyncPool* pool = Get_UrlRequestAsyncPool();
 		if (pool) {
-			if (pool->threadPool->addTask(SLIB_FUNCTION_WEAKREF(UrlRequest, _sendSync_call, this))) {
+			if (pool->threadPool->addTask(InlineFunction<void()>::fromWeakRef(WeakRef<UrlRequest>(this), &UrlRequest::_sendSync_call))) {
 				return;
 			}
 		}
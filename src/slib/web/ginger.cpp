@@ -20,23 +20,975 @@
  *   THE SOFTWARE.
  */
 
-#define SLIB_SUPPORT_STD_TYPES
-
 #include "slib/web/ginger.h"
 
-#include "ginger/ginger.h"
+#include "slib/network/http_io.h"
+#include "slib/core/file.h"
+#include "slib/core/safe_static.h"
+#include "slib/core/scoped.h"
+#include "slib/core/log.h"
+
+#include <stdio.h>
+
+#define TAG "Ginger"
+
+#define PRIV_GINGER_CHUNK_SIZE 4096
+#define PRIV_GINGER_MIN_REFERENCED_TEXT 256
 
 namespace slib
 {
 	
+	enum class _priv_GingerOp
+	{
+		Text,
+		Variable,
+		For, // jumps to `jump` when the list is empty
+		EndFor, // jumps back to the instruction after `jump` while the list has more elements
+		If, // jumps to `jump` when the condition is false
+		Jump,
+		Include,
+		Inline
+	};
+	
+	class _priv_GingerVariable
+	{
+	public:
+		sl_uint32 slot;
+		List<String> keys; // members following the first name
+		String literal; // rendered when the variable is not resolved
+		
+	public:
+		_priv_GingerVariable()
+		{
+			slot = 0;
+		}
+		
+	};
+	
+	class _priv_GingerInstruction
+	{
+	public:
+		_priv_GingerOp op;
+		sl_size start; // Text: range in the source
+		sl_size length;
+		_priv_GingerVariable variable; // Variable, For: list, If: condition
+		sl_uint32 slot; // For: loop variable
+		sl_uint32 depth; // For, EndFor: loop nesting
+		sl_uint32 jump;
+		sl_bool flagCompare; // If: `variable == value`
+		String value;
+		String path; // Include, Inline
+		
+	public:
+		_priv_GingerInstruction()
+		{
+			op = _priv_GingerOp::Text;
+			start = 0;
+			length = 0;
+			slot = 0;
+			depth = 0;
+			jump = 0;
+			flagCompare = sl_false;
+		}
+		
+	};
+	
+	class _priv_GingerBinding
+	{
+	public:
+		String name;
+		sl_uint32 slot;
+	};
+	
+	class _priv_GingerTemplate : public GingerTemplate
+	{
+	public:
+		Memory m_source;
+		List<_priv_GingerInstruction> m_program;
+		List<_priv_GingerBinding> m_bindings; // top-level variables
+		sl_uint32 m_nSlots;
+		sl_uint32 m_nDepth;
+		
+	public:
+		_priv_GingerTemplate()
+		{
+			m_nSlots = 0;
+			m_nDepth = 0;
+		}
+		
+	public:
+		void render(MemoryQueue& output, const Json& data) override;
+		
+	};
+	
+	/*
+		Follows the syntax of the bundled ginger library:
+		${var.member}, $for x in xs {{ }}, $if x {{ }} $elseif y {{ }} $else {{ }},
+		$include {{ path }}, $inline {{ path }}, $$, ${{, $}}, and $# comments.
+	*/
+	class _priv_GingerCompiler
+	{
+	public:
+		const sl_char8* m_buf;
+		sl_size m_len;
+		sl_size m_pos;
+		
+		List<_priv_GingerInstruction> m_program;
+		List<_priv_GingerBinding> m_bindings;
+		CHashMap<String, sl_uint32> m_mapBindings;
+		List<_priv_GingerBinding> m_scopes; // loop variables, innermost last
+		sl_uint32 m_nSlots;
+		sl_uint32 m_nDepth;
+		sl_uint32 m_nMaxDepth;
+		
+	public:
+		_priv_GingerCompiler(const void* buf, sl_size len)
+		{
+			m_buf = (const sl_char8*)buf;
+			m_len = len;
+			m_pos = 0;
+			m_nSlots = 0;
+			m_nDepth = 0;
+			m_nMaxDepth = 0;
+		}
+		
+	public:
+		sl_bool isEnd()
+		{
+			return m_pos >= m_len;
+		}
+		
+		// returns sl_false at the end of the source
+		sl_bool skipWhitespace()
+		{
+			while (m_pos < m_len) {
+				if ((sl_uint8)(m_buf[m_pos]) > 32) {
+					return sl_true;
+				}
+				m_pos++;
+			}
+			return sl_false;
+		}
+		
+		sl_bool eat(const char* s)
+		{
+			while (*s) {
+				if (m_pos >= m_len || m_buf[m_pos] != *s) {
+					return sl_false;
+				}
+				m_pos++;
+				s++;
+			}
+			return sl_true;
+		}
+		
+		String readToken(sl_bool flagVariable)
+		{
+			sl_size start = m_pos;
+			while (m_pos < m_len) {
+				sl_char8 c = m_buf[m_pos];
+				if ((sl_uint8)c <= 32 || c == '{' || c == '}' || (flagVariable && (c == '.' || c == '='))) {
+					break;
+				}
+				m_pos++;
+			}
+			return String(m_buf + start, m_pos - start);
+		}
+		
+		String readIdent()
+		{
+			if (!(skipWhitespace())) {
+				return sl_null;
+			}
+			return readToken(sl_false);
+		}
+		
+		void addText(sl_size start, sl_size length)
+		{
+			if (!length) {
+				return;
+			}
+			sl_size n = m_program.getCount();
+			if (n) {
+				_priv_GingerInstruction& last = (m_program.getData())[n - 1];
+				if (last.op == _priv_GingerOp::Text && last.start + last.length == start) {
+					last.length += length;
+					return;
+				}
+			}
+			_priv_GingerInstruction instruction;
+			instruction.start = start;
+			instruction.length = length;
+			m_program.add_NoLock(Move(instruction));
+		}
+		
+		sl_uint32 add(_priv_GingerInstruction& instruction)
+		{
+			sl_uint32 index = (sl_uint32)(m_program.getCount());
+			m_program.add_NoLock(Move(instruction));
+			return index;
+		}
+		
+		_priv_GingerInstruction& at(sl_uint32 index)
+		{
+			return (m_program.getData())[index];
+		}
+		
+		sl_bool readVariable(_priv_GingerVariable& variable)
+		{
+			if (!(skipWhitespace())) {
+				return sl_false;
+			}
+			String name = readToken(sl_true);
+			if (name.isEmpty() || isEnd()) {
+				return sl_false;
+			}
+			String path = name;
+			while (m_buf[m_pos] == '.') {
+				m_pos++;
+				String key = readToken(sl_true);
+				if (key.isEmpty() || isEnd()) {
+					return sl_false;
+				}
+				variable.keys.add_NoLock(key);
+				path += ".";
+				path += key;
+			}
+			variable.literal = "${" + path + "}";
+			// loop variables shadow the top-level ones
+			ListElements<_priv_GingerBinding> scopes(m_scopes);
+			for (sl_size i = scopes.count; i > 0; i--) {
+				if (scopes[i - 1].name == name) {
+					variable.slot = scopes[i - 1].slot;
+					return sl_true;
+				}
+			}
+			sl_uint32 slot;
+			if (!(m_mapBindings.get_NoLock(name, &slot))) {
+				slot = m_nSlots++;
+				m_mapBindings.put_NoLock(name, slot);
+				_priv_GingerBinding binding;
+				binding.name = name;
+				binding.slot = slot;
+				m_bindings.add_NoLock(binding);
+			}
+			variable.slot = slot;
+			return sl_true;
+		}
+		
+		sl_bool readCondition(_priv_GingerInstruction& instruction)
+		{
+			instruction.op = _priv_GingerOp::If;
+			if (!(readVariable(instruction.variable))) {
+				return sl_false;
+			}
+			if (!(skipWhitespace())) {
+				return sl_false;
+			}
+			if (m_pos + 1 < m_len && m_buf[m_pos] == '=' && m_buf[m_pos + 1] == '=') {
+				m_pos += 2;
+				sl_size start = m_pos;
+				while (m_pos + 1 < m_len && !(m_buf[m_pos] == '{' && m_buf[m_pos + 1] == '{')) {
+					m_pos++;
+				}
+				instruction.flagCompare = sl_true;
+				instruction.value = String(m_buf + start, m_pos - start).trim();
+			}
+			return sl_true;
+		}
+		
+		sl_bool readBlock(sl_bool flagTop)
+		{
+			for (;;) {
+				sl_size start = m_pos;
+				while (m_pos < m_len && m_buf[m_pos] != '}' && m_buf[m_pos] != '$') {
+					m_pos++;
+				}
+				addText(start, m_pos - start);
+				if (isEnd()) {
+					// a block must be closed by `}}`
+					return flagTop;
+				}
+				if (m_buf[m_pos] == '}') {
+					if (m_pos + 1 < m_len && m_buf[m_pos + 1] == '}') {
+						// end of block (the rest of the source is ignored at the top level)
+						return sl_true;
+					}
+					addText(m_pos, 1);
+					m_pos++;
+					continue;
+				}
+				m_pos++;
+				if (isEnd()) {
+					return sl_false;
+				}
+				sl_char8 c = m_buf[m_pos];
+				if (c == '$') {
+					addText(m_pos, 1);
+					m_pos++;
+				} else if (c == '#') {
+					while (m_pos < m_len && m_buf[m_pos] != '\n') {
+						m_pos++;
+					}
+				} else if (c == '{') {
+					m_pos++;
+					if (isEnd()) {
+						return sl_false;
+					}
+					if (m_buf[m_pos] == '{') {
+						addText(m_pos - 1, 2);
+						m_pos++;
+					} else {
+						_priv_GingerInstruction instruction;
+						instruction.op = _priv_GingerOp::Variable;
+						if (!(readVariable(instruction.variable))) {
+							return sl_false;
+						}
+						if (!(skipWhitespace()) || !(eat("}"))) {
+							return sl_false;
+						}
+						add(instruction);
+					}
+				} else if (c == '}') {
+					m_pos++;
+					if (isEnd() || m_buf[m_pos] != '}') {
+						return sl_false;
+					}
+					addText(m_pos - 1, 2);
+					m_pos++;
+				} else {
+					String command = readIdent();
+					if (command == "for") {
+						if (!(readFor())) {
+							return sl_false;
+						}
+					} else if (command == "if") {
+						if (!(readIf())) {
+							return sl_false;
+						}
+					} else if (command == "include" || command == "inline") {
+						_priv_GingerInstruction instruction;
+						instruction.op = command == "include" ? _priv_GingerOp::Include : _priv_GingerOp::Inline;
+						if (!(skipWhitespace()) || !(eat("{{")) || !(skipWhitespace())) {
+							return sl_false;
+						}
+						sl_size start = m_pos;
+						while (m_pos < m_len && (sl_uint8)(m_buf[m_pos]) > 32 && m_buf[m_pos] != '}') {
+							m_pos++;
+						}
+						if (m_pos == start) {
+							return sl_false;
+						}
+						instruction.path = String(m_buf + start, m_pos - start);
+						if (!(skipWhitespace()) || !(eat("}}"))) {
+							return sl_false;
+						}
+						add(instruction);
+					} else {
+						return sl_false;
+					}
+				}
+			}
+		}
+		
+		sl_bool readFor()
+		{
+			String name = readIdent();
+			if (name.isEmpty()) {
+				return sl_false;
+			}
+			if (readIdent() != "in") {
+				return sl_false;
+			}
+			_priv_GingerInstruction instruction;
+			instruction.op = _priv_GingerOp::For;
+			if (!(readVariable(instruction.variable))) {
+				return sl_false;
+			}
+			if (!(skipWhitespace()) || !(eat("{{"))) {
+				return sl_false;
+			}
+			sl_uint32 slot = m_nSlots++;
+			instruction.slot = slot;
+			instruction.depth = m_nDepth;
+			sl_uint32 indexFor = add(instruction);
+			m_nDepth++;
+			if (m_nDepth > m_nMaxDepth) {
+				m_nMaxDepth = m_nDepth;
+			}
+			_priv_GingerBinding scope;
+			scope.name = name;
+			scope.slot = slot;
+			m_scopes.add_NoLock(scope);
+			if (!(readBlock(sl_false))) {
+				return sl_false;
+			}
+			m_scopes.popBack_NoLock();
+			m_nDepth--;
+			if (!(eat("}}"))) {
+				return sl_false;
+			}
+			_priv_GingerInstruction end;
+			end.op = _priv_GingerOp::EndFor;
+			end.depth = m_nDepth;
+			end.jump = indexFor;
+			sl_uint32 indexEnd = add(end);
+			at(indexFor).jump = indexEnd + 1;
+			return sl_true;
+		}
+		
+		sl_bool readIf()
+		{
+			List<sl_uint32> jumps;
+			_priv_GingerInstruction instruction;
+			if (!(readCondition(instruction))) {
+				return sl_false;
+			}
+			sl_uint32 indexCondition = add(instruction);
+			sl_bool flagElse = sl_false;
+			for (;;) {
+				if (!(skipWhitespace()) || !(eat("{{"))) {
+					return sl_false;
+				}
+				if (!(readBlock(sl_false))) {
+					return sl_false;
+				}
+				if (!(eat("}}"))) {
+					return sl_false;
+				}
+				if (flagElse) {
+					break;
+				}
+				// $elseif, $else
+				sl_size pos = m_pos;
+				String command;
+				if (skipWhitespace() && m_buf[m_pos] == '$') {
+					m_pos++;
+					command = readIdent();
+				}
+				if (command == "elseif" || command == "else") {
+					_priv_GingerInstruction jump;
+					jump.op = _priv_GingerOp::Jump;
+					jumps.add_NoLock(add(jump));
+					at(indexCondition).jump = (sl_uint32)(m_program.getCount());
+					if (command == "else") {
+						flagElse = sl_true;
+					} else {
+						_priv_GingerInstruction condition;
+						if (!(readCondition(condition))) {
+							return sl_false;
+						}
+						indexCondition = add(condition);
+					}
+				} else {
+					m_pos = pos;
+					break;
+				}
+			}
+			sl_uint32 indexEnd = (sl_uint32)(m_program.getCount());
+			if (!flagElse) {
+				at(indexCondition).jump = indexEnd;
+			}
+			ListElements<sl_uint32> listJumps(jumps);
+			for (sl_size i = 0; i < listJumps.count; i++) {
+				at(listJumps[i]).jump = indexEnd;
+			}
+			return sl_true;
+		}
+		
+	};
+	
+	class _priv_GingerOutput
+	{
+	public:
+		MemoryQueue& m_output;
+		Ref<Referable> m_refSource;
+		Memory m_chunk;
+		sl_size m_posChunk;
+		
+	public:
+		_priv_GingerOutput(MemoryQueue& output, const Memory& source): m_output(output), m_refSource(source.ref)
+		{
+			m_posChunk = 0;
+		}
+		
+		~_priv_GingerOutput()
+		{
+			flush();
+		}
+		
+	public:
+		void flush()
+		{
+			if (m_posChunk) {
+				MemoryData data;
+				data.data = m_chunk.getData();
+				data.size = m_posChunk;
+				data.refer = m_chunk.ref;
+				m_output.add(data);
+				m_chunk.setNull();
+				m_posChunk = 0;
+			}
+		}
+		
+		void addReference(const void* buf, sl_size size, Referable* refer)
+		{
+			flush();
+			MemoryData data;
+			data.data = (void*)buf;
+			data.size = size;
+			data.refer = refer;
+			m_output.add(data);
+		}
+		
+		void write(const void* _buf, sl_size size)
+		{
+			const sl_uint8* buf = (const sl_uint8*)_buf;
+			while (size) {
+				if (m_chunk.isNull()) {
+					m_chunk = Memory::create(PRIV_GINGER_CHUNK_SIZE);
+					if (m_chunk.isNull()) {
+						return;
+					}
+					m_posChunk = 0;
+				}
+				sl_size n = PRIV_GINGER_CHUNK_SIZE - m_posChunk;
+				if (n > size) {
+					n = size;
+				}
+				Base::copyMemory((sl_uint8*)(m_chunk.getData()) + m_posChunk, buf, n);
+				m_posChunk += n;
+				buf += n;
+				size -= n;
+				if (m_posChunk == PRIV_GINGER_CHUNK_SIZE) {
+					flush();
+				}
+			}
+		}
+		
+		void writeText(const void* buf, sl_size size)
+		{
+			if (size >= PRIV_GINGER_MIN_REFERENCED_TEXT) {
+				addReference(buf, size, m_refSource.get());
+			} else {
+				write(buf, size);
+			}
+		}
+		
+		void write(const String& str)
+		{
+			write(str.getData(), str.getLength());
+		}
+		
+	};
+	
+	// the value types converted by the ginger library, other values are regarded as missing
+	static sl_bool _priv_Ginger_isValue(const Json& value)
+	{
+		return value.isNull() || value.isString() || value.isNumber() || value.isBoolean() || value.isJsonMap() || value.isJsonList();
+	}
+	
+	// returns null when the variable is not resolved, `holder` keeps the member value
+	static const Json* _priv_Ginger_resolve(const _priv_GingerVariable& variable, const Json* slots, const sl_bool* flagSlots, Json& holder)
+	{
+		if (!(flagSlots[variable.slot])) {
+			return sl_null;
+		}
+		const Json* value = slots + variable.slot;
+		ListElements<String> keys(variable.keys);
+		for (sl_size i = 0; i < keys.count; i++) {
+			if (!(value->isJsonMap())) {
+				return sl_null;
+			}
+			Json item;
+			if (!(value->getJsonMap().get(keys[i], &item))) {
+				return sl_null;
+			}
+			if (!(_priv_Ginger_isValue(item))) {
+				return sl_null;
+			}
+			holder = Move(item);
+			value = &holder;
+		}
+		return value;
+	}
+	
+	// same as the output of std::stringstream in the ginger library: returns sl_true for `_out`, otherwise the text is formatted into `buf`
+	static sl_bool _priv_Ginger_toString(const Json& value, String& _out, char* buf, sl_size& len)
+	{
+		len = 0;
+		if (value.isString()) {
+			_out = value.getString();
+			return sl_true;
+		}
+		if (value.isNull()) {
+			_out = "null";
+			return sl_true;
+		}
+		int n = -1;
+		if (value.isInteger()) {
+			n = snprintf(buf, 128, "%lld", (long long)(value.getInt64()));
+		} else if (value.isNumber()) {
+			n = snprintf(buf, 128, "%.64g", value.getDouble());
+		} else if (value.isBoolean()) {
+			buf[0] = value.getBoolean() ? '1' : '0';
+			n = 1;
+		}
+		if (n > 0 && n < 128) {
+			len = n;
+		}
+		return sl_false;
+	}
+	
+	static void _priv_Ginger_write(_priv_GingerOutput& output, const Json& value)
+	{
+		char buf[128];
+		sl_size len;
+		String str;
+		if (_priv_Ginger_toString(value, str, buf, len)) {
+			output.write(str);
+		} else {
+			output.write(buf, len);
+		}
+	}
+	
+	static sl_bool _priv_Ginger_equals(const Json& value, const String& str)
+	{
+		char buf[128];
+		sl_size len;
+		String s;
+		if (_priv_Ginger_toString(value, s, buf, len)) {
+			return s == str;
+		} else {
+			return str.getLength() == len && Base::equalsMemory(str.getData(), buf, len);
+		}
+	}
+	
+	static sl_bool _priv_Ginger_isTrue(const Json& value)
+	{
+		if (value.isBoolean()) {
+			return value.getBoolean();
+		}
+		if (value.isInteger()) {
+			return value.getInt64() != 0;
+		}
+		if (value.isNumber()) {
+			return value.getDouble() != 0;
+		}
+		if (value.isString()) {
+			return value.getString().isNotEmpty();
+		}
+		if (value.isJsonList() || value.isJsonMap()) {
+			return value.getElementsCount() > 0;
+		}
+		return sl_false;
+	}
+	
+	class _priv_GingerLoop
+	{
+	public:
+		JsonList list;
+		sl_size index;
+		
+	public:
+		_priv_GingerLoop()
+		{
+			index = 0;
+		}
+		
+	};
+	
+	class _priv_GingerFile : public Referable
+	{
+	public:
+		Time timeModified;
+		sl_uint64 size;
+		Memory content;
+		Ref<GingerTemplate> compiled;
+		sl_bool flagCompiled;
+		Mutex lock;
+		
+	public:
+		_priv_GingerFile()
+		{
+			size = 0;
+			flagCompiled = sl_false;
+		}
+		
+	};
+	
+	typedef CHashMap< String, Ref<_priv_GingerFile> > _priv_GingerFileMap;
+	SLIB_SAFE_STATIC_GETTER(_priv_GingerFileMap, _priv_Ginger_getFileMap)
+	
+	static Ref<_priv_GingerFile> _priv_Ginger_getFile(const String& path)
+	{
+		_priv_GingerFileMap* map = _priv_Ginger_getFileMap();
+		if (!map) {
+			return sl_null;
+		}
+		if (!(File::exists(path))) {
+			map->remove(path);
+			return sl_null;
+		}
+		Time timeModified = File::getModifiedTime(path);
+		sl_uint64 size = File::getSize(path);
+		Ref<_priv_GingerFile> file;
+		if (map->get(path, &file) && file.isNotNull()) {
+			if (file->timeModified == timeModified && file->size == size) {
+				return file;
+			}
+		}
+		file = new _priv_GingerFile;
+		if (file.isNull()) {
+			return sl_null;
+		}
+		file->timeModified = timeModified;
+		file->size = size;
+		file->content = File::readAllBytes(path);
+		map->put(path, file);
+		return file;
+	}
+	
+	static Ref<GingerTemplate> _priv_Ginger_compile(const Memory& source)
+	{
+		_priv_GingerCompiler compiler(source.getData(), source.getSize());
+		if (!(compiler.readBlock(sl_true))) {
+			return sl_null;
+		}
+		Ref<_priv_GingerTemplate> ret = new _priv_GingerTemplate;
+		if (ret.isNotNull()) {
+			ret->m_source = source;
+			ret->m_program = compiler.m_program;
+			ret->m_bindings = compiler.m_bindings;
+			ret->m_nSlots = compiler.m_nSlots;
+			ret->m_nDepth = compiler.m_nMaxDepth;
+			return ret;
+		}
+		return sl_null;
+	}
+	
+	void _priv_GingerTemplate::render(MemoryQueue& _output, const Json& data)
+	{
+		ListElements<_priv_GingerInstruction> program(m_program);
+		if (!(program.count)) {
+			return;
+		}
+		
+		_priv_GingerOutput output(_output, m_source);
+		const sl_char8* source = (const sl_char8*)(m_source.getData());
+		
+		sl_uint32 nSlots = m_nSlots;
+		SLIB_SCOPED_BUFFER(Json, 32, slots, nSlots)
+		SLIB_SCOPED_BUFFER(sl_bool, 32, flagSlots, nSlots)
+		SLIB_SCOPED_BUFFER(_priv_GingerLoop, 8, loops, m_nDepth)
+		if (!slots || !flagSlots || !loops) {
+			return;
+		}
+		Base::zeroMemory(flagSlots, nSlots);
+		
+		// the top-level variables are looked up once
+		if (data.isJsonMap()) {
+			JsonMap map = data.getJsonMap();
+			ListElements<_priv_GingerBinding> bindings(m_bindings);
+			for (sl_size i = 0; i < bindings.count; i++) {
+				sl_uint32 slot = bindings[i].slot;
+				if (map.get(bindings[i].name, slots + slot) && _priv_Ginger_isValue(slots[slot])) {
+					flagSlots[slot] = sl_true;
+				}
+			}
+		}
+		
+		sl_size pc = 0;
+		while (pc < program.count) {
+			_priv_GingerInstruction& instruction = program[pc];
+			switch (instruction.op) {
+				case _priv_GingerOp::Text:
+					output.writeText(source + instruction.start, instruction.length);
+					pc++;
+					break;
+				case _priv_GingerOp::Variable:
+					{
+						Json holder;
+						const Json* value = _priv_Ginger_resolve(instruction.variable, slots, flagSlots, holder);
+						if (value) {
+							_priv_Ginger_write(output, *value);
+						} else {
+							output.write(instruction.variable.literal);
+						}
+						pc++;
+					}
+					break;
+				case _priv_GingerOp::For:
+				case _priv_GingerOp::EndFor:
+					{
+						_priv_GingerLoop& loop = loops[instruction.depth];
+						sl_size indexFor = pc;
+						if (instruction.op == _priv_GingerOp::For) {
+							loop.list.setNull();
+							loop.index = 0;
+							Json holder;
+							const Json* value = _priv_Ginger_resolve(instruction.variable, slots, flagSlots, holder);
+							if (value && value->isJsonList()) {
+								loop.list = value->getJsonList();
+							}
+						} else {
+							indexFor = instruction.jump;
+							loop.index++;
+						}
+						_priv_GingerInstruction& instructionFor = program[indexFor];
+						sl_uint32 slot = instructionFor.slot;
+						ListElements<Json> items(loop.list);
+						// the elements not converted by the ginger library are skipped
+						while (loop.index < items.count && !(_priv_Ginger_isValue(items[loop.index]))) {
+							loop.index++;
+						}
+						if (loop.index < items.count) {
+							slots[slot] = items[loop.index];
+							flagSlots[slot] = sl_true;
+							pc = indexFor + 1;
+						} else {
+							loop.list.setNull();
+							slots[slot].setNull();
+							flagSlots[slot] = sl_false;
+							pc = instructionFor.jump;
+						}
+					}
+					break;
+				case _priv_GingerOp::If:
+					{
+						sl_bool flag = sl_false;
+						Json holder;
+						const Json* value = _priv_Ginger_resolve(instruction.variable, slots, flagSlots, holder);
+						if (value) {
+							if (instruction.flagCompare) {
+								if (instruction.value == "true" || instruction.value == "false") {
+									flag = _priv_Ginger_isTrue(*value) == (instruction.value == "true");
+								} else {
+									flag = _priv_Ginger_equals(*value, instruction.value);
+								}
+							} else {
+								flag = _priv_Ginger_isTrue(*value);
+							}
+						}
+						if (flag) {
+							pc++;
+						} else {
+							pc = instruction.jump;
+						}
+					}
+					break;
+				case _priv_GingerOp::Jump:
+					pc = instruction.jump;
+					break;
+				case _priv_GingerOp::Include:
+					{
+						Ref<GingerTemplate> t = Ginger::getCompiledFile(instruction.path);
+						if (t.isNotNull()) {
+							output.flush();
+							t->render(_output, data);
+						}
+						pc++;
+					}
+					break;
+				case _priv_GingerOp::Inline:
+					{
+						Ref<_priv_GingerFile> file = _priv_Ginger_getFile(instruction.path);
+						if (file.isNotNull() && file->content.isNotNull()) {
+							output.addReference(file->content.getData(), file->content.getSize(), file->content.ref.get());
+						}
+						pc++;
+					}
+					break;
+			}
+		}
+		
+	}
+	
+	
+	SLIB_DEFINE_OBJECT(GingerTemplate, Object)
+	
+	GingerTemplate::GingerTemplate()
+	{
+	}
+	
+	GingerTemplate::~GingerTemplate()
+	{
+	}
+	
+	Ref<GingerTemplate> GingerTemplate::compile(const String& source)
+	{
+		return _priv_Ginger_compile(Memory::create(source.getData(), source.getLength()));
+	}
+	
+	String GingerTemplate::render(const Json& data)
+	{
+		MemoryQueue queue;
+		render(queue, data);
+		Memory mem = queue.merge();
+		return String((sl_char8*)(mem.getData()), mem.getSize());
+	}
+	
+	void GingerTemplate::render(HttpOutputBuffer* output, const Json& data)
+	{
+		MemoryQueue queue;
+		render(queue, data);
+		MemoryData item;
+		while (queue.pop(item)) {
+			output->write(item.getMemory());
+		}
+	}
+	
+	
 	String Ginger::render(const String& _template, const Json& data)
 	{
-		return ginger::render_string(_template.toStd(), data);
+		Ref<GingerTemplate> t = GingerTemplate::compile(_template);
+		if (t.isNotNull()) {
+			return t->render(data);
+		}
+		LogError(TAG, "Syntax error in the template");
+		return sl_null;
 	}
 
 	String Ginger::renderFile(const String& filePath, const Json& data)
 	{
-		return ginger::render_file(filePath.toStd(), data);
+		Ref<GingerTemplate> t = getCompiledFile(filePath);
+		if (t.isNotNull()) {
+			return t->render(data);
+		}
+		LogError(TAG, "Cannot open or compile the template: %s", filePath);
+		return sl_null;
+	}
+	
+	void Ginger::renderFile(HttpOutputBuffer* output, const String& filePath, const Json& data)
+	{
+		Ref<GingerTemplate> t = getCompiledFile(filePath);
+		if (t.isNotNull()) {
+			t->render(output, data);
+		} else {
+			LogError(TAG, "Cannot open or compile the template: %s", filePath);
+		}
+	}
+	
+	Ref<GingerTemplate> Ginger::getCompiledFile(const String& filePath)
+	{
+		Ref<_priv_GingerFile> file = _priv_Ginger_getFile(filePath);
+		if (file.isNull()) {
+			return sl_null;
+		}
+		MutexLocker lock(&(file->lock));
+		if (!(file->flagCompiled)) {
+			file->compiled = _priv_Ginger_compile(file->content);
+			file->flagCompiled = sl_true;
+		}
+		return file->compiled;
+	}
+	
+	void Ginger::clearCache()
+	{
+		_priv_GingerFileMap* map = _priv_Ginger_getFileMap();
+		if (map) {
+			map->removeAll();
+		}
 	}
 
 }
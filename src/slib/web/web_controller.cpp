@@ -42,18 +42,23 @@ namespace slib
 	void WebController::registerHandler(HttpMethod method, const String& path, const WebHandler& handler)
 	{
 		if (handler.isNotNull()) {
-			String sig = _getHandlerSignature(method, path);
-			m_handlers.put(sig, handler);
+			CHashMap<String, WebHandler>* handlers = _getHandlers(method);
+			if (handlers) {
+				handlers->put(path, handler);
+			}
 		}
 	}
 
 	sl_bool WebController::processHttpRequest(HttpServerContext* context)
 	{
 		HttpMethod method = context->getMethod();
+		CHashMap<String, WebHandler>* handlers = _getHandlers(method);
+		if (!handlers) {
+			return sl_false;
+		}
 		String path = context->getPath();
-		String sig = _getHandlerSignature(method, path);
 		WebHandler handler;
-		if (m_handlers.get(sig, &handler)) {
+		if (handlers->get(path, &handler)) {
 			Variant ret(handler(context, method, path));
 			if (ret.isNotNull()) {
 				if (ret.isObject()) {
@@ -76,9 +81,13 @@ namespace slib
 		return sl_false;
 	}
 
-	String WebController::_getHandlerSignature(HttpMethod method, const String& path)
+	CHashMap<String, WebHandler>* WebController::_getHandlers(HttpMethod method)
 	{
-		return HttpMethods::toString(method) + " " + path;
+		sl_uint32 index = (sl_uint32)method;
+		if (index < sizeof(m_handlers) / sizeof(m_handlers[0])) {
+			return m_handlers + index;
+		}
+		return sl_null;
 	}
 
 
@@ -0,0 +1,374 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+
+using namespace slib;
+
+/*
+	Boundary test of `BufferedReader` and `BufferedWriter` with the smallest buffer (16 bytes). The streams are
+	compared with the unbuffered `IReader`/`IWriter` methods on a `MemoryWriter`, while the underlying stream
+	returns the data in small chunks and records the size of every call:
+	- CVLI values starting at every offset around the end of the buffer, so they are split across a refill
+	- reads and writes of exactly the buffer size, which bypass the buffer, and primitives filling it exactly
+	- a round trip through `File::openBufferedForWrite`, `openBufferedForAppend` and `openBufferedForRead`
+*/
+
+#define BUFFER_SIZE 16
+
+static sl_uint32 g_nFailed = 0;
+
+static void Check(sl_bool flag, const char* name, sl_uint32 param = 0)
+{
+	if (!flag) {
+		if (g_nFailed < 20) {
+			Println("FAILED: %s (%d)", name, param);
+		}
+		g_nFailed++;
+	}
+}
+
+// returns at most `chunk` bytes per call, and -1 at the end
+class ChunkReader : public Object, public IReader
+{
+public:
+	Memory data;
+	sl_size offset;
+	sl_size chunk;
+	List<sl_size> calls;
+
+public:
+	ChunkReader(const Memory& _data, sl_size _chunk): data(_data), offset(0), chunk(_chunk) {}
+
+public:
+	sl_reg read(void* buf, sl_size size) override
+	{
+		calls.add(size);
+		sl_size n = data.getSize() - offset;
+		if (!n) {
+			return -1;
+		}
+		if (n > size) {
+			n = size;
+		}
+		if (n > chunk) {
+			n = chunk;
+		}
+		Base::copyMemory(buf, (sl_uint8*)(data.getData()) + offset, n);
+		offset += n;
+		return n;
+	}
+
+};
+
+// writes at most `chunk` bytes per call
+class ChunkWriter : public Object, public IWriter
+{
+public:
+	Ref<MemoryWriter> output;
+	sl_size chunk;
+	List<sl_size> calls;
+
+public:
+	ChunkWriter(sl_size _chunk): output(new MemoryWriter), chunk(_chunk) {}
+
+public:
+	sl_reg write(const void* buf, sl_size size) override
+	{
+		calls.add(size);
+		if (size > chunk) {
+			size = chunk;
+		}
+		return output->write(buf, size);
+	}
+
+};
+
+static sl_bool IsSameMemory(const Memory& m1, const Memory& m2)
+{
+	sl_size n = m1.getSize();
+	if (n != m2.getSize()) {
+		return sl_false;
+	}
+	return !n || Base::equalsMemory(m1.getData(), m2.getData(), n);
+}
+
+static const sl_uint32 g_values32[] = { 0, 1, 127, 128, 0x3FFF, 0x4000, 0x1FFFFF, 0x200000, 0x0FFFFFFF, 0x10000000, 0xFFFFFFFF };
+static const sl_uint64 g_values64[] = { 0, 128, 0xFFFFFFFF, SLIB_UINT64(0x100000000), SLIB_UINT64(0x7FFFFFFFFFFFFFFF), SLIB_UINT64(0x8000000000000000), SLIB_UINT64(0xFFFFFFFFFFFFFFFF) };
+
+#define COUNT_32 (sizeof(g_values32) / sizeof(g_values32[0]))
+#define COUNT_64 (sizeof(g_values64) / sizeof(g_values64[0]))
+
+static void TestCVLI()
+{
+	static const sl_size chunks[] = { 1, 3, BUFFER_SIZE };
+	for (sl_size iChunk = 0; iChunk < sizeof(chunks) / sizeof(chunks[0]); iChunk++) {
+		sl_size chunk = chunks[iChunk];
+		for (sl_uint32 pad = 0; pad <= BUFFER_SIZE + 4; pad++) {
+			for (sl_size i = 0; i < COUNT_32; i++) {
+				sl_uint32 v32 = g_values32[i];
+				sl_uint64 v64 = g_values64[i % COUNT_64];
+				// reference
+				MemoryWriter ref;
+				for (sl_uint32 k = 0; k < pad; k++) {
+					ref.writeUint8((sl_uint8)k);
+				}
+				ref.writeUint32CVLI(v32);
+				ref.writeUint64CVLI(v64);
+				ref.writeInt32CVLI(-(sl_int32)v32);
+				ref.writeUint32(0x12345678);
+				Memory data = ref.getData();
+				// writer
+				{
+					Ref<ChunkWriter> output = new ChunkWriter(chunk);
+					{
+						Ref<BufferedWriter> writer = BufferedWriter::create(output, BUFFER_SIZE);
+						for (sl_uint32 k = 0; k < pad; k++) {
+							writer->writeUint8((sl_uint8)k);
+						}
+						Check(writer->writeUint32CVLI(v32), "write uint32 CVLI", pad);
+						Check(writer->writeUint64CVLI(v64), "write uint64 CVLI", pad);
+						Check(writer->writeInt32CVLI(-(sl_int32)v32), "write int32 CVLI", pad);
+						Check(writer->writeUint32(0x12345678), "write uint32", pad);
+						Check(writer->getBufferedSize() <= BUFFER_SIZE, "buffered size of writer", pad);
+					}
+					Check(IsSameMemory(output->output->getData(), data), "written CVLI", pad);
+				}
+				// reader
+				{
+					Ref<ChunkReader> input = new ChunkReader(data, chunk);
+					Ref<BufferedReader> reader = BufferedReader::create(input, BUFFER_SIZE);
+					sl_bool flagPad = sl_true;
+					for (sl_uint32 k = 0; k < pad; k++) {
+						if (reader->readUint8((sl_uint8)0xFF) != (sl_uint8)k) {
+							flagPad = sl_false;
+						}
+					}
+					Check(flagPad, "read padding", pad);
+					sl_uint32 r32 = 0;
+					Check(reader->readUint32CVLI(&r32) && r32 == v32, "read uint32 CVLI", pad);
+					sl_uint64 r64 = 0;
+					Check(reader->readUint64CVLI(&r64) && r64 == v64, "read uint64 CVLI", pad);
+					sl_int32 n32 = 0;
+					Check(reader->readInt32CVLI(&n32) && n32 == -(sl_int32)v32, "read int32 CVLI", pad);
+					Check(reader->readUint32() == 0x12345678, "read after CVLI", pad);
+					sl_uint8 n8;
+					Check(!(reader->readUint8(&n8)), "read at end", pad);
+				}
+				// truncated in the middle of the 64-bit value
+				{
+					MemoryWriter head;
+					for (sl_uint32 k = 0; k < pad; k++) {
+						head.writeUint8((sl_uint8)k);
+					}
+					sl_size sizeHead = head.getData().getSize();
+					MemoryWriter cvli;
+					cvli.writeUint64CVLI(v64);
+					Memory mem = cvli.getData();
+					sl_size nCvli = mem.getSize();
+					if (nCvli > 1) {
+						head.write(mem.getData(), nCvli - 1);
+						Ref<ChunkReader> input = new ChunkReader(head.getData(), chunk);
+						Ref<BufferedReader> reader = BufferedReader::create(input, BUFFER_SIZE);
+						Memory skipped = Memory::create(sizeHead + 1);
+						if (sizeHead) {
+							Check(reader->readFully(skipped.getData(), sizeHead) == (sl_reg)sizeHead, "read before truncated CVLI", pad);
+						}
+						sl_uint64 r64;
+						Check(!(reader->readUint64CVLI(&r64)), "read truncated CVLI", pad);
+					}
+				}
+			}
+		}
+	}
+}
+
+static void TestExactBufferSize()
+{
+	sl_uint8 data[BUFFER_SIZE * 4];
+	for (sl_uint32 i = 0; i < sizeof(data); i++) {
+		data[i] = (sl_uint8)(i * 7 + 1);
+	}
+	sl_uint8 buf[BUFFER_SIZE];
+
+	// reader
+	{
+		Ref<ChunkReader> input = new ChunkReader(Memory::create(data, sizeof(data)), BUFFER_SIZE);
+		Ref<BufferedReader> reader = BufferedReader::create(input, BUFFER_SIZE);
+		// empty buffer: read directly into `buf`
+		Check(reader->read(buf, BUFFER_SIZE) == BUFFER_SIZE, "exact read");
+		Check(Base::equalsMemory(buf, data, BUFFER_SIZE), "exact read data");
+		Check(reader->getBufferedSize() == 0, "exact read is not buffered");
+		Check(input->calls.getCount() == 1, "exact read calls", (sl_uint32)(input->calls.getCount()));
+		// four 32-bit values fill the buffer exactly
+		sl_bool flagValues = sl_true;
+		for (sl_uint32 i = 0; i < 4; i++) {
+			if (reader->readUint32() != MIO::readUint32LE(data + BUFFER_SIZE + i * 4)) {
+				flagValues = sl_false;
+			}
+		}
+		Check(flagValues, "values filling the buffer");
+		Check(reader->getBufferedSize() == 0, "buffer consumed");
+		Check(input->calls.getCount() == 2, "one refill for the values", (sl_uint32)(input->calls.getCount()));
+		// one buffered byte: `read` returns it alone, `readFully` continues after it
+		Check(reader->readUint8() == data[BUFFER_SIZE * 2], "byte after the values");
+		Check(reader->getBufferedSize() == BUFFER_SIZE - 1, "rest of the buffer");
+		Check(reader->read(buf, BUFFER_SIZE) == BUFFER_SIZE - 1, "read of the rest");
+		Check(Base::equalsMemory(buf, data + BUFFER_SIZE * 2 + 1, BUFFER_SIZE - 1), "read of the rest data");
+		Check(reader->readUint8() == data[BUFFER_SIZE * 3], "byte before the last block");
+		Check(reader->readFully(buf, BUFFER_SIZE) == BUFFER_SIZE - 1, "readFully up to the end");
+		Check(Base::equalsMemory(buf, data + BUFFER_SIZE * 3 + 1, BUFFER_SIZE - 1), "readFully data");
+		Check(reader->read(buf, BUFFER_SIZE) < 0, "read at end");
+	}
+	{
+		// exact read while the buffer has bytes, through `readFully`
+		Ref<ChunkReader> input = new ChunkReader(Memory::create(data, sizeof(data)), 5);
+		Ref<BufferedReader> reader = BufferedReader::create(input, BUFFER_SIZE);
+		Check(reader->readUint16() == MIO::readUint16LE(data), "first value");
+		Check(reader->readFully(buf, BUFFER_SIZE) == BUFFER_SIZE, "exact readFully");
+		Check(Base::equalsMemory(buf, data + 2, BUFFER_SIZE), "exact readFully data");
+		Check(reader->readUint16() == MIO::readUint16LE(data + 2 + BUFFER_SIZE), "value after exact readFully");
+	}
+
+	// writer
+	{
+		Ref<ChunkWriter> output = new ChunkWriter(BUFFER_SIZE);
+		Ref<BufferedWriter> writer = BufferedWriter::create(output, BUFFER_SIZE);
+		// empty buffer: written directly
+		Check(writer->write(data, BUFFER_SIZE) == BUFFER_SIZE, "exact write");
+		Check(writer->getBufferedSize() == 0, "exact write is not buffered");
+		Check(output->calls.getCount() == 1 && output->calls.getValueAt(0) == BUFFER_SIZE, "exact write calls");
+		// the bytes fill the buffer exactly without writing it
+		for (sl_uint32 i = 0; i < BUFFER_SIZE; i++) {
+			writer->writeUint8(data[BUFFER_SIZE + i]);
+		}
+		Check(writer->getBufferedSize() == BUFFER_SIZE, "full buffer");
+		Check(output->calls.getCount() == 1, "full buffer is kept");
+		// the next byte writes the full buffer
+		writer->writeUint8(data[BUFFER_SIZE * 2]);
+		Check(output->calls.getCount() == 2 && output->calls.getValueAt(1) == BUFFER_SIZE, "full buffer is written");
+		Check(writer->getBufferedSize() == 1, "byte after the full buffer");
+		// exact write after a buffered byte: the byte goes first
+		Check(writer->writeFully(data + BUFFER_SIZE * 2 + 1, BUFFER_SIZE) == BUFFER_SIZE, "exact writeFully");
+		Check(writer->getBufferedSize() == 0, "exact writeFully is not buffered");
+		Check(writer->writeFully(data + BUFFER_SIZE * 3 + 1, BUFFER_SIZE - 1) == BUFFER_SIZE - 1, "writeFully of the rest");
+		Check(writer->flush(), "flush");
+		Check(IsSameMemory(output->output->getData(), Memory::create(data, sizeof(data))), "written data");
+	}
+	{
+		// the underlying writer takes a few bytes per call
+		Ref<ChunkWriter> output = new ChunkWriter(3);
+		Ref<BufferedWriter> writer = BufferedWriter::create(output, BUFFER_SIZE);
+		for (sl_uint32 i = 0; i < 4; i++) {
+			writer->writeUint32(MIO::readUint32LE(data + i * 4));
+		}
+		Check(writer->writeFully(data + BUFFER_SIZE, BUFFER_SIZE * 3) == BUFFER_SIZE * 3, "large writeFully");
+		writer->close();
+		Check(IsSameMemory(output->output->getData(), Memory::create(data, sizeof(data))), "written data in chunks");
+	}
+}
+
+static void TestFile()
+{
+	String path = System::getTempDirectory() + "/slib_test_buffered_io_" + String::fromUint32(System::getProcessId());
+	String text = "Buffered text over the size of the buffer";
+	{
+		Ref<BufferedWriter> writer = File::openBufferedForWrite(path, BUFFER_SIZE);
+		Check(writer.isNotNull(), "openBufferedForWrite");
+		if (writer.isNull()) {
+			return;
+		}
+		Check(writer->writeDouble(1.0, sl_true), "write double");
+		writer->writeDouble(-2.5);
+		writer->writeFloat(0.75f, sl_true);
+		for (sl_uint32 i = 0; i < 1000; i++) {
+			writer->writeUint32CVLI(i * 2654435761u);
+			writer->writeInt16((sl_int16)i, sl_true);
+		}
+		writer->writeStringSection(text);
+		writer->writeInt64(SLIB_INT64(-1234567890123));
+		writer->close();
+		Check(!(writer->isOpened()), "closed writer");
+		Check(writer->write(text.getData(), 4) < 0, "write after close");
+		Check(!(writer->writeUint32(1)), "writeUint32 after close");
+	}
+	// big-endian double is written from the most significant byte
+	Memory head = File::readAllBytes(path, 8);
+	static const sl_uint8 one[] = { 0x3F, 0xF0, 0, 0, 0, 0, 0, 0 };
+	Check(head.getSize() == 8 && Base::equalsMemory(head.getData(), one, 8), "big-endian double in the file");
+	// same format as `IWriter`
+	MemoryWriter ref;
+	ref.writeDouble(1.0, sl_true);
+	Check(IsSameMemory(ref.getData(), head), "big-endian double of IWriter");
+	{
+		// flushed on destruction
+		Ref<BufferedWriter> writer = File::openBufferedForAppend(path, BUFFER_SIZE);
+		Check(writer.isNotNull(), "openBufferedForAppend");
+		if (writer.isNull()) {
+			return;
+		}
+		writer->writeUint64CVLI(SLIB_UINT64(0xFFFFFFFFFFFFFFFF));
+		writer->writeUint8(0x5A);
+	}
+	{
+		Ref<BufferedReader> reader = File::openBufferedForRead(path, BUFFER_SIZE);
+		Check(reader.isNotNull(), "openBufferedForRead");
+		if (reader.isNull()) {
+			return;
+		}
+		Check(reader->readDouble(0.0, sl_true) == 1.0, "read big-endian double");
+		Check(reader->readDouble() == -2.5, "read double");
+		Check(reader->readFloat(0.0f, sl_true) == 0.75f, "read big-endian float");
+		sl_bool flagValues = sl_true;
+		for (sl_uint32 i = 0; i < 1000; i++) {
+			if (reader->readUint32CVLI() != i * 2654435761u) {
+				flagValues = sl_false;
+			}
+			if (reader->readInt16((sl_int16)0, sl_true) != (sl_int16)i) {
+				flagValues = sl_false;
+			}
+		}
+		Check(flagValues, "read values");
+		Check(reader->readStringSection() == text, "read string");
+		Check(reader->readInt64() == SLIB_INT64(-1234567890123), "read int64");
+		Check(reader->readUint64CVLI() == SLIB_UINT64(0xFFFFFFFFFFFFFFFF), "read appended CVLI");
+		Check(reader->readUint8() == 0x5A, "read appended byte");
+		sl_uint8 n;
+		Check(!(reader->readUint8(&n)), "read at end of file");
+		reader->close();
+	}
+	File::deleteFile(path);
+}
+
+int main(int argc, const char * argv[])
+{
+	TestCVLI();
+	TestExactBufferSize();
+	TestFile();
+	if (g_nFailed) {
+		Println("FAILED: %d checks", g_nFailed);
+		return 1;
+	}
+	Println("OK");
+	return 0;
+}
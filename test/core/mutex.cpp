@@ -0,0 +1,106 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+
+using namespace slib;
+
+/*
+	Contention test of `Mutex`: the threads count how many of them are inside the critical section
+	at once, and accumulate an unprotected counter which must not lose any increment.
+*/
+
+#define THREAD_COUNT 8
+#define LOOP_COUNT 200000
+
+static Mutex g_mutex;
+static volatile sl_int32 g_inside = 0;
+static sl_int32 g_maxInside = 0;
+static sl_uint64 g_counter = 0;
+
+static void Enter()
+{
+	sl_int32 n = Base::interlockedIncrement32((sl_int32*)&g_inside);
+	if (n > g_maxInside) {
+		g_maxInside = n;
+	}
+}
+
+static void Leave()
+{
+	Base::interlockedDecrement32((sl_int32*)&g_inside);
+}
+
+static void RunThread()
+{
+	for (sl_uint32 i = 0; i < LOOP_COUNT; i++) {
+		if (i % 7 == 0) {
+			if (!(g_mutex.tryLock())) {
+				g_mutex.lock();
+			}
+		} else {
+			g_mutex.lock();
+		}
+		Enter();
+		g_counter++;
+		if (i % 13 == 0) {
+			// recursive locking by the owner
+			g_mutex.lock();
+			g_counter++;
+			g_mutex.unlock();
+		}
+		if (i % 1000 == 0) {
+			// holds the lock long enough to make the others sleep on it
+			for (volatile sl_uint32 k = 0; k < 20000; k++);
+		}
+		Leave();
+		g_mutex.unlock();
+	}
+}
+
+int main(int argc, const char * argv[])
+{
+	Ref<Thread> threads[THREAD_COUNT];
+	sl_uint32 i;
+	for (i = 0; i < THREAD_COUNT; i++) {
+		threads[i] = Thread::start(&RunThread);
+		if (threads[i].isNull()) {
+			Println("Failed to start thread");
+			return 1;
+		}
+	}
+	for (i = 0; i < THREAD_COUNT; i++) {
+		threads[i]->join();
+	}
+	sl_uint64 expected = 0;
+	for (i = 0; i < LOOP_COUNT; i++) {
+		expected += (i % 13 == 0) ? 2 : 1;
+	}
+	expected *= THREAD_COUNT;
+	if (g_maxInside != 1 || g_counter != expected) {
+		Println("FAILED: max threads inside=%d, counter=%d, expected=%d", g_maxInside, g_counter, expected);
+		return 1;
+	}
+	Println("OK");
+	return 0;
+}
@@ -0,0 +1,453 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+#include <slib/core/detail/simd.h>
+
+using namespace slib;
+
+/*
+	Fuzz test of the vectorized string and charset routines. Every random case runs with the scalar code (`_priv_Simd::None`)
+	and with each SIMD level. Substring search, case folding, case-insensitive comparison and hashes must match the reference
+	implementations below, and UTF conversions (which also see invalid UTF-8, lone surrogates and out-of-range code points)
+	must give the same output as the scalar code. Lengths are concentrated around the 16/32-byte block boundaries.
+*/
+
+#define MAX_LENGTH 300
+#define ITERATIONS 100
+
+static const _priv_Simd::Level g_levels[] = { _priv_Simd::None, _priv_Simd::Base, _priv_Simd::SSSE3, _priv_Simd::AVX2 };
+#define LEVELS_COUNT (sizeof(g_levels) / sizeof(g_levels[0]))
+
+static sl_uint32 g_seed = 12345;
+static sl_uint32 g_nFailed = 0;
+
+static sl_uint32 Random(sl_uint32 n)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xFFFFFF) % n;
+}
+
+static void Fail(const char* name, sl_size len, sl_int32 level)
+{
+	if (g_nFailed < 20) {
+		Println("FAILED: %s, length=%d, level=%d", name, (sl_uint32)len, level);
+	}
+	g_nFailed++;
+}
+
+// letters around the case boundaries ('@', '[', '`', '{'), bytes over 0x7F, and sometimes null characters
+static void GenerateText(sl_char8* text, sl_size len, sl_bool flagNull)
+{
+	static const char* alphabet = "aAbBzZ@[`{09 ";
+	for (sl_size i = 0; i < len; i++) {
+		sl_uint32 r = Random(16);
+		if (r < 13) {
+			text[i] = alphabet[r];
+		} else if (r < 15 || !flagNull) {
+			text[i] = (sl_char8)(0x80 + Random(128));
+		} else {
+			text[i] = 0;
+		}
+	}
+}
+
+static sl_reg RefIndexOf(const sl_char8* text, sl_size len, const sl_char8* pattern, sl_size lenPattern, sl_reg start)
+{
+	if (start < 0) {
+		start = 0;
+	}
+	for (sl_size i = start; i + lenPattern <= len; i++) {
+		if (Base::equalsMemory(text + i, pattern, lenPattern)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// `String::lastIndexOf()` finds the patterns starting before `start` (`lenPattern` >= 2)
+static sl_reg RefLastIndexOf(const sl_char8* text, sl_size len, const sl_char8* pattern, sl_size lenPattern, sl_reg start)
+{
+	if (len < lenPattern) {
+		return -1;
+	}
+	sl_size n = len - lenPattern + 1;
+	if (start >= 0 && (sl_size)start < n) {
+		n = start;
+	}
+	for (sl_size i = n; i > 0; i--) {
+		if (Base::equalsMemory(text + i - 1, pattern, lenPattern)) {
+			return i - 1;
+		}
+	}
+	return -1;
+}
+
+static sl_uint8 ToUpper(sl_uint8 c)
+{
+	return (c >= 'a' && c <= 'z') ? c - 32 : c;
+}
+
+static sl_uint8 ToLower(sl_uint8 c)
+{
+	return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+}
+
+// for the strings without null characters
+static sl_int32 RefCompareIgnoreCase(const sl_char8* s1, sl_size len1, const sl_char8* s2, sl_size len2)
+{
+	sl_size len = SLIB_MIN(len1, len2);
+	for (sl_size i = 0; i < len; i++) {
+		sl_uint8 c1 = ToUpper(s1[i]);
+		sl_uint8 c2 = ToUpper(s2[i]);
+		if (c1 != c2) {
+			return c1 < c2 ? -1 : 1;
+		}
+	}
+	return len1 < len2 ? -1 : (len1 > len2 ? 1 : 0);
+}
+
+static sl_size RefHash(const sl_char8* s, sl_size len, sl_bool flagIgnoreCase)
+{
+	if (!len) {
+		return 0;
+	}
+	sl_size hash = 0;
+	for (sl_size i = 0; i < len; i++) {
+		sl_uint32 ch = s[i];
+		if (flagIgnoreCase && ch >= 'a' && ch <= 'z') {
+			ch -= 32;
+		}
+		hash = hash * 31 + ch;
+	}
+	return Rehash(hash);
+}
+
+static void TestString(const sl_char8* text, sl_size len, sl_bool flagNull)
+{
+	// pattern taken from the text (found) or generated (mostly not found)
+	sl_char8 pattern[64];
+	sl_size lenPattern = 1 + Random(40);
+	if (len && Random(2)) {
+		sl_size pos = Random((sl_uint32)len);
+		if (lenPattern > len - pos) {
+			lenPattern = len - pos;
+		}
+		Base::copyMemory(pattern, text + pos, lenPattern);
+	} else {
+		GenerateText(pattern, lenPattern, flagNull);
+	}
+	sl_reg starts[] = { -1, 0, 1, 15, 16, 17, 31, 32, 33, (sl_reg)len / 2, (sl_reg)len };
+	
+	// the other side of the comparison: the same text in the different cases, with a byte changed at a random position
+	sl_char8 other[MAX_LENGTH + 1];
+	sl_size lenOther = len;
+	for (sl_size i = 0; i < len; i++) {
+		other[i] = Random(2) ? (sl_char8)ToUpper(text[i]) : (sl_char8)ToLower(text[i]);
+	}
+	sl_uint32 mode = Random(4);
+	if (mode == 1 && len) {
+		other[Random((sl_uint32)len)] ^= (sl_char8)(1 << Random(8));
+	} else if (mode == 2 && len) {
+		lenOther = Random((sl_uint32)len);
+	} else if (mode == 3) {
+		other[len] = 'a';
+		lenOther = len + 1;
+	}
+	
+	sl_int32 compareScalar[2] = {0, 0};
+	for (sl_uint32 iLevel = 0; iLevel < LEVELS_COUNT; iLevel++) {
+		sl_int32 level = (sl_int32)(g_levels[iLevel]);
+		_priv_Simd::setLevelLimit(g_levels[iLevel]);
+		String str(text, len);
+		StringView view(text, len);
+		String strPattern(pattern, lenPattern);
+		for (sl_size k = 0; k < sizeof(starts) / sizeof(starts[0]); k++) {
+			sl_reg expected = RefIndexOf(text, len, pattern, lenPattern, starts[k]);
+			if (str.indexOf(strPattern, starts[k]) != expected) {
+				Fail("String::indexOf", len, level);
+			}
+			if (view.indexOf(StringView(pattern, lenPattern), starts[k]) != expected) {
+				Fail("StringView::indexOf", len, level);
+			}
+			if (lenPattern >= 2) {
+				if (str.lastIndexOf(strPattern, starts[k]) != RefLastIndexOf(text, len, pattern, lenPattern, starts[k])) {
+					Fail("String::lastIndexOf", len, level);
+				}
+			}
+		}
+		
+		String upper = String::toUpper(text, len);
+		String lower = String::toLower(text, len);
+		if (upper.getLength() != len || lower.getLength() != len) {
+			Fail("toUpper/toLower length", len, level);
+		} else {
+			for (sl_size i = 0; i < len; i++) {
+				if ((sl_uint8)(upper.getData()[i]) != ToUpper(text[i]) || (sl_uint8)(lower.getData()[i]) != ToLower(text[i])) {
+					Fail("toUpper/toLower", len, level);
+					break;
+				}
+			}
+		}
+		
+		String strOther(other, lenOther);
+		StringView viewOther(other, lenOther);
+		sl_bool bEquals = lenOther == len && !(RefCompareIgnoreCase(text, len, other, lenOther));
+		if (str.equalsIgnoreCase(strOther) != bEquals || view.equalsIgnoreCase(viewOther) != bEquals) {
+			Fail("equalsIgnoreCase", len, level);
+		}
+		sl_int32 compare = str.compareIgnoreCase(strOther);
+		sl_int32 compareView = view.compareIgnoreCase(viewOther);
+		if (flagNull) {
+			// the texts with null characters are only compared with the scalar code
+			if (iLevel) {
+				if (compare != compareScalar[0] || compareView != compareScalar[1]) {
+					Fail("compareIgnoreCase (null)", len, level);
+				}
+			} else {
+				compareScalar[0] = compare;
+				compareScalar[1] = compareView;
+			}
+		} else {
+			sl_int32 expected = RefCompareIgnoreCase(text, len, other, lenOther);
+			if (compare != expected || compareView != expected) {
+				Fail("compareIgnoreCase", len, level);
+			}
+		}
+		
+		if (str.getHashCode() != RefHash(text, len, sl_false)) {
+			Fail("getHashCode", len, level);
+		}
+		sl_size hashIgnoreCase = str.getHashCodeIgnoreCase();
+		if (hashIgnoreCase != RefHash(text, len, sl_true)) {
+			Fail("getHashCodeIgnoreCase", len, level);
+		}
+		if (mode != 1 && hashIgnoreCase != String(other, len).getHashCodeIgnoreCase()) {
+			Fail("getHashCodeIgnoreCase (other case)", len, level);
+		}
+	}
+	_priv_Simd::setLevelLimit(_priv_Simd::AVX2);
+}
+
+/*
+	Runs `convert(dst, lenBuffer)` with each level, on the output buffers filled with the same garbage,
+	and compares the returned lengths and the whole buffers.
+*/
+template <class CT, class CONVERT>
+static void CompareConversion(const char* name, sl_size len, sl_reg lenBuffer, const CONVERT& convert)
+{
+	static CT outputs[LEVELS_COUNT][MAX_LENGTH * 4 + 64];
+	sl_size results[LEVELS_COUNT];
+	for (sl_uint32 iLevel = 0; iLevel < LEVELS_COUNT; iLevel++) {
+		_priv_Simd::setLevelLimit(g_levels[iLevel]);
+		Base::resetMemory(outputs[iLevel], 0xCC, sizeof(outputs[iLevel]));
+		results[iLevel] = convert(outputs[iLevel], lenBuffer);
+		if (iLevel) {
+			if (results[iLevel] != results[0] || Base::compareMemory((sl_uint8*)(outputs[iLevel]), (sl_uint8*)(outputs[0]), sizeof(outputs[0]))) {
+				Fail(name, len, (sl_int32)(g_levels[iLevel]));
+			}
+			if (convert(sl_null, lenBuffer) != results[0]) {
+				Fail(name, len, (sl_int32)(g_levels[iLevel]));
+			}
+		}
+	}
+	_priv_Simd::setLevelLimit(_priv_Simd::AVX2);
+}
+
+static sl_reg GetBufferLength(sl_size len)
+{
+	switch (Random(4)) {
+		case 0:
+			return -1;
+		case 1:
+			// around the block boundaries
+			return 15 + Random(3) + 16 * Random(2);
+		default:
+			return Random((sl_uint32)(len * 2 + 1));
+	}
+}
+
+// ASCII runs broken by the multi-byte sequences, which are invalid in `flagInvalid` mode
+static void GenerateUtf8(sl_char8* text, sl_size len, sl_bool flagInvalid, sl_bool flagSupplementary = sl_true)
+{
+	sl_size i = 0;
+	while (i < len) {
+		if (Random(8)) {
+			text[i++] = (sl_char8)(Random(128));
+			continue;
+		}
+		sl_uint8 seq[4];
+		sl_uint32 n;
+		if (flagInvalid) {
+			static const sl_uint8 invalids[][4] = {
+				{0x80}, {0xBF}, {0xC0, 0x80}, {0xC1, 0xBF}, {0xE0, 0x80, 0x80}, {0xED, 0xA0, 0x80}, {0xED, 0xBF, 0xBF},
+				{0xF4, 0x90, 0x80, 0x80}, {0xF8, 0x88}, {0xFE}, {0xFF}, {0xC3}, {0xE2, 0x82}, {0xF0, 0x9F, 0x98}
+			};
+			static const sl_uint32 lens[] = { 1, 1, 2, 2, 3, 3, 3, 4, 2, 1, 1, 1, 2, 3 };
+			sl_uint32 k = Random(sizeof(lens) / sizeof(lens[0]));
+			n = lens[k];
+			Base::copyMemory(seq, invalids[k], n);
+		} else {
+			sl_uint32 r = Random(flagSupplementary ? 3 : 2);
+			sl_uint32 ch;
+			if (r == 0) {
+				ch = 0x80 + Random(0x780);
+			} else if (r == 1) {
+				ch = 0x800 + Random(0xF800);
+				if (ch >= 0xD800 && ch < 0xE000) {
+					ch -= 0x800;
+				}
+			} else {
+				ch = 0x10000 + Random(0x100000);
+			}
+			n = (sl_uint32)(Charsets::utf32ToUtf8((sl_char32*)&ch, 1, (sl_char8*)seq, 4));
+		}
+		for (sl_uint32 k = 0; k < n && i < len; k++) {
+			text[i++] = (sl_char8)(seq[k]);
+		}
+	}
+}
+
+// ASCII runs broken by the other characters, the surrogate pairs and the lone surrogates
+static void GenerateUtf16(sl_char16* text, sl_size len)
+{
+	for (sl_size i = 0; i < len; i++) {
+		sl_uint32 r = Random(32);
+		if (r < 26) {
+			text[i] = (sl_char16)(Random(128));
+		} else if (r < 28) {
+			text[i] = (sl_char16)(0x80 + Random(0xFF80));
+		} else if (r < 30 && i + 1 < len) {
+			text[i++] = (sl_char16)(0xD800 + Random(0x400));
+			text[i] = (sl_char16)(0xDC00 + Random(0x400));
+		} else {
+			text[i] = (sl_char16)(0xD800 + Random(0x800));
+		}
+	}
+}
+
+// ASCII runs broken by the other code points, the surrogates and the values out of the range
+static void GenerateUtf32(sl_char32* text, sl_size len)
+{
+	for (sl_size i = 0; i < len; i++) {
+		sl_uint32 r = Random(32);
+		if (r < 26) {
+			text[i] = (sl_char32)(Random(128));
+		} else if (r < 29) {
+			text[i] = (sl_char32)(0x80 + Random(0x10FF80));
+		} else if (r < 30) {
+			text[i] = (sl_char32)(0xD800 + Random(0x800));
+		} else if (r < 31) {
+			text[i] = (sl_char32)(0x110000 + Random(0x1000));
+		} else {
+			text[i] = (sl_char32)0xFFFFFF80 + (sl_char32)(Random(0x80));
+		}
+	}
+}
+
+static void TestCharsets(sl_size len, sl_uint32 offset)
+{
+	static sl_char8 bufUtf8[MAX_LENGTH + 8];
+	static sl_char16 bufUtf16[MAX_LENGTH + 8];
+	static sl_char32 bufUtf32[MAX_LENGTH + 8];
+	sl_char8* utf8 = bufUtf8 + offset;
+	sl_char16* utf16 = bufUtf16 + offset;
+	sl_char32* utf32 = bufUtf32 + offset;
+	
+	GenerateUtf8(utf8, len, Random(2) != 0);
+	GenerateUtf16(utf16, len);
+	GenerateUtf32(utf32, len);
+	sl_reg lenBuffer = GetBufferLength(len);
+	
+	CompareConversion<sl_char16>("utf8ToUtf16", len, lenBuffer, [&](sl_char16* dst, sl_reg n) {
+		return Charsets::utf8ToUtf16(utf8, len, dst, n);
+	});
+	CompareConversion<sl_char32>("utf8ToUtf32", len, lenBuffer, [&](sl_char32* dst, sl_reg n) {
+		return Charsets::utf8ToUtf32(utf8, len, dst, n);
+	});
+	CompareConversion<sl_char8>("utf16ToUtf8", len, lenBuffer, [&](sl_char8* dst, sl_reg n) {
+		return Charsets::utf16ToUtf8(utf16, len, dst, n);
+	});
+	CompareConversion<sl_char32>("utf16ToUtf32", len, lenBuffer, [&](sl_char32* dst, sl_reg n) {
+		return Charsets::utf16ToUtf32(utf16, len, dst, n);
+	});
+	CompareConversion<sl_char8>("utf32ToUtf8", len, lenBuffer, [&](sl_char8* dst, sl_reg n) {
+		return Charsets::utf32ToUtf8(utf32, len, dst, n);
+	});
+	CompareConversion<sl_char16>("utf32ToUtf16", len, lenBuffer, [&](sl_char16* dst, sl_reg n) {
+		return Charsets::utf32ToUtf16(utf32, len, dst, n);
+	});
+	
+	// valid text survives the round trips with each level (`utf8ToUtf16()` decodes the BMP only)
+	for (sl_uint32 k = 0; k < 2; k++) {
+		sl_bool flagSupplementary = k != 0;
+		GenerateUtf8(utf8, len, sl_false, flagSupplementary);
+		sl_size lenValid = len;
+		while (lenValid && ((sl_uint8)(utf8[lenValid - 1]) & 0x80)) {
+			// drops the truncated sequence at the end
+			lenValid--;
+		}
+		for (sl_uint32 iLevel = 0; iLevel < LEVELS_COUNT; iLevel++) {
+			_priv_Simd::setLevelLimit(g_levels[iLevel]);
+			static sl_char16 t16[MAX_LENGTH * 2];
+			static sl_char32 t32[MAX_LENGTH * 2];
+			static sl_char8 t8[MAX_LENGTH * 4];
+			sl_size n8;
+			if (!flagSupplementary) {
+				sl_size n16 = Charsets::utf8ToUtf16(utf8, lenValid, t16, -1);
+				n8 = Charsets::utf16ToUtf8(t16, n16, t8, -1);
+				if (n8 != lenValid || !(Base::equalsMemory(t8, utf8, lenValid))) {
+					Fail("UTF-8 -> UTF-16 -> UTF-8", len, (sl_int32)(g_levels[iLevel]));
+				}
+			}
+			sl_size n32 = Charsets::utf8ToUtf32(utf8, lenValid, t32, -1);
+			n8 = Charsets::utf32ToUtf8(t32, n32, t8, -1);
+			if (n8 != lenValid || !(Base::equalsMemory(t8, utf8, lenValid))) {
+				Fail("UTF-8 -> UTF-32 -> UTF-8", len, (sl_int32)(g_levels[iLevel]));
+			}
+		}
+		_priv_Simd::setLevelLimit(_priv_Simd::AVX2);
+	}
+}
+
+int main(int argc, const char * argv[])
+{
+	static sl_char8 buf[MAX_LENGTH + 8];
+	sl_size lengths[] = { 127, 128, 129, 255, 256, 257, MAX_LENGTH };
+	for (sl_size n = 0; n < 70 + sizeof(lengths) / sizeof(lengths[0]); n++) {
+		sl_size len = n < 70 ? n : lengths[n - 70];
+		for (sl_uint32 i = 0; i < ITERATIONS; i++) {
+			sl_uint32 offset = i & 3;
+			sl_bool flagNull = (i & 4) != 0;
+			GenerateText(buf + offset, len, flagNull);
+			TestString(buf + offset, len, flagNull);
+			TestCharsets(len, offset);
+		}
+	}
+	if (g_nFailed) {
+		Println("FAILED: %d cases", g_nFailed);
+		return 1;
+	}
+	Println("OK");
+	return 0;
+}
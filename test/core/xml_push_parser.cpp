@@ -0,0 +1,275 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+
+using namespace slib;
+
+/*
+	Chunk test of `XmlPushParser`: every document is fed one byte at a time, in random chunk sizes and at once,
+	and the sequence of the callbacks and the error (message, position, line and column) must be the same as
+	`Xml::parseXml` on the whole document. When a document ends with '>', all its nodes must be reported before `end()`.
+	The documents have quotes and '>' inside the start tags, comments, CDATA sections and processing instructions whose
+	terminators ("-->", "]]>", "?>") are split across the chunks, a UTF-8 BOM (possibly split), and errors in every kind
+	of node.
+*/
+
+#define RANDOM_ROUNDS 50
+
+static sl_uint32 g_seed = 12345;
+static sl_uint32 g_nFailed = 0;
+
+static sl_uint32 Random(sl_uint32 n)
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return ((g_seed >> 8) & 0xFFFFFF) % n;
+}
+
+static const char* g_documents[] = {
+	// valid
+	"<a/>",
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<root>\n  <item id=\"1\">text</item>\n  <item id='2'/>\n</root>\n",
+	"<a x=\"1>2\" y='\"q\">' z=\"'>'\">v</a>",
+	"<a x = \"a/>b\" y\t=\t'<'/>",
+	"<a><!-- comment > - -> with - dashes - -></a>",
+	"<a><!-- x --><!----><b/><!-- y --></a>",
+	"<a><![CDATA[ ]] ]> ]]]> <b> & ]]></a>",
+	"<a><![CDATA[]]><![CDATA[x]]]]><![CDATA[>]]></a>",
+	"<?pi a ? > b ?>\n<a><?target data?x?></a><?end?>",
+	"<a>1 &lt; 2 &amp;&amp; 3 &gt; 2 &#65;&#x42;</a>",
+	"<r xmlns=\"urn:d\" xmlns:p=\"urn:p\"><p:a p:x=\"1\" y=\"2\"><b xmlns=\"\"/></p:a><c/></r>",
+	"<a>\n\t<b>\r\n\t\t<c>text\nin lines</c>\n\t</b>\n</a>",
+	"  \n<a>  </a>  \n",
+	"<a>\xC3\xA9\xE4\xB8\xAD \xF0\x9F\x98\x80</a>",
+	"\xEF\xBB\xBF<a>bom</a>",
+	"\xEF\xBB\xBF",
+	"\xEF\xBB\xBF<?xml version=\"1.0\"?><a x='\xEF\xBB\xBF'/>",
+	// errors
+	"",
+	"a",
+	"ab",
+	"\xEF\xBB",
+	"\xEF\xBB<a/>",
+	"<a>",
+	"<a",
+	"<a x=\"1>",
+	"<a x=\"1\" x=\"2\"/>",
+	"<a x=1/>",
+	"<a x=\"<\"/>",
+	"<a></b>",
+	"<a><b></a></b>",
+	"</a>",
+	"<a/></a>",
+	"<a/><b/>",
+	"<a/>text",
+	"text<a/>",
+	"<a><!-- open",
+	"<a><!-- x -- ></a>",
+	"<a><![CDATA[ open</a>",
+	"<a><![CDAT[x]]></a>",
+	"<!DOCTYPE a><a/>",
+	"<a><!x></a>",
+	"<a><?pi open</a>",
+	"<? x?><a/>",
+	"<a>&bogus;</a>",
+	"<a>x & y</a>",
+	"<a>1 < 2</a>",
+	"<a>\n  <b attr=\"v\"\n     c=d>\n</a>",
+	"<p:a xmlns:q=\"u\"/>",
+	"\xEF\xBB\xBF<a></b>",
+	"\xEF\xBB\xBF\n\n<a>\n<b></a>",
+};
+
+#define DOCUMENTS_COUNT (sizeof(g_documents) / sizeof(g_documents[0]))
+
+static String ToString(const XmlString& s)
+{
+	return String(s);
+}
+
+// `offset` is added to the positions
+static void SetCallbacks(XmlParseParam& param, StringBuffer* trace, sl_size offset)
+{
+	param.flagCreateDocument = sl_false;
+	param.flagLogError = sl_false;
+	param.onStartDocument = [trace](XmlParseControl*, XmlDocument*) {
+		trace->add("StartDocument\n");
+	};
+	param.onEndDocument = [trace](XmlParseControl*, XmlDocument*) {
+		trace->add("EndDocument\n");
+	};
+	param.onStartElement = [trace, offset](XmlParseControl*, XmlElement* element) {
+		String s = String::format("StartElement %s {%s} %s pos=%d line=%d col=%d content=%d", ToString(element->getName()), ToString(element->getUri()), ToString(element->getLocalName()), element->getStartPositionInSource() + offset, element->getLineNumberInSource(), element->getColumnNumberInSource(), element->getStartContentPositionInSource() + offset);
+		XmlAttribute attr;
+		for (sl_size i = 0; element->getAttribute(i, &attr); i++) {
+			s += String::format(" %s{%s}%s=\"%s\"", ToString(attr.name), ToString(attr.uri), ToString(attr.localName), ToString(attr.value));
+		}
+		trace->add(s + "\n");
+	};
+	param.onEndElement = [trace, offset](XmlParseControl*, XmlElement* element) {
+		trace->add(String::format("EndElement %s content=%d end=%d\n", ToString(element->getName()), element->getEndContentPositionInSource() + offset, element->getEndPositionInSource() + offset));
+	};
+	param.onText = [trace](XmlParseControl*, const XmlString& text) {
+		trace->add(String::format("Text [%s]\n", ToString(text)));
+	};
+	param.onCDATA = [trace](XmlParseControl*, const XmlString& text) {
+		trace->add(String::format("CDATA [%s]\n", ToString(text)));
+	};
+	param.onProcessingInstruction = [trace](XmlParseControl*, const XmlString& target, const XmlString& content) {
+		trace->add(String::format("PI %s [%s]\n", ToString(target), ToString(content)));
+	};
+	param.onComment = [trace](XmlParseControl*, const XmlString& content) {
+		trace->add(String::format("Comment [%s]\n", ToString(content)));
+	};
+	param.onStartPrefixMapping = [trace](XmlParseControl*, const XmlString& prefix, const XmlString& uri) {
+		trace->add(String::format("StartPrefixMapping %s %s\n", ToString(prefix), ToString(uri)));
+	};
+	param.onEndPrefixMapping = [trace](XmlParseControl*, const XmlString& prefix) {
+		trace->add(String::format("EndPrefixMapping %s\n", ToString(prefix)));
+	};
+}
+
+static String GetErrorTrace(const XmlParseParam& param, sl_size offset)
+{
+	if (param.flagError) {
+		return String::format("Error pos=%d line=%d col=%d %s\n", param.errorPosition + offset, param.errorLine, param.errorColumn, param.errorMessage);
+	}
+	return "OK\n";
+}
+
+static void InitParam(XmlParseParam& param, sl_bool flagCreateAll)
+{
+	if (flagCreateAll) {
+		param.setCreatingAll();
+	}
+}
+
+// `Xml::parseXml` doesn't skip the BOM: the document is passed without it, and the positions are shifted by `offset`
+static String ParseWhole(const char* doc, sl_size len, sl_bool flagCreateAll, sl_size offset)
+{
+	XmlParseParam param;
+	InitParam(param, flagCreateAll);
+	StringBuffer trace;
+	SetCallbacks(param, &trace, offset);
+	Xml::parseXml(doc, len, param);
+	trace.add(GetErrorTrace(param, offset));
+	return trace.merge();
+}
+
+// chunk sizes: 0 = whole document, 1 = byte by byte, otherwise random sizes in [1, maxChunk]
+static String ParseChunks(const char* doc, sl_size len, sl_bool flagCreateAll, sl_uint32 maxChunk, sl_bool flagMarkEnd)
+{
+	XmlParseParam param;
+	InitParam(param, flagCreateAll);
+	StringBuffer trace;
+	SetCallbacks(param, &trace, 0);
+	Ref<XmlPushParser> parser = XmlPushParser::create(param);
+	if (parser.isNull()) {
+		return "Null\n";
+	}
+	sl_size offset = 0;
+	sl_bool flagPut = sl_true;
+	while (offset < len) {
+		sl_size n = len - offset;
+		if (maxChunk == 1) {
+			n = 1;
+		} else if (maxChunk) {
+			n = Math::min(n, (sl_size)(Random(maxChunk) + 1));
+		}
+		if (!(parser->put(doc + offset, n))) {
+			flagPut = sl_false;
+			break;
+		}
+		// empty chunks are allowed between the others
+		if (!(parser->put(doc + offset, 0))) {
+			flagPut = sl_false;
+			break;
+		}
+		offset += n;
+	}
+	if (flagMarkEnd) {
+		trace.add("-- end() --\n");
+	}
+	sl_bool flagEnd = parser->end();
+	if (flagPut && flagEnd == parser->isError()) {
+		trace.add("Mismatched result of end()\n");
+	}
+	if (!(parser->isEnded())) {
+		trace.add("Not ended\n");
+	}
+	trace.add(GetErrorTrace(parser->getParam(), 0));
+	return trace.merge();
+}
+
+// when the document ends with '>', all nodes are complete and must be reported before `end()`, which only reports the end of the document or the error
+static String InsertEndMarker(const String& trace)
+{
+	sl_reg index = trace.indexOf("EndDocument\n");
+	if (index < 0) {
+		// before the error
+		index = trace.lastIndexOf('\n', trace.getLength() - 2) + 1;
+	}
+	return trace.substring(0, index) + "-- end() --\n" + trace.substring(index);
+}
+
+static void CompareTrace(sl_size iDoc, const String& expected, const String& result, const char* mode)
+{
+	if (expected != result) {
+		if (g_nFailed < 10) {
+			Println("FAILED: document %d (%s)\n--- expected\n%s--- result\n%s", (sl_uint32)iDoc, mode, expected, result);
+		}
+		g_nFailed++;
+	}
+}
+
+int main(int argc, const char * argv[])
+{
+	for (sl_size iDoc = 0; iDoc < DOCUMENTS_COUNT; iDoc++) {
+		const char* doc = g_documents[iDoc];
+		sl_size len = Base::getStringLength(doc);
+		// the push parser skips the BOM, and counts the positions including it
+		sl_size lenBOM = 0;
+		if (len >= 3 && Base::equalsMemory(doc, "\xEF\xBB\xBF", 3)) {
+			lenBOM = 3;
+		}
+		for (int iCreate = 0; iCreate < 2; iCreate++) {
+			sl_bool flagCreateAll = iCreate != 0;
+			sl_bool flagCompleteNodes = len && doc[len - 1] == '>';
+			String expected = ParseWhole(doc + lenBOM, len - lenBOM, flagCreateAll, lenBOM);
+			if (flagCompleteNodes) {
+				expected = InsertEndMarker(expected);
+			}
+			CompareTrace(iDoc, expected, ParseChunks(doc, len, flagCreateAll, 0, flagCompleteNodes), "whole");
+			CompareTrace(iDoc, expected, ParseChunks(doc, len, flagCreateAll, 1, flagCompleteNodes), "byte by byte");
+			for (sl_uint32 i = 0; i < RANDOM_ROUNDS; i++) {
+				CompareTrace(iDoc, expected, ParseChunks(doc, len, flagCreateAll, i < RANDOM_ROUNDS / 2 ? 4 : 16, flagCompleteNodes), "random chunks");
+			}
+		}
+	}
+	if (g_nFailed) {
+		Println("FAILED: %d cases", g_nFailed);
+		return 1;
+	}
+	Println("OK");
+	return 0;
+}
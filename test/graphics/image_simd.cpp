@@ -0,0 +1,295 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+#include <slib/graphics.h>
+
+#include <slib/core/detail/simd.h>
+#include <slib/graphics/detail/image_simd.h>
+
+using namespace slib;
+
+/*
+	Differential test of the image row kernels: every kernel runs with the scalar code (`_priv_Simd::None`) and then with each SIMD level,
+	on odd widths, tail pixels and unaligned pointers/strides, and the outputs (including the guard bytes around them) must be identical.
+*/
+
+#define GUARD 64
+#define MAX_COUNT 300
+
+static const _priv_Simd::Level g_levels[] = { _priv_Simd::Base, _priv_Simd::SSSE3, _priv_Simd::AVX2 };
+static sl_uint32 g_seed = 12345;
+static sl_uint32 g_nFailed = 0;
+
+static sl_uint8 Random()
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return (sl_uint8)(g_seed >> 16);
+}
+
+// many alphas should be 0 or 255 to hit the special cases
+static sl_uint8 RandomAlpha()
+{
+	sl_uint8 r = Random();
+	if (r < 64) {
+		return 0;
+	}
+	if (r < 128) {
+		return 255;
+	}
+	return Random();
+}
+
+static void FillRandom(sl_uint8* data, sl_size size, sl_bool flagAlpha = sl_false)
+{
+	for (sl_size i = 0; i < size; i++) {
+		data[i] = Random();
+	}
+	if (flagAlpha) {
+		for (sl_size i = 3; i < size; i += 4) {
+			data[i] = RandomAlpha();
+		}
+	}
+}
+
+static sl_uint32 g_widths[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 23, 31, 32, 33, 47, 63, 64, 65, 95, 127, 128, 129, 255, MAX_COUNT - 1 };
+
+/*
+	Calls `run(buf, level)` on the copies of `input` with `_priv_Simd::None` and each SIMD level, and compares the results.
+	`run` must modify only the given buffer.
+*/
+template <class RUN>
+static void CompareLevels(const char* name, sl_uint32 width, sl_uint32 offset, const sl_uint8* input, sl_size size, const RUN& run)
+{
+	static sl_uint8 expected[(MAX_COUNT + GUARD) * 32];
+	static sl_uint8 result[(MAX_COUNT + GUARD) * 32];
+	Base::copyMemory(expected, input, size);
+	_priv_Simd::setLevelLimit(_priv_Simd::None);
+	run(expected);
+	for (sl_uint32 i = 0; i < sizeof(g_levels) / sizeof(g_levels[0]); i++) {
+		Base::copyMemory(result, input, size);
+		_priv_Simd::setLevelLimit(g_levels[i]);
+		run(result);
+		if (Base::compareMemory(expected, result, size)) {
+			for (sl_size k = 0; k < size; k++) {
+				if (expected[k] != result[k]) {
+					Println("FAILED: %s, width=%d, offset=%d, level=%d, byte=%d, expected=%d, result=%d", name, width, offset, (sl_int32)(g_levels[i]), (sl_uint32)k, expected[k], result[k]);
+					break;
+				}
+			}
+			g_nFailed++;
+		}
+	}
+	_priv_Simd::setLevelLimit(_priv_Simd::AVX2);
+}
+
+static void TestRowKernels()
+{
+	static sl_uint8 input[(MAX_COUNT + GUARD) * 32];
+	sl_size size = sizeof(input);
+	// orders of the conversions between the packed RGB formats (see `BitmapFormat`)
+	static const sl_uint8 orders4to4[][4] = { {0, 1, 2, 3}, {2, 1, 0, 3}, {3, 2, 1, 0}, {1, 2, 3, 0}, {3, 0, 1, 2}, {0, 3, 2, 1} };
+	static const sl_uint8 orders4to3[][3] = { {0, 1, 2}, {2, 1, 0}, {1, 2, 3}, {3, 2, 1} };
+	static const sl_uint8 orders3to4[][4] = { {0, 1, 2, 255}, {2, 1, 0, 255}, {255, 0, 1, 2}, {255, 2, 1, 0} };
+	static const sl_uint8 alphas[] = { 0, 1, 127, 128, 254, 255 };
+	for (sl_uint32 iWidth = 0; iWidth < sizeof(g_widths) / sizeof(g_widths[0]); iWidth++) {
+		sl_uint32 width = g_widths[iWidth];
+		for (sl_uint32 offset = 0; offset < 4; offset++) {
+			// `offset` is in bytes for the byte kernels, and in pixels for the `Color` kernels
+			FillRandom(input, size, sl_true);
+			sl_uint8* src = input + (size >> 1) + offset;
+			Color* colorsSrc = (Color*)(input + (size >> 1)) + offset;
+			sl_size posDst = GUARD + offset;
+			Color color(Random(), Random(), Random(), alphas[Random() % sizeof(alphas)]);
+			
+			CompareLevels("fillRow", width, offset, input, size, [&](sl_uint8* buf) {
+				_priv_ImageSimd::fillRow((Color*)buf + posDst, color, width);
+			});
+			CompareLevels("blendRow_PA_NPA", width, offset, input, size, [&](sl_uint8* buf) {
+				_priv_ImageSimd::blendRow_PA_NPA((Color*)buf + posDst, colorsSrc, width);
+			});
+			for (sl_uint32 k = 0; k < sizeof(alphas); k++) {
+				Color c(color.r, color.g, color.b, alphas[k]);
+				CompareLevels("blendColorRow_PA_NPA", width, offset, input, size, [&](sl_uint8* buf) {
+					_priv_ImageSimd::blendColorRow_PA_NPA((Color*)buf + posDst, c, width);
+				});
+			}
+			for (sl_uint32 k = 0; k < sizeof(orders4to4) / sizeof(orders4to4[0]); k++) {
+				CompareLevels("shuffleRow_4to4", width, offset, input, size, [&](sl_uint8* buf) {
+					_priv_ImageSimd::shuffleRow_4to4(buf + posDst, src, width, orders4to4[k]);
+				});
+			}
+			for (sl_uint32 k = 0; k < sizeof(orders4to3) / sizeof(orders4to3[0]); k++) {
+				CompareLevels("shuffleRow_4to3", width, offset, input, size, [&](sl_uint8* buf) {
+					_priv_ImageSimd::shuffleRow_4to3(buf + posDst, src, width, orders4to3[k]);
+				});
+			}
+			for (sl_uint32 k = 0; k < sizeof(orders3to4) / sizeof(orders3to4[0]); k++) {
+				CompareLevels("shuffleRow_3to4", width, offset, input, size, [&](sl_uint8* buf) {
+					_priv_ImageSimd::shuffleRow_3to4(buf + posDst, src, width, orders3to4[k]);
+				});
+			}
+			for (sl_uint32 indexAlpha = 0; indexAlpha < 4; indexAlpha += 3) {
+				CompareLevels("premultiplyRow", width, offset, input, size, [&](sl_uint8* buf) {
+					_priv_ImageSimd::premultiplyRow(buf + posDst, width, indexAlpha);
+				});
+				CompareLevels("unpremultiplyRow", width, offset, input, size, [&](sl_uint8* buf) {
+					// makes valid premultiplied samples first
+					_priv_ImageSimd::premultiplyRow(buf + posDst, width, indexAlpha);
+					_priv_ImageSimd::unpremultiplyRow(buf + posDst, width, indexAlpha);
+				});
+			}
+		}
+	}
+}
+
+static void TestYUVKernels()
+{
+	static sl_uint8 input[(MAX_COUNT + GUARD) * 32];
+	sl_size size = sizeof(input);
+	for (sl_uint32 iMatrix = 0; iMatrix < 4; iMatrix++) {
+		const _priv_YUVMatrix& m = _priv_YUVMatrix::get((YUVMatrix)iMatrix);
+		for (sl_uint32 iWidth = 0; iWidth < sizeof(g_widths) / sizeof(g_widths[0]); iWidth++) {
+			sl_uint32 width = g_widths[iWidth];
+			for (sl_uint32 offset = 0; offset < 2; offset++) {
+				FillRandom(input, size, sl_true);
+				sl_uint8* src = input + (size >> 1) + offset;
+				sl_uint8* src1 = src + (width << 2) + GUARD + 1;
+				sl_size posDst = GUARD + offset;
+				for (sl_uint32 flagBGRA = 0; flagBGRA < 2; flagBGRA++) {
+					// planar (I420), interleaved (NV12, NV21), and the other strides taking the scalar code
+					for (sl_uint32 layout = 0; layout < 4; layout++) {
+						sl_uint32 strideUV = layout ? 2 : 1;
+						sl_uint32 posU = layout == 2 ? 1 : 0;
+						sl_uint32 posV = layout == 0 ? width : (layout == 2 ? 0 : (layout == 1 ? 1 : width * 2 + 2));
+						CompareLevels("convertYUV420ToRGBARow", width, offset, input, size, [&](sl_uint8* buf) {
+							_priv_ImageSimd::convertYUV420ToRGBARow(buf + posDst, src, src1 + posU, src1 + posV, strideUV, width, m, flagBGRA);
+						});
+						CompareLevels("convertRGBAToYUV420Rows", width, offset, input, size, [&](sl_uint8* buf) {
+							sl_uint8* y0 = buf + posDst;
+							sl_uint8* y1 = y0 + width + 1;
+							sl_uint8* uv = y1 + width + 1;
+							_priv_ImageSimd::convertRGBAToYUV420Rows(y0, y1, uv + posU, uv + posV, strideUV, src, src1, width, m, flagBGRA);
+						});
+						CompareLevels("convertRGBAToYUV420Rows (last row)", width, offset, input, size, [&](sl_uint8* buf) {
+							sl_uint8* y0 = buf + posDst;
+							sl_uint8* uv = y0 + width + 1;
+							_priv_ImageSimd::convertRGBAToYUV420Rows(y0, y0, uv + posU, uv + posV, strideUV, src, src, width, m, flagBGRA);
+						});
+					}
+					CompareLevels("convertYUYVToRGBARow", width, offset, input, size, [&](sl_uint8* buf) {
+						_priv_ImageSimd::convertYUYVToRGBARow(buf + posDst, src, width, m, flagBGRA);
+					});
+					CompareLevels("convertRGBAToYUYVRow", width, offset, input, size, [&](sl_uint8* buf) {
+						_priv_ImageSimd::convertRGBAToYUYVRow(buf + posDst, src, width, m, flagBGRA);
+					});
+				}
+			}
+		}
+	}
+}
+
+static void TestSumBlock()
+{
+	static Color colors[64 * 64];
+	FillRandom((sl_uint8*)colors, sizeof(colors), sl_true);
+	for (sl_uint32 width = 1; width <= 9; width++) {
+		for (sl_uint32 height = 1; height <= 5; height++) {
+			for (sl_int32 stride = width; stride < (sl_int32)width + 4; stride++) {
+				sl_uint32 sum[4];
+				sl_uint32 expected[4];
+				_priv_Simd::setLevelLimit(_priv_Simd::None);
+				_priv_ImageSimd::sumBlock(expected, colors + 1, width, height, stride);
+				for (sl_uint32 i = 0; i < sizeof(g_levels) / sizeof(g_levels[0]); i++) {
+					_priv_Simd::setLevelLimit(g_levels[i]);
+					_priv_ImageSimd::sumBlock(sum, colors + 1, width, height, stride);
+					if (Base::compareMemory((sl_uint8*)sum, (sl_uint8*)expected, sizeof(sum))) {
+						Println("FAILED: sumBlock, width=%d, height=%d, stride=%d, level=%d", width, height, stride, (sl_int32)(g_levels[i]));
+						g_nFailed++;
+					}
+				}
+				_priv_Simd::setLevelLimit(_priv_Simd::AVX2);
+			}
+		}
+	}
+}
+
+// conversions between every pair of the packed RGB formats, through `BitmapData::copyPixelsFrom`
+static void TestCopyPixels()
+{
+	static const BitmapFormat formats[] = {
+		BitmapFormat::RGBA, BitmapFormat::BGRA, BitmapFormat::ARGB, BitmapFormat::ABGR,
+		BitmapFormat::RGBA_PA, BitmapFormat::BGRA_PA, BitmapFormat::ARGB_PA, BitmapFormat::ABGR_PA,
+		BitmapFormat::RGB, BitmapFormat::BGR
+	};
+	static sl_uint8 input[(MAX_COUNT + GUARD) * 32];
+	sl_size size = sizeof(input);
+	sl_uint32 nFormats = sizeof(formats) / sizeof(formats[0]);
+	for (sl_uint32 iSrc = 0; iSrc < nFormats; iSrc++) {
+		for (sl_uint32 iDst = 0; iDst < nFormats; iDst++) {
+			for (sl_uint32 width = 1; width <= 67; width += 11) {
+				sl_uint32 height = 3;
+				FillRandom(input, size, sl_true);
+				BitmapData bdSrc;
+				bdSrc.width = width;
+				bdSrc.height = height;
+				bdSrc.format = formats[iSrc];
+				bdSrc.sampleStride = BitmapFormats::getBitsPerSample(bdSrc.format) >> 3;
+				// unaligned pitch
+				bdSrc.pitch = bdSrc.sampleStride * width + 5;
+				bdSrc.data = input + (size >> 1) + 1;
+				if (BitmapFormats::isPrecomputedAlpha(bdSrc.format)) {
+					// valid premultiplied samples
+					_priv_Simd::setLevelLimit(_priv_Simd::None);
+					for (sl_uint32 y = 0; y < height; y++) {
+						_priv_ImageSimd::premultiplyRow((sl_uint8*)(bdSrc.data) + bdSrc.pitch * y, width, formats[iSrc] == BitmapFormat::ARGB_PA || formats[iSrc] == BitmapFormat::ABGR_PA ? 0 : 3);
+					}
+				}
+				CompareLevels("copyPixelsFrom", width, iSrc * nFormats + iDst, input, size, [&](sl_uint8* buf) {
+					BitmapData bdDst;
+					bdDst.width = width;
+					bdDst.height = height;
+					bdDst.format = formats[iDst];
+					bdDst.sampleStride = BitmapFormats::getBitsPerSample(bdDst.format) >> 3;
+					bdDst.pitch = bdDst.sampleStride * width + 3;
+					bdDst.data = buf + GUARD + 3;
+					bdDst.copyPixelsFrom(bdSrc);
+				});
+			}
+		}
+	}
+}
+
+int main(int argc, const char * argv[])
+{
+	TestRowKernels();
+	TestYUVKernels();
+	TestSumBlock();
+	TestCopyPixels();
+	if (g_nFailed) {
+		Println("FAILED: %d cases", g_nFailed);
+		return 1;
+	}
+	Println("OK");
+	return 0;
+}
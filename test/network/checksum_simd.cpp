@@ -0,0 +1,158 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+#include <slib/network/tcpip.h>
+
+#include <slib/core/detail/simd.h>
+
+using namespace slib;
+
+/*
+	Differential test of the Internet checksum: `calculateOneComplementSum` and `copyAndCalculateOneComplementSum`
+	run with the scalar code (`_priv_Simd::None`) and with each SIMD level, on odd lengths and unaligned starts,
+	and must return the RFC 1071 sum computed word by word. The copies (including the guard bytes around them) are compared too.
+*/
+
+#define GUARD 64
+#define OFFSET_COUNT 4
+
+static const _priv_Simd::Level g_levels[] = { _priv_Simd::None, _priv_Simd::Base, _priv_Simd::SSSE3, _priv_Simd::AVX2 };
+#define LEVELS_COUNT (sizeof(g_levels) / sizeof(g_levels[0]))
+
+static sl_uint32 g_seed = 12345;
+static sl_uint32 g_nFailed = 0;
+
+static sl_uint8 Random()
+{
+	g_seed = g_seed * 1103515245 + 12345;
+	return (sl_uint8)(g_seed >> 16);
+}
+
+// big-endian 16-bit words, the odd byte padded with zero
+static sl_uint16 ReferenceSum(const sl_uint8* data, sl_size size, sl_uint32 add)
+{
+	sl_uint64 sum = (add >> 16) + (add & 0xffff);
+	sl_size i = 0;
+	for (; i + 1 < size; i += 2) {
+		sum += ((sl_uint32)(data[i]) << 8) | data[i + 1];
+	}
+	if (i < size) {
+		sum += (sl_uint32)(data[i]) << 8;
+	}
+	while (sum >> 16) {
+		sum = (sum >> 16) + (sum & 0xffff);
+	}
+	return (sl_uint16)sum;
+}
+
+static void Fail(const char* name, sl_size size, sl_uint32 offset, sl_uint32 level, sl_uint32 expected, sl_uint32 result)
+{
+	Println("FAILED: %s, size=%d, offset=%d, level=%d, expected=%d, result=%d", name, (sl_uint32)size, offset, level, expected, result);
+	g_nFailed++;
+}
+
+static void TestSize(sl_uint8* input, sl_uint8* output, sl_uint8* outputExpected, sl_size size, sl_uint32 add)
+{
+	for (sl_uint32 offset = 0; offset < OFFSET_COUNT; offset++) {
+		const sl_uint8* src = input + GUARD + offset;
+		sl_uint16 expected = ReferenceSum(src, size, add);
+		Base::copyMemory(outputExpected, input, size + GUARD * 2);
+		// the copy starts at a different alignment than the source
+		sl_uint32 offsetDst = (offset * 3 + 1) % OFFSET_COUNT;
+		Base::copyMemory(outputExpected + GUARD + offsetDst, src, size);
+		for (sl_uint32 i = 0; i < LEVELS_COUNT; i++) {
+			_priv_Simd::setLevelLimit(g_levels[i]);
+			sl_uint16 result = TCP_IP::calculateOneComplementSum(src, size, add);
+			if (result != expected) {
+				Fail("calculateOneComplementSum", size, offset, (sl_uint32)(g_levels[i]), expected, result);
+			}
+			Base::copyMemory(output, input, size + GUARD * 2);
+			result = TCP_IP::copyAndCalculateOneComplementSum(output + GUARD + offsetDst, src, size, add);
+			if (result != expected) {
+				Fail("copyAndCalculateOneComplementSum", size, offset, (sl_uint32)(g_levels[i]), expected, result);
+			}
+			if (Base::compareMemory(output, outputExpected, size + GUARD * 2)) {
+				Fail("copyAndCalculateOneComplementSum (copy)", size, offset, (sl_uint32)(g_levels[i]), 0, 1);
+			}
+		}
+		_priv_Simd::setLevelLimit(_priv_Simd::AVX2);
+	}
+}
+
+static void TestRandom()
+{
+	static const sl_size sizes[] = { 1023, 1024, 1025, 1499, 1500, 1501, 4095, 4097, 9001, 65535, 65536, 65537 };
+	sl_size nMax = 65537 + GUARD * 2 + OFFSET_COUNT;
+	Memory memInput = Memory::create(nMax);
+	Memory memOutput = Memory::create(nMax);
+	Memory memExpected = Memory::create(nMax);
+	if (memInput.isNull() || memOutput.isNull() || memExpected.isNull()) {
+		Println("FAILED: out of memory");
+		g_nFailed++;
+		return;
+	}
+	sl_uint8* input = (sl_uint8*)(memInput.getData());
+	sl_uint8* output = (sl_uint8*)(memOutput.getData());
+	sl_uint8* expected = (sl_uint8*)(memExpected.getData());
+	for (sl_size k = 0; k < nMax; k++) {
+		input[k] = Random();
+	}
+	// every length up to a few AVX2 blocks, to hit all the tails
+	for (sl_size size = 0; size <= 520; size++) {
+		sl_uint32 add = (size & 1) ? 0 : ((sl_uint32)(Random()) << 24 | (sl_uint32)(Random()) << 8 | Random());
+		TestSize(input, output, expected, size, add);
+	}
+	for (sl_uint32 i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		TestSize(input, output, expected, sizes[i], 0xffff);
+	}
+}
+
+// all ones: the 32-bit lanes overflow unless they are flushed in time
+static void TestOverflow()
+{
+	sl_size size = (1 << 21) + 3;
+	sl_size n = size + GUARD * 2 + OFFSET_COUNT;
+	Memory memInput = Memory::create(n);
+	Memory memOutput = Memory::create(n);
+	Memory memExpected = Memory::create(n);
+	if (memInput.isNull() || memOutput.isNull() || memExpected.isNull()) {
+		Println("FAILED: out of memory");
+		g_nFailed++;
+		return;
+	}
+	Base::resetMemory(memInput.getData(), 0xff, n);
+	TestSize((sl_uint8*)(memInput.getData()), (sl_uint8*)(memOutput.getData()), (sl_uint8*)(memExpected.getData()), size, 0);
+}
+
+int main(int argc, const char * argv[])
+{
+	TestRandom();
+	TestOverflow();
+	if (g_nFailed) {
+		Println("FAILED: %d cases", g_nFailed);
+		return 1;
+	}
+	Println("OK");
+	return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#include <slib/core.h>
+#include <slib/network.h>
+
+using namespace slib;
+
+/*
+	Test of `HttpResponseCache` sharing a route with other pre/post handlers: an authentication handler registered
+	by `before` must still run on every request (including the cache hits), and a rejected request must neither be
+	served from the cache nor stored into it. The requests are dispatched in the same order as `HttpServer` does.
+*/
+
+static sl_uint32 g_nFailed = 0;
+static sl_uint32 g_nAuth = 0;
+static sl_uint32 g_nHandler = 0;
+static sl_uint32 g_nAfter = 0;
+
+class TestContext : public HttpServerContext
+{
+public:
+	TestContext() {}
+};
+
+static void Check(sl_bool flag, const char* name)
+{
+	if (!flag) {
+		Println("FAILED: %s", name);
+		g_nFailed++;
+	}
+}
+
+static String GetBody(HttpServerContext* context)
+{
+	Memory mem;
+	if (context->mergeOutput(mem)) {
+		return String((sl_char8*)(mem.getData()), mem.getSize());
+	}
+	return sl_null;
+}
+
+static Ref<HttpServerContext> Request(HttpServerRouter& router, const String& token)
+{
+	Ref<HttpServerContext> context = new TestContext;
+	context->setMethod(HttpMethod::GET);
+	context->setPath("/data");
+	if (token.isNotEmpty()) {
+		context->setRequestHeader("Authorization", token);
+	}
+	String path = context->getPath();
+	if (router.preProcessRequest(path, sl_null, context.get())) {
+		context->setProcessed();
+	} else if (router.processRequest(path, sl_null, context.get())) {
+		context->setProcessed();
+	}
+	if (!(context->isProcessed())) {
+		context->setResponseCode(HttpStatus::NotFound);
+	}
+	router.postProcessRequest(path, sl_null, context.get());
+	return context;
+}
+
+static void Expect(HttpServerRouter& router, const char* name, const String& token, HttpStatus code, const String& body, sl_uint32 nAuth, sl_uint32 nHandler, sl_uint32 nAfter)
+{
+	Ref<HttpServerContext> context = Request(router, token);
+	if (context->getResponseCode() != code || GetBody(context.get()) != body || g_nAuth != nAuth || g_nHandler != nHandler || g_nAfter != nAfter) {
+		Println("FAILED: %s, code=%d, body=%s, auth=%d, handler=%d, after=%d", name, (sl_uint32)(context->getResponseCode()), GetBody(context.get()), g_nAuth, g_nHandler, g_nAfter);
+		g_nFailed++;
+	}
+}
+
+static void RegisterHandlers(HttpServerRouter& router)
+{
+	router.before(HttpMethod::GET, "/data", [](HttpServer*, HttpServerContext* context) {
+		g_nAuth++;
+		if (context->getRequestHeader("Authorization") != "secret") {
+			context->setResponseCode(HttpStatus::Unauthorized);
+			context->write(String("denied"));
+			return sl_true;
+		}
+		return sl_false;
+	});
+	router.after(HttpMethod::GET, "/data", [](HttpServer*, HttpServerContext* context) {
+		g_nAfter++;
+		return sl_false;
+	});
+	router.GET("/data", [](HttpServer*, HttpServerContext* context) {
+		g_nHandler++;
+		context->write(String("payload"));
+		return sl_true;
+	});
+}
+
+int main(int argc, const char * argv[])
+{
+	HttpServerRouter router;
+	RegisterHandlers(router);
+	Ref<HttpResponseCache> cache = HttpResponseCache::create();
+	HttpResponseCacheRule rule;
+	rule.TTL = 600;
+	cache->GET(router, "/data", rule);
+	
+	Expect(router, "rejected before caching", sl_null, HttpStatus::Unauthorized, "denied", 1, 0, 1);
+	Expect(router, "miss", "secret", HttpStatus::OK, "payload", 2, 1, 2);
+	Expect(router, "hit", "secret", HttpStatus::OK, "payload", 3, 1, 3);
+	Expect(router, "rejected on cached route", "wrong", HttpStatus::Unauthorized, "denied", 4, 1, 4);
+	Expect(router, "hit after rejection", "secret", HttpStatus::OK, "payload", 5, 1, 5);
+	
+	HttpResponseCacheStatistics stats = cache->getStatistics();
+	Check(stats.countHits == 2, "count of hits");
+	Check(stats.countMisses == 1, "count of misses");
+	Check(stats.countEntries == 1, "count of entries");
+	
+	if (g_nFailed) {
+		Println("FAILED: %d cases", g_nFailed);
+		return 1;
+	}
+	Println("OK");
+	return 0;
+}
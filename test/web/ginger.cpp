@@ -0,0 +1,180 @@
+/*
+ *   Copyright (c) 2008-2018 SLIBIO <https://github.com/SLIBIO>
+ *
+ *   Permission is hereby granted, free of charge, to any person obtaining a copy
+ *   of this software and associated documentation files (the "Software"), to deal
+ *   in the Software without restriction, including without limitation the rights
+ *   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *   copies of the Software, and to permit persons to whom the Software is
+ *   furnished to do so, subject to the following conditions:
+ *
+ *   The above copyright notice and this permission notice shall be included in
+ *   all copies or substantial portions of the Software.
+ *
+ *   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *   THE SOFTWARE.
+ */
+
+
+#define SLIB_SUPPORT_STD_TYPES
+
+#include <slib/core.h>
+#include <slib/web/ginger.h>
+
+#include <ginger/ginger.h>
+
+using namespace slib;
+
+/*
+	Differential test of the compiled Ginger templates: every template is rendered by `Ginger::render`/`Ginger::renderFile`
+	and by the bundled ginger library, and the outputs must be identical. The conditions stay in the syntax accepted by
+	the bundled library (boolean and integer values, `==` without spaces). Syntax errors must give null results.
+*/
+
+static sl_uint32 g_nFailed = 0;
+
+static const char* g_data = "{"
+	"\"name\": \"World\", \"count\": 3, \"zero\": 0, \"ratio\": 0.25, \"flag\": true, \"off\": false, \"empty\": \"\", \"nothing\": null,"
+	"\"items\": [1, 2, 3], \"none\": [], \"words\": [\"a\", \"bb\", \"\"],"
+	"\"user\": {\"name\": \"Kim\", \"age\": 30, \"tags\": [\"x\", \"y\"]},"
+	"\"users\": [{\"name\": \"A\", \"age\": 1}, {\"name\": \"B\", \"age\": 2}],"
+	"\"rows\": [{\"cells\": [1, 2]}, {\"cells\": []}, {\"cells\": [3]}]"
+"}";
+
+static void CompareRender(const char* name, const String& source, const Json& data)
+{
+	String expected;
+	try {
+		expected = String(ginger::render_string(source.toStd(), data));
+	} catch (...) {
+		Println("FAILED: %s, the bundled library rejected the template", name);
+		g_nFailed++;
+		return;
+	}
+	String result = Ginger::render(source, data);
+	if (result != expected) {
+		Println("FAILED: %s\n  expected: [%s]\n  result:   [%s]", name, expected, result);
+		g_nFailed++;
+	}
+}
+
+static void CompareRenderFile(const char* name, const String& path, const Json& data)
+{
+	String expected;
+	try {
+		expected = String(ginger::render_file(path.toStd(), data));
+	} catch (...) {
+		Println("FAILED: %s, the bundled library rejected the template", name);
+		g_nFailed++;
+		return;
+	}
+	String result = Ginger::renderFile(path, data);
+	if (result != expected) {
+		Println("FAILED: %s\n  expected: [%s]\n  result:   [%s]", name, expected, result);
+		g_nFailed++;
+	}
+}
+
+static void TestTemplates(const Json& data)
+{
+	CompareRender("text", "plain text without tags", data);
+	CompareRender("variables", "Hello ${name}! ${count} ${ratio} ${flag} ${off} [${empty}] ${nothing}", data);
+	CompareRender("members", "${user.name} is ${ user.age }.", data);
+	
+	CompareRender("for", "$for x in items {{[${x}]}}", data);
+	CompareRender("for empty", "<$for x in none {{[${x}]}}>", data);
+	CompareRender("for strings", "$for w in words {{(${w})}}", data);
+	CompareRender("for maps", "$for u in users {{${u.name}=${u.age};}}", data);
+	CompareRender("for member list", "$for t in user.tags {{${t} }}", data);
+	CompareRender("for nested", "$for r in rows {{<$for c in r.cells {{${c},}}>}}", data);
+	CompareRender("for shadowing", "$for name in words {{${name}|}}${name}", data);
+	CompareRender("for outer", "$for x in items {{$for y in items {{${x}${y} }}}}", data);
+	
+	CompareRender("if", "$if flag {{yes}}", data);
+	CompareRender("if false", "[$if off {{yes}}]", data);
+	CompareRender("if else", "$if off {{yes}} $else {{no}}", data);
+	CompareRender("if elseif", "$if off {{one}} $elseif flag {{two}} $else {{other}}", data);
+	CompareRender("if elseif else", "$if off {{one}} $elseif off {{two}} $else {{other}}", data);
+	CompareRender("if compare", "$if count==3 {{three}} $else {{other}}|$if count==4 {{four}} $else {{other}}", data);
+	CompareRender("if compare string", "$if name==World {{world}} $else {{other}}|$if name==world {{world}} $else {{other}}", data);
+	CompareRender("if number", "$if count {{nonzero}} $else {{zero}}|$if zero {{nonzero}} $else {{zero}}", data);
+	CompareRender("if in for", "$for x in items {{$if flag {{${x}}} $else {{-}}}}", data);
+	CompareRender("for in if", "$if flag {{$for x in items {{${x}}}}}", data);
+	
+	CompareRender("escapes", "$$ ${{ $}} a } b { c $$${name}", data);
+	CompareRender("comment", "before $# a comment ${name}\nafter", data);
+	CompareRender("unicode", "\xED\x95\x9C\xEA\xB8\x80 ${name} \xF0\x9F\x98\x80", data);
+	
+	String longText;
+	for (sl_uint32 i = 0; i < 100; i++) {
+		longText += "long text to be referenced from the compiled source ";
+	}
+	CompareRender("long text", longText + "${name}" + longText, data);
+}
+
+static void TestFiles(const Json& data)
+{
+	String dir = System::getTempDirectory() + String::format("/slib_test_ginger_%d", System::getProcessId());
+	File::createDirectories(dir);
+	String pathPart = dir + "/part.html";
+	String pathRaw = dir + "/raw.html";
+	String pathMain = dir + "/main.html";
+	File::writeAllTextUTF8(pathPart, "<p>${name}: $for x in items {{${x}}}</p>");
+	File::writeAllTextUTF8(pathRaw, "raw ${name} $$");
+	File::writeAllTextUTF8(pathMain, "begin $include {{ " + pathPart + " }} middle $inline {{ " + pathRaw + " }} $if flag {{$include {{" + pathPart + "}}}} end");
+	
+	CompareRender("include", "[$include {{ " + pathPart + " }}]", data);
+	CompareRender("inline", "[$inline {{ " + pathRaw + " }}]", data);
+	CompareRender("include in for", "$for x in items {{$include {{ " + pathPart + " }}}}", data);
+	CompareRenderFile("renderFile", pathMain, data);
+	
+	// modified file is compiled again
+	File::writeAllTextUTF8(pathMain, "changed ${user.name} $include {{ " + pathPart + " }}");
+	CompareRenderFile("renderFile modified", pathMain, data);
+	
+	File::deleteDirectoryRecursively(dir);
+}
+
+static void TestErrors(const Json& data)
+{
+	static const char* sources[] = {
+		"${name", "${}", "$for x items {{${x}}}", "$for x in items {{${x}", "$if flag {{yes", "$unknown {{ }}", "$", "$include {{ }}"
+	};
+	for (sl_uint32 i = 0; i < sizeof(sources) / sizeof(sources[0]); i++) {
+		if (GingerTemplate::compile(sources[i]).isNotNull()) {
+			Println("FAILED: compiled an invalid template: %s", sources[i]);
+			g_nFailed++;
+		}
+		if (Ginger::render(sources[i], data).isNotNull()) {
+			Println("FAILED: rendered an invalid template: %s", sources[i]);
+			g_nFailed++;
+		}
+	}
+	if (Ginger::renderFile("/not/existing/ginger/template.html", data).isNotNull()) {
+		Println("FAILED: rendered a missing file");
+		g_nFailed++;
+	}
+}
+
+int main(int argc, const char * argv[])
+{
+	Json data = Json::parseJson(g_data);
+	if (!(data.isJsonMap())) {
+		Println("FAILED: invalid test data");
+		return 1;
+	}
+	TestTemplates(data);
+	TestFiles(data);
+	TestErrors(data);
+	if (g_nFailed) {
+		Println("FAILED: %d cases", g_nFailed);
+		return 1;
+	}
+	Println("OK");
+	return 0;
+}